@@ -4572,6 +4572,9 @@ void CApplication::UpdateLibraries()
     StartVideoScan("", !settings->GetBool(CSettings::SETTING_VIDEOLIBRARY_BACKGROUNDUPDATE));
   }
 
+  // continue filling in stream details and thumbs if the last run was interrupted
+  CVideoLibraryQueue::GetInstance().BackfillLibrary(true);
+
   if (settings->GetBool(CSettings::SETTING_MUSICLIBRARY_UPDATEONSTARTUP))
   {
     CLog::LogF(LOGNOTICE, "Starting music library startup scan");
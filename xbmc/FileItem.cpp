@@ -7,6 +7,7 @@
  */
 
 #include "FileItem.h"
+#include "FileItemListPager.h"
 
 #include "CueDocument.h"
 #include "ServiceBroker.h"
@@ -1634,7 +1635,7 @@ void CFileItem::UpdateInfo(const CFileItem &item, bool replaceLabels /*=true*/)
     SetLabel(item.GetLabel());
   if (replaceLabels && !item.GetLabel2().empty())
     SetLabel2(item.GetLabel2());
-  if (!item.GetArt().empty())
+  if (item.HasArt())
     SetArt(item.GetArt());
   if (!item.GetIconImage().empty())
     SetIconImage(item.GetIconImage());
@@ -2016,6 +2017,7 @@ void CFileItemList::ClearItems()
     item->FreeMemory();
   }
   m_items.clear();
+  m_pager.reset();
   m_map.clear();
 }
 
@@ -2076,7 +2078,7 @@ void CFileItemList::Remove(int iItem)
 {
   CSingleLock lock(m_lock);
 
-  if (iItem >= 0 && iItem < Size())
+  if (iItem >= 0 && iItem < (int)m_items.size())
   {
     CFileItemPtr pItem = *(m_items.begin() + iItem);
     if (m_fastLookup)
@@ -2091,8 +2093,11 @@ void CFileItemList::Append(const CFileItemList& itemlist)
 {
   CSingleLock lock(m_lock);
 
-  for (int i = 0; i < itemlist.Size(); ++i)
-    Add(itemlist[i]);
+  for (const auto& item : itemlist.m_items)
+    Add(item);
+  // the lists are sorted independently
+  if (itemlist.m_pager)
+    m_pager = itemlist.m_pager->Clone();
 }
 
 void CFileItemList::Assign(const CFileItemList& itemlist, bool append)
@@ -2128,11 +2133,14 @@ bool CFileItemList::Copy(const CFileItemList& items, bool copyItems /* = true */
   if (copyItems)
   {
     // make a copy of each item
-    for (int i = 0; i < items.Size(); i++)
+    for (const auto& item : items.m_items)
     {
-      CFileItemPtr newItem(new CFileItem(*items[i]));
+      CFileItemPtr newItem(new CFileItem(*item));
       Add(newItem);
     }
+    // the items of a virtual list are loaded when needed anyway
+    if (items.m_pager)
+      m_pager = items.m_pager->Clone();
   }
 
   return true;
@@ -2144,6 +2152,8 @@ CFileItemPtr CFileItemList::Get(int iItem)
 
   if (iItem > -1 && iItem < (int)m_items.size())
     return m_items[iItem];
+  if (m_pager && iItem >= (int)m_items.size())
+    return m_pager->Get(iItem - (int)m_items.size());
 
   return CFileItemPtr();
 }
@@ -2154,6 +2164,8 @@ const CFileItemPtr CFileItemList::Get(int iItem) const
 
   if (iItem > -1 && iItem < (int)m_items.size())
     return m_items[iItem];
+  if (m_pager && iItem >= (int)m_items.size())
+    return m_pager->Get(iItem - (int)m_items.size());
 
   return CFileItemPtr();
 }
@@ -2207,13 +2219,63 @@ const CFileItemPtr CFileItemList::Get(const std::string& strPath) const
 int CFileItemList::Size() const
 {
   CSingleLock lock(m_lock);
+  if (m_pager)
+    return (int)m_items.size() + m_pager->GetCount();
   return (int)m_items.size();
 }
 
 bool CFileItemList::IsEmpty() const
 {
   CSingleLock lock(m_lock);
-  return m_items.empty();
+  return m_items.empty() && (!m_pager || m_pager->GetCount() == 0);
+}
+
+void CFileItemList::SetPager(std::shared_ptr<CFileItemListPager> pager)
+{
+  CSingleLock lock(m_lock);
+  m_pager = std::move(pager);
+}
+
+int CFileItemList::GetAddedCount() const
+{
+  CSingleLock lock(m_lock);
+  return (int)m_items.size();
+}
+
+void CFileItemList::GetLoadedItems(std::vector<std::pair<int, CFileItemPtr>> &items) const
+{
+  CSingleLock lock(m_lock);
+  for (size_t i = 0; i < m_items.size(); i++)
+    items.emplace_back(static_cast<int>(i), m_items[i]);
+
+  if (m_pager)
+  {
+    std::vector<std::pair<int, CFileItemPtr>> pagerItems;
+    m_pager->GetLoadedItems(pagerItems);
+    for (const auto& item : pagerItems)
+      items.emplace_back(static_cast<int>(m_items.size()) + item.first, item.second);
+  }
+}
+
+bool CFileItemList::LoadAllItems()
+{
+  CSingleLock lock(m_lock);
+  if (!m_pager)
+    return true;
+
+  CFileItemList items;
+  if (!m_pager->GetAllItems(items))
+    return false;
+
+  SetPagerItems(items);
+  return true;
+}
+
+void CFileItemList::SetPagerItems(const CFileItemList &items)
+{
+  CSingleLock lock(m_lock);
+  m_pager.reset();
+  Append(items);
 }
 
 void CFileItemList::Reserve(int iCount)
@@ -2270,6 +2332,20 @@ void CFileItemList::Sort(SortDescription sortDescription)
   if (m_sortIgnoreFolders)
     sortDescription.sortAttributes = (SortAttribute)((int)sortDescription.sortAttributes | SortAttributeIgnoreFolders);
 
+  // the source of a virtual list sorts all of its items, the items in front keep their place
+  if (m_pager)
+  {
+    if (m_pager->Sort(sortDescription))
+      return;
+
+    // the source can't sort this way, sort all items in memory. this blocks until all of them
+    // are loaded, the GUI loads them on a job first.
+    CLog::Log(LOGDEBUG, "CFileItemList::Sort - sort method %i not supported by the source of %s, loading all items",
+              sortDescription.sortBy, CURL::GetRedacted(GetPath()).c_str());
+    if (!LoadAllItems())
+      return;
+  }
+
   const Fields fields = SortUtils::GetFieldsForSorting(sortDescription.sortBy);
   SortItems sortItems((size_t)Size());
   for (int index = 0; index < Size(); index++)
@@ -2459,6 +2535,8 @@ int CFileItemList::GetObjectCount() const
   int numObjects = (int)m_items.size();
   if (numObjects && m_items[0]->IsParentFolder())
     numObjects--;
+  if (m_pager)
+    numObjects += m_pager->GetCount();
 
   return numObjects;
 }
@@ -2473,6 +2551,9 @@ int CFileItemList::GetFileCount() const
     if (!pItem->m_bIsFolder)
       nFileCount++;
   }
+  // sources of virtual lists only have files
+  if (m_pager)
+    nFileCount += m_pager->GetCount();
 
   return nFileCount;
 }
@@ -2916,6 +2997,10 @@ bool CFileItemList::Load(int windowID)
 
 bool CFileItemList::Save(int windowID)
 {
+  // the source of a virtual list is the cache
+  if (m_pager)
+    return false;
+
   int iSize = Size();
   if (iSize <= 0)
     return false;
@@ -3487,6 +3572,9 @@ bool CFileItem::HasVideoInfoTag() const
 
 CVideoInfoTag* CFileItem::GetVideoInfoTag()
 {
+  // the caller may change the tag and with it what the labels are formatted from
+  SetLabelFormat(0);
+
   // Note: CPVRRecording is derived from CVideoInfoTag
   if (m_pvrRecordingInfoTag)
     return m_pvrRecordingInfoTag.get();
@@ -3504,6 +3592,8 @@ const CVideoInfoTag* CFileItem::GetVideoInfoTag() const
 
 CPictureInfoTag* CFileItem::GetPictureInfoTag()
 {
+  SetLabelFormat(0);
+
   if (!m_pictureInfoTag)
     m_pictureInfoTag = new CPictureInfoTag;
 
@@ -3512,6 +3602,8 @@ CPictureInfoTag* CFileItem::GetPictureInfoTag()
 
 MUSIC_INFO::CMusicInfoTag* CFileItem::GetMusicInfoTag()
 {
+  SetLabelFormat(0);
+
   if (!m_musicInfoTag)
     m_musicInfoTag = new MUSIC_INFO::CMusicInfoTag;
 
@@ -3520,6 +3612,8 @@ MUSIC_INFO::CMusicInfoTag* CFileItem::GetMusicInfoTag()
 
 CGameInfoTag* CFileItem::GetGameInfoTag()
 {
+  SetLabelFormat(0);
+
   if (!m_gameInfoTag)
     m_gameInfoTag = new CGameInfoTag;
 
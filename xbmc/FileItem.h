@@ -54,6 +54,7 @@ class CURL;
 class CVariant;
 
 class CFileItemList;
+class CFileItemListPager;
 class CCueDocument;
 typedef std::shared_ptr<CCueDocument> CCueDocumentPtr;
 
@@ -118,7 +119,7 @@ public:
   void SetURL(const CURL& url);
   bool IsURL(const CURL& url) const;
   const std::string &GetPath() const { return m_strPath; };
-  void SetPath(const std::string &path) { m_strPath = path; };
+  void SetPath(const std::string &path) { m_strPath = path; SetLabelFormat(0); };
   bool IsPath(const std::string& path, bool ignoreURLOptions = false) const;
 
   const CURL GetDynURL() const;
@@ -748,6 +749,26 @@ public:
 
   void ClearSortState();
 
+  /*! \brief Make this a virtual list, the items of the pager follow the items added to the list
+
+   The pager only loads the items being used, the count and the sort order
+   come from its source. Operations that go through the internal list (e.g.
+   stacking, searching by path, iterating with begin() and end()) only see
+   the items added to the list.
+   \sa CFileItemListPager
+   */
+  void SetPager(std::shared_ptr<CFileItemListPager> pager);
+  const std::shared_ptr<CFileItemListPager>& GetPager() const { return m_pager; }
+  bool IsVirtual() const { return m_pager != nullptr; }
+  /*! \brief Number of items added to the list, without those of the pager */
+  int GetAddedCount() const;
+  /*! \brief Get the items added to the list and the pager's loaded items with their index, without loading any */
+  void GetLoadedItems(std::vector<std::pair<int, CFileItemPtr>> &items) const;
+  /*! \brief Load all items of the pager into the list, it isn't virtual anymore afterwards */
+  bool LoadAllItems();
+  /*! \brief Replace the pager by its items, e.g. loaded from a clone of the pager on a job */
+  void SetPagerItems(const CFileItemList &items);
+
   VECFILEITEMS::const_iterator begin() { return m_items.cbegin(); }
   VECFILEITEMS::const_iterator end() { return m_items.cend(); }
   VECFILEITEMS::const_iterator begin() const { return m_items.begin(); }
@@ -772,6 +793,7 @@ private:
   void StackFolders();
 
   VECFILEITEMS m_items;
+  std::shared_ptr<CFileItemListPager> m_pager;
   MAPFILEITEMS m_map;
   bool m_ignoreURLOptions = false;
   bool m_fastLookup = false;
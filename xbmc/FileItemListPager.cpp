@@ -0,0 +1,264 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItemListPager.h"
+
+#include "FileItem.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+CFileItemListPager::CFileItemListPager(std::unique_ptr<IFileItemListSource> source)
+  : m_source(std::move(source))
+{
+}
+
+std::shared_ptr<CFileItemListPager> CFileItemListPager::Clone() const
+{
+  CSingleLock lock(m_section);
+  CSingleLock sourceLock(m_sourceSection);
+  std::shared_ptr<CFileItemListPager> pager = std::make_shared<CFileItemListPager>(m_source->Clone());
+  pager->m_prepare = m_prepare;
+  pager->m_count = m_count;
+  return pager;
+}
+
+int CFileItemListPager::GetCount()
+{
+  CSingleLock lock(m_section);
+  if (m_count < 0)
+  {
+    CSingleLock sourceLock(m_sourceSection);
+    m_count = std::max(m_source->GetCount(), 0);
+  }
+  return m_count;
+}
+
+CFileItemPtr CFileItemListPager::Get(int index)
+{
+  CSingleLock lock(m_section);
+  if (index < 0 || index >= GetCount())
+    return CFileItemPtr();
+
+  Page& page = LoadPage(index / PAGE_SIZE);
+  page.lastUsed = ++m_useCounter;
+  return page.items[index % PAGE_SIZE];
+}
+
+CFileItemPtr CFileItemListPager::GetIfLoaded(int index)
+{
+  int page;
+  unsigned int generation;
+  {
+    CSingleLock lock(m_section);
+    if (index < 0 || index >= GetCount())
+      return CFileItemPtr();
+
+    page = index / PAGE_SIZE;
+    auto it = m_pages.find(page);
+    if (it != m_pages.end())
+    {
+      it->second.lastUsed = ++m_useCounter;
+      return it->second.items[index % PAGE_SIZE];
+    }
+
+    if (!m_requestedPages.insert(page).second)
+      return CFileItemPtr();
+    generation = m_generation;
+  }
+
+  // not submitted with the section held, the job manager destroys dropped jobs with its own lock held
+  LoadPageAsync(page, generation);
+  return CFileItemPtr();
+}
+
+CFileItemListPager::Page& CFileItemListPager::LoadPage(int page)
+{
+  auto it = m_pages.find(page);
+  if (it != m_pages.end())
+    return it->second;
+
+  const int start = page * PAGE_SIZE;
+  const int count = std::min(PAGE_SIZE, m_count - start);
+
+  CFileItemList items;
+  bool loaded;
+  {
+    CSingleLock sourceLock(m_sourceSection);
+    loaded = m_source->GetItems(start, count, items) && items.Size() == count;
+  }
+  if (loaded && m_prepare)
+    m_prepare(items);
+
+  return StorePage(page, items, loaded);
+}
+
+void CFileItemListPager::LoadPageAsync(int page, unsigned int generation)
+{
+  auto request = std::make_shared<CPageRequest>(shared_from_this(), page, generation);
+  CJobManager::GetInstance().Submit([request]() { request->Run(); }, CJob::PRIORITY_HIGH);
+}
+
+CFileItemListPager::CPageRequest::CPageRequest(std::weak_ptr<CFileItemListPager> pager, int page, unsigned int generation)
+  : m_pager(std::move(pager)), m_page(page), m_generation(generation)
+{
+}
+
+CFileItemListPager::CPageRequest::~CPageRequest()
+{
+  std::shared_ptr<CFileItemListPager> pager = m_pager.lock();
+  if (!pager)
+    return;
+
+  CSingleLock lock(pager->m_section);
+  if (pager->m_generation == m_generation)
+    pager->m_requestedPages.erase(m_page);
+}
+
+void CFileItemListPager::CPageRequest::Run()
+{
+  std::shared_ptr<CFileItemListPager> pager = m_pager.lock();
+  if (!pager)
+    return;
+
+  int start;
+  int count;
+  PrepareFunction prepare;
+  {
+    CSingleLock lock(pager->m_section);
+    if (pager->m_generation != m_generation || pager->m_pages.find(m_page) != pager->m_pages.end())
+      return;
+    start = m_page * PAGE_SIZE;
+    count = std::min(PAGE_SIZE, pager->m_count - start);
+    prepare = pager->m_prepare;
+  }
+
+  // the list is shown meanwhile, only the source is locked while the page is loaded
+  CFileItemList items;
+  bool loaded;
+  {
+    CSingleLock sourceLock(pager->m_sourceSection);
+    if (pager->m_generation != m_generation)
+      return;
+    loaded = pager->m_source->GetItems(start, count, items) && items.Size() == count;
+  }
+  if (loaded && prepare)
+    prepare(items);
+
+  CSingleLock lock(pager->m_section);
+  if (pager->m_generation == m_generation && pager->m_pages.find(m_page) == pager->m_pages.end())
+    pager->StorePage(m_page, items, loaded);
+}
+
+CFileItemListPager::Page& CFileItemListPager::StorePage(int page, CFileItemList &items, bool loaded)
+{
+  // drop the least recently used page
+  if (m_pages.size() >= static_cast<size_t>(MAX_PAGES))
+  {
+    auto oldest = std::min_element(m_pages.begin(), m_pages.end(),
+                                   [](const std::pair<const int, Page>& a, const std::pair<const int, Page>& b)
+                                   { return a.second.lastUsed < b.second.lastUsed; });
+    m_pages.erase(oldest);
+  }
+
+  const int start = page * PAGE_SIZE;
+  const int count = std::min(PAGE_SIZE, m_count - start);
+  if (!loaded)
+  {
+    CLog::Log(LOGERROR, "CFileItemListPager: failed to get items %i to %i (got %i)", start, start + count - 1, items.Size());
+    items.Clear();
+  }
+
+  Page& result = m_pages[page];
+  result.items.reserve(count);
+  for (int i = 0; i < count; i++)
+  {
+    // keep the indexes of the following items, even if the source failed
+    CFileItemPtr item = items.Get(i);
+    result.items.push_back(item ? item : std::make_shared<CFileItem>());
+  }
+  return result;
+}
+
+bool CFileItemListPager::GetAllItems(CFileItemList &items)
+{
+  CSingleLock lock(m_section);
+  const int count = GetCount();
+  CSingleLock sourceLock(m_sourceSection);
+  if (!m_source->GetItems(0, count, items) || items.Size() != count)
+  {
+    CLog::Log(LOGERROR, "CFileItemListPager: failed to get all %i items (got %i)", count, items.Size());
+    return false;
+  }
+  return true;
+}
+
+bool CFileItemListPager::CanSort(const SortDescription &sortDescription) const
+{
+  CSingleLock lock(m_section);
+  CSingleLock sourceLock(m_sourceSection);
+  return m_source->CanSort(sortDescription);
+}
+
+bool CFileItemListPager::Sort(const SortDescription &sortDescription)
+{
+  CSingleLock lock(m_section);
+  CSingleLock sourceLock(m_sourceSection);
+  if (!m_source->Sort(sortDescription))
+    return false;
+
+  Invalidate();
+  return true;
+}
+
+void CFileItemListPager::SetPrepareFunction(PrepareFunction prepare)
+{
+  CSingleLock lock(m_section);
+  CSingleLock sourceLock(m_sourceSection);
+  m_prepare = std::move(prepare);
+  m_pages.clear();
+  // pages being loaded were prepared by the old function
+  m_requestedPages.clear();
+  m_generation++;
+}
+
+void CFileItemListPager::GetLetterOffsets(std::vector<std::pair<int, std::string>> &offsets)
+{
+  CSingleLock lock(m_section);
+  if (!m_letterOffsetsValid)
+  {
+    m_letterOffsets.clear();
+    CSingleLock sourceLock(m_sourceSection);
+    if (!m_source->GetLetterOffsets(m_letterOffsets))
+      m_letterOffsets.clear();
+    m_letterOffsetsValid = true;
+  }
+  offsets = m_letterOffsets;
+}
+
+void CFileItemListPager::GetLoadedItems(std::vector<std::pair<int, CFileItemPtr>> &items) const
+{
+  CSingleLock lock(m_section);
+  for (const auto& page : m_pages)
+  {
+    for (size_t i = 0; i < page.second.items.size(); i++)
+      items.emplace_back(page.first * PAGE_SIZE + static_cast<int>(i), page.second.items[i]);
+  }
+}
+
+void CFileItemListPager::Invalidate()
+{
+  // the number of items stays the same, pages being loaded are in the old order
+  m_pages.clear();
+  m_requestedPages.clear();
+  m_generation++;
+  m_letterOffsetsValid = false;
+  m_letterOffsets.clear();
+}
@@ -0,0 +1,131 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "IFileItemListSource.h"
+#include "threads/CriticalSection.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CFileItem;
+typedef std::shared_ptr<CFileItem> CFileItemPtr;
+
+/*!
+ \brief Items of a virtual CFileItemList, fetched page by page from an IFileItemListSource.
+
+ Only the most recently used pages are kept, so memory use doesn't depend on
+ the number of items in the list. Shared by the list and the containers
+ showing it, all methods are thread safe. Always created with std::make_shared,
+ pages requested with GetIfLoaded() are loaded on jobs.
+ */
+class CFileItemListPager : public std::enable_shared_from_this<CFileItemListPager>
+{
+public:
+  typedef std::function<void(CFileItemList &page)> PrepareFunction;
+
+  static const int PAGE_SIZE = 100;
+  static const int MAX_PAGES = 16;
+
+  explicit CFileItemListPager(std::unique_ptr<IFileItemListSource> source);
+
+  /*!
+   \brief Create a pager for the same items with its own source, e.g. for a copy of the list
+   */
+  std::shared_ptr<CFileItemListPager> Clone() const;
+
+  int GetCount();
+
+  /*!
+   \brief Get an item, loads its page from the source if needed
+   \return the item, an empty item if its page couldn't be loaded and nullptr if index is out of range
+   */
+  CFileItemPtr Get(int index);
+
+  /*!
+   \brief Get an item if its page is loaded, otherwise load the page on a job, e.g. for rendering
+   \return the item, nullptr if its page is still being loaded or index is out of range
+   */
+  CFileItemPtr GetIfLoaded(int index);
+
+  /*!
+   \brief Get all items in the current order, the prepare function isn't run on them
+   Blocks the pager while the whole list is loaded, use it on a Clone() to keep the list responsive.
+   */
+  bool GetAllItems(CFileItemList &items);
+
+  bool CanSort(const SortDescription &sortDescription) const;
+
+  /*!
+   \brief Sort the items, drops all loaded pages
+   \return false if the source can't sort this way
+   */
+  bool Sort(const SortDescription &sortDescription);
+
+  /*!
+   \brief Set a function run on each page after it was loaded, e.g. to format the labels, drops all loaded pages
+   */
+  void SetPrepareFunction(PrepareFunction prepare);
+
+  void GetLetterOffsets(std::vector<std::pair<int, std::string>> &offsets);
+
+  /*!
+   \brief Get the loaded items with their index, for lookups that mustn't load the whole list
+   */
+  void GetLoadedItems(std::vector<std::pair<int, CFileItemPtr>> &items) const;
+
+private:
+  CFileItemListPager(const CFileItemListPager&) = delete;
+  CFileItemListPager& operator=(const CFileItemListPager&) = delete;
+
+  struct Page
+  {
+    std::vector<CFileItemPtr> items;
+    uint64_t lastUsed;
+  };
+
+  /*!
+   \brief Owned by the job loading a page, the page can be requested again once the job is gone, also if it was dropped
+   */
+  class CPageRequest
+  {
+  public:
+    CPageRequest(std::weak_ptr<CFileItemListPager> pager, int page, unsigned int generation);
+    ~CPageRequest();
+    void Run();
+
+  private:
+    std::weak_ptr<CFileItemListPager> m_pager;
+    int m_page;
+    unsigned int m_generation;
+  };
+
+  Page& LoadPage(int page);
+  void LoadPageAsync(int page, unsigned int generation);
+  Page& StorePage(int page, CFileItemList &items, bool loaded);
+  void Invalidate();
+
+  mutable CCriticalSection m_section;
+  mutable CCriticalSection m_sourceSection; ///< the source isn't thread safe, taken after m_section if both are needed
+  std::unique_ptr<IFileItemListSource> m_source;
+  PrepareFunction m_prepare;
+  int m_count = -1;
+  std::map<int, Page> m_pages;
+  std::set<int> m_requestedPages; ///< pages being loaded on jobs
+  unsigned int m_generation = 0; ///< changed with the order of the items, changed with both sections held
+  uint64_t m_useCounter = 0;
+  bool m_letterOffsetsValid = false;
+  std::vector<std::pair<int, std::string>> m_letterOffsets;
+};
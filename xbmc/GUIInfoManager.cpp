@@ -22,9 +22,12 @@
 #include "interfaces/AnnouncementManager.h"
 #include "interfaces/info/InfoExpression.h"
 #include "messaging/ApplicationMessenger.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "settings/SkinSettings.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
@@ -32,12 +35,19 @@
 #include <cmath>
 #include <functional>
 #include <iterator>
+#include <map>
 #include <memory>
 
 using namespace KODI::GUILIB;
 using namespace KODI::GUILIB::GUIINFO;
 using namespace INFO;
 
+namespace
+{
+// number of frames after which the conditions are reordered
+const unsigned int CONDITION_REORDER_INTERVAL = 256;
+}
+
 bool InfoBoolComparator(const InfoPtr &right, const InfoPtr &left)
 {
   return *right < *left;
@@ -912,6 +922,14 @@ const infomap player_times[] =   {{ "seektime",         PLAYER_SEEKTIME },
 ///     @skinning_v17 **[New Infolabel]** \link Player_Process_audiobitspersample `Player.Process(audiobitspersample)`\endlink
 ///     <p>
 ///   }
+///   \table_row3{   <b>`Player.Process(audiolatency)`</b>,
+///                  \anchor Player_Process_audiolatency
+///                  _string_,
+///     @return The measured audio output latency in milliseconds of the currently playing game\, empty if not available.
+///     <p><hr>
+///     @skinning_v19 **[New Infolabel]** \link Player_Process_audiolatency `Player.Process(audiolatency)`\endlink
+///     <p>
+///   }
 /// \table_end
 ///
 /// -----------------------------------------------------------------------------
@@ -929,7 +947,8 @@ const infomap player_process[] =
   { "audiodecoder", PLAYER_PROCESS_AUDIODECODER },
   { "audiochannels", PLAYER_PROCESS_AUDIOCHANNELS },
   { "audiosamplerate", PLAYER_PROCESS_AUDIOSAMPLERATE },
-  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE }
+  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE },
+  { "audiolatency", PLAYER_PROCESS_AUDIOLATENCY }
 };
 
 /// \page modules__infolabels_boolean_conditions
@@ -9624,6 +9643,14 @@ void CGUIInfoManager::Clear()
   CSingleLock lock(m_critInfo);
   m_skinVariableStrings.clear();
 
+  if (INFO::InfoBool::IsProfiling())
+    LogConditionProfile();
+
+  // takes effect for the conditions of the skin loaded next
+  CSettingsComponent *settingsComponent = CServiceBroker::GetSettingsComponent();
+  if (settingsComponent)
+    INFO::InfoBool::SetProfiling(settingsComponent->GetAdvancedSettings()->m_guiProfileConditions);
+
   /*
     Erase any info bools that are unused. We do this repeatedly as each run
     will remove those bools that are no longer dependencies of other bools
@@ -9644,6 +9671,44 @@ void CGUIInfoManager::Clear()
     CLog::Log(LOGDEBUG, "Infobool '%s' still used by %u instances", (*i)->GetExpression().c_str(), (unsigned int) i->use_count());
 }
 
+void CGUIInfoManager::LogConditionProfile(int contextWindow /* = -1 */)
+{
+  CSingleLock lock(m_critInfo);
+
+  std::map<int, std::vector<std::pair<int64_t, INFO::InfoPtr>>> contexts;
+  for (const auto &info : m_bools)
+  {
+    if (contextWindow != -1 && info->GetContext() != contextWindow)
+      continue;
+
+    int64_t time;
+    unsigned int updates;
+    info->GetProfile(time, updates);
+    if (updates > 0)
+      contexts[info->GetContext()].emplace_back(time, info);
+    info->ResetProfile();
+  }
+
+  const double ticksPerMs = CurrentHostFrequency() / 1000.0;
+  for (auto &context : contexts)
+  {
+    auto &infos = context.second;
+    const size_t count = std::min(infos.size(), static_cast<size_t>(10));
+    std::partial_sort(infos.begin(), infos.begin() + count, infos.end(),
+                      [](const std::pair<int64_t, INFO::InfoPtr> &a, const std::pair<int64_t, INFO::InfoPtr> &b)
+                      {
+                        return a.first > b.first;
+                      });
+
+    std::string window = context.first ? CWindowTranslator::TranslateWindow(context.first) : "global";
+    if (window.empty())
+      window = StringUtils::Format("window %d", context.first);
+    CLog::Log(LOGNOTICE, "Most expensive conditions of %s (%u evaluated)", window.c_str(), static_cast<unsigned int>(infos.size()));
+    for (size_t i = 0; i < count; i++)
+      CLog::Log(LOGNOTICE, "  %8.2f ms: %s", infos[i].first / ticksPerMs, infos[i].second->GetExpression().c_str());
+  }
+}
+
 void CGUIInfoManager::UpdateAVInfo()
 {
   if (CServiceBroker::GetDataCacheCore().HasAVInfoChanges())
@@ -9887,6 +9952,14 @@ void CGUIInfoManager::ResetCache()
   // mark our infobools as dirty
   CSingleLock lock(m_critInfo);
   ++m_refreshCounter;
+
+  // adapt the order of evaluation every few frames, expressions are evaluated on other threads too
+  // and swap in the reordered code atomically
+  if (m_refreshCounter % CONDITION_REORDER_INTERVAL == 0)
+  {
+    for (const auto &info : m_bools)
+      info->Reorder();
+  }
 }
 
 void CGUIInfoManager::SetCurrentVideoTag(const CVideoInfoTag &tag)
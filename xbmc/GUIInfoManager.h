@@ -62,6 +62,13 @@ public:
   void Clear();
   void ResetCache();
 
+  /*! \brief Log the conditions that took the most time to update, per window, and reset the times
+   Only measured if profileconditions is enabled in the gui section of advancedsettings.xml. The
+   conditions of a window are logged when it is closed, all others when the skin is unloaded.
+   \param contextWindow the window to log the conditions of, -1 for all
+   */
+  void LogConditionProfile(int contextWindow = -1);
+
   // KODI::MESSAGING::IMessageTarget implementation
   int GetMessageMask() override;
   void OnApplicationMessage(KODI::MESSAGING::ThreadMessage* pMsg) override;
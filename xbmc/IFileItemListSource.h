@@ -0,0 +1,60 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/SortUtils.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CFileItemList;
+
+/*!
+ \brief Source of the items of a virtual CFileItemList, usually backed by a database.
+
+ Counting, sorting and finding the letters to jump to are done by the
+ source, so the items only have to be created for the pages being shown.
+ The items of a source are files, no folders.
+ */
+class IFileItemListSource
+{
+public:
+  IFileItemListSource() = default;
+  virtual ~IFileItemListSource() = default;
+
+  /*!
+   \brief Create a source for the same items in the same order, with its own resources
+   */
+  virtual std::unique_ptr<IFileItemListSource> Clone() const = 0;
+
+  virtual int GetCount() = 0;
+
+  /*!
+   \brief Get the items [start, start + count) in the current sort order
+   */
+  virtual bool GetItems(int start, int count, CFileItemList &items) = 0;
+
+  /*!
+   \brief Whether the source can sort its items this way
+   */
+  virtual bool CanSort(const SortDescription &sortDescription) const = 0;
+
+  /*!
+   \brief Change the order of the items
+   \return false if the source can't sort this way, the order is unchanged then
+   */
+  virtual bool Sort(const SortDescription &sortDescription) = 0;
+
+  /*!
+   \brief Get the index of the first item for each leading (upper case) letter of the sort labels
+   */
+  virtual bool GetLetterOffsets(std::vector<std::pair<int, std::string>> &offsets) = 0;
+};
@@ -21,6 +21,7 @@
 #include "guilib/WindowIDs.h"
 #include "messaging/ApplicationMessenger.h"
 #include "messaging/helpers/DialogHelper.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
@@ -274,6 +275,15 @@ void CSkinInfo::LoadIncludes()
   CLog::Log(LOGINFO, "Loading skin includes from %s", includesPath.c_str());
   m_includes.Clear();
   m_includes.Load(includesPath);
+
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiSkinWindowCache)
+  {
+    std::vector<std::string> paths;
+    GetSkinPaths(paths);
+    m_windowCache.Initialize(ID(), Version().asString(), paths);
+  }
+  else
+    m_windowCache.Deinitialize();
 }
 
 void CSkinInfo::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */)
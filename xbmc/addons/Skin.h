@@ -10,6 +10,7 @@
 
 #include "addons/Addon.h"
 #include "guilib/GUIIncludes.h" // needed for the GUIInclude member
+#include "guilib/GUIWindowCache.h" // needed for the window cache member
 #include "windowing/GraphicContext.h" // needed for the RESOLUTION members
 
 #include <map>
@@ -167,6 +168,11 @@ public:
 
   void LoadIncludes();
   void ToggleDebug();
+
+  /*! \brief Cache of the windows of this skin with resolved includes
+   */
+  CGUIWindowCache& GetWindowCache() { return m_windowCache; }
+
   const INFO::CSkinVariableString* CreateSkinVariable(const std::string& name, int context);
 
   static void SettingOptionsSkinColorsFiller(std::shared_ptr<const CSetting> setting, std::vector<StringSettingOption> &list, std::string &current, void *data);
@@ -209,6 +215,7 @@ protected:
 
   float m_effectsSlowDown;
   CGUIIncludes m_includes;
+  CGUIWindowCache m_windowCache;
   std::string m_currentAspect;
 
   std::vector<CStartupWindow> m_startupWindows;
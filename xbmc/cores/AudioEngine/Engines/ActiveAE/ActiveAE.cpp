@@ -30,6 +30,11 @@ using namespace ActiveAE;
 #define MAX_WATER_LEVEL 0.2   // buffered time after stream stages in seconds
 #define MAX_BUFFER_TIME 0.1   // max time of a buffer in seconds
 
+// targets used while a low latency stream (e.g. a game) is active
+#define LOW_LATENCY_CACHE_LEVEL 0.04 // total cache time of stream in seconds
+#define LOW_LATENCY_WATER_LEVEL 0.04 // buffered time after stream stages in seconds
+#define LOW_LATENCY_BUFFER_TIME 0.02 // max time of a buffer in seconds
+
 void CEngineStats::Reset(unsigned int sampleRate, bool pcm)
 {
   CSingleLock lock(m_lock);
@@ -205,11 +210,13 @@ float CEngineStats::GetCacheTime(CActiveAEStream *stream)
 
 float CEngineStats::GetCacheTotal()
 {
-  return MAX_CACHE_LEVEL;
+  return m_lowLatency ? LOW_LATENCY_CACHE_LEVEL : MAX_CACHE_LEVEL;
 }
 
 float CEngineStats::GetMaxDelay() const
 {
+  if (m_lowLatency)
+    return LOW_LATENCY_CACHE_LEVEL + LOW_LATENCY_WATER_LEVEL + m_sinkCacheTotal;
   return MAX_CACHE_LEVEL + MAX_WATER_LEVEL + m_sinkCacheTotal;
 }
 
@@ -222,6 +229,12 @@ float CEngineStats::GetWaterLevel()
     return (float)m_bufferedSamples * m_sinkFormat.m_streamInfo.GetDuration() / 1000;
 }
 
+void CEngineStats::SetLowLatency(bool state)
+{
+  CSingleLock lock(m_lock);
+  m_lowLatency = state;
+}
+
 void CEngineStats::SetSuspended(bool state)
 {
   CSingleLock lock(m_lock);
@@ -1132,6 +1145,13 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 
   inputFormat = GetInputFormat(desiredFmt);
 
+  bool lowLatency = false;
+  for (auto stream : m_streams)
+  {
+    if (stream->m_lowLatency)
+      lowLatency = true;
+  }
+
   m_sinkRequestFormat = inputFormat;
   ApplySettingsToFormat(m_sinkRequestFormat, m_settings, (int*)&m_mode);
   m_extKeepConfig = 0;
@@ -1141,7 +1161,8 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
   CAESinkFactory::ParseDevice(device, driver);
   if ((!CompareFormat(m_sinkRequestFormat, m_sinkFormat) && !CompareFormat(m_sinkRequestFormat, oldSinkRequestFormat)) ||
       m_currDevice.compare(device) != 0 ||
-      m_settings.driver.compare(driver) != 0)
+      m_settings.driver.compare(driver) != 0 ||
+      (lowLatency && !m_sinkLowLatency && m_sinkRequestFormat.m_dataFormat != AE_FMT_RAW))
   {
     FlushEngine();
     if (!InitSink())
@@ -1161,9 +1182,21 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         CLog::Log(LOGWARNING, "ActiveAE::%s - sink returned large buffer of %d ms, reducing to %d ms", __FUNCTION__, (int)(buffertime * 1000), (int)(MAX_BUFFER_TIME*1000));
         m_sinkFormat.m_frames = MAX_BUFFER_TIME * m_sinkFormat.m_sampleRate;
       }
+
+      // small periods let game audio reach the sink without queuing behind large buffers
+      buffertime = (double)m_sinkFormat.m_frames / m_sinkFormat.m_sampleRate;
+      if (lowLatency && buffertime > LOW_LATENCY_BUFFER_TIME)
+      {
+        CLog::Log(LOGDEBUG, "ActiveAE::%s - low latency mode, reducing buffer of %d ms to %d ms", __FUNCTION__, (int)(buffertime * 1000), (int)(LOW_LATENCY_BUFFER_TIME*1000));
+        m_sinkFormat.m_frames = LOW_LATENCY_BUFFER_TIME * m_sinkFormat.m_sampleRate;
+      }
     }
+    m_sinkLowLatency = lowLatency;
   }
 
+  m_lowLatency = lowLatency;
+  m_stats.SetLowLatency(lowLatency);
+
   if (m_silenceBuffers)
   {
     m_discardBufferPools.push_back(m_silenceBuffers);
@@ -1305,7 +1338,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 
         // create buffer pool
         (*it)->m_inputBuffers = new CActiveAEBufferPool((*it)->m_format);
-        (*it)->m_inputBuffers->Create(MAX_CACHE_LEVEL*1000);
+        (*it)->m_inputBuffers->Create(GetCacheLevel(*it)*1000);
         (*it)->m_streamSpace = (*it)->m_format.m_frameSize * (*it)->m_format.m_frames;
 
         // if input format does not follow ffmpeg channel mask, we may need to remap channels
@@ -1324,9 +1357,10 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         (*it)->m_processingBuffers = new CActiveAEStreamBuffers((*it)->m_inputBuffers->m_format, outputFormat, m_settings.resampleQuality);
         (*it)->m_processingBuffers->ForceResampler((*it)->m_forceResampler);
 
-        (*it)->m_processingBuffers->Create(MAX_CACHE_LEVEL*1000, false, m_settings.stereoupmix, m_settings.normalizelevels);
+        (*it)->m_processingBuffers->Create(GetCacheLevel(*it)*1000, false, m_settings.stereoupmix, m_settings.normalizelevels);
       }
-      if (m_mode == MODE_TRANSCODE || m_streams.size() > 1)
+      // low latency streams go straight through without pre-filled buffers
+      if ((m_mode == MODE_TRANSCODE || m_streams.size() > 1) && !(*it)->m_lowLatency)
         (*it)->m_processingBuffers->FillBuffer();
 
       // amplification
@@ -1447,6 +1481,10 @@ CActiveAEStream* CActiveAE::CreateStream(MsgStreamNew *streamMsg)
   if (streamMsg->options & AESTREAM_FORCE_RESAMPLE)
     stream->m_forceResampler = true;
 
+  // keep buffering minimal, the resampler is skipped if formats match
+  if (streamMsg->options & AESTREAM_LOW_LATENCY)
+    stream->m_lowLatency = true;
+
   stream->m_pClock = streamMsg->clock;
 
   m_streams.push_back(stream);
@@ -1455,6 +1493,11 @@ CActiveAEStream* CActiveAE::CreateStream(MsgStreamNew *streamMsg)
   return stream;
 }
 
+float CActiveAE::GetCacheLevel(CActiveAEStream *stream)
+{
+  return stream->m_lowLatency ? LOW_LATENCY_CACHE_LEVEL : MAX_CACHE_LEVEL;
+}
+
 void CActiveAE::DiscardStream(CActiveAEStream *stream)
 {
   std::list<CActiveAEStream*>::iterator it;
@@ -1871,7 +1914,8 @@ bool CActiveAE::RunStages()
       float buftime = (float)(*it)->m_inputBuffers->m_format.m_frames / (*it)->m_inputBuffers->m_format.m_sampleRate;
       if ((*it)->m_inputBuffers->m_format.m_dataFormat == AE_FMT_RAW)
         buftime = (*it)->m_inputBuffers->m_format.m_streamInfo.GetDuration() / 1000;
-      while ((time < MAX_CACHE_LEVEL || (*it)->m_streamIsBuffering) && !(*it)->m_inputBuffers->m_freeSamples.empty())
+      float cacheLevel = GetCacheLevel(*it);
+      while ((time < cacheLevel || (*it)->m_streamIsBuffering) && !(*it)->m_inputBuffers->m_freeSamples.empty())
       {
         buffer = (*it)->m_inputBuffers->GetFreeBuffer();
         (*it)->m_processingSamples.push_back(buffer);
@@ -1910,7 +1954,8 @@ bool CActiveAE::RunStages()
     }
   }
 
-  if (m_stats.GetWaterLevel() < MAX_WATER_LEVEL &&
+  const float waterLevel = m_lowLatency ? LOW_LATENCY_WATER_LEVEL : MAX_WATER_LEVEL;
+  if (m_stats.GetWaterLevel() < waterLevel &&
      (m_mode != MODE_TRANSCODE || (m_encoderBuffers && !m_encoderBuffers->m_freeSamples.empty())))
   {
     // calculate sync error
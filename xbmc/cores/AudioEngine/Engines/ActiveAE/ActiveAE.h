@@ -187,6 +187,7 @@ public:
   float GetMaxDelay() const;
   float GetWaterLevel();
   void SetSuspended(bool state);
+  void SetLowLatency(bool state);
   void SetCurrentSinkFormat(const AEAudioFormat& SinkFormat);
   void SetSinkCacheTotal(float time) { m_sinkCacheTotal = time; }
   void SetSinkLatency(float time) { m_sinkLatency = time; }
@@ -201,6 +202,7 @@ protected:
   bool m_suspended;
   AEAudioFormat m_sinkFormat;
   bool m_pcmOutput;
+  bool m_lowLatency = false;
   CCriticalSection m_lock;
   struct StreamStats
   {
@@ -297,6 +299,7 @@ protected:
   void Configure(AEAudioFormat *desiredFmt = NULL);
   AEAudioFormat GetInputFormat(AEAudioFormat *desiredFmt = NULL);
   CActiveAEStream* CreateStream(MsgStreamNew *streamMsg);
+  float GetCacheLevel(CActiveAEStream *stream);
   void DiscardStream(CActiveAEStream *stream);
   void SFlushStream(CActiveAEStream *stream);
   void FlushEngine();
@@ -330,6 +333,8 @@ protected:
   bool m_extDeferData;
   std::queue<time_t> m_extLastDeviceChange;
   bool m_isWinSysReg = false;
+  bool m_lowLatency = false;
+  bool m_sinkLowLatency = false;
 
   enum
   {
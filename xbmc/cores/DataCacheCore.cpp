@@ -244,6 +244,20 @@ int CDataCacheCore::GetAudioBitsPerSample()
   return m_playerAudioInfo.bitsPerSample;
 }
 
+void CDataCacheCore::SetAudioLatency(int latencyMs)
+{
+  CSingleLock lock(m_audioPlayerSection);
+
+  m_playerAudioInfo.latencyMs = latencyMs;
+}
+
+int CDataCacheCore::GetAudioLatency()
+{
+  CSingleLock lock(m_audioPlayerSection);
+
+  return m_playerAudioInfo.latencyMs;
+}
+
 void CDataCacheCore::SetCutList(const std::vector<EDL::Cut>& cutList)
 {
   CSingleLock lock(m_contentSection);
@@ -58,6 +58,8 @@ public:
   int GetAudioSampleRate();
   void SetAudioBitsPerSample(int bitsPerSample);
   int GetAudioBitsPerSample();
+  void SetAudioLatency(int latencyMs);
+  int GetAudioLatency();
 
   // content info
   void SetCutList(const std::vector<EDL::Cut>& cutList);
@@ -150,6 +152,7 @@ protected:
     std::string channels;
     int sampleRate;
     int bitsPerSample;
+    int latencyMs;
   } m_playerAudioInfo;
 
   mutable CCriticalSection m_contentSection;
@@ -118,7 +118,7 @@ bool CRetroPlayer::OpenFile(const CFileItem& file, const CPlayerOptions& options
     m_gameClient = std::static_pointer_cast<CGameClient>(addon);
     if (m_gameClient->Initialize())
     {
-      m_streamManager.reset(new CRPStreamManager(*m_renderManager, *m_processInfo));
+      m_streamManager.reset(new CRPStreamManager(*m_renderManager, *m_processInfo, m_gameServices.GameSettings().LowLatencyAudio()));
 
       m_input.reset(new CRetroPlayerInput(CServiceBroker::GetPeripherals()));
 
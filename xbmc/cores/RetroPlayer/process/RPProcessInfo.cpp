@@ -155,6 +155,7 @@ void CRPProcessInfo::ResetInfo()
     m_dataCache->SetAudioChannels("");
     m_dataCache->SetAudioSampleRate(0);
     m_dataCache->SetAudioBitsPerSample(0);
+    m_dataCache->SetAudioLatency(0);
     m_dataCache->SetRenderClockSync(false);
     m_dataCache->SetStateSeeking(false);
     m_dataCache->SetSpeed(1.0f, 1.0f);
@@ -221,6 +222,12 @@ void CRPProcessInfo::SetAudioBitsPerSample(int bitsPerSample)
     m_dataCache->SetAudioBitsPerSample(bitsPerSample);
 }
 
+void CRPProcessInfo::SetAudioLatency(double latencySecs)
+{
+  if (m_dataCache != nullptr)
+    m_dataCache->SetAudioLatency(static_cast<int>(latencySecs * 1000));
+}
+
 //******************************************************************************
 // player states
 //******************************************************************************
@@ -153,6 +153,7 @@ namespace RETRO
     void SetAudioChannels(const std::string &channels);
     void SetAudioSampleRate(int sampleRate);
     void SetAudioBitsPerSample(int bitsPerSample);
+    void SetAudioLatency(double latencySecs);
     ///}
 
     /// @name Player states
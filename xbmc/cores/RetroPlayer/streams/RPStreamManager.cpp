@@ -15,9 +15,10 @@
 using namespace KODI;
 using namespace RETRO;
 
-CRPStreamManager::CRPStreamManager(CRPRenderManager& renderManager, CRPProcessInfo& processInfo) :
+CRPStreamManager::CRPStreamManager(CRPRenderManager& renderManager, CRPProcessInfo& processInfo, bool bLowLatencyAudio) :
   m_renderManager(renderManager),
-  m_processInfo(processInfo)
+  m_processInfo(processInfo),
+  m_bLowLatencyAudio(bLowLatencyAudio)
 {
 }
 
@@ -34,7 +35,7 @@ StreamPtr CRPStreamManager::CreateStream(StreamType streamType)
   case StreamType::AUDIO:
   {
     // Save pointer to audio stream
-    m_audioStream = new CRetroPlayerAudio(m_processInfo);
+    m_audioStream = new CRetroPlayerAudio(m_processInfo, m_bLowLatencyAudio);
 
     return StreamPtr(m_audioStream);
   }
@@ -21,7 +21,7 @@ namespace RETRO
   class CRPStreamManager : public IStreamManager
   {
   public:
-    CRPStreamManager(CRPRenderManager& renderManager, CRPProcessInfo& processInfo);
+    CRPStreamManager(CRPRenderManager& renderManager, CRPProcessInfo& processInfo, bool bLowLatencyAudio);
     ~CRPStreamManager() override = default;
 
     void EnableAudio(bool bEnable);
@@ -34,6 +34,7 @@ namespace RETRO
     // Construction parameters
     CRPRenderManager& m_renderManager;
     CRPProcessInfo& m_processInfo;
+    const bool m_bLowLatencyAudio;
 
     // Stream parameters
     CRetroPlayerAudio* m_audioStream = nullptr;
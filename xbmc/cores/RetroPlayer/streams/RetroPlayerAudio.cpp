@@ -12,6 +12,7 @@
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Interfaces/AEStream.h"
 #include "cores/AudioEngine/Utils/AEChannelInfo.h"
+#include "cores/AudioEngine/Utils/AEStreamData.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/RetroPlayer/audio/AudioTranslator.h"
 #include "cores/RetroPlayer/process/RPProcessInfo.h"
@@ -23,13 +24,18 @@ using namespace KODI;
 using namespace RETRO;
 
 const double MAX_DELAY = 0.3; // seconds
+const double MAX_DELAY_LOW_LATENCY = 0.1; // seconds
 
-CRetroPlayerAudio::CRetroPlayerAudio(CRPProcessInfo& processInfo) :
+// Number of packets between updates of the reported latency
+const unsigned int LATENCY_REPORT_INTERVAL = 30;
+
+CRetroPlayerAudio::CRetroPlayerAudio(CRPProcessInfo& processInfo, bool bLowLatency) :
   m_processInfo(processInfo),
+  m_bLowLatency(bLowLatency),
   m_pAudioStream(nullptr),
   m_bAudioEnabled(true)
 {
-  CLog::Log(LOGDEBUG, "RetroPlayer[AUDIO]: Initializing audio");
+  CLog::Log(LOGDEBUG, "RetroPlayer[AUDIO]: Initializing audio%s", m_bLowLatency ? " (low latency)" : "");
 }
 
 CRetroPlayerAudio::~CRetroPlayerAudio()
@@ -90,7 +96,11 @@ bool CRetroPlayerAudio::OpenStream(const StreamProperties& properties)
   audioFormat.m_dataFormat = pcmFormat;
   audioFormat.m_sampleRate = iSampleRate;
   audioFormat.m_channelLayout = channelLayout;
-  m_pAudioStream = audioEngine->MakeStream(audioFormat);
+  unsigned int options = 0;
+  if (m_bLowLatency)
+    options |= AESTREAM_LOW_LATENCY;
+
+  m_pAudioStream = audioEngine->MakeStream(audioFormat, options);
 
   if (m_pAudioStream == nullptr)
   {
@@ -102,6 +112,9 @@ bool CRetroPlayerAudio::OpenStream(const StreamProperties& properties)
   m_processInfo.SetAudioSampleRate(audioFormat.m_sampleRate);
   m_processInfo.SetAudioBitsPerSample(CAEUtil::DataFormatToUsedBits(audioFormat.m_dataFormat));
 
+  m_latencySecs = 0.0;
+  m_latencyPackets = 0;
+
   return true;
 }
 
@@ -119,7 +132,9 @@ void CRetroPlayerAudio::AddStreamData(const StreamPacket &packet)
 
       const unsigned int frameCount = static_cast<unsigned int>(audioPacket.size / frameSize);
 
-      if (delaySecs > MAX_DELAY)
+      UpdateLatency(delaySecs);
+
+      if (delaySecs > (m_bLowLatency ? MAX_DELAY_LOW_LATENCY : MAX_DELAY))
       {
         m_pAudioStream->Flush();
         CLog::Log(LOGDEBUG, "RetroPlayer[AUDIO]: Audio delay (%0.2f ms) is too high - flushing", delaySecs * 1000);
@@ -138,5 +153,24 @@ void CRetroPlayerAudio::CloseStream()
 
     CServiceBroker::GetActiveAE()->FreeStream(m_pAudioStream, true);
     m_pAudioStream = nullptr;
+
+    m_processInfo.SetAudioLatency(0.0);
+  }
+}
+
+void CRetroPlayerAudio::UpdateLatency(double delaySecs)
+{
+  // The stream delay is the time until the first sample of the next packet
+  // is heard, which is the latency between the game producing a sound and
+  // the player hearing it
+  if (m_latencySecs == 0.0)
+    m_latencySecs = delaySecs;
+  else
+    m_latencySecs = 0.9 * m_latencySecs + 0.1 * delaySecs;
+
+  if (++m_latencyPackets >= LATENCY_REPORT_INTERVAL)
+  {
+    m_latencyPackets = 0;
+    m_processInfo.SetAudioLatency(m_latencySecs);
   }
 }
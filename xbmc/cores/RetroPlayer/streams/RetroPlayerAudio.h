@@ -49,7 +49,13 @@ namespace RETRO
   class CRetroPlayerAudio : public IRetroPlayerStream
   {
   public:
-    explicit CRetroPlayerAudio(CRPProcessInfo& processInfo);
+    /*!
+     * \brief Create the audio stream of a game
+     *
+     * \param bLowLatency Run the audio engine with minimal buffering, so
+     *        sound follows player input as closely as possible
+     */
+    CRetroPlayerAudio(CRPProcessInfo& processInfo, bool bLowLatency);
     ~CRetroPlayerAudio() override;
 
     void Enable(bool bEnabled) { m_bAudioEnabled = bEnabled; }
@@ -61,9 +67,16 @@ namespace RETRO
     void CloseStream() override;
 
   private:
+    void UpdateLatency(double delaySecs);
+
     CRPProcessInfo& m_processInfo;
+    const bool m_bLowLatency;
     IAEStream* m_pAudioStream;
     bool m_bAudioEnabled;
+
+    // Latency measurement
+    double m_latencySecs = 0.0;
+    unsigned int m_latencyPackets = 0;
   };
 }
 }
@@ -21,6 +21,7 @@
 #include "utils/log.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include <memory>
 
 extern "C" {
@@ -423,15 +424,6 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     return false;
   }
 
-  m_pFilterFrame = av_frame_alloc();
-  if (!m_pFilterFrame)
-  {
-    av_frame_free(&m_pFrame);
-    av_frame_free(&m_pDecodedFrame);
-    avcodec_free_context(&m_pCodecContext);
-    return false;
-  }
-
   UpdateName();
   const char* pixFmtName = av_get_pix_fmt_name(m_pCodecContext->pix_fmt);
   m_processInfo.SetVideoDimensions(m_pCodecContext->coded_width, m_pCodecContext->coded_height);
@@ -446,7 +438,6 @@ void CDVDVideoCodecFFmpeg::Dispose()
 {
   av_frame_free(&m_pFrame);
   av_frame_free(&m_pDecodedFrame);
-  av_frame_free(&m_pFilterFrame);
   avcodec_free_context(&m_pCodecContext);
   SAFE_RELEASE(m_pHardware);
 
@@ -565,7 +556,9 @@ bool CDVDVideoCodecFFmpeg::AddData(const DemuxPacket &packet)
   avpkt.side_data = static_cast<AVPacketSideData*>(packet.pSideData);
   avpkt.side_data_elems = packet.iSideDataElems;
 
+  int64_t start = CurrentHostCounter();
   int ret = avcodec_send_packet(m_pCodecContext, &avpkt);
+  UpdateDecodeTime(CurrentHostCounter() - start, false);
 
   // try again
   if (ret == AVERROR(EAGAIN))
@@ -626,7 +619,7 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     else
       return ret;
   }
-  else if (m_pFilterGraph && !m_filterEof)
+  else if (m_filter.IsOpen() && !m_filter.IsEof())
   {
     CDVDVideoCodec::VCReturn ret = FilterProcess(nullptr);
     if (ret == VC_PICTURE)
@@ -653,7 +646,9 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     avcodec_send_packet(m_pCodecContext, &avpkt);
   }
 
+  int64_t start = CurrentHostCounter();
   int ret = avcodec_receive_frame(m_pCodecContext, m_pDecodedFrame);
+  UpdateDecodeTime(CurrentHostCounter() - start, ret == 0);
 
   if (m_decoderState == STATE_HW_FAILED && !m_pHardware)
     return VC_REOPEN;
@@ -684,7 +679,7 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
         return VC_EOF;
       }
     }
-    else if (m_pFilterGraph && !m_filterEof)
+    else if (m_filter.IsOpen() && !m_filter.IsEof())
     {
       int ret = FilterProcess(nullptr);
       if (ret == VC_PICTURE)
@@ -803,19 +798,19 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     if (m_filters != m_filters_next)
       need_reopen = true;
 
-    if (!m_filters_next.empty() && m_filterEof)
+    if (!m_filters_next.empty() && m_filter.IsEof())
       need_reopen = true;
 
-    if (m_pFilterIn)
+    if (m_filter.IsOpen())
     {
-      if (m_pFilterIn->outputs[0]->format != m_pCodecContext->pix_fmt ||
-          m_pFilterIn->outputs[0]->w != m_pCodecContext->width ||
-          m_pFilterIn->outputs[0]->h != m_pCodecContext->height)
+      if (m_filter.NeedsReopen(m_pCodecContext->pix_fmt,
+                               m_pCodecContext->width,
+                               m_pCodecContext->height))
         need_reopen = true;
     }
 
     // try to setup new filters
-    if (need_reopen || (need_scale && m_pFilterGraph == nullptr))
+    if (need_reopen || (need_scale && !m_filter.IsOpen()))
     {
       m_filters = m_filters_next;
 
@@ -823,7 +818,7 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
         FilterClose();
     }
 
-    if (m_pFilterGraph && !m_filterEof)
+    if (m_filter.IsOpen() && !m_filter.IsEof())
     {
       CDVDVideoCodec::VCReturn ret = FilterProcess(m_pDecodedFrame);
       if (ret != VC_PICTURE)
@@ -1049,7 +1044,7 @@ int CDVDVideoCodecFFmpeg::FilterOpen(const std::string& filters, bool scale)
 {
   int result;
 
-  if (m_pFilterGraph)
+  if (m_filter.IsOpen())
     FilterClose();
 
   if (filters.empty() && !scale)
@@ -1061,154 +1056,57 @@ int CDVDVideoCodecFFmpeg::FilterOpen(const std::string& filters, bool scale)
     return 0;
   }
 
-  if (!(m_pFilterGraph = avfilter_graph_alloc()))
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - unable to alloc filter graph");
-    return -1;
-  }
+  // -1: own thread with default slice threads, 0: filter on decode thread
+  int threads = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoFilterThreads;
 
-  const AVFilter* srcFilter = avfilter_get_by_name("buffer");
-  const AVFilter* outFilter = avfilter_get_by_name("buffersink"); // should be last filter in the graph for now
-
-  std::string args = StringUtils::Format("%d:%d:%d:%d:%d:%d:%d",
-                                        m_pCodecContext->width,
-                                        m_pCodecContext->height,
-                                        m_pCodecContext->pix_fmt,
-                                        m_pCodecContext->time_base.num ? m_pCodecContext->time_base.num : 1,
-                                        m_pCodecContext->time_base.num ? m_pCodecContext->time_base.den : 1,
-                                        m_pCodecContext->sample_aspect_ratio.num != 0 ? m_pCodecContext->sample_aspect_ratio.num : 1,
-                                        m_pCodecContext->sample_aspect_ratio.num != 0 ? m_pCodecContext->sample_aspect_ratio.den : 1);
-
-  if ((result = avfilter_graph_create_filter(&m_pFilterIn, srcFilter, "src", args.c_str(), NULL, m_pFilterGraph)) < 0)
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_graph_create_filter: src");
+  if ((result = m_filter.Open(m_pCodecContext, filters, m_formats, std::max(threads, 0), threads != 0)) < 0)
     return result;
-  }
 
-  if ((result = avfilter_graph_create_filter(&m_pFilterOut, outFilter, "out", NULL, NULL, m_pFilterGraph)) < 0)
+  if (!filters.empty() && filters.compare(0,5,"yadif") == 0)
   {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_graph_create_filter: out");
-    return result;
-  }
-  if ((result = av_opt_set_int_list(m_pFilterOut, "pix_fmts", &m_formats[0],  AV_PIX_FMT_NONE, AV_OPT_SEARCH_CHILDREN)) < 0)
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - failed settings pix formats");
-    return result;
-  }
-
-  if (!filters.empty())
-  {
-    AVFilterInOut* outputs = avfilter_inout_alloc();
-    AVFilterInOut* inputs  = avfilter_inout_alloc();
-
-    outputs->name = av_strdup("in");
-    outputs->filter_ctx = m_pFilterIn;
-    outputs->pad_idx = 0;
-    outputs->next = nullptr;
-
-    inputs->name = av_strdup("out");
-    inputs->filter_ctx = m_pFilterOut;
-    inputs->pad_idx = 0;
-    inputs->next = nullptr;
-
-    result = avfilter_graph_parse_ptr(m_pFilterGraph, m_filters.c_str(), &inputs, &outputs, NULL);
-    avfilter_inout_free(&outputs);
-    avfilter_inout_free(&inputs);
-
-    if (result < 0)
-    {
-      CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_graph_parse");
-      return result;
-    }
-
-    if (filters.compare(0,5,"yadif") == 0)
-    {
-      m_processInfo.SetVideoDeintMethod(filters);
-    }
-    else
-    {
-      m_processInfo.SetVideoDeintMethod("none");
-    }
+    m_processInfo.SetVideoDeintMethod(filters);
   }
   else
   {
-    if ((result = avfilter_link(m_pFilterIn, 0, m_pFilterOut, 0)) < 0)
-    {
-      CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_link");
-      return result;
-    }
-
     m_processInfo.SetVideoDeintMethod("none");
   }
 
-  if ((result = avfilter_graph_config(m_pFilterGraph,  nullptr)) < 0)
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterOpen - avfilter_graph_config");
-    return result;
-  }
-
-  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->CanLogComponent(LOGVIDEO))
-  {
-    char* graphDump = avfilter_graph_dump(m_pFilterGraph, nullptr);
-    if (graphDump)
-    {
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::FilterOpen - Final filter graph:\n%s", graphDump);
-      av_freep(&graphDump);
-    }
-  }
-
-  m_filterEof = false;
   return result;
 }
 
 void CDVDVideoCodecFFmpeg::FilterClose()
 {
-  if (m_pFilterGraph)
-  {
-    CLog::Log(LOGDEBUG, LOGVIDEO, "CDVDVideoCodecFFmpeg::FilterClose - Freeing filter graph");
-    avfilter_graph_free(&m_pFilterGraph);
-
-    // Disposed by above code
-    m_pFilterIn = nullptr;
-    m_pFilterOut = nullptr;
-  }
+  m_filter.Close();
 }
 
 CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::FilterProcess(AVFrame* frame)
 {
-  int result;
+  bool drain = (m_codecControlFlags & DVD_CODEC_CTRL_DRAIN) != 0;
 
-  if (frame || (m_codecControlFlags & DVD_CODEC_CTRL_DRAIN))
+  if (frame || drain)
   {
-    result = av_buffersrc_add_frame(m_pFilterIn, frame);
-    if (result < 0)
+    if (!m_filter.AddFrame(frame))
     {
-      CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterProcess - av_buffersrc_add_frame");
+      CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterProcess - failed to add frame");
       return VC_ERROR;
     }
   }
 
-  result = av_buffersink_get_frame(m_pFilterOut, m_pFilterFrame);
+  // while draining, wait for the filter stage to catch up
+  return m_filter.GetFrame(m_pFrame, !frame && drain);
+}
 
-  if (result  == AVERROR(EAGAIN))
-    return VC_BUFFER;
-  else if (result == AVERROR_EOF)
-  {
-    result = av_buffersink_get_frame(m_pFilterOut, m_pFilterFrame);
-    m_filterEof = true;
-    if (result < 0)
-      return VC_BUFFER;
-  }
-  else if (result < 0)
-  {
-    CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::FilterProcess - av_buffersink_get_frame");
-    return VC_ERROR;
-  }
+void CDVDVideoCodecFFmpeg::UpdateDecodeTime(int64_t ticks, bool frame)
+{
+  m_decodeTicks += ticks;
+  if (!frame)
+    return;
 
-  av_frame_unref(m_pFrame);
-  av_frame_move_ref(m_pFrame, m_pFilterFrame);
+  double elapsed = static_cast<double>(m_decodeTicks) * 1000.0 / CurrentHostFrequency();
+  m_decodeTime = m_decodeTime > 0.0 ? m_decodeTime * 0.9 + elapsed * 0.1 : elapsed;
+  m_decodeTicks = 0;
 
-  return VC_PICTURE;
+  m_processInfo.SetVideoPipelineTimes(m_decodeTime, m_filter.GetFilterTime());
 }
 
 unsigned CDVDVideoCodecFFmpeg::GetConvergeCount()
@@ -11,6 +11,7 @@
 #include "cores/VideoPlayer/DVDCodecs/DVDCodecs.h"
 #include "cores/VideoPlayer/DVDStreamInfo.h"
 #include "DVDVideoCodec.h"
+#include "DVDVideoFilterFFmpeg.h"
 #include "DVDVideoPPFFmpeg.h"
 #include <string>
 #include <vector>
@@ -55,6 +56,7 @@ protected:
   void SetFilters();
   void UpdateName();
   bool SetPictureParams(VideoPicture* pVideoPicture);
+  void UpdateDecodeTime(int64_t ticks, bool frame);
 
   bool HasHardware() { return m_pHardware != nullptr; };
   void SetHardware(IHardwareDecoder *hardware);
@@ -66,11 +68,7 @@ protected:
 
   std::string m_filters;
   std::string m_filters_next;
-  AVFilterGraph* m_pFilterGraph = nullptr;
-  AVFilterContext* m_pFilterIn = nullptr;
-  AVFilterContext* m_pFilterOut = nullptr;;
-  AVFrame* m_pFilterFrame = nullptr;;
-  bool m_filterEof = false;
+  CDVDVideoFilterFFmpeg m_filter;
   bool m_eof = false;
 
   CDVDVideoPPFFmpeg m_postProc;
@@ -90,6 +88,8 @@ protected:
   bool m_startedInput = false;
   std::vector<AVPixelFormat> m_formats;
   double m_decoderPts = DVD_NOPTS_VALUE;
+  int64_t m_decodeTicks = 0;
+  double m_decodeTime = 0.0;
   int m_skippedDeint = 0;
   int m_droppedFrames = 0;
   bool m_requestSkipDeint = false;
@@ -0,0 +1,349 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DVDVideoFilterFFmpeg.h"
+
+#include "ServiceBroker.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavfilter/buffersink.h>
+#include <libavfilter/buffersrc.h>
+#include <libavutil/opt.h>
+}
+
+namespace
+{
+// decoded frames waiting for the filter, each one holds a decoder buffer
+constexpr size_t MAX_INPUT_FRAMES = 4;
+}
+
+CDVDVideoFilterFFmpeg::CDVDVideoFilterFFmpeg() : CThread("VideoFilterFFmpeg")
+{
+}
+
+CDVDVideoFilterFFmpeg::~CDVDVideoFilterFFmpeg()
+{
+  Close();
+}
+
+int CDVDVideoFilterFFmpeg::Open(AVCodecContext* avctx, const std::string& filters,
+                                std::vector<AVPixelFormat>& formats, int threads, bool threaded)
+{
+  int result;
+
+  Close();
+
+  if (!(m_pFilterGraph = avfilter_graph_alloc()))
+  {
+    CLog::Log(LOGERROR, "CDVDVideoFilterFFmpeg::Open - unable to alloc filter graph");
+    return -1;
+  }
+
+  // must be set before the first filter is created
+  if (threads > 0)
+    m_pFilterGraph->nb_threads = threads;
+
+  const AVFilter* srcFilter = avfilter_get_by_name("buffer");
+  const AVFilter* outFilter = avfilter_get_by_name("buffersink"); // should be last filter in the graph for now
+
+  std::string args = StringUtils::Format("%d:%d:%d:%d:%d:%d:%d",
+                                        avctx->width,
+                                        avctx->height,
+                                        avctx->pix_fmt,
+                                        avctx->time_base.num ? avctx->time_base.num : 1,
+                                        avctx->time_base.num ? avctx->time_base.den : 1,
+                                        avctx->sample_aspect_ratio.num != 0 ? avctx->sample_aspect_ratio.num : 1,
+                                        avctx->sample_aspect_ratio.num != 0 ? avctx->sample_aspect_ratio.den : 1);
+
+  if ((result = avfilter_graph_create_filter(&m_pFilterIn, srcFilter, "src", args.c_str(), NULL, m_pFilterGraph)) < 0)
+  {
+    CLog::Log(LOGERROR, "CDVDVideoFilterFFmpeg::Open - avfilter_graph_create_filter: src");
+    return result;
+  }
+
+  if ((result = avfilter_graph_create_filter(&m_pFilterOut, outFilter, "out", NULL, NULL, m_pFilterGraph)) < 0)
+  {
+    CLog::Log(LOGERROR, "CDVDVideoFilterFFmpeg::Open - avfilter_graph_create_filter: out");
+    return result;
+  }
+  if ((result = av_opt_set_int_list(m_pFilterOut, "pix_fmts", &formats[0],  AV_PIX_FMT_NONE, AV_OPT_SEARCH_CHILDREN)) < 0)
+  {
+    CLog::Log(LOGERROR, "CDVDVideoFilterFFmpeg::Open - failed settings pix formats");
+    return result;
+  }
+
+  if (!filters.empty())
+  {
+    AVFilterInOut* outputs = avfilter_inout_alloc();
+    AVFilterInOut* inputs  = avfilter_inout_alloc();
+
+    outputs->name = av_strdup("in");
+    outputs->filter_ctx = m_pFilterIn;
+    outputs->pad_idx = 0;
+    outputs->next = nullptr;
+
+    inputs->name = av_strdup("out");
+    inputs->filter_ctx = m_pFilterOut;
+    inputs->pad_idx = 0;
+    inputs->next = nullptr;
+
+    result = avfilter_graph_parse_ptr(m_pFilterGraph, filters.c_str(), &inputs, &outputs, NULL);
+    avfilter_inout_free(&outputs);
+    avfilter_inout_free(&inputs);
+
+    if (result < 0)
+    {
+      CLog::Log(LOGERROR, "CDVDVideoFilterFFmpeg::Open - avfilter_graph_parse");
+      return result;
+    }
+  }
+  else
+  {
+    if ((result = avfilter_link(m_pFilterIn, 0, m_pFilterOut, 0)) < 0)
+    {
+      CLog::Log(LOGERROR, "CDVDVideoFilterFFmpeg::Open - avfilter_link");
+      return result;
+    }
+  }
+
+  if ((result = avfilter_graph_config(m_pFilterGraph,  nullptr)) < 0)
+  {
+    CLog::Log(LOGERROR, "CDVDVideoFilterFFmpeg::Open - avfilter_graph_config");
+    return result;
+  }
+
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->CanLogComponent(LOGVIDEO))
+  {
+    char* graphDump = avfilter_graph_dump(m_pFilterGraph, nullptr);
+    if (graphDump)
+    {
+      CLog::Log(LOGDEBUG, "CDVDVideoFilterFFmpeg::Open - Final filter graph:\n%s", graphDump);
+      av_freep(&graphDump);
+    }
+  }
+
+  m_inFormat = avctx->pix_fmt;
+  m_inWidth = avctx->width;
+  m_inHeight = avctx->height;
+  m_drainQueued = false;
+  m_eof = false;
+  m_error = false;
+  m_filterTime = 0.0;
+  m_threaded = threaded;
+
+  if (m_threaded)
+  {
+    CLog::Log(LOGDEBUG, LOGVIDEO, "CDVDVideoFilterFFmpeg::Open - filtering on separate thread, %d slice threads", threads);
+    Create();
+  }
+
+  return result;
+}
+
+void CDVDVideoFilterFFmpeg::Close()
+{
+  if (m_threaded)
+  {
+    StopThread(true);
+    m_threaded = false;
+  }
+
+  ClearQueues();
+  m_eof = false;
+  m_error = false;
+
+  if (m_pFilterGraph)
+  {
+    CLog::Log(LOGDEBUG, LOGVIDEO, "CDVDVideoFilterFFmpeg::Close - Freeing filter graph");
+    avfilter_graph_free(&m_pFilterGraph);
+
+    // Disposed by above code
+    m_pFilterIn = nullptr;
+    m_pFilterOut = nullptr;
+  }
+}
+
+void CDVDVideoFilterFFmpeg::ClearQueues()
+{
+  CSingleLock lock(m_section);
+  for (AVFrame* frame : m_input)
+    av_frame_free(&frame);
+  m_input.clear();
+  for (AVFrame* frame : m_output)
+    av_frame_free(&frame);
+  m_output.clear();
+}
+
+bool CDVDVideoFilterFFmpeg::IsEof()
+{
+  CSingleLock lock(m_section);
+  return m_eof && m_output.empty();
+}
+
+bool CDVDVideoFilterFFmpeg::NeedsReopen(int format, int width, int height) const
+{
+  return m_inFormat != format || m_inWidth != width || m_inHeight != height;
+}
+
+bool CDVDVideoFilterFFmpeg::AddFrame(AVFrame* frame)
+{
+  AVFrame* queued = nullptr;
+  if (frame)
+  {
+    queued = av_frame_alloc();
+    if (!queued)
+      return false;
+    av_frame_move_ref(queued, frame);
+  }
+  else
+  {
+    // graph is flushed once, repeated drain requests just collect the output
+    if (m_drainQueued)
+      return true;
+    m_drainQueued = true;
+  }
+
+  if (!m_threaded)
+  {
+    bool ret = Filter(queued);
+    av_frame_free(&queued);
+    return ret;
+  }
+
+  CSingleLock lock(m_section);
+  while (m_input.size() >= MAX_INPUT_FRAMES && !m_error)
+  {
+    CSingleExit exit(m_section);
+    m_inputSpaceEvent.WaitMSec(100);
+  }
+  if (m_error)
+  {
+    av_frame_free(&queued);
+    return false;
+  }
+  m_input.push_back(queued);
+  m_inputEvent.Set();
+  return true;
+}
+
+CDVDVideoCodec::VCReturn CDVDVideoFilterFFmpeg::GetFrame(AVFrame* frame, bool wait)
+{
+  CSingleLock lock(m_section);
+  while (m_output.empty())
+  {
+    if (m_error)
+      return CDVDVideoCodec::VC_ERROR;
+
+    if (!wait || !m_threaded || m_eof)
+      return CDVDVideoCodec::VC_BUFFER;
+
+    CSingleExit exit(m_section);
+    m_outputEvent.WaitMSec(100);
+  }
+
+  AVFrame* filtered = m_output.front();
+  m_output.pop_front();
+
+  av_frame_unref(frame);
+  av_frame_move_ref(frame, filtered);
+  av_frame_free(&filtered);
+
+  return CDVDVideoCodec::VC_PICTURE;
+}
+
+bool CDVDVideoFilterFFmpeg::Filter(AVFrame* frame)
+{
+  int64_t start = CurrentHostCounter();
+
+  int result = av_buffersrc_add_frame(m_pFilterIn, frame);
+  if (result < 0)
+  {
+    CLog::Log(LOGERROR, "CDVDVideoFilterFFmpeg::Filter - av_buffersrc_add_frame");
+    return false;
+  }
+
+  while (true)
+  {
+    AVFrame* filtered = av_frame_alloc();
+    if (!filtered)
+      return false;
+
+    result = av_buffersink_get_frame(m_pFilterOut, filtered);
+    if (result == AVERROR(EAGAIN))
+    {
+      av_frame_free(&filtered);
+      break;
+    }
+    else if (result == AVERROR_EOF)
+    {
+      av_frame_free(&filtered);
+      CSingleLock lock(m_section);
+      m_eof = true;
+      m_outputEvent.Set();
+      break;
+    }
+    else if (result < 0)
+    {
+      av_frame_free(&filtered);
+      CLog::Log(LOGERROR, "CDVDVideoFilterFFmpeg::Filter - av_buffersink_get_frame");
+      return false;
+    }
+
+    CSingleLock lock(m_section);
+    m_output.push_back(filtered);
+    m_outputEvent.Set();
+  }
+
+  if (frame)
+  {
+    double elapsed = static_cast<double>(CurrentHostCounter() - start) * 1000.0 / CurrentHostFrequency();
+    double filterTime = m_filterTime;
+    m_filterTime = filterTime > 0.0 ? filterTime * 0.9 + elapsed * 0.1 : elapsed;
+  }
+
+  return true;
+}
+
+void CDVDVideoFilterFFmpeg::Process()
+{
+  while (!m_bStop)
+  {
+    AVFrame* frame;
+    {
+      CSingleLock lock(m_section);
+      if (m_input.empty())
+      {
+        CSingleExit exit(m_section);
+        AbortableWait(m_inputEvent, 100);
+        continue;
+      }
+      frame = m_input.front();
+      m_input.pop_front();
+      m_inputSpaceEvent.Set();
+    }
+
+    bool ret = Filter(frame);
+    av_frame_free(&frame);
+
+    if (!ret)
+    {
+      CSingleLock lock(m_section);
+      m_error = true;
+      m_outputEvent.Set();
+      m_inputSpaceEvent.Set();
+      break;
+    }
+  }
+}
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "DVDVideoCodec.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavfilter/avfilter.h>
+#include <libavutil/frame.h>
+}
+
+/*!
+ * \brief libavfilter graph (deinterlacing, scaling, rotation) for software
+ * decoded frames.
+ *
+ * In threaded mode the graph runs as a separate pipeline stage: decoded
+ * frames are queued by the decode thread and filtered on a worker thread
+ * while the decoder continues with the next frames. The graph itself uses
+ * libavfilter's slice threading. AddFrame() blocks when the input queue is
+ * full, the codec only queues new frames once the filtered output has been
+ * collected, which bounds the output queue.
+ */
+class CDVDVideoFilterFFmpeg : private CThread
+{
+public:
+  CDVDVideoFilterFFmpeg();
+  ~CDVDVideoFilterFFmpeg() override;
+
+  /*!
+   * \brief Configure the graph for frames coming from avctx
+   * \param threads slice threads of the graph, 0 for libavfilter's default
+   * \param threaded run the graph on its own thread
+   * \return >= 0 on success, an AVERROR otherwise
+   */
+  int Open(AVCodecContext* avctx, const std::string& filters,
+           std::vector<AVPixelFormat>& formats, int threads, bool threaded);
+  void Close();
+  bool IsOpen() const { return m_pFilterGraph != nullptr; }
+  bool IsEof();
+
+  /*!
+   * \brief Check if the graph was configured for different input
+   */
+  bool NeedsReopen(int format, int width, int height) const;
+
+  /*!
+   * \brief Queue a frame for filtering, takes over the frame's references.
+   * A nullptr frame flushes the graph.
+   */
+  bool AddFrame(AVFrame* frame);
+
+  /*!
+   * \brief Move the next filtered frame into frame
+   * \param wait block until a frame is available or the graph is drained
+   * \return VC_PICTURE, VC_BUFFER if no frame is ready or VC_ERROR
+   */
+  CDVDVideoCodec::VCReturn GetFrame(AVFrame* frame, bool wait);
+
+  /*!
+   * \brief Average time in ms the graph spent on one input frame
+   */
+  double GetFilterTime() const { return m_filterTime; }
+
+private:
+  void Process() override;
+  bool Filter(AVFrame* frame);
+  void ClearQueues();
+
+  AVFilterGraph* m_pFilterGraph = nullptr;
+  AVFilterContext* m_pFilterIn = nullptr;
+  AVFilterContext* m_pFilterOut = nullptr;
+  int m_inFormat = -1;
+  int m_inWidth = 0;
+  int m_inHeight = 0;
+  bool m_threaded = false;
+  bool m_drainQueued = false;
+
+  CCriticalSection m_section;
+  std::deque<AVFrame*> m_input;
+  std::deque<AVFrame*> m_output;
+  bool m_eof = false;
+  bool m_error = false;
+  CEvent m_inputEvent;
+  CEvent m_inputSpaceEvent;
+  CEvent m_outputEvent;
+
+  std::atomic<double> m_filterTime{0.0};
+};
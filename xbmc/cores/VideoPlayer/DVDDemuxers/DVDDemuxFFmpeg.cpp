@@ -70,6 +70,11 @@ static const struct StereoModeConversionMap WmvToInternalStereoModeMap[] =
 
 #define FF_MAX_EXTRADATA_SIZE ((1 << 28) - AV_INPUT_BUFFER_PADDING_SIZE)
 
+// time Read() waits for the read-ahead thread before returning an empty packet
+#define READAHEAD_WAIT_MS 10
+// upper bound of buffered payload, independent of the packet count
+#define READAHEAD_MAX_BYTES (16 * 1024 * 1024)
+
 std::string CDemuxStreamAudioFFmpeg::GetStreamName()
 {
   if (!m_stream)
@@ -191,6 +196,9 @@ bool CDVDDemuxFFmpeg::Aborted()
   if (m_timeout.IsTimePast())
     return true;
 
+  if (m_readAhead && m_readAhead->IsAborting())
+    return true;
+
   std::shared_ptr<CDVDInputStreamFFmpeg> input = std::dynamic_pointer_cast<CDVDInputStreamFFmpeg>(m_pInput);
   if (input && input->Aborted())
     return true;
@@ -215,6 +223,7 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
 
   m_pInput = pInput;
   strFile = m_pInput->GetFileName();
+  m_strFileName = strFile;
 
   if (m_pInput->GetContent().length() > 0)
   {
@@ -610,11 +619,31 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
     SeekTime(0);
   }
 
+  // navigators and inputs that report their own time must stay in sync with
+  // the packets handed to the player, they can't be read ahead. the reader
+  // thread only uses the input through the io context, so inputs queried by
+  // the player for chapters while reading aren't read ahead either
+  const int readAheadPackets =
+    CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoDemuxReadAheadPackets;
+  if (!fileinfo && readAheadPackets > 0 &&
+      !m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD) &&
+      !m_pInput->IsStreamType(DVDSTREAM_TYPE_BLURAY) &&
+      !m_pInput->GetIPosTime() && !m_pInput->GetIDisplayTime() &&
+      !std::dynamic_pointer_cast<CDVDInputStream::IMenus>(m_pInput) &&
+      !std::dynamic_pointer_cast<CDVDInputStream::IChapter>(m_pInput))
+  {
+    CLog::Log(LOGDEBUG, "CDVDDemuxFFmpeg::Open - using read-ahead of %d packets", readAheadPackets);
+    m_readAhead.reset(new CDemuxReadAhead([this](bool& hold) { return ReadPacket(hold); },
+                                          readAheadPackets, READAHEAD_MAX_BYTES));
+  }
+
   return true;
 }
 
 void CDVDDemuxFFmpeg::Dispose()
 {
+  m_readAhead.reset();
+
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
@@ -651,6 +680,14 @@ bool CDVDDemuxFFmpeg::Reset()
 }
 
 void CDVDDemuxFFmpeg::Flush()
+{
+  StopReadAhead();
+  FlushInternal();
+
+  m_currentPts = DVD_NOPTS_VALUE;
+}
+
+void CDVDDemuxFFmpeg::FlushInternal()
 {
   if (m_pFormatContext)
   {
@@ -659,8 +696,6 @@ void CDVDDemuxFFmpeg::Flush()
     avformat_flush(m_pFormatContext);
   }
 
-  m_currentPts = DVD_NOPTS_VALUE;
-
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
@@ -682,6 +717,8 @@ void CDVDDemuxFFmpeg::SetSpeed(int iSpeed)
   if (m_speed == iSpeed)
     return;
 
+  StopReadAhead();
+
   if (m_speed != DVD_PLAYSPEED_PAUSE && iSpeed == DVD_PLAYSPEED_PAUSE)
   {
     m_pInput->Pause(m_currentPts);
@@ -917,7 +954,60 @@ double CDVDDemuxFFmpeg::ConvertTimestamp(int64_t pts, int den, int num)
   return timestamp * DVD_TIME_BASE;
 }
 
+void CDVDDemuxFFmpeg::StopReadAhead()
+{
+  // cancels a pending read and drops buffered packets, the next call to
+  // Read() restarts reading at the new position
+  if (m_readAhead)
+    m_readAhead->Stop();
+}
+
 DemuxPacket* CDVDDemuxFFmpeg::Read()
+{
+  if (!m_readAhead)
+    return ReadInternal();
+
+  m_readAhead->Start();
+
+  bool eof;
+  bool hold;
+  DemuxPacket* pPacket = m_readAhead->Read(READAHEAD_WAIT_MS, eof, hold);
+  if (eof)
+  {
+    // report eof to the player once, reading is retried on the next call
+    m_readAhead->Stop();
+    return nullptr;
+  }
+
+  // nothing buffered yet, don't block the player
+  if (!pPacket)
+    return CDVDDemuxUtils::AllocateDemuxPacket(0);
+
+  // streams are only changed on this thread, the reader waits meanwhile
+  if (hold)
+  {
+    pPacket = UpdateStreams(pPacket);
+    m_readAhead->Resume();
+  }
+
+  UpdateCurrentPTS(pPacket);
+  return pPacket;
+}
+
+DemuxPacket* CDVDDemuxFFmpeg::ReadInternal()
+{
+  bool bUpdateStreams = false;
+  DemuxPacket* pPacket = ReadPacket(bUpdateStreams);
+  if (pPacket && bUpdateStreams)
+    pPacket = UpdateStreams(pPacket);
+
+  if (pPacket)
+    UpdateCurrentPTS(pPacket);
+
+  return pPacket;
+}
+
+DemuxPacket* CDVDDemuxFFmpeg::ReadPacket(bool& bUpdateStreams)
 {
   DemuxPacket* pPacket = NULL;
   // on some cases where the received packet is invalid we will need to return an empty packet (0 length) otherwise the main loop (in CVideoPlayer)
@@ -941,6 +1031,9 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
       m_timeout.Set(20000);
       m_pkt.result = av_read_frame(m_pFormatContext, &m_pkt.pkt);
       m_timeout.SetInfinite();
+
+      // some formats estimate the duration while reading
+      UpdateStreamLength();
     }
 
     if (m_pkt.result == AVERROR(EINTR) || m_pkt.result == AVERROR(EAGAIN))
@@ -953,7 +1046,7 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
     }
     else if (m_pkt.result < 0)
     {
-      Flush();
+      FlushInternal();
     }
     // check size and stream index for being in a valid range
     else if (m_pkt.pkt.size < 0 ||
@@ -965,7 +1058,7 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
       {
         CLog::Log(LOGERROR, "CDVDDemuxFFmpeg::Read() no valid packet");
         bReturnEmpty = true;
-        Flush();
+        FlushInternal();
       }
       else
         CLog::Log(LOGERROR, "CDVDDemuxFFmpeg::Read() returned invalid packet and eof reached");
@@ -980,14 +1073,13 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
       if (IsProgramChange())
       {
         CLog::Log(LOGNOTICE, "CDVDDemuxFFmpeg::Read() stream change");
-        av_dump_format(m_pFormatContext, 0, CURL::GetRedacted(m_pInput->GetFileName()).c_str(), 0);
-
-        // update streams
-        CreateStreams(m_program);
+        av_dump_format(m_pFormatContext, 0, CURL::GetRedacted(m_strFileName).c_str(), 0);
 
+        // streams are updated by UpdateStreams()
         pPacket = CDVDDemuxUtils::AllocateDemuxPacket(0);
         pPacket->iStreamId = DMX_SPECIALID_STREAMCHANGE;
         pPacket->demuxerId = m_demuxerId;
+        bUpdateStreams = true;
 
         return pPacket;
       }
@@ -1058,10 +1150,6 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
           }
         }
 
-        // used to guess streamlength
-        if (pPacket->dts != DVD_NOPTS_VALUE && (pPacket->dts > m_currentPts || m_currentPts == DVD_NOPTS_VALUE))
-          m_currentPts = pPacket->dts;
-
         // store internal id until we know the continuous id presented to player
         // the stream might not have been created yet
         pPacket->iStreamId = m_pkt.pkt.stream_index;
@@ -1080,13 +1168,14 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
   // check streams, can we make this a bit more simple?
   if (pPacket && pPacket->iStreamId >= 0)
   {
+    // streams are only read here, changes are left to UpdateStreams()
     CDemuxStream* stream = GetStream(pPacket->iStreamId);
     if (!stream ||
         stream->pPrivate != m_pFormatContext->streams[pPacket->iStreamId] ||
         stream->codec != m_pFormatContext->streams[pPacket->iStreamId]->codecpar->codec_id)
     {
       // content has changed, or stream did not yet exist
-      stream = AddStream(pPacket->iStreamId);
+      bUpdateStreams = true;
     }
     // we already check for a valid m_streams[pPacket->iStreamId] above
     else if (stream->type == STREAM_AUDIO)
@@ -1095,7 +1184,7 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
           static_cast<CDemuxStreamAudio*>(stream)->iSampleRate != m_pFormatContext->streams[pPacket->iStreamId]->codecpar->sample_rate)
       {
         // content has changed
-        stream = AddStream(pPacket->iStreamId);
+        bUpdateStreams = true;
       }
     }
     else if (stream->type == STREAM_VIDEO)
@@ -1104,17 +1193,18 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
           static_cast<CDemuxStreamVideo*>(stream)->iHeight != m_pFormatContext->streams[pPacket->iStreamId]->codecpar->height)
       {
         // content has changed
-        stream = AddStream(pPacket->iStreamId);
+        bUpdateStreams = true;
       }
-      if (stream && stream->codec == AV_CODEC_ID_H264)
-        pPacket->recoveryPoint = m_seekToKeyFrame;
-      m_seekToKeyFrame = false;
     }
-    if (!stream)
-    {
-      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-      pPacket = CDVDDemuxUtils::AllocateDemuxPacket(0);
+
+    if (bUpdateStreams)
       return pPacket;
+
+    if (stream->type == STREAM_VIDEO)
+    {
+      if (stream->codec == AV_CODEC_ID_H264)
+        pPacket->recoveryPoint = m_seekToKeyFrame;
+      m_seekToKeyFrame = false;
     }
 
     pPacket->iStreamId = stream->uniqueId;
@@ -1123,6 +1213,48 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
   return pPacket;
 }
 
+DemuxPacket* CDVDDemuxFFmpeg::UpdateStreams(DemuxPacket* pPacket)
+{
+  // runs on the player's thread, which holds pointers to the streams
+  if (pPacket->iStreamId == DMX_SPECIALID_STREAMCHANGE)
+  {
+    CSingleLock lock(m_critSection);
+    CreateStreams(m_program);
+    return pPacket;
+  }
+
+  // the stream of the packet is missing or has changed
+  CDemuxStream* stream;
+  {
+    CSingleLock lock(m_critSection);
+    stream = AddStream(pPacket->iStreamId);
+  }
+
+  if (!stream)
+  {
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+    return CDVDDemuxUtils::AllocateDemuxPacket(0);
+  }
+
+  if (stream->type == STREAM_VIDEO)
+  {
+    if (stream->codec == AV_CODEC_ID_H264)
+      pPacket->recoveryPoint = m_seekToKeyFrame;
+    m_seekToKeyFrame = false;
+  }
+
+  pPacket->iStreamId = stream->uniqueId;
+  pPacket->demuxerId = m_demuxerId;
+  return pPacket;
+}
+
+void CDVDDemuxFFmpeg::UpdateCurrentPTS(const DemuxPacket* pPacket)
+{
+  // used to guess streamlength
+  if (pPacket->dts != DVD_NOPTS_VALUE && (pPacket->dts > m_currentPts || m_currentPts == DVD_NOPTS_VALUE))
+    m_currentPts = pPacket->dts;
+}
+
 bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 {
   bool hitEnd = false;
@@ -1136,6 +1268,8 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
     hitEnd = true;
   }
 
+  StopReadAhead();
+
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
@@ -1231,6 +1365,8 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 
 bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
 {
+  StopReadAhead();
+
   CSingleLock lock(m_critSection);
   int ret = av_seek_frame(m_pFormatContext, -1, pos, AVSEEK_FLAG_BYTE);
 
@@ -1261,14 +1397,24 @@ void CDVDDemuxFFmpeg::UpdateCurrentPTS()
 
 int CDVDDemuxFFmpeg::GetStreamLength()
 {
-  if (!m_pFormatContext)
-    return 0;
+  // while reading ahead, the reader thread updates the duration after each read
+  if (!m_readAhead || !m_readAhead->IsStarted())
+    UpdateStreamLength();
 
-  if (m_pFormatContext->duration < 0 ||
+  return m_streamLength;
+}
+
+void CDVDDemuxFFmpeg::UpdateStreamLength()
+{
+  if (!m_pFormatContext ||
+      m_pFormatContext->duration < 0 ||
       m_pFormatContext->duration == AV_NOPTS_VALUE)
-    return 0;
+  {
+    m_streamLength = 0;
+    return;
+  }
 
-  return (int)(m_pFormatContext->duration / (AV_TIME_BASE / 1000));
+  m_streamLength = (int)(m_pFormatContext->duration / (AV_TIME_BASE / 1000));
 }
 
 /**
@@ -1276,6 +1422,7 @@ int CDVDDemuxFFmpeg::GetStreamLength()
  */
 CDemuxStream* CDVDDemuxFFmpeg::GetStream(int iStreamId) const
 {
+  CSingleLock lock(m_streamsSection);
   auto it = m_streams.find(iStreamId);
   if (it != m_streams.end())
     return it->second;
@@ -1287,6 +1434,7 @@ std::vector<CDemuxStream*> CDVDDemuxFFmpeg::GetStreams() const
 {
   std::vector<CDemuxStream*> streams;
 
+  CSingleLock lock(m_streamsSection);
   for (auto& iter : m_streams)
     streams.push_back(iter.second);
 
@@ -1295,6 +1443,7 @@ std::vector<CDemuxStream*> CDVDDemuxFFmpeg::GetStreams() const
 
 int CDVDDemuxFFmpeg::GetNrOfStreams() const
 {
+  CSingleLock lock(m_streamsSection);
   return m_streams.size();
 }
 
@@ -1434,6 +1583,7 @@ void CDVDDemuxFFmpeg::CreateStreams(unsigned int program)
 
 void CDVDDemuxFFmpeg::DisposeStreams()
 {
+  CSingleLock lock(m_streamsSection);
   std::map<int, CDemuxStream*>::iterator it;
   for(it = m_streams.begin(); it != m_streams.end(); ++it)
     delete it->second;
@@ -1745,6 +1895,7 @@ void CDVDDemuxFFmpeg::AddStream(int streamIdx, CDemuxStream* stream)
 {
   std::pair<std::map<int, CDemuxStream*>::iterator, bool> res;
 
+  CSingleLock lock(m_streamsSection);
   res = m_streams.insert(std::make_pair(streamIdx, stream));
   if (res.second)
   {
@@ -1839,6 +1990,8 @@ bool CDVDDemuxFFmpeg::SeekChapter(int chapter, double* startpts)
   if (chapter < 1)
     chapter = 1;
 
+  StopReadAhead();
+
   std::shared_ptr<CDVDInputStream::IChapter> ich = std::dynamic_pointer_cast<CDVDInputStream::IChapter>(m_pInput);
   if (ich)
   {
@@ -9,8 +9,10 @@
 #pragma once
 
 #include "DVDDemux.h"
+#include "DemuxReadAhead.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
+#include <atomic>
 #include <map>
 #include <memory>
 #include <vector>
@@ -117,6 +119,13 @@ protected:
   void CreateStreams(unsigned int program = UINT_MAX);
   void DisposeStreams();
   void ParsePacket(AVPacket* pkt);
+  DemuxPacket* ReadInternal();
+  DemuxPacket* ReadPacket(bool& bUpdateStreams);
+  DemuxPacket* UpdateStreams(DemuxPacket* pPacket);
+  void UpdateCurrentPTS(const DemuxPacket* pPacket);
+  void UpdateStreamLength();
+  void FlushInternal();
+  void StopReadAhead();
   bool IsVideoReady();
   void ResetVideoStreams();
   AVDictionary* GetFFMpegOptionsFromInput();
@@ -132,12 +141,13 @@ protected:
   double SelectAspect(AVStream* st, bool& forced);
 
   CCriticalSection m_critSection;
+  mutable CCriticalSection m_streamsSection;
   std::map<int, CDemuxStream*> m_streams;
   std::map<int, std::unique_ptr<CDemuxParserFFmpeg>> m_parsers;
 
   AVIOContext* m_ioContext;
 
-  double   m_currentPts; // used for stream length estimation
+  double   m_currentPts; // used for stream length estimation, only used on the player thread
   bool     m_bMatroska;
   bool     m_bAVI;
   bool     m_bSup;
@@ -165,5 +175,11 @@ protected:
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
   double m_startTime = 0;
+
+  // packets are read and parsed on this thread when read-ahead is enabled,
+  // streams are still created and changed on the player thread only
+  std::unique_ptr<CDemuxReadAhead> m_readAhead;
+  std::atomic<int> m_streamLength{0}; ///< in ms, readable while the reader thread uses the format context
+  std::string m_strFileName;
 };
 
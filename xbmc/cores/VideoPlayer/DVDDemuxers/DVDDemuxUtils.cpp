@@ -7,9 +7,11 @@
  */
 
 #include "DVDDemuxUtils.h"
+#include "DemuxPacketPool.h"
 #include "cores/VideoPlayer/Interface/Addon/DemuxCrypto.h"
 #include "utils/log.h"
-#include "utils/MemUtils.h"
+
+#include <new>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -19,8 +21,9 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
 {
   if (pPacket)
   {
+    CDemuxPacketPool& pool = CDemuxPacketPool::GetInstance();
     if (pPacket->pData)
-      KODI::MEMORY::AlignedFree(pPacket->pData);
+      pool.Free(pPacket->pData);
     if (pPacket->iSideDataElems)
     {
       AVPacket avPkt;
@@ -29,13 +32,19 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
       avPkt.side_data_elems = pPacket->iSideDataElems;
       av_packet_free_side_data(&avPkt);
     }
-    delete pPacket;
+    pPacket->~DemuxPacket();
+    pool.Free(pPacket);
   }
 }
 
 DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(int iDataSize)
 {
-  DemuxPacket* pPacket = new DemuxPacket();
+  CDemuxPacketPool& pool = CDemuxPacketPool::GetInstance();
+  void* storage = pool.Allocate(sizeof(DemuxPacket));
+  if (!storage)
+    return NULL;
+
+  DemuxPacket* pPacket = new (storage) DemuxPacket();
 
   if (iDataSize > 0)
   {
@@ -48,7 +57,7 @@ DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(int iDataSize)
      * Note, if the first 23 bits of the additional bytes are not 0 then damaged
      * MPEG bitstreams could cause overread and segfault
      */
-    pPacket->pData = static_cast<uint8_t*>(KODI::MEMORY::AlignedMalloc(iDataSize + AV_INPUT_BUFFER_PADDING_SIZE, 16));
+    pPacket->pData = static_cast<uint8_t*>(pool.Allocate(iDataSize + AV_INPUT_BUFFER_PADDING_SIZE));
     if (!pPacket->pData)
     {
       FreeDemuxPacket(pPacket);
@@ -0,0 +1,171 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxPacketPool.h"
+
+#include "utils/MemUtils.h"
+
+namespace
+{
+// sized for packet structs and messages, audio frames, and small to large video frames
+constexpr size_t CLASS_SIZE[CDemuxPacketPool::SIZE_CLASSES] = {
+  256, 1024, 4096, 16384, 65536, 262144 };
+
+// pooled blocks per class, about 8 MB for each of the large classes
+constexpr unsigned int CLASS_MAX_BLOCKS[CDemuxPacketPool::SIZE_CLASSES] = {
+  2048, 1024, 512, 512, 128, 32 };
+
+constexpr unsigned int NOT_POOLED = CDemuxPacketPool::SIZE_CLASSES;
+
+// header in front of each block, keeps the user data 16 byte aligned
+constexpr size_t HEADER_SIZE = 16;
+
+unsigned int GetSizeClass(size_t size)
+{
+  for (unsigned int i = 0; i < CDemuxPacketPool::SIZE_CLASSES; i++)
+  {
+    if (size <= CLASS_SIZE[i])
+      return i;
+  }
+  return NOT_POOLED;
+}
+}
+
+struct CDemuxPacketPool::Block
+{
+  Block* next;
+  unsigned int sizeClass;
+};
+
+struct CDemuxPacketPool::ThreadCache
+{
+  ~ThreadCache()
+  {
+    // hand the blocks back when the thread exits
+    for (unsigned int i = 0; i < SIZE_CLASSES; i++)
+    {
+      if (!blocks[i])
+        continue;
+
+      Block* last = blocks[i];
+      while (last->next)
+        last = last->next;
+      CDemuxPacketPool::GetInstance().Push(i, blocks[i], last);
+    }
+  }
+
+  Block* blocks[SIZE_CLASSES] = {};
+};
+
+CDemuxPacketPool& CDemuxPacketPool::GetInstance()
+{
+  // never destroyed, thread caches may return blocks during shutdown
+  static CDemuxPacketPool* pool = new CDemuxPacketPool();
+  return *pool;
+}
+
+CDemuxPacketPool::ThreadCache& CDemuxPacketPool::GetThreadCache()
+{
+  static thread_local ThreadCache cache;
+  return cache;
+}
+
+void* CDemuxPacketPool::Allocate(size_t size)
+{
+  static_assert(sizeof(Block) <= HEADER_SIZE, "block header too large");
+
+  m_requests.fetch_add(1, std::memory_order_relaxed);
+
+  unsigned int sizeClass = GetSizeClass(size);
+  Block* block = nullptr;
+
+  if (sizeClass != NOT_POOLED)
+  {
+    ThreadCache& cache = GetThreadCache();
+    if (!cache.blocks[sizeClass])
+      cache.blocks[sizeClass] = m_classes[sizeClass].freed.exchange(nullptr, std::memory_order_acquire);
+
+    block = cache.blocks[sizeClass];
+    if (block)
+    {
+      cache.blocks[sizeClass] = block->next;
+      m_classes[sizeClass].pooled.fetch_sub(1, std::memory_order_relaxed);
+      m_hits.fetch_add(1, std::memory_order_relaxed);
+      return reinterpret_cast<uint8_t*>(block) + HEADER_SIZE;
+    }
+    size = CLASS_SIZE[sizeClass];
+  }
+
+  block = static_cast<Block*>(KODI::MEMORY::AlignedMalloc(size + HEADER_SIZE, 16));
+  if (!block)
+    return nullptr;
+
+  block->next = nullptr;
+  block->sizeClass = sizeClass;
+  return reinterpret_cast<uint8_t*>(block) + HEADER_SIZE;
+}
+
+void CDemuxPacketPool::Free(void* ptr)
+{
+  if (!ptr)
+    return;
+
+  Block* block = reinterpret_cast<Block*>(static_cast<uint8_t*>(ptr) - HEADER_SIZE);
+  unsigned int sizeClass = block->sizeClass;
+
+  if (sizeClass == NOT_POOLED ||
+      m_classes[sizeClass].pooled.fetch_add(1, std::memory_order_relaxed) >= CLASS_MAX_BLOCKS[sizeClass])
+  {
+    if (sizeClass != NOT_POOLED)
+      m_classes[sizeClass].pooled.fetch_sub(1, std::memory_order_relaxed);
+    KODI::MEMORY::AlignedFree(block);
+    return;
+  }
+
+  Push(sizeClass, block, block);
+}
+
+void CDemuxPacketPool::Push(unsigned int sizeClass, Block* first, Block* last)
+{
+  // only the consumer's exchange() ever takes blocks off the stack, so a
+  // plain compare and swap push is free of ABA problems
+  std::atomic<Block*>& head = m_classes[sizeClass].freed;
+  last->next = head.load(std::memory_order_relaxed);
+  while (!head.compare_exchange_weak(last->next, first, std::memory_order_release, std::memory_order_relaxed))
+    ;
+}
+
+void CDemuxPacketPool::Trim()
+{
+  ThreadCache& cache = GetThreadCache();
+  for (unsigned int i = 0; i < SIZE_CLASSES; i++)
+  {
+    FreeBlocks(i, cache.blocks[i]);
+    cache.blocks[i] = nullptr;
+
+    // taking the whole stack is as safe as the consumer's exchange()
+    FreeBlocks(i, m_classes[i].freed.exchange(nullptr, std::memory_order_acquire));
+  }
+}
+
+void CDemuxPacketPool::FreeBlocks(unsigned int sizeClass, Block* first)
+{
+  while (first)
+  {
+    Block* next = first->next;
+    KODI::MEMORY::AlignedFree(first);
+    m_classes[sizeClass].pooled.fetch_sub(1, std::memory_order_relaxed);
+    first = next;
+  }
+}
+
+void CDemuxPacketPool::GetStats(uint64_t& requests, uint64_t& hits) const
+{
+  requests = m_requests.load(std::memory_order_relaxed);
+  hits = m_hits.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \brief Recycles the memory of demux packets, their payload and the
+ * messages carrying them to the decoders.
+ *
+ * Blocks are grouped in size classes. Freed blocks, usually released on a
+ * decoder thread, are pushed onto a lock-free stack of their class. An
+ * allocating thread, usually the demuxer, takes over the whole stack into a
+ * thread local cache, so neither side ever waits for the other. Requests
+ * larger than the largest class and blocks exceeding the pool limits go to
+ * the heap.
+ *
+ * All blocks are 16 byte aligned.
+ */
+class CDemuxPacketPool
+{
+public:
+  static CDemuxPacketPool& GetInstance();
+
+  void* Allocate(size_t size);
+  void Free(void* ptr);
+
+  /*!
+   * \brief Free the pooled blocks of the calling thread and those given back
+   * by other threads, e.g. when playback ended
+   */
+  void Trim();
+
+  /*!
+   * \brief Number of allocations and how many of them were served from the pool
+   */
+  void GetStats(uint64_t& requests, uint64_t& hits) const;
+
+  static constexpr unsigned int SIZE_CLASSES = 6;
+
+private:
+  CDemuxPacketPool() = default;
+  CDemuxPacketPool(const CDemuxPacketPool&) = delete;
+  CDemuxPacketPool& operator=(const CDemuxPacketPool&) = delete;
+
+  struct Block;
+  struct ThreadCache;
+
+  static ThreadCache& GetThreadCache();
+  void Push(unsigned int sizeClass, Block* first, Block* last);
+  void FreeBlocks(unsigned int sizeClass, Block* first);
+
+  struct SizeClass
+  {
+    std::atomic<Block*> freed{nullptr};
+    std::atomic<unsigned int> pooled{0};
+  };
+  SizeClass m_classes[SIZE_CLASSES];
+
+  std::atomic<uint64_t> m_requests{0};
+  std::atomic<uint64_t> m_hits{0};
+};
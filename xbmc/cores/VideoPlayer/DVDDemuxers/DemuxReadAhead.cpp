@@ -0,0 +1,158 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxReadAhead.h"
+
+#include "DVDDemuxUtils.h"
+#include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+CDemuxReadAhead::CDemuxReadAhead(ReadFunc readFunc, unsigned int maxPackets, unsigned int maxBytes)
+  : CThread("DemuxReadAhead"),
+    m_readFunc(std::move(readFunc)),
+    m_maxPackets(maxPackets > 0 ? maxPackets : 1),
+    m_maxBytes(maxBytes)
+{
+}
+
+CDemuxReadAhead::~CDemuxReadAhead()
+{
+  Stop();
+}
+
+void CDemuxReadAhead::Start()
+{
+  if (m_started)
+    return;
+
+  m_abort = false;
+  {
+    CSingleLock lock(m_section);
+    m_eof = false;
+    m_holding = false;
+  }
+  m_started = true;
+  Create();
+}
+
+void CDemuxReadAhead::Stop()
+{
+  if (m_started)
+  {
+    // interrupt a read blocked in the input stream
+    m_abort = true;
+    m_spaceEvent.Set();
+    StopThread(true);
+    m_started = false;
+
+    // the demuxer seeks right after stopping, which must not be interrupted
+    m_abort = false;
+  }
+  Clear();
+}
+
+void CDemuxReadAhead::Clear()
+{
+  CSingleLock lock(m_section);
+  for (auto& entry : m_queue)
+    CDVDDemuxUtils::FreeDemuxPacket(entry.first);
+  m_queue.clear();
+  m_queuedBytes = 0;
+  m_eof = false;
+  m_holding = false;
+  m_packetEvent.Reset();
+}
+
+DemuxPacket* CDemuxReadAhead::Read(unsigned int timeoutMs, bool& eof, bool& hold)
+{
+  eof = false;
+  hold = false;
+
+  for (int attempt = 0; attempt < 2; attempt++)
+  {
+    {
+      CSingleLock lock(m_section);
+      if (!m_queue.empty())
+      {
+        DemuxPacket* packet = m_queue.front().first;
+        hold = m_queue.front().second;
+        m_queue.pop_front();
+        m_queuedBytes -= packet->iSize;
+        m_spaceEvent.Set();
+        return packet;
+      }
+      if (m_eof)
+      {
+        eof = true;
+        return nullptr;
+      }
+    }
+
+    if (attempt == 0 && !m_packetEvent.WaitMSec(timeoutMs))
+      break;
+  }
+  return nullptr;
+}
+
+void CDemuxReadAhead::Resume()
+{
+  CSingleLock lock(m_section);
+  m_holding = false;
+  m_spaceEvent.Set();
+}
+
+void CDemuxReadAhead::Process()
+{
+  while (!m_bStop)
+  {
+    {
+      CSingleLock lock(m_section);
+      bool full = m_holding || m_queue.size() >= m_maxPackets ||
+                  (m_maxBytes > 0 && m_queuedBytes >= m_maxBytes);
+      if (full)
+      {
+        CSingleExit exit(m_section);
+        AbortableWait(m_spaceEvent, 100);
+        continue;
+      }
+    }
+
+    bool hold = false;
+    DemuxPacket* packet = m_readFunc(hold);
+
+    if (m_bStop)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(packet);
+      break;
+    }
+
+    if (!packet)
+    {
+      // end of stream or read error, the consumer restarts us after it
+      // has seen the eof so that growing or realtime streams are retried
+      CSingleLock lock(m_section);
+      m_eof = true;
+      m_packetEvent.Set();
+      break;
+    }
+
+    // empty packets only signal "nothing yet" in the synchronous path
+    if (packet->iSize == 0 && packet->iStreamId == -1)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(packet);
+      continue;
+    }
+
+    CSingleLock lock(m_section);
+    m_queue.emplace_back(packet, hold);
+    m_queuedBytes += packet->iSize;
+    m_holding = hold;
+    m_packetEvent.Set();
+  }
+}
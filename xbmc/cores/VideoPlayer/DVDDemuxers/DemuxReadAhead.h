@@ -0,0 +1,87 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <utility>
+
+struct DemuxPacket;
+
+/*!
+ * \brief Runs a demuxer's blocking read function on its own thread and
+ * buffers the produced packets in a bounded queue.
+ *
+ * The owning demuxer must stop the read-ahead before it touches its format
+ * context from another thread (seek, flush, speed change) and restart it
+ * afterwards. Stopping cancels a pending read via IsAborting() and drops all
+ * queued packets.
+ *
+ * The read function can hold a packet which needs work on the consumer's
+ * thread, e.g. creating streams. Reading then pauses until the consumer has
+ * taken the packet and called Resume(), so the consumer can use the format
+ * context without racing the reader.
+ */
+class CDemuxReadAhead : private CThread
+{
+public:
+  using ReadFunc = std::function<DemuxPacket*(bool& hold)>;
+
+  CDemuxReadAhead(ReadFunc readFunc, unsigned int maxPackets, unsigned int maxBytes);
+  ~CDemuxReadAhead() override;
+
+  void Start();
+  void Stop();
+
+  /*!
+   * \brief Take the next packet from the queue
+   * \param timeoutMs time to wait for a packet if the queue is empty
+   * \param eof set to true if the reader hit end of stream and all packets were consumed
+   * \param hold set to true if reading is paused until Resume() is called
+   * \return the next packet, or nullptr on timeout or eof
+   */
+  DemuxPacket* Read(unsigned int timeoutMs, bool& eof, bool& hold);
+
+  /*!
+   * \brief Continue reading after a held packet was handled
+   */
+  void Resume();
+
+  /*!
+   * \brief Checked by the demuxer's interrupt callback to cancel a pending read.
+   * Only true while Stop() waits for the reader thread.
+   */
+  bool IsAborting() const { return m_abort; }
+
+  bool IsStarted() const { return m_started; }
+
+private:
+  void Process() override;
+  void Clear();
+
+  ReadFunc m_readFunc;
+  const unsigned int m_maxPackets;
+  const unsigned int m_maxBytes;
+
+  CCriticalSection m_section;
+  std::deque<std::pair<DemuxPacket*, bool>> m_queue;
+  unsigned int m_queuedBytes = 0;
+  bool m_eof = false;
+  bool m_holding = false;
+  bool m_started = false;
+  std::atomic<bool> m_abort{false};
+
+  CEvent m_packetEvent;
+  CEvent m_spaceEvent;
+};
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDDemuxers/DemuxReadAhead.h"
+#include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+  // Stands in for av_read_frame. Blocks until data is available, cancelled
+  // by the demuxer's interrupt callback, which checks IsAborting().
+  class TestSource
+  {
+  public:
+    DemuxPacket* Read(bool& hold)
+    {
+      hold = false;
+      while (!m_dataAvailable)
+      {
+        if (m_readAhead->IsAborting())
+          return nullptr;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+      DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(10);
+      packet->iSize = 10;
+      packet->iStreamId = 0;
+      return packet;
+    }
+
+    // like av_seek_frame, fails if the interrupt callback reports an abort
+    bool Seek() const { return !m_readAhead->IsAborting(); }
+
+    CDemuxReadAhead* m_readAhead = nullptr;
+    std::atomic<bool> m_dataAvailable{true};
+  };
+
+  DemuxPacket* WaitForPacket(CDemuxReadAhead& readAhead)
+  {
+    bool eof;
+    bool hold;
+    for (int i = 0; i < 100; i++)
+    {
+      DemuxPacket* packet = readAhead.Read(10, eof, hold);
+      if (packet || eof)
+        return packet;
+    }
+    return nullptr;
+  }
+}
+
+TEST(TestDemuxReadAhead, SeekAfterReadAhead)
+{
+  TestSource source;
+  CDemuxReadAhead readAhead([&source](bool& hold) { return source.Read(hold); }, 5, 0);
+  source.m_readAhead = &readAhead;
+
+  readAhead.Start();
+  DemuxPacket* packet = WaitForPacket(readAhead);
+  ASSERT_NE(nullptr, packet);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+
+  // the demuxer stops reading ahead before each seek
+  readAhead.Stop();
+  EXPECT_TRUE(source.Seek());
+
+  // and reads from the new position afterwards
+  readAhead.Start();
+  packet = WaitForPacket(readAhead);
+  ASSERT_NE(nullptr, packet);
+  CDVDDemuxUtils::FreeDemuxPacket(packet);
+
+  readAhead.Stop();
+  EXPECT_TRUE(source.Seek());
+}
+
+TEST(TestDemuxReadAhead, StopInterruptsRead)
+{
+  TestSource source;
+  source.m_dataAvailable = false;
+  CDemuxReadAhead readAhead([&source](bool& hold) { return source.Read(hold); }, 5, 0);
+  source.m_readAhead = &readAhead;
+
+  readAhead.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  // returns only once the blocked read was cancelled
+  readAhead.Stop();
+  EXPECT_FALSE(readAhead.IsStarted());
+  EXPECT_TRUE(source.Seek());
+}
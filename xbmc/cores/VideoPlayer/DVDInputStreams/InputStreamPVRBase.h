@@ -49,7 +49,7 @@ public:
 
   bool CanSeek() override; //! @todo drop this
   bool CanPause() override;
-  void Pause(bool bPaused);
+  virtual void Pause(bool bPaused);
 
   // Demux interface
   CDVDInputStream::IDemux* GetIDemux() override { return nullptr; };
@@ -8,12 +8,19 @@
 
 #include "InputStreamPVRChannel.h"
 
+#include "PVRTimeshiftBuffer.h"
 #include "ServiceBroker.h"
+#include "Util.h"
 #include "addons/PVRClient.h"
+#include "filesystem/SpecialProtocol.h"
 #include "pvr/PVRManager.h"
 #include "pvr/channels/PVRChannelGroupsContainer.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/log.h"
 
+#include <cinttypes>
+
 using namespace PVR;
 
 CInputStreamPVRChannel::CInputStreamPVRChannel(IVideoPlayer* pPlayer, const CFileItem& fileitem)
@@ -35,6 +42,29 @@ CDVDInputStream::IDemux* CInputStreamPVRChannel::GetIDemux()
   return CInputStreamPVRBase::GetIDemux();
 }
 
+bool CInputStreamPVRChannel::GetTimes(Times &times)
+{
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->GetTimes(times);
+
+  return CInputStreamPVRBase::GetTimes(times);
+}
+
+bool CInputStreamPVRChannel::IsRealtime()
+{
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->GetSecondsBehindLive() < CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeshiftThreshold;
+
+  return CInputStreamPVRBase::IsRealtime();
+}
+
+void CInputStreamPVRChannel::Pause(bool bPaused)
+{
+  // the time-shift buffer keeps receiving the live stream while paused
+  if (!m_timeshiftBuffer)
+    CInputStreamPVRBase::Pause(bPaused);
+}
+
 bool CInputStreamPVRChannel::OpenPVRStream()
 {
   std::shared_ptr<CPVRChannel> channel = m_item.GetPVRChannelInfoTag();
@@ -48,6 +78,24 @@ bool CInputStreamPVRChannel::OpenPVRStream()
   {
     m_bDemuxActive = m_client->GetClientCapabilities().HandlesDemuxing();
     CLog::Log(LOGDEBUG, "CInputStreamPVRChannel - %s - opened channel stream %s", __FUNCTION__, m_item.GetPath().c_str());
+
+    const int64_t iBufferSize = m_bDemuxActive ? 0 : GetTimeshiftBufferSize();
+    if (iBufferSize > 0)
+    {
+      const std::shared_ptr<CPVRClient> client = m_client;
+      m_timeshiftBuffer.reset(new CPVRTimeshiftBuffer([client](uint8_t* buf, int buf_size)
+      {
+        int ret = -1;
+        client->ReadLiveStream(buf, buf_size, ret);
+        return ret;
+      }, iBufferSize));
+
+      if (!m_timeshiftBuffer->Open(CSpecialProtocol::TranslatePath(CUtil::GetNextFilename("special://temp/pvrtimeshift%03d.ts", 999))))
+      {
+        CLog::Log(LOGERROR, "CInputStreamPVRChannel - %s - unable to create time-shift buffer, playing without", __FUNCTION__);
+        m_timeshiftBuffer.reset();
+      }
+    }
     return true;
   }
   return false;
@@ -55,6 +103,9 @@ bool CInputStreamPVRChannel::OpenPVRStream()
 
 void CInputStreamPVRChannel::ClosePVRStream()
 {
+  // stop reading the stream before closing it
+  m_timeshiftBuffer.reset();
+
   if (m_client && (m_client->CloseLiveStream() == PVR_ERROR_NO_ERROR))
   {
     m_bDemuxActive = false;
@@ -64,6 +115,21 @@ void CInputStreamPVRChannel::ClosePVRStream()
 
 int CInputStreamPVRChannel::ReadPVRStream(uint8_t* buf, int buf_size)
 {
+  if (m_timeshiftBuffer)
+  {
+    const int iRead = m_timeshiftBuffer->Read(buf, buf_size);
+    if (iRead == CPVRTimeshiftBuffer::READ_DATA_OVERWRITTEN)
+    {
+      // fail this read, so the demuxer doesn't take the data after the gap for the continuation of
+      // the current packet, and continue with the oldest data kept
+      const int64_t iStartPos = m_timeshiftBuffer->GetStartPosition();
+      CLog::Log(LOGWARNING, "CInputStreamPVRChannel - %s - playback fell behind the time-shift buffer, continuing at position %" PRId64, __FUNCTION__, iStartPos);
+      m_timeshiftBuffer->Seek(iStartPos, SEEK_SET);
+      return -1;
+    }
+    return iRead;
+  }
+
   int ret = -1;
 
   if (m_client)
@@ -74,6 +140,9 @@ int CInputStreamPVRChannel::ReadPVRStream(uint8_t* buf, int buf_size)
 
 int64_t CInputStreamPVRChannel::SeekPVRStream(int64_t offset, int whence)
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->Seek(offset, whence);
+
   int64_t ret = -1;
 
   if (m_client)
@@ -84,6 +153,9 @@ int64_t CInputStreamPVRChannel::SeekPVRStream(int64_t offset, int whence)
 
 int64_t CInputStreamPVRChannel::GetPVRStreamLength()
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->GetLength();
+
   int64_t ret = -1;
 
   if (m_client)
@@ -102,6 +174,9 @@ CDVDInputStream::ENextStream CInputStreamPVRChannel::NextPVRStream()
 
 bool CInputStreamPVRChannel::CanPausePVRStream()
 {
+  if (m_timeshiftBuffer)
+    return true;
+
   bool ret = false;
 
   if (m_client)
@@ -112,6 +187,9 @@ bool CInputStreamPVRChannel::CanPausePVRStream()
 
 bool CInputStreamPVRChannel::CanSeekPVRStream()
 {
+  if (m_timeshiftBuffer)
+    return true;
+
   bool ret = false;
 
   if (m_client)
@@ -119,3 +197,25 @@ bool CInputStreamPVRChannel::CanSeekPVRStream()
 
   return ret;
 }
+
+int64_t CInputStreamPVRChannel::GetTimeshiftBufferSize() const
+{
+  const std::shared_ptr<CAdvancedSettings> settings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+  int iSize = settings->m_iPVRTimeshiftBufferSize;
+  const auto it = settings->m_pvrTimeshiftBufferClientSizes.find(m_client->ID());
+  if (it != settings->m_pvrTimeshiftBufferClientSizes.end())
+  {
+    iSize = it->second;
+  }
+  else if (iSize > 0)
+  {
+    // by default, only for clients without time-shift support
+    bool bCanPause = false;
+    m_client->CanPauseStream(bCanPause);
+    if (bCanPause)
+      iSize = 0;
+  }
+
+  return static_cast<int64_t>(iSize) * 1024 * 1024;
+}
@@ -10,6 +10,10 @@
 
 #include "InputStreamPVRBase.h"
 
+#include <memory>
+
+class CPVRTimeshiftBuffer;
+
 class CInputStreamPVRChannel : public CInputStreamPVRBase
 {
 public:
@@ -17,6 +21,9 @@ public:
   ~CInputStreamPVRChannel() override;
 
   CDVDInputStream::IDemux* GetIDemux() override;
+  bool GetTimes(Times &times) override;
+  bool IsRealtime() override;
+  void Pause(bool bPaused) override;
 
 protected:
   bool OpenPVRStream() override;
@@ -29,5 +36,8 @@ protected:
   bool CanSeekPVRStream() override;
 
 private:
+  int64_t GetTimeshiftBufferSize() const;
+
   bool m_bDemuxActive;
+  std::unique_ptr<CPVRTimeshiftBuffer> m_timeshiftBuffer;
 };
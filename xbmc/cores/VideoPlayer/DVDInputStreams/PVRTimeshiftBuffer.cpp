@@ -0,0 +1,326 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRTimeshiftBuffer.h"
+
+#include "URL.h"
+#include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
+using namespace XFILE;
+
+namespace
+{
+  // bytes requested from the live stream at once
+  const int CHUNK_SIZE = 64 * 1024;
+
+  // time a read waits for the live stream before failing
+  const unsigned int READ_TIMEOUT_MS = 10000;
+
+  // minimum time between two recorded receive times
+  const std::chrono::milliseconds RECEIVE_TIME_INTERVAL(500);
+}
+
+const int CPVRTimeshiftBuffer::READ_DATA_OVERWRITTEN;
+
+CPVRTimeshiftBuffer::CPVRTimeshiftBuffer(const ReadFunction& readFunc, int64_t iMaxSize)
+  : CThread("PVRTimeshiftBuffer"),
+    m_readFunc(readFunc),
+    m_iMaxSize(iMaxSize)
+{
+}
+
+CPVRTimeshiftBuffer::~CPVRTimeshiftBuffer()
+{
+  Close();
+}
+
+bool CPVRTimeshiftBuffer::Open(const std::string& strFileName)
+{
+  Close();
+
+  if (m_iMaxSize <= 0 || strFileName.empty())
+    return false;
+
+  const CURL fileURL(strFileName);
+  if (!m_writeFile.OpenForWrite(fileURL, true))
+  {
+    CLog::LogF(LOGERROR, "Failed to create file '%s' for writing", strFileName.c_str());
+    return false;
+  }
+
+  m_strFileName = strFileName;
+
+  // the data is read once, right after it was written. caching it would only cost memory.
+  if (!m_readFile.Open(fileURL, READ_NO_CACHE | READ_TRUNCATED | READ_CHUNKED))
+  {
+    CLog::LogF(LOGERROR, "Failed to open file '%s' for reading", strFileName.c_str());
+    Close();
+    return false;
+  }
+
+  {
+    CSingleLock lock(m_critSection);
+    m_iStartPos = 0;
+    m_iWritePos = 0;
+    m_iReadPos = 0;
+    m_bEndOfInput = false;
+    m_startTime = time(nullptr);
+    m_openTime = std::chrono::steady_clock::now();
+    m_lastReceiveTime = m_openTime;
+    m_receiveTimes.clear();
+  }
+
+  Create();
+  CLog::LogFC(LOGDEBUG, LOGPVR, "Opened time-shift buffer '%s' (%" PRId64 " bytes)", strFileName.c_str(), m_iMaxSize);
+  return true;
+}
+
+void CPVRTimeshiftBuffer::Close()
+{
+  StopThread(true);
+
+  m_writeFile.Close();
+  m_readFile.Close();
+
+  if (!m_strFileName.empty())
+  {
+    if (!CFile::Delete(CURL(m_strFileName)))
+      CLog::LogF(LOGWARNING, "Failed to delete time-shift buffer '%s'", m_strFileName.c_str());
+
+    m_strFileName.clear();
+  }
+
+  CSingleLock lock(m_critSection);
+  m_bEndOfInput = true;
+  m_dataAvailable.Set();
+}
+
+void CPVRTimeshiftBuffer::Process()
+{
+  std::vector<uint8_t> buffer(static_cast<size_t>(std::min<int64_t>(CHUNK_SIZE, m_iMaxSize)));
+
+  while (!m_bStop)
+  {
+    const int iRead = m_readFunc(buffer.data(), static_cast<int>(buffer.size()));
+    if (iRead <= 0 || !WriteToBuffer(buffer.data(), iRead))
+    {
+      if (iRead < 0)
+        CLog::LogF(LOGERROR, "Failed to read the live stream");
+
+      break;
+    }
+  }
+
+  CSingleLock lock(m_critSection);
+  m_bEndOfInput = true;
+  m_dataAvailable.Set();
+}
+
+bool CPVRTimeshiftBuffer::WriteToBuffer(const uint8_t* buf, int bufSize)
+{
+  int64_t iWritePos;
+  {
+    CSingleLock lock(m_critSection);
+    iWritePos = m_iWritePos;
+
+    // drop the data about to be overwritten first, so a reader of that range notices
+    if (iWritePos + bufSize - m_iStartPos > m_iMaxSize)
+    {
+      m_iStartPos = iWritePos + bufSize - m_iMaxSize;
+      while (m_receiveTimes.size() > 1 && m_receiveTimes[1].first <= m_iStartPos)
+        m_receiveTimes.pop_front();
+    }
+  }
+
+  int iWritten = 0;
+  while (iWritten < bufSize)
+  {
+    const int64_t iFilePos = (iWritePos + iWritten) % m_iMaxSize;
+    const size_t iSize = static_cast<size_t>(std::min<int64_t>(bufSize - iWritten, m_iMaxSize - iFilePos));
+
+    if (m_writeFile.Seek(iFilePos, SEEK_SET) != iFilePos)
+    {
+      CLog::LogF(LOGERROR, "Failed to seek in time-shift buffer");
+      return false;
+    }
+
+    const ssize_t iLastWritten = m_writeFile.Write(buf + iWritten, iSize);
+    if (iLastWritten <= 0)
+    {
+      CLog::LogF(LOGERROR, "Failed to write to time-shift buffer");
+      return false;
+    }
+    iWritten += static_cast<int>(iLastWritten);
+  }
+
+  CSingleLock lock(m_critSection);
+  m_lastReceiveTime = std::chrono::steady_clock::now();
+  if (m_receiveTimes.empty() || m_lastReceiveTime - m_receiveTimes.back().second >= RECEIVE_TIME_INTERVAL)
+    m_receiveTimes.emplace_back(iWritePos, m_lastReceiveTime);
+
+  m_iWritePos = iWritePos + bufSize;
+  m_dataAvailable.Set();
+  return true;
+}
+
+int CPVRTimeshiftBuffer::Read(uint8_t* buf, int bufSize)
+{
+  if (bufSize <= 0)
+    return 0;
+
+  XbmcThreads::EndTime timeout(READ_TIMEOUT_MS);
+  while (true)
+  {
+    int64_t iReadPos;
+    int iSize;
+    {
+      CSingleLock lock(m_critSection);
+      // the caller decides how to continue, the data read so far doesn't continue here
+      if (m_iReadPos < m_iStartPos)
+        return READ_DATA_OVERWRITTEN;
+
+      iReadPos = m_iReadPos;
+      iSize = static_cast<int>(std::min<int64_t>(bufSize, m_iWritePos - m_iReadPos));
+
+      if (iSize <= 0 && m_bEndOfInput)
+        return 0;
+    }
+
+    if (iSize <= 0)
+    {
+      // the live end is reached, wait for the stream
+      if (!m_dataAvailable.WaitMSec(timeout.MillisLeft()))
+      {
+        CLog::LogF(LOGERROR, "Timed out waiting for the live stream");
+        return -1;
+      }
+      continue;
+    }
+
+    if (!ReadFromBuffer(iReadPos, buf, iSize))
+      return -1;
+
+    CSingleLock lock(m_critSection);
+    if (iReadPos < m_iStartPos)
+      continue; // overwritten while reading
+
+    m_iReadPos = iReadPos + iSize;
+    return iSize;
+  }
+}
+
+bool CPVRTimeshiftBuffer::ReadFromBuffer(int64_t iPosition, uint8_t* buf, int bufSize)
+{
+  int iRead = 0;
+  while (iRead < bufSize)
+  {
+    const int64_t iFilePos = (iPosition + iRead) % m_iMaxSize;
+    const size_t iSize = static_cast<size_t>(std::min<int64_t>(bufSize - iRead, m_iMaxSize - iFilePos));
+
+    if (m_readFile.Seek(iFilePos, SEEK_SET) != iFilePos)
+    {
+      CLog::LogF(LOGERROR, "Failed to seek in time-shift buffer");
+      return false;
+    }
+
+    const ssize_t iLastRead = m_readFile.Read(buf + iRead, iSize);
+    if (iLastRead <= 0)
+    {
+      CLog::LogF(LOGERROR, "Failed to read from time-shift buffer");
+      return false;
+    }
+    iRead += static_cast<int>(iLastRead);
+  }
+  return true;
+}
+
+int64_t CPVRTimeshiftBuffer::Seek(int64_t offset, int whence)
+{
+  CSingleLock lock(m_critSection);
+
+  int64_t iTarget;
+  switch (whence)
+  {
+    case SEEK_SET:
+      iTarget = offset;
+      break;
+    case SEEK_CUR:
+      iTarget = m_iReadPos + offset;
+      break;
+    case SEEK_END:
+      iTarget = m_iWritePos + offset;
+      break;
+    default:
+      return -1;
+  }
+
+  if (iTarget < m_iStartPos || iTarget > m_iWritePos)
+    return -1;
+
+  m_iReadPos = iTarget;
+  return m_iReadPos;
+}
+
+int64_t CPVRTimeshiftBuffer::GetStartPosition() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iStartPos;
+}
+
+int64_t CPVRTimeshiftBuffer::GetLength() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iWritePos;
+}
+
+bool CPVRTimeshiftBuffer::GetTimes(CDVDInputStream::ITimes::Times& times) const
+{
+  CSingleLock lock(m_critSection);
+  if (m_receiveTimes.empty())
+    return false;
+
+  times.startTime = m_startTime;
+  times.ptsStart = 0;
+  times.ptsBegin = ToStreamTime(GetTimeAt(m_iStartPos));
+  times.ptsEnd = ToStreamTime(m_lastReceiveTime);
+  return true;
+}
+
+int CPVRTimeshiftBuffer::GetSecondsBehindLive() const
+{
+  CSingleLock lock(m_critSection);
+  if (m_receiveTimes.empty())
+    return 0;
+
+  return static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(m_lastReceiveTime - GetTimeAt(m_iReadPos)).count());
+}
+
+std::chrono::steady_clock::time_point CPVRTimeshiftBuffer::GetTimeAt(int64_t iPosition) const
+{
+  // the last entry at or before the position
+  auto it = std::upper_bound(m_receiveTimes.cbegin(), m_receiveTimes.cend(), iPosition,
+                             [](int64_t iPos, const std::pair<int64_t, std::chrono::steady_clock::time_point>& entry) {
+                               return iPos < entry.first;
+                             });
+  if (it != m_receiveTimes.cbegin())
+    --it;
+
+  return it->second;
+}
+
+double CPVRTimeshiftBuffer::ToStreamTime(const std::chrono::steady_clock::time_point& time) const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(time - m_openTime).count() * DVD_TIME_BASE / 1000000.0;
+}
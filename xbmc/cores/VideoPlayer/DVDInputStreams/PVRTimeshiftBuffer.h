@@ -0,0 +1,137 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "DVDInputStream.h"
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <stdint.h>
+#include <string>
+#include <utility>
+
+/*!
+ * @brief Local, disk-backed time-shift buffer for live PVR streams.
+ *
+ * The live stream is read in the background and written to a file used as a ring, so pausing and
+ * seeking back work for back-ends without time-shift support and don't request data again. Positions
+ * are absolute stream positions, only the last maxSize bytes can be read. Live streams arrive in real
+ * time, so the time of a position is taken from the time it was received.
+ */
+class CPVRTimeshiftBuffer : private CThread
+{
+public:
+  /*!
+   * @brief Returned by Read() if the data at the current position was overwritten before it was read.
+   */
+  static const int READ_DATA_OVERWRITTEN = -2;
+
+  /*!
+   * @brief Reads the live stream. Returns the number of bytes read, 0 at the end of the stream or -1 on error.
+   */
+  typedef std::function<int(uint8_t* buf, int bufSize)> ReadFunction;
+
+  /*!
+   * @brief Create a buffer.
+   * @param readFunc The function reading the live stream, called on the buffer's thread.
+   * @param iMaxSize The maximum number of bytes kept, the oldest data is overwritten once reached.
+   */
+  CPVRTimeshiftBuffer(const ReadFunction& readFunc, int64_t iMaxSize);
+  ~CPVRTimeshiftBuffer() override;
+
+  /*!
+   * @brief Create the buffer file and start reading the live stream.
+   * @param strFileName The buffer file, deleted on close.
+   * @return True on success, false otherwise.
+   */
+  bool Open(const std::string& strFileName);
+
+  /*!
+   * @brief Stop reading the live stream and delete the buffer file.
+   */
+  void Close();
+
+  /*!
+   * @brief Read from the current position, waiting for the live stream if all data was read.
+   * @param buf The buffer.
+   * @param bufSize The size of the buffer.
+   * @return The number of bytes read, 0 at the end of the stream, -1 on error or READ_DATA_OVERWRITTEN
+   * if the reader fell behind the oldest data kept. The position is left unchanged then, reading can
+   * continue after seeking to GetStartPosition().
+   */
+  int Read(uint8_t* buf, int bufSize);
+
+  /*!
+   * @brief Seek within the buffered data, from GetStartPosition() to GetLength().
+   * @param offset The offset.
+   * @param whence SEEK_SET, SEEK_CUR or SEEK_END.
+   * @return The new position or -1 if it is not buffered (any more), the position is left unchanged then.
+   */
+  int64_t Seek(int64_t offset, int whence);
+
+  /*!
+   * @brief Get the position of the oldest data kept.
+   * @return The position.
+   */
+  int64_t GetStartPosition() const;
+
+  /*!
+   * @brief Get the end position of the buffered data.
+   * @return The position.
+   */
+  int64_t GetLength() const;
+
+  /*!
+   * @brief Get the times of the buffered data, relative to the begin of the stream.
+   * @param times The times.
+   * @return True if data was buffered, false otherwise.
+   */
+  bool GetTimes(CDVDInputStream::ITimes::Times& times) const;
+
+  /*!
+   * @brief Get how far the current position is behind the live end of the stream.
+   * @return The time in seconds.
+   */
+  int GetSecondsBehindLive() const;
+
+protected:
+  void Process() override;
+
+private:
+  CPVRTimeshiftBuffer(const CPVRTimeshiftBuffer&) = delete;
+  CPVRTimeshiftBuffer& operator=(const CPVRTimeshiftBuffer&) = delete;
+
+  bool WriteToBuffer(const uint8_t* buf, int bufSize);
+  bool ReadFromBuffer(int64_t iPosition, uint8_t* buf, int bufSize);
+  std::chrono::steady_clock::time_point GetTimeAt(int64_t iPosition) const;
+  double ToStreamTime(const std::chrono::steady_clock::time_point& time) const;
+
+  const ReadFunction m_readFunc;
+  const int64_t m_iMaxSize;
+  std::string m_strFileName;
+  XFILE::CFile m_readFile;
+  XFILE::CFile m_writeFile;
+
+  mutable CCriticalSection m_critSection;
+  CEvent m_dataAvailable;
+  int64_t m_iStartPos = 0; /*!< the oldest position still buffered */
+  int64_t m_iWritePos = 0;
+  int64_t m_iReadPos = 0;
+  bool m_bEndOfInput = false;
+  time_t m_startTime = 0;
+  std::chrono::steady_clock::time_point m_openTime;
+  std::chrono::steady_clock::time_point m_lastReceiveTime;
+  std::deque<std::pair<int64_t, std::chrono::steady_clock::time_point>> m_receiveTimes; /*!< position and time of the data received, one entry per interval */
+};
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDInputStreams/PVRTimeshiftBuffer.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+  // Stands in for a live stream of iTotal bytes, delivered in small chunks.
+  CPVRTimeshiftBuffer::ReadFunction CreateStream(int iTotal)
+  {
+    auto position = std::make_shared<int>(0);
+    return [position, iTotal](uint8_t* buf, int bufSize)
+    {
+      const int iSize = std::min(std::min(bufSize, 100), iTotal - *position);
+      for (int i = 0; i < iSize; i++)
+        buf[i] = static_cast<uint8_t>((*position + i) % 251);
+      *position += iSize;
+      return iSize;
+    };
+  }
+
+  bool IsStreamData(const uint8_t* buf, int bufSize, int64_t iPosition)
+  {
+    for (int i = 0; i < bufSize; i++)
+    {
+      if (buf[i] != static_cast<uint8_t>((iPosition + i) % 251))
+        return false;
+    }
+    return true;
+  }
+
+  class TestPVRTimeshiftBuffer : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      m_tempFile = XBMC_CREATETEMPFILE(".ts");
+      ASSERT_NE(nullptr, m_tempFile);
+      m_strFileName = XBMC_TEMPFILEPATH(m_tempFile);
+      m_tempFile->Close();
+    }
+
+    void TearDown() override
+    {
+      // the buffer deletes its file itself
+      XBMC_DELETETEMPFILE(m_tempFile);
+    }
+
+    void WaitForLength(const CPVRTimeshiftBuffer& buffer, int64_t iLength)
+    {
+      for (int i = 0; i < 500 && buffer.GetLength() < iLength; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+      ASSERT_EQ(iLength, buffer.GetLength());
+    }
+
+    XFILE::CFile* m_tempFile = nullptr;
+    std::string m_strFileName;
+  };
+}
+
+TEST_F(TestPVRTimeshiftBuffer, ReadsLiveStream)
+{
+  CPVRTimeshiftBuffer buffer(CreateStream(10000), 1024 * 1024);
+  ASSERT_TRUE(buffer.Open(m_strFileName));
+
+  std::vector<uint8_t> data(1000);
+  int64_t iPosition = 0;
+  int iRead;
+  while ((iRead = buffer.Read(data.data(), static_cast<int>(data.size()))) > 0)
+  {
+    EXPECT_TRUE(IsStreamData(data.data(), iRead, iPosition));
+    iPosition += iRead;
+  }
+
+  EXPECT_EQ(0, iRead);
+  EXPECT_EQ(10000, iPosition);
+}
+
+TEST_F(TestPVRTimeshiftBuffer, Seek)
+{
+  CPVRTimeshiftBuffer buffer(CreateStream(3000), 1024 * 1024);
+  ASSERT_TRUE(buffer.Open(m_strFileName));
+  WaitForLength(buffer, 3000);
+
+  EXPECT_EQ(1000, buffer.Seek(1000, SEEK_SET));
+  uint8_t data[10];
+  ASSERT_EQ(10, buffer.Read(data, sizeof(data)));
+  EXPECT_TRUE(IsStreamData(data, sizeof(data), 1000));
+
+  EXPECT_EQ(1110, buffer.Seek(100, SEEK_CUR));
+  EXPECT_EQ(2500, buffer.Seek(-500, SEEK_END));
+  ASSERT_EQ(10, buffer.Read(data, sizeof(data)));
+  EXPECT_TRUE(IsStreamData(data, sizeof(data), 2500));
+
+  // positions beyond the live end are not buffered, the position is kept
+  EXPECT_EQ(-1, buffer.Seek(5000, SEEK_SET));
+  EXPECT_EQ(-1, buffer.Seek(-1, SEEK_SET));
+  EXPECT_EQ(2510, buffer.Seek(0, SEEK_CUR));
+  EXPECT_EQ(3000, buffer.Seek(0, SEEK_END));
+}
+
+TEST_F(TestPVRTimeshiftBuffer, KeepsLatestData)
+{
+  CPVRTimeshiftBuffer buffer(CreateStream(5050), 1000);
+  ASSERT_TRUE(buffer.Open(m_strFileName));
+  WaitForLength(buffer, 5050);
+
+  // the oldest data is overwritten, reading or seeking to it fails
+  std::vector<uint8_t> data(1000);
+  EXPECT_EQ(CPVRTimeshiftBuffer::READ_DATA_OVERWRITTEN, buffer.Read(data.data(), static_cast<int>(data.size())));
+  EXPECT_EQ(-1, buffer.Seek(0, SEEK_SET));
+
+  EXPECT_EQ(4050, buffer.GetStartPosition());
+  EXPECT_EQ(4050, buffer.Seek(4050, SEEK_SET));
+  ASSERT_EQ(1000, buffer.Read(data.data(), static_cast<int>(data.size())));
+  EXPECT_TRUE(IsStreamData(data.data(), 1000, 4050));
+  EXPECT_EQ(0, buffer.Read(data.data(), static_cast<int>(data.size())));
+}
+
+TEST_F(TestPVRTimeshiftBuffer, Times)
+{
+  CPVRTimeshiftBuffer buffer(CreateStream(3000), 1000);
+
+  CDVDInputStream::ITimes::Times times = {};
+  EXPECT_FALSE(buffer.GetTimes(times));
+
+  ASSERT_TRUE(buffer.Open(m_strFileName));
+  WaitForLength(buffer, 3000);
+
+  ASSERT_TRUE(buffer.GetTimes(times));
+  EXPECT_NE(0, times.startTime);
+  EXPECT_EQ(0, times.ptsStart);
+  EXPECT_LE(0, times.ptsBegin);
+  EXPECT_LE(times.ptsBegin, times.ptsEnd);
+
+  buffer.Seek(0, SEEK_END);
+  EXPECT_EQ(0, buffer.GetSecondsBehindLive());
+}
@@ -9,6 +9,7 @@
 #include "DVDMessage.h"
 
 #include "DVDDemuxers/DVDDemuxUtils.h"
+#include "DVDDemuxers/DemuxPacketPool.h"
 #include "threads/Condition.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
@@ -16,6 +17,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <new>
 
 class CDVDMsgGeneralSynchronizePriv
 {
@@ -108,6 +110,19 @@ CDVDMsgDemuxerPacket::~CDVDMsgDemuxerPacket()
     CDVDDemuxUtils::FreeDemuxPacket(m_packet);
 }
 
+void* CDVDMsgDemuxerPacket::operator new(size_t size)
+{
+  void* ptr = CDemuxPacketPool::GetInstance().Allocate(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void CDVDMsgDemuxerPacket::operator delete(void* ptr)
+{
+  CDemuxPacketPool::GetInstance().Free(ptr);
+}
+
 unsigned int CDVDMsgDemuxerPacket::GetPacketSize()
 {
   if (m_packet)
@@ -282,6 +282,11 @@ class CDVDMsgDemuxerPacket : public CDVDMsg
 public:
   CDVDMsgDemuxerPacket(DemuxPacket* packet, bool drop = false);
   ~CDVDMsgDemuxerPacket() override;
+
+  // one message per packet, recycle them together with the packets
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   DemuxPacket* GetPacket() { return m_packet; }
   unsigned int GetPacketSize();
   bool GetPacketDrop() { return m_drop; }
@@ -65,6 +65,8 @@ void CProcessInfo::ResetVideoCodecInfo()
   m_videoIsHWDecoder = false;
   m_videoDecoderName = "unknown";
   m_videoDeintMethod = "unknown";
+  m_videoDecodeTime = 0.0;
+  m_videoFilterTime = 0.0;
   m_videoPixelFormat = "unknown";
   m_videoStereoMode.clear();
   m_videoWidth = 0;
@@ -132,6 +134,22 @@ std::string CProcessInfo::GetVideoDeintMethod()
   return m_videoDeintMethod;
 }
 
+void CProcessInfo::SetVideoPipelineTimes(double decodeMs, double filterMs)
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  m_videoDecodeTime = decodeMs;
+  m_videoFilterTime = filterMs;
+}
+
+void CProcessInfo::GetVideoPipelineTimes(double &decodeMs, double &filterMs)
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  decodeMs = m_videoDecodeTime;
+  filterMs = m_videoFilterTime;
+}
+
 void CProcessInfo::SetVideoPixelFormat(const std::string &pixFormat)
 {
   CSingleLock lock(m_videoCodecSection);
@@ -331,6 +349,7 @@ void CProcessInfo::ResetAudioCodecInfo()
     m_dataCache->SetAudioChannels(m_audioChannels);
     m_dataCache->SetAudioSampleRate(m_audioSampleRate);
     m_dataCache->SetAudioBitsPerSample(m_audioBitsPerSample);
+    m_dataCache->SetAudioLatency(0);
   }
 }
 
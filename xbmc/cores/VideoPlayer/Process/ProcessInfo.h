@@ -38,6 +38,8 @@ public:
   bool IsVideoHwDecoder();
   void SetVideoDeintMethod(const std::string &method);
   std::string GetVideoDeintMethod();
+  void SetVideoPipelineTimes(double decodeMs, double filterMs);
+  void GetVideoPipelineTimes(double &decodeMs, double &filterMs);
   void SetVideoPixelFormat(const std::string &pixFormat);
   std::string GetVideoPixelFormat();
   void SetVideoStereoMode(const std::string &mode);
@@ -120,6 +122,8 @@ protected:
   bool m_videoIsHWDecoder;
   std::string m_videoDecoderName;
   std::string m_videoDeintMethod;
+  double m_videoDecodeTime = 0.0;
+  double m_videoFilterTime = 0.0;
   std::string m_videoPixelFormat;
   std::string m_videoStereoMode;
   int m_videoWidth;
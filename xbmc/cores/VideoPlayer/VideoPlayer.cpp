@@ -23,6 +23,7 @@
 #include "DVDDemuxers/DVDDemuxVobsub.h"
 #include "DVDDemuxers/DVDFactoryDemuxer.h"
 #include "DVDDemuxers/DVDDemuxFFmpeg.h"
+#include "DVDDemuxers/DemuxPacketPool.h"
 
 #include "DVDFileInfo.h"
 
@@ -2442,6 +2443,9 @@ void CVideoPlayer::OnExit()
 
   m_messenger.End();
 
+  // demuxers and decoders are gone, don't keep their packet memory
+  CDemuxPacketPool::GetInstance().Trim();
+
   CFFmpegLog::ClearLogLevel();
   m_bStop = true;
 
@@ -3147,6 +3151,11 @@ void CVideoPlayer::GetGeneralInfo(std::string& strGeneralInfo)
         strBuf += StringUtils::Format(" %d msec", DVD_TIME_TO_MSEC(m_State.cache_delay));
     }
 
+    uint64_t poolRequests, poolHits;
+    CDemuxPacketPool::GetInstance().GetStats(poolRequests, poolHits);
+    if (poolRequests > 0)
+      strBuf += StringUtils::Format(" pool:%2.0f%%", 100.0 * poolHits / poolRequests);
+
     strGeneralInfo = StringUtils::Format("Player: a/v:% 6.3f, %s"
                                          , dDiff
                                          , strBuf.c_str());
@@ -945,6 +945,13 @@ std::string CVideoPlayerVideo::GetPlayerInfo()
   else
     s << ", pc:none";
 
+  double decodeTime, filterTime;
+  m_processInfo.GetVideoPipelineTimes(decodeTime, filterTime);
+  if (decodeTime > 0.0)
+    s << ", dec:" << std::fixed << std::setprecision(1) << decodeTime << "ms";
+  if (filterTime > 0.0)
+    s << ", flt:" << std::fixed << std::setprecision(1) << filterTime << "ms";
+
   return s.str();
 }
 
@@ -25,6 +25,7 @@ namespace
   const std::string SETTING_GAMES_ENABLEAUTOSAVE = "gamesgeneral.enableautosave";
   const std::string SETTING_GAMES_ENABLEREWIND = "gamesgeneral.enablerewind";
   const std::string SETTING_GAMES_REWINDTIME = "gamesgeneral.rewindtime";
+  const std::string SETTING_GAMES_LOWLATENCYAUDIO = "gamesgeneral.lowlatencyaudio";
 }
 
 CGameSettings::CGameSettings()
@@ -85,6 +86,11 @@ unsigned int CGameSettings::MaxRewindTimeSec()
   return static_cast<unsigned int>(std::max(rewindTimeSec, 0));
 }
 
+bool CGameSettings::LowLatencyAudio()
+{
+  return m_settings->GetBool(SETTING_GAMES_LOWLATENCYAUDIO);
+}
+
 void CGameSettings::OnSettingChanged(std::shared_ptr<const CSetting> setting)
 {
   if (setting == nullptr)
@@ -9,6 +9,7 @@
 #include "GUIBaseContainer.h"
 
 #include "FileItem.h"
+#include "FileItemListPager.h"
 #include "GUIInfoManager.h"
 #include "GUIListItemLayout.h"
 #include "GUIMessage.h"
@@ -101,7 +102,7 @@ void CGUIBaseContainer::Process(unsigned int currentTime, CDirtyRegionList &dirt
   GetCacheOffsets(cacheBefore, cacheAfter);
 
   // Free memory not used on screen
-  if ((int)m_items.size() > m_itemsPerPage + cacheBefore + cacheAfter)
+  if (m_virtualItems || (int)m_items.size() > m_itemsPerPage + cacheBefore + cacheAfter)
     FreeMemory(CorrectOffset(offset - cacheBefore, 0), CorrectOffset(offset + m_itemsPerPage + 1 + cacheAfter, 0));
 
   CPoint origin = CPoint(m_posX, m_posY) + m_renderOffset;
@@ -410,8 +411,13 @@ bool CGUIBaseContainer::OnMessage(CGUIMessage& message)
       { // bind our items
         Reset();
         CFileItemList *items = static_cast<CFileItemList*>(message.GetPointer());
-        for (int i = 0; i < items->Size(); i++)
-          m_items.push_back(items->Get(i));
+        if (items->IsVirtual())
+          BindVirtualItems(*items);
+        else
+        {
+          for (int i = 0; i < items->Size(); i++)
+            m_items.push_back(items->Get(i));
+        }
         UpdateLayout(true); // true to refresh all items
         UpdateScrollByLetter();
         SelectItem(message.GetParam1());
@@ -1010,6 +1016,15 @@ void CGUIBaseContainer::UpdateScrollByLetter()
 {
   m_letterOffsets.clear();
 
+  // the source of a virtual list knows the letters without loading all items
+  if (m_virtualItems)
+  {
+    m_virtualItems->GetLetterOffsets(m_letterOffsets);
+    for (auto& offset : m_letterOffsets)
+      offset.first += m_virtualFront;
+    return;
+  }
+
   // for scrolling by letter we have an offset table into our vector.
   std::string currentMatch;
   for (unsigned int i = 0; i < m_items.size(); i++)
@@ -1141,6 +1156,10 @@ void CGUIBaseContainer::Reset()
 {
   m_wasReset = true;
   m_items.clear();
+  m_virtualItems.reset();
+  m_virtualFront = 0;
+  m_virtualPlaceholder.reset();
+  m_virtualLoaded.clear();
   m_lastItem.reset();
   ResetAutoScrolling();
 }
@@ -1187,6 +1206,12 @@ void CGUIBaseContainer::SetRenderOffset(const CPoint &offset)
 
 void CGUIBaseContainer::FreeMemory(int keepStart, int keepEnd)
 {
+  if (m_virtualItems)
+  {
+    LoadVirtualItems(keepStart, keepEnd);
+    return;
+  }
+
   if (keepStart < keepEnd)
   { // remove before keepStart and after keepEnd
     for (int i = 0; i < keepStart && i < (int)m_items.size(); ++i)
@@ -1201,6 +1226,89 @@ void CGUIBaseContainer::FreeMemory(int keepStart, int keepEnd)
   }
 }
 
+void CGUIBaseContainer::BindVirtualItems(const CFileItemList &items)
+{
+  m_virtualItems = items.GetPager();
+  m_virtualFront = static_cast<int>(items.GetList().size());
+  m_virtualPlaceholder = std::make_shared<CFileItem>();
+
+  m_items.reserve(items.Size());
+  for (const auto& item : items.GetList())
+    m_items.push_back(item);
+  m_items.resize(items.Size(), m_virtualPlaceholder);
+}
+
+void CGUIBaseContainer::LoadVirtualItems(int keepStart, int keepEnd)
+{
+  const int size = static_cast<int>(m_items.size());
+  if (size == 0)
+    return;
+
+  auto inside = [keepStart, keepEnd](int itemNo)
+  {
+    return keepStart < keepEnd ? itemNo >= keepStart && itemNo <= keepEnd : itemNo >= keepStart || itemNo <= keepEnd;
+  };
+
+  // load the cached items and the same number of items before and after them, so that
+  // scrolling doesn't hit unloaded items. Wrapped ranges wrap around the end of the list.
+  int first = keepStart;
+  int last = keepEnd;
+  if (keepStart > keepEnd)
+    last += size;
+  const int range = last - first + 1;
+  first -= range;
+  last += range;
+  if (keepStart <= keepEnd)
+  {
+    first = std::max(first, 0);
+    last = std::min(last, size - 1);
+  }
+
+  std::set<int> loaded;
+  auto load = [this, &loaded](int itemNo)
+  {
+    if (itemNo < m_virtualFront)
+      return;
+    loaded.insert(itemNo);
+    if (m_items[itemNo] == m_virtualPlaceholder)
+    {
+      // pages are loaded on jobs, the placeholder is shown until then
+      CFileItemPtr item = m_virtualItems->GetIfLoaded(itemNo - m_virtualFront);
+      if (item)
+      {
+        m_items[itemNo] = item;
+        MarkDirtyRegion();
+      }
+    }
+  };
+
+  for (int position = first; position <= last; position++)
+    load(((position % size) + size) % size);
+
+  // the selected item is used by the info labels, even if it scrolled off
+  int selected = GetSelectedItem();
+  if (selected >= 0 && selected < size)
+    load(selected);
+
+  for (int itemNo : m_virtualLoaded)
+  {
+    if (loaded.find(itemNo) == loaded.end())
+    {
+      m_items[itemNo]->FreeMemory();
+      m_items[itemNo] = m_virtualPlaceholder;
+    }
+    else if (!inside(itemNo))
+      m_items[itemNo]->FreeMemory();
+  }
+  m_virtualLoaded.swap(loaded);
+
+  for (int itemNo = 0; itemNo < m_virtualFront && itemNo < size; itemNo++)
+  {
+    if (!inside(itemNo))
+      m_items[itemNo]->FreeMemory();
+  }
+}
+
 bool CGUIBaseContainer::InsideLayout(const CGUIListItemLayout *layout, const CPoint &point) const
 {
   if (!layout) return false;
@@ -18,6 +18,8 @@
 #include "utils/Stopwatch.h"
 
 #include <list>
+#include <memory>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -26,6 +28,8 @@
  \brief
  */
 
+class CFileItemList;
+class CFileItemListPager;
 class IListProvider;
 class TiXmlNode;
 class CGUIListItemLayout;
@@ -127,6 +131,8 @@ protected:
   int ScrollCorrectionRange() const;
   inline float Size() const;
   void FreeMemory(int keepStart, int keepEnd);
+  void BindVirtualItems(const CFileItemList &items);
+  void LoadVirtualItems(int keepStart, int keepEnd);
   void GetCurrentLayouts();
   CGUIListItemLayout *GetFocusedLayout() const;
 
@@ -160,6 +166,15 @@ protected:
 
   IListProvider *m_listProvider;
 
+  /*! \brief Items of a virtual list are loaded around the visible ones only, the others
+   share a placeholder item. Items in front of the virtual ones are always loaded. Pages of
+   items are loaded on jobs, not on the render thread.
+   */
+  std::shared_ptr<CFileItemListPager> m_virtualItems;
+  int m_virtualFront = 0;
+  CGUIListItemPtr m_virtualPlaceholder;
+  std::set<int> m_virtualLoaded;
+
   bool m_wasReset;  // true if we've received a Reset message until we've rendered once.  Allows
                     // us to make sure we don't tell the infomanager that we've been moving when
                     // the "movement" was simply due to the list being repopulated (thus cursor position
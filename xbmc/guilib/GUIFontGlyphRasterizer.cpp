@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIFontGlyphRasterizer.h"
+
+#include "GUIComponent.h"
+#include "GUIFontTTF.h"
+#include "GUIMessage.h"
+#include "GUIWindowManager.h"
+#include "ServiceBroker.h"
+#include "threads/SingleLock.h"
+
+#include <algorithm>
+
+namespace
+{
+// let the GUI pick up rendered glyphs at least this often while the queue is busy
+const unsigned int GLYPHS_PER_NOTIFICATION = 64;
+
+void NotifyGlyphsRendered()
+{
+  if (CServiceBroker::GetGUI())
+  {
+    CGUIMessage msg(GUI_MSG_GLYPHS_RENDERED, 0, 0);
+    CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
+  }
+}
+}
+
+CGUIFontGlyphRasterizer::CGUIFontGlyphRasterizer()
+  : CThread("GUIFontGlyphRasterizer")
+{
+}
+
+CGUIFontGlyphRasterizer::~CGUIFontGlyphRasterizer()
+{
+  StopThread();
+}
+
+void CGUIFontGlyphRasterizer::Request(CGUIFontTTFBase* font, uint32_t letterAndStyle, bool prewarm)
+{
+  CSingleLock lock(m_queueSection);
+  if (prewarm)
+    m_prewarmRequests.push_back({font, letterAndStyle});
+  else
+    m_requests.push_back({font, letterAndStyle});
+
+  if (!IsRunning())
+    Create();
+  m_queueEvent.Set();
+}
+
+void CGUIFontGlyphRasterizer::Cancel(CGUIFontTTFBase* font)
+{
+  auto isFont = [font](const GlyphRequest& request) { return request.font == font; };
+
+  CSingleLock lock(m_queueSection);
+  m_requests.erase(std::remove_if(m_requests.begin(), m_requests.end(), isFont), m_requests.end());
+  m_prewarmRequests.erase(std::remove_if(m_prewarmRequests.begin(), m_prewarmRequests.end(), isFont), m_prewarmRequests.end());
+
+  // the worker takes this lock before it releases the queue, so it can't start
+  // on another glyph of the font once we got it
+  CSingleLock processLock(m_processSection);
+}
+
+void CGUIFontGlyphRasterizer::Process()
+{
+  unsigned int rendered = 0;
+  while (!m_bStop)
+  {
+    CSingleLock lock(m_queueSection);
+    if (m_requests.empty() && m_prewarmRequests.empty())
+    {
+      lock.Leave();
+      if (rendered > 0)
+      {
+        NotifyGlyphsRendered();
+        rendered = 0;
+      }
+      AbortableWait(m_queueEvent);
+      continue;
+    }
+
+    std::deque<GlyphRequest>& queue = m_requests.empty() ? m_prewarmRequests : m_requests;
+    GlyphRequest request = queue.front();
+    queue.pop_front();
+
+    CSingleLock processLock(m_processSection);
+    lock.Leave();
+
+    request.font->RasterizeGlyph(request.letterAndStyle);
+    processLock.Leave();
+
+    if (++rendered >= GLYPHS_PER_NOTIFICATION)
+    {
+      NotifyGlyphsRendered();
+      rendered = 0;
+    }
+  }
+}
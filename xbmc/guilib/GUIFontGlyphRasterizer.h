@@ -0,0 +1,57 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <stdint.h>
+
+class CGUIFontTTFBase;
+
+/*!
+ \ingroup textures
+ \brief Renders glyph bitmaps with FreeType on a worker thread.
+
+ Fonts request the bitmaps of characters they don't have yet and copy them to
+ their texture at the next Begin(), so rendering a frame never waits for
+ FreeType. Requests to prewarm a font are only served while no font waits for
+ a glyph. GUI_MSG_GLYPHS_RENDERED is sent whenever bitmaps are ready, so that
+ the GUI is rendered again even if nothing else changed.
+ */
+class CGUIFontGlyphRasterizer : private CThread
+{
+public:
+  CGUIFontGlyphRasterizer();
+  ~CGUIFontGlyphRasterizer() override;
+
+  void Request(CGUIFontTTFBase* font, uint32_t letterAndStyle, bool prewarm = false);
+
+  /*! \brief Drop all requests of a font and wait until the worker no longer uses it
+   */
+  void Cancel(CGUIFontTTFBase* font);
+
+protected:
+  void Process() override;
+
+private:
+  struct GlyphRequest
+  {
+    CGUIFontTTFBase* font;
+    uint32_t letterAndStyle;
+  };
+
+  CCriticalSection m_queueSection;
+  CCriticalSection m_processSection; ///< held while a glyph is rendered
+  CEvent m_queueEvent;
+  std::deque<GlyphRequest> m_requests;
+  std::deque<GlyphRequest> m_prewarmRequests;
+};
@@ -15,10 +15,15 @@
 #include "addons/FontResource.h"
 #include "GUIFontTTF.h"
 #include "GUIFont.h"
+#include "GUIMessage.h"
+#include "GUITextLayoutCache.h"
+#include "LocalizeStrings.h"
 #include "utils/XMLUtils.h"
 #include "GUIControlFactory.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingDefinitions.h"
 #include "utils/log.h"
@@ -32,6 +37,8 @@
 #include "filesystem/SpecialProtocol.h"
 #endif
 
+#include <algorithm>
+
 using namespace ADDON;
 
 GUIFontManager::GUIFontManager(void)
@@ -153,6 +160,7 @@ CGUIFont* GUIFontManager::LoadTTF(const std::string& strFontName, const std::str
     }
 
     m_vecFontFiles.push_back(pFontFile);
+    pFontFile->Prewarm(m_prewarmCharacters);
   }
 
   // font file is loaded, create our CGUIFont
@@ -175,6 +183,12 @@ CGUIFont* GUIFontManager::LoadTTF(const std::string& strFontName, const std::str
 
 bool GUIFontManager::OnMessage(CGUIMessage &message)
 {
+  if (message.GetMessage() == GUI_MSG_GLYPHS_RENDERED)
+  { // fonts pick up the glyphs on their next render, make sure there is one
+    CServiceBroker::GetGUI()->GetWindowManager().MarkDirty();
+    return true;
+  }
+
   if (message.GetMessage() != GUI_MSG_NOTIFY_ALL)
     return false;
 
@@ -210,6 +224,9 @@ void GUIFontManager::ReloadTTFFonts(void)
   if (!m_vecFonts.size())
     return;   // we haven't even loaded fonts in yet
 
+  // the metrics of the fonts change
+  CGUITextLayoutCache::GetInstance().Clear();
+
   for (unsigned int i = 0; i < m_vecFonts.size(); i++)
   {
     CGUIFont* font = m_vecFonts[i];
@@ -236,6 +253,7 @@ void GUIFontManager::ReloadTTFFonts(void)
       }
 
       m_vecFontFiles.push_back(pFontFile);
+      pFontFile->Prewarm(m_prewarmCharacters);
     }
 
     font->SetFont(pFontFile);
@@ -248,6 +266,7 @@ void GUIFontManager::Unload(const std::string& strFontName)
   {
     if (StringUtils::EqualsNoCase((*iFont)->GetFontName(), strFontName))
     {
+      CGUITextLayoutCache::GetInstance().Clear();
       delete (*iFont);
       m_vecFonts.erase(iFont);
       return;
@@ -329,6 +348,8 @@ CGUIFont* GUIFontManager::GetDefaultFont(bool border)
 
 void GUIFontManager::Clear()
 {
+  CGUITextLayoutCache::GetInstance().Clear();
+
   for (int i = 0; i < (int)m_vecFonts.size(); ++i)
   {
     CGUIFont* pFont = m_vecFonts[i];
@@ -342,6 +363,8 @@ void GUIFontManager::Clear()
 
 void GUIFontManager::LoadFonts(const std::string& fontSet)
 {
+  UpdatePrewarmCharacters();
+
   // Get the file to load fonts from:
   const std::string strPath = g_SkinInfo->GetSkinPath("Font.xml", &m_skinResolution);
   CLog::Log(LOGINFO, "Loading fonts from %s", strPath.c_str());
@@ -392,6 +415,22 @@ void GUIFontManager::LoadFonts(const std::string& fontSet)
     CLog::Log(LOGERROR, "file '%s' doesnt have a valid <fontset>", strPath.c_str());
 }
 
+void GUIFontManager::UpdatePrewarmCharacters()
+{
+  // printable ASCII and the characters used most in the GUI language
+  m_prewarmCharacters.clear();
+  const int count = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiFontPrewarmCharacters;
+  if (count <= 0)
+    return;
+
+  for (wchar_t letter = L' '; letter <= L'~'; letter++)
+    m_prewarmCharacters += letter;
+  m_prewarmCharacters += g_localizeStrings.GetFrequentCharacters(count);
+
+  std::sort(m_prewarmCharacters.begin(), m_prewarmCharacters.end());
+  m_prewarmCharacters.erase(std::unique(m_prewarmCharacters.begin(), m_prewarmCharacters.end()), m_prewarmCharacters.end());
+}
+
 void GUIFontManager::LoadFonts(const TiXmlNode* fontNode)
 {
   while (fontNode)
@@ -13,11 +13,13 @@
 \brief
 */
 
+#include "GUIFontGlyphRasterizer.h"
 #include "IMsgTargetCallback.h"
 #include "utils/Color.h"
 #include "utils/GlobalsHandling.h"
 #include "windowing/GraphicContext.h"
 
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -66,12 +68,15 @@ public:
   void Clear();
   void FreeFontFile(CGUIFontTTFBase *pFont);
 
+  CGUIFontGlyphRasterizer& GetGlyphRasterizer() { return m_glyphRasterizer; }
+
   static void SettingOptionsFontsFiller(std::shared_ptr<const CSetting> setting, std::vector<StringSettingOption> &list, std::string &current, void *data);
 
 protected:
   void ReloadTTFFonts();
   static void RescaleFontSizeAndAspect(float *size, float *aspect, const RESOLUTION_INFO &sourceRes, bool preserveAspect);
   void LoadFonts(const TiXmlNode* fontNode);
+  void UpdatePrewarmCharacters();
   CGUIFontTTFBase* GetFontFile(const std::string& strFontFile);
   static void GetStyle(const TiXmlNode *fontNode, int &iStyle);
 
@@ -80,6 +85,8 @@ protected:
   std::vector<OrigFontInfo> m_vecFontInfo;
   RESOLUTION_INFO m_skinResolution;
   bool m_canReload;
+  std::wstring m_prewarmCharacters;
+  CGUIFontGlyphRasterizer m_glyphRasterizer;
 };
 
 /*!
@@ -8,7 +8,10 @@
 
 #include "GUIFont.h"
 #include "GUIFontTTF.h"
+#include "GUIFontGlyphRasterizer.h"
 #include "GUIFontManager.h"
+#include "GUIComponent.h"
+#include "GUIWindowManager.h"
 #include "Texture.h"
 #include "windowing/GraphicContext.h"
 #include "ServiceBroker.h"
@@ -19,8 +22,11 @@
 #include "windowing/WinSystem.h"
 #include "URL.h"
 #include "filesystem/File.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 
+#include <algorithm>
+#include <iterator>
 #include <math.h>
 #include <memory>
 #include <queue>
@@ -38,10 +44,14 @@
 #include FT_STROKER_H
 
 #define CHARS_PER_TEXTURE_LINE 20 // number of characters to cache per texture line
-#define CHAR_CHUNK    64      // 64 chars allocated at a time (1024 bytes)
 #define GLYPH_STRENGTH_BOLD 24
 #define GLYPH_STRENGTH_LIGHT -48
 
+// Character::line of glyphs without a bitmap in the texture
+static const unsigned short NO_TEXTURE_LINE = 0xffff;
+// prewarming doesn't grow the texture beyond this height, nor drop glyphs from it
+static const unsigned int PREWARM_MAX_TEXTURE_HEIGHT = 1024;
+
 
 class CFreeTypeLibrary
 {
@@ -94,14 +104,7 @@ public:
       return NULL;
 #endif // ! TARGET_WINDOWS
 
-    unsigned int ydpi = 72; // 72 points to the inch is the freetype default
-    unsigned int xdpi = (unsigned int)MathUtils::round_int(ydpi * aspect);
-
-    // we set our screen res currently to 96dpi in both directions (windows default)
-    // we cache our characters (for rendering speed) so it's probably
-    // not a good idea to allow free scaling of fonts - rather, just
-    // scaling to pixel ratio on screen perhaps?
-    if (FT_Set_Char_Size( face, 0, (int)(size*64 + 0.5f), xdpi, ydpi ))
+    if (!SetCharSize(face, size, aspect))
     {
       FT_Done_Face(face);
       return NULL;
@@ -110,6 +113,36 @@ public:
     return face;
   };
 
+  /*! \brief Open another face of a font opened with GetFont(), so it can be used on another thread
+   \param memoryBuf the buffer filled by GetFont(), if any
+   */
+  FT_Face GetFontCopy(const std::string &filename, float size, float aspect, const XUTILS::auto_buffer& memoryBuf)
+  {
+    if (!m_library)
+      return NULL;
+
+    FT_Face face;
+    if (memoryBuf.size() > 0)
+    {
+      if (FT_New_Memory_Face(m_library, (const FT_Byte*)memoryBuf.get(), memoryBuf.size(), 0, &face) != 0)
+        return NULL;
+    }
+    else
+    {
+      CURL realFile(CSpecialProtocol::TranslatePath(filename));
+      if (FT_New_Face(m_library, realFile.GetFileName().c_str(), 0, &face))
+        return NULL;
+    }
+
+    if (!SetCharSize(face, size, aspect))
+    {
+      FT_Done_Face(face);
+      return NULL;
+    }
+
+    return face;
+  }
+
   FT_Stroker GetStroker()
   {
     if (!m_library)
@@ -135,6 +168,18 @@ public:
   }
 
 private:
+  static bool SetCharSize(FT_Face face, float size, float aspect)
+  {
+    unsigned int ydpi = 72; // 72 points to the inch is the freetype default
+    unsigned int xdpi = (unsigned int)MathUtils::round_int(ydpi * aspect);
+
+    // we set our screen res currently to 96dpi in both directions (windows default)
+    // we cache our characters (for rendering speed) so it's probably
+    // not a good idea to allow free scaling of fonts - rather, just
+    // scaling to pixel ratio on screen perhaps?
+    return FT_Set_Char_Size( face, 0, (int)(size*64 + 0.5f), xdpi, ydpi ) == 0;
+  }
+
   FT_Library   m_library;
 };
 
@@ -144,21 +189,21 @@ XBMC_GLOBAL_REF(CFreeTypeLibrary, g_freeTypeLibrary); // our freetype library
 CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache(*this), m_dynamicCache(*this)
 {
   m_texture = NULL;
-  m_char = NULL;
-  m_maxChars = 0;
   m_nestedBeginCount = 0;
 
   m_vertex.reserve(4*1024);
 
   m_face = NULL;
+  m_rasterFace = NULL;
   m_stroker = NULL;
+  m_borderStrength = 0;
   memset(m_charquick, 0, sizeof(m_charquick));
   m_strFileName = strFileName;
   m_referenceCount = 0;
   m_originX = m_originY = 0.0f;
   m_cellBaseLine = m_cellHeight = 0;
-  m_numChars = 0;
-  m_posX = m_posY = 0;
+  m_renderCount = 0;
+  m_fillLine = 0;
   m_textureHeight = m_textureWidth = 0;
   m_textureScaleX = m_textureScaleY = 0.0;
   m_ellipsesWidth = m_height = 0.0f;
@@ -187,40 +232,26 @@ void CGUIFontTTFBase::RemoveReference()
 }
 
 
-void CGUIFontTTFBase::ClearCharacterCache()
-{
-  delete(m_texture);
-
-  DeleteHardwareTexture();
-
-  m_texture = NULL;
-  delete[] m_char;
-  m_char = new Character[CHAR_CHUNK];
-  memset(m_charquick, 0, sizeof(m_charquick));
-  m_numChars = 0;
-  m_maxChars = CHAR_CHUNK;
-  // set the posX and posY so that our texture will be created on first character write.
-  m_posX = m_textureWidth;
-  m_posY = -(int)GetTextureLineHeight();
-  m_textureHeight = 0;
-}
-
 void CGUIFontTTFBase::Clear()
 {
+  // the rasterizer must be done with our face and stroker before they are released
+  g_fontManager.GetGlyphRasterizer().Cancel(this);
+  m_rasterized.clear();
+
   delete(m_texture);
   m_texture = NULL;
-  delete[] m_char;
+  m_char.clear();
   memset(m_charquick, 0, sizeof(m_charquick));
-  m_char = NULL;
-  m_maxChars = 0;
-  m_numChars = 0;
-  m_posX = 0;
-  m_posY = 0;
+  m_textureLines.clear();
+  m_fillLine = 0;
   m_nestedBeginCount = 0;
 
   if (m_face)
     g_freeTypeLibrary.ReleaseFont(m_face);
   m_face = NULL;
+  if (m_rasterFace)
+    g_freeTypeLibrary.ReleaseFont(m_rasterFace);
+  m_rasterFace = NULL;
   if (m_stroker)
     g_freeTypeLibrary.ReleaseStroker(m_stroker);
   m_stroker = NULL;
@@ -241,6 +272,15 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
   if (!m_face)
     return false;
 
+  // glyph bitmaps are rendered on another thread, which needs a face of its own
+  m_rasterFace = g_freeTypeLibrary.GetFontCopy(strFilename, height, aspect, m_fontFileInMemory);
+  if (!m_rasterFace)
+  {
+    g_freeTypeLibrary.ReleaseFont(m_face);
+    m_face = NULL;
+    return false;
+  }
+
   /*
    the values used are described below
 
@@ -277,7 +317,10 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 
     m_stroker = g_freeTypeLibrary.GetStroker();
     if (m_stroker)
+    {
       FT_Stroker_Set(m_stroker, strength, FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+      m_borderStrength = strength;
+    }
   }
 
   // scale to pixel sizing, rounding so that maximal extent is obtained
@@ -292,11 +335,9 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 
   delete(m_texture);
   m_texture = NULL;
-  delete[] m_char;
-  m_char = NULL;
-
-  m_maxChars = 0;
-  m_numChars = 0;
+  m_char.clear();
+  m_textureLines.clear();
+  m_fillLine = 0;
 
   m_strFilename = strFilename;
 
@@ -309,10 +350,6 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
     m_textureWidth = m_renderSystem->GetMaxTextureSize();
   m_textureScaleX = 1.0f / m_textureWidth;
 
-  // set the posX and posY so that our texture will be created on first character write.
-  m_posX = m_textureWidth;
-  m_posY = -(int)GetTextureLineHeight();
-
   // cache the ellipses width
   Character *ellipse = GetCharacter(L'.');
   if (ellipse) m_ellipsesWidth = ellipse->advance;
@@ -320,12 +357,31 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
   return true;
 }
 
+void CGUIFontTTFBase::Prewarm(const std::wstring& characters)
+{
+  for (wchar_t letter : characters)
+  {
+    const character_t letterAndStyle = letter & 0xffff;
+    auto it = std::lower_bound(m_char.begin(), m_char.end(), letterAndStyle,
+                               [](const Character& ch, character_t value) { return ch.letterAndStyle < value; });
+    if (it == m_char.end() || it->letterAndStyle != letterAndStyle)
+      g_fontManager.GetGlyphRasterizer().Request(this, letterAndStyle, true);
+  }
+}
+
 void CGUIFontTTFBase::Begin()
 {
-  if (m_nestedBeginCount == 0 && m_texture != NULL && FirstBegin())
+  if (m_nestedBeginCount == 0)
   {
-    m_vertexTrans.clear();
-    m_vertex.clear();
+    // glyphs can't be added to the texture while it is in use
+    ProcessRasterizedGlyphs();
+    m_renderCount++;
+
+    if (m_texture != NULL && FirstBegin())
+    {
+      m_vertexTrans.clear();
+      m_vertex.clear();
+    }
   }
   // Keep track of the nested begin/end calls.
   m_nestedBeginCount++;
@@ -439,8 +495,7 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
     float cursorX = 0; // current position along the line
 
     // Collect all the Character info in a first pass, in case any of them
-    // are not currently cached and cause the texture to be enlarged, which
-    // would invalidate the texture coordinates.
+    // are not currently cached and adding them moves the others in memory.
     std::queue<Character> characters;
     if (alignment & XBFONT_TRUNCATED)
       GetCharacter(L'.');
@@ -605,193 +660,340 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   if (letter == L'\r')
     return NULL;
 
+  Character *ch = NULL;
+
   // quick access to ascii chars
   if (letter < 255)
   {
-    character_t ch = (style << 8) | letter;
-    if (ch < LOOKUPTABLE_SIZE && m_charquick[ch])
-      return m_charquick[ch];
+    character_t quick = (style << 8) | letter;
+    if (quick < LOOKUPTABLE_SIZE)
+      ch = m_charquick[quick];
   }
 
-  // letters are stored based on style and letter
-  character_t ch = (style << 16) | letter;
-
-  int low = 0;
-  int high = m_numChars - 1;
-  while (low <= high)
+  if (!ch)
   {
-    int mid = (low + high) >> 1;
-    if (ch > m_char[mid].letterAndStyle)
-      low = mid + 1;
-    else if (ch < m_char[mid].letterAndStyle)
-      high = mid - 1;
-    else
-      return &m_char[mid];
-  }
-  // if we get to here, then low is where we should insert the new character
-
-  // increase the size of the buffer if we need it
-  if (m_numChars >= m_maxChars)
-  { // need to increase the size of the buffer
-    Character *newTable = new Character[m_maxChars + CHAR_CHUNK];
-    if (m_char)
+    // letters are stored based on style and letter
+    character_t letterAndStyle = (style << 16) | letter;
+    auto it = std::lower_bound(m_char.begin(), m_char.end(), letterAndStyle,
+                               [](const Character& c, character_t value) { return c.letterAndStyle < value; });
+    if (it == m_char.end() || it->letterAndStyle != letterAndStyle)
     {
-      memcpy(newTable, m_char, low * sizeof(Character));
-      memcpy(newTable + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
-      delete[] m_char;
-    }
-    m_char = newTable;
-    m_maxChars += CHAR_CHUNK;
+      // only the metrics are needed for layout, the bitmap is rendered in the background
+      Character newChar;
+      if (!LoadCharacterMetrics(letter, style, &newChar))
+        return NULL;
 
-  }
-  else
-  { // just move the data along as necessary
-    memmove(m_char + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
-  }
-  // render the character to our texture
-  // must End() as we can't render text to our texture during a Begin(), End() block
-  unsigned int nestedBeginCount = m_nestedBeginCount;
-  m_nestedBeginCount = 1;
-  if (nestedBeginCount) End();
-  if (!CacheCharacter(letter, style, m_char + low))
-  { // unable to cache character - try clearing them all out and starting over
-    CLog::Log(LOGDEBUG, "%s: Unable to cache character.  Clearing character cache of %i characters", __FUNCTION__, m_numChars);
-    ClearCharacterCache();
-    low = 0;
-    if (!CacheCharacter(letter, style, m_char + low))
-    {
-      CLog::Log(LOGERROR, "%s: Unable to cache character (out of memory?)", __FUNCTION__);
-      if (nestedBeginCount) Begin();
-      m_nestedBeginCount = nestedBeginCount;
-      return NULL;
+      it = m_char.insert(it, newChar);
+      UpdateQuickLookup();
+      if (it->state == GLYPH_PENDING)
+        RequestGlyph(&*it);
+      return &*it;
     }
+    ch = &*it;
   }
-  if (nestedBeginCount) Begin();
-  m_nestedBeginCount = nestedBeginCount;
 
-  // fixup quick access
+  if (ch->state == GLYPH_EVICTED)
+    RequestGlyph(ch);
+  else if (ch->line != NO_TEXTURE_LINE)
+    m_textureLines[ch->line].lastUsed = m_renderCount;
+
+  return ch;
+}
+
+void CGUIFontTTFBase::UpdateQuickLookup()
+{
   memset(m_charquick, 0, sizeof(m_charquick));
-  for(int i=0;i<m_numChars;i++)
+  for (auto& ch : m_char)
   {
-    if ((m_char[i].letterAndStyle & 0xffff) < 255)
+    if ((ch.letterAndStyle & 0xffff) < 255)
     {
-      character_t ch = ((m_char[i].letterAndStyle & 0xffff0000) >> 8) | (m_char[i].letterAndStyle & 0xff);
-      m_charquick[ch] = m_char+i;
+      character_t quick = ((ch.letterAndStyle & 0xffff0000) >> 8) | (ch.letterAndStyle & 0xff);
+      m_charquick[quick] = &ch;
     }
   }
-
-  return m_char + low;
 }
 
-bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
+bool CGUIFontTTFBase::LoadGlyph(FT_Face face, wchar_t letter, uint32_t style)
 {
-  int glyph_index = FT_Get_Char_Index( m_face, letter );
+  int glyph_index = FT_Get_Char_Index( face, letter );
 
-  FT_Glyph glyph = NULL;
-  if (FT_Load_Glyph( m_face, glyph_index, FT_LOAD_TARGET_LIGHT ))
-  {
-    CLog::Log(LOGDEBUG, "%s Failed to load glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
+  if (FT_Load_Glyph( face, glyph_index, FT_LOAD_TARGET_LIGHT ))
     return false;
-  }
+
   // make bold if applicable
   if (style & FONT_STYLE_BOLD)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_BOLD);
+    SetGlyphStrength(face, face->glyph, GLYPH_STRENGTH_BOLD);
   // and italics if applicable
   if (style & FONT_STYLE_ITALICS)
-    ObliqueGlyph(m_face->glyph);
+    ObliqueGlyph(face->glyph);
   // and light if applicable
   if (style & FONT_STYLE_LIGHT)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_LIGHT);
-  // grab the glyph
-  if (FT_Get_Glyph(m_face->glyph, &glyph))
+    SetGlyphStrength(face, face->glyph, GLYPH_STRENGTH_LIGHT);
+
+  return true;
+}
+
+bool CGUIFontTTFBase::LoadCharacterMetrics(wchar_t letter, uint32_t style, Character *ch)
+{
+  if (!LoadGlyph(m_face, letter, style))
   {
-    CLog::Log(LOGDEBUG, "%s Failed to get glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
+    CLog::Log(LOGDEBUG, "%s Failed to load glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
     return false;
   }
-  if (m_stroker)
-    FT_Glyph_StrokeBorder(&glyph, m_stroker, 0, 1);
-  // render the glyph
-  if (FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, NULL, 1))
+
+  FT_GlyphSlot slot = m_face->glyph;
+  int left = 0;
+  int top = 0;
+  unsigned int width = 0;
+  unsigned int rows = 0;
+  if (slot->format == FT_GLYPH_FORMAT_BITMAP)
   {
-    CLog::Log(LOGDEBUG, "%s Failed to render glyph %x to a bitmap", __FUNCTION__, static_cast<uint32_t>(letter));
-    return false;
+    left = slot->bitmap_left;
+    top = slot->bitmap_top;
+    width = slot->bitmap.width;
+    rows = slot->bitmap.rows;
   }
-  FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
-  FT_Bitmap bitmap = bitGlyph->bitmap;
-  bool isEmptyGlyph = (bitmap.width == 0 || bitmap.rows == 0);
-
-  if (!isEmptyGlyph)
+  else if (slot->format == FT_GLYPH_FORMAT_OUTLINE && slot->outline.n_points > 0)
   {
-    if (bitGlyph->left < 0)
-      m_posX += -bitGlyph->left;
-
-    // check we have enough room for the character.
-    // cast-fest is here to avoid warnings due to freeetype version differences (signedness of width).
-    if (static_cast<int>(m_posX + bitGlyph->left + bitmap.width) > static_cast<int>(m_textureWidth))
-    { // no space - gotta drop to the next line (which means creating a new texture and copying it across)
-      m_posX = 0;
-      m_posY += GetTextureLineHeight();
-      if (bitGlyph->left < 0)
-        m_posX += -bitGlyph->left;
+    // until the bitmap is rendered, its extent is estimated from the outline,
+    // which is what FreeType does for the bitmap (grown by the border, if any)
+    FT_BBox box;
+    FT_Outline_Get_CBox(&slot->outline, &box);
+    const FT_Pos border = m_stroker ? m_borderStrength : 0;
+    const FT_Pos xMin = (box.xMin - border) & ~63;
+    const FT_Pos yMin = (box.yMin - border) & ~63;
+    const FT_Pos xMax = (box.xMax + border + 63) & ~63;
+    const FT_Pos yMax = (box.yMax + border + 63) & ~63;
+    left = xMin >> 6;
+    top = yMax >> 6;
+    width = (xMax - xMin) >> 6;
+    rows = (yMax - yMin) >> 6;
+  }
 
-      if(m_posY + GetTextureLineHeight() >= m_textureHeight)
-      {
-        // create the new larger texture
-        unsigned int newHeight = m_posY + GetTextureLineHeight();
-        // check for max height
-        if (newHeight > m_renderSystem->GetMaxTextureSize())
-        {
-          CLog::Log(LOGDEBUG, "%s: New cache texture is too large (%u > %u pixels long)", __FUNCTION__, newHeight, m_renderSystem->GetMaxTextureSize());
-          FT_Done_Glyph(glyph);
-          return false;
-        }
+  ch->letterAndStyle = (style << 16) | letter;
+  ch->offsetX = (short)left;
+  ch->offsetY = (short)m_cellBaseLine - top;
+  ch->left = 0;
+  ch->top = 0;
+  ch->right = (float)width;
+  ch->bottom = (float)rows;
+  ch->advance = (float)MathUtils::round_int( (float)slot->advance.x / 64 );
+  ch->line = NO_TEXTURE_LINE;
+  ch->state = (width == 0 || rows == 0) ? GLYPH_READY : GLYPH_PENDING;
+  return true;
+}
 
-        CBaseTexture* newTexture = NULL;
-        newTexture = ReallocTexture(newHeight);
-        if(newTexture == NULL)
-        {
-          FT_Done_Glyph(glyph);
-          CLog::Log(LOGDEBUG, "%s: Failed to allocate new texture of height %u", __FUNCTION__, newHeight);
-          return false;
-        }
-        m_texture = newTexture;
-      }
-    }
+void CGUIFontTTFBase::RequestGlyph(Character *ch)
+{
+  ch->state = GLYPH_PENDING;
+  g_fontManager.GetGlyphRasterizer().Request(this, ch->letterAndStyle);
+}
 
-    if(m_texture == NULL)
+void CGUIFontTTFBase::RasterizeGlyph(character_t letterAndStyle)
+{
+  GlyphBitmap bitmap;
+  bitmap.letterAndStyle = letterAndStyle;
+  bitmap.left = bitmap.top = 0;
+  bitmap.width = bitmap.rows = 0;
+  bitmap.advance = 0;
+  bitmap.valid = false;
+
+  const wchar_t letter = (wchar_t)(letterAndStyle & 0xffff);
+  FT_Glyph glyph = NULL;
+  if (!LoadGlyph(m_rasterFace, letter, letterAndStyle >> 16))
+    CLog::Log(LOGDEBUG, "%s Failed to load glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
+  else if (FT_Get_Glyph(m_rasterFace->glyph, &glyph))
+    CLog::Log(LOGDEBUG, "%s Failed to get glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
+  else
+  {
+    bitmap.advance = (float)MathUtils::round_int( (float)m_rasterFace->glyph->advance.x / 64 );
+    if (m_stroker)
+      FT_Glyph_StrokeBorder(&glyph, m_stroker, 0, 1);
+    // render the glyph
+    if (FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, NULL, 1))
+      CLog::Log(LOGDEBUG, "%s Failed to render glyph %x to a bitmap", __FUNCTION__, static_cast<uint32_t>(letter));
+    else
     {
-      FT_Done_Glyph(glyph);
-      CLog::Log(LOGDEBUG, "%s: no texture to cache character to", __FUNCTION__);
-      return false;
+      FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
+      const FT_Bitmap& source = bitGlyph->bitmap;
+      bitmap.left = bitGlyph->left;
+      bitmap.top = bitGlyph->top;
+      bitmap.width = source.width;
+      bitmap.rows = source.rows;
+      bitmap.pixels.resize(bitmap.width * bitmap.rows);
+      for (unsigned int y = 0; y < bitmap.rows; y++)
+        memcpy(bitmap.pixels.data() + y * bitmap.width, source.buffer + y * source.pitch, bitmap.width);
+      bitmap.valid = true;
     }
   }
-  // set the character in our table
-  ch->letterAndStyle = (style << 16) | letter;
-  ch->offsetX = (short)bitGlyph->left;
-  ch->offsetY = (short)m_cellBaseLine - bitGlyph->top;
-  ch->left = isEmptyGlyph ? 0 : ((float)m_posX + ch->offsetX);
-  ch->top = isEmptyGlyph ? 0 : ((float)m_posY + ch->offsetY);
-  ch->right = ch->left + bitmap.width;
-  ch->bottom = ch->top + bitmap.rows;
-  ch->advance = (float)MathUtils::round_int( (float)m_face->glyph->advance.x / 64 );
+  if (glyph)
+    FT_Done_Glyph(glyph);
+
+  CSingleLock lock(m_rasterizedSection);
+  m_rasterized.push_back(std::move(bitmap));
+}
 
-  // we need only render if we actually have some pixels
-  if (!isEmptyGlyph)
+void CGUIFontTTFBase::ProcessRasterizedGlyphs()
+{
+  std::vector<GlyphBitmap> rasterized;
+  {
+    CSingleLock lock(m_rasterizedSection);
+    if (m_rasterized.empty())
+      return;
+    rasterized.swap(m_rasterized);
+  }
+
+  // glyphs waited for are placed first, they may drop other glyphs from a full texture
+  std::vector<const GlyphBitmap*> prewarmed;
+  std::vector<GlyphBitmap> deferred;
+  for (auto& bitmap : rasterized)
   {
-    // ensure our rect will stay inside the texture (it *should* but we need to be certain)
-    unsigned int x1 = std::max(m_posX + ch->offsetX, 0);
-    unsigned int y1 = std::max(m_posY + ch->offsetY, 0);
-    unsigned int x2 = std::min(x1 + bitmap.width, m_textureWidth);
-    unsigned int y2 = std::min(y1 + bitmap.rows, m_textureHeight);
-    CopyCharToTexture(bitGlyph, x1, y1, x2, y2);
+    auto it = std::lower_bound(m_char.begin(), m_char.end(), bitmap.letterAndStyle,
+                               [](const Character& ch, character_t value) { return ch.letterAndStyle < value; });
+    if (it == m_char.end() || it->letterAndStyle != bitmap.letterAndStyle)
+      prewarmed.push_back(&bitmap);
+    else if (it->state == GLYPH_PENDING && !PlaceGlyph(bitmap, &*it, false))
+      deferred.push_back(std::move(bitmap)); // all lines are in use, try again after the next pass
+  }
+
+  if (!deferred.empty())
+  {
+    CSingleLock lock(m_rasterizedSection);
+    m_rasterized.insert(m_rasterized.end(), std::make_move_iterator(deferred.begin()),
+                        std::make_move_iterator(deferred.end()));
+  }
+
+  // prewarmed glyphs nobody asked for yet only take free space
+  std::vector<Character> newChars;
+  for (const GlyphBitmap* bitmap : prewarmed)
+  {
+    if (!bitmap->valid)
+      continue;
+
+    Character ch;
+    ch.letterAndStyle = bitmap->letterAndStyle;
+    ch.advance = bitmap->advance;
+    if (!PlaceGlyph(*bitmap, &ch, true))
+      break;
+    newChars.push_back(ch);
+  }
 
-    m_posX += spacing_between_characters_in_texture + (unsigned short)std::max(ch->right - ch->left + ch->offsetX, ch->advance);
+  if (!newChars.empty())
+  {
+    std::sort(newChars.begin(), newChars.end(),
+              [](const Character& a, const Character& b) { return a.letterAndStyle < b.letterAndStyle; });
+    const size_t oldSize = m_char.size();
+    m_char.insert(m_char.end(), newChars.begin(), newChars.end());
+    std::inplace_merge(m_char.begin(), m_char.begin() + oldSize, m_char.end(),
+                       [](const Character& a, const Character& b) { return a.letterAndStyle < b.letterAndStyle; });
+    // a glyph may have been prewarmed more than once
+    m_char.erase(std::unique(m_char.begin(), m_char.end(),
+                             [](const Character& a, const Character& b) { return a.letterAndStyle == b.letterAndStyle; }),
+                 m_char.end());
+    UpdateQuickLookup();
+  }
+
+  // cached vertices don't have the new glyphs yet, or still point to dropped ones
+  m_staticCache.Flush();
+  m_dynamicCache.Flush();
+}
+
+bool CGUIFontTTFBase::PlaceGlyph(const GlyphBitmap& bitmap, Character *ch, bool prewarm)
+{
+  ch->offsetX = (short)bitmap.left;
+  ch->offsetY = (short)m_cellBaseLine - bitmap.top;
+  ch->left = ch->top = ch->right = ch->bottom = 0;
+  ch->line = NO_TEXTURE_LINE;
+  ch->state = GLYPH_READY;
+
+  // nothing to render
+  if (!bitmap.valid || bitmap.width == 0 || bitmap.rows == 0)
+    return true;
+
+  const unsigned int width = std::min(bitmap.width, m_textureWidth);
+  unsigned int line;
+  if (!GetTextureLine(width, prewarm, line))
+    return false;
+
+  // the glyph is placed at its position relative to the base line, as the
+  // line height is the height of the font's bounding box
+  TextureLine& textureLine = m_textureLines[line];
+  const unsigned int lineY = line * GetTextureLineHeight();
+  const unsigned int x1 = textureLine.posX;
+  const unsigned int y1 = lineY + std::min(static_cast<unsigned int>(std::max<int>(ch->offsetY, 0)), m_cellHeight);
+  const unsigned int x2 = x1 + width;
+  const unsigned int y2 = std::min(y1 + bitmap.rows, lineY + m_cellHeight);
+  CopyCharToTexture(bitmap.pixels.data(), bitmap.width, x1, y1, x2, y2);
+
+  ch->left = (float)x1;
+  ch->top = (float)y1;
+  ch->right = (float)x2;
+  ch->bottom = (float)y2;
+  ch->line = line;
+
+  textureLine.posX = x2 + spacing_between_characters_in_texture;
+  textureLine.lastUsed = m_renderCount;
+  return true;
+}
+
+bool CGUIFontTTFBase::GetTextureLine(unsigned int width, bool prewarm, unsigned int& line)
+{
+  if (m_fillLine < m_textureLines.size() && m_textureLines[m_fillLine].posX + width <= m_textureWidth)
+  {
+    line = m_fillLine;
+    return true;
+  }
+
+  const unsigned int lineHeight = GetTextureLineHeight();
+  const unsigned int newHeight = (m_textureLines.size() + 1) * lineHeight;
+  const unsigned int maxHeight = prewarm ? std::min(PREWARM_MAX_TEXTURE_HEIGHT, m_renderSystem->GetMaxTextureSize())
+                                         : m_renderSystem->GetMaxTextureSize();
+  if (newHeight > m_textureHeight && newHeight <= maxHeight && m_textureLines.size() < NO_TEXTURE_LINE)
+  {
+    // create the new larger texture
+    unsigned int height = newHeight;
+    CBaseTexture* newTexture = ReallocTexture(height);
+    if (newTexture)
+      m_texture = newTexture;
+    else
+      CLog::Log(LOGDEBUG, "%s: Failed to allocate new texture of height %u", __FUNCTION__, newHeight);
+  }
+
+  if (m_texture && newHeight <= m_textureHeight)
+  {
+    m_fillLine = m_textureLines.size();
+    m_textureLines.push_back({0, m_renderCount});
+    line = m_fillLine;
+    return true;
+  }
+
+  if (prewarm || m_textureLines.empty())
+    return false;
+
+  // the texture is full: reuse the least recently used line, its glyphs are rendered again when needed
+  auto oldest = std::min_element(m_textureLines.begin(), m_textureLines.end(),
+                                 [](const TextureLine& a, const TextureLine& b) { return a.lastUsed < b.lastUsed; });
+
+  // every line was used by the last pass, dropping one would only have its glyphs rendered again
+  if (oldest->lastUsed == m_renderCount)
+    return false;
+
+  line = oldest - m_textureLines.begin();
+  for (auto& ch : m_char)
+  {
+    if (ch.line == line)
+    {
+      ch.line = NO_TEXTURE_LINE;
+      ch.state = GLYPH_EVICTED;
+    }
   }
-  m_numChars++;
 
-  // free the glyph
-  FT_Done_Glyph(glyph);
+  // clear it, so that filtering doesn't pick up pixels of the old glyphs
+  std::vector<unsigned char> blank(m_textureWidth * lineHeight, 0);
+  CopyCharToTexture(blank.data(), m_textureWidth, 0, line * lineHeight, m_textureWidth, (line + 1) * lineHeight);
 
+  oldest->posX = 0;
+  m_fillLine = line;
   return true;
 }
 
@@ -802,8 +1004,8 @@ void CGUIFontTTFBase::RenderCharacter(float posX, float posY, const Character *c
   const float width = ch->right - ch->left;
   const float height = ch->bottom - ch->top;
 
-  // return early if nothing to render
-  if (width == 0 || height == 0)
+  // return early if nothing to render (yet)
+  if (width == 0 || height == 0 || ch->state != GLYPH_READY)
     return;
 
   // posX and posY are relative to our origin, and the textcell is offset
@@ -960,14 +1162,14 @@ void CGUIFontTTFBase::ObliqueGlyph(FT_GlyphSlot slot)
 
 
 // Embolden code - original taken from freetype2 (ftsynth.c)
-void CGUIFontTTFBase::SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength)
+void CGUIFontTTFBase::SetGlyphStrength(FT_Face face, FT_GlyphSlot slot, int glyphStrength)
 {
   if ( slot->format != FT_GLYPH_FORMAT_OUTLINE )
     return;
 
   /* some reasonable strength */
-  FT_Pos strength = FT_MulFix( m_face->units_per_EM,
-                    m_face->size->metrics.y_scale ) / glyphStrength;
+  FT_Pos strength = FT_MulFix( face->units_per_EM,
+                    face->size->metrics.y_scale ) / glyphStrength;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox( &slot->outline, &bbox_before );
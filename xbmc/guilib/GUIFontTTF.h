@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <vector>
 
+#include "threads/CriticalSection.h"
 #include "utils/auto_buffer.h"
 #include "utils/Color.h"
 #include "utils/Geometry.h"
@@ -67,6 +68,7 @@ struct SVertex
 class CGUIFontTTFBase
 {
   friend class CGUIFont;
+  friend class CGUIFontGlyphRasterizer;
 
 public:
 
@@ -85,14 +87,41 @@ public:
 
   const std::string& GetFileName() const { return m_strFileName; };
 
+  /*! \brief Render the given characters in the background, before they are first shown
+   \param characters the characters to render, in regular style
+   */
+  void Prewarm(const std::wstring& characters);
+
 protected:
+  enum GlyphState : uint8_t
+  {
+    GLYPH_READY,    ///< bitmap is in the texture (or there is nothing to render)
+    GLYPH_PENDING,  ///< metrics are known, the bitmap is being rendered
+    GLYPH_EVICTED   ///< bitmap was dropped from the texture, rendered again on next use
+  };
+
   struct Character
   {
     short offsetX, offsetY;
     float left, top, right, bottom;
     float advance;
     character_t letterAndStyle;
+    unsigned short line;           // line of the texture holding the bitmap
+    GlyphState state;
+  };
+
+  /*! \brief A glyph bitmap rendered by CGUIFontGlyphRasterizer
+   */
+  struct GlyphBitmap
+  {
+    character_t letterAndStyle;
+    int left, top;
+    unsigned int width, rows;
+    float advance;
+    bool valid;
+    std::vector<uint8_t> pixels;
   };
+
   void AddReference();
   void RemoveReference();
 
@@ -111,24 +140,46 @@ protected:
 
   // Stuff for pre-rendering for speed
   inline Character *GetCharacter(character_t letter);
-  bool CacheCharacter(wchar_t letter, uint32_t style, Character *ch);
+  bool LoadCharacterMetrics(wchar_t letter, uint32_t style, Character *ch);
+  void RequestGlyph(Character *ch);
   void RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices);
-  void ClearCharacterCache();
+  void UpdateQuickLookup();
+
+  /*! \brief Render the bitmap of a glyph, called on the thread of CGUIFontGlyphRasterizer
+   */
+  void RasterizeGlyph(character_t letterAndStyle);
+
+  /*! \brief Copy the bitmaps rendered since the last call to the texture
+   Must not be called between Begin() and End().
+   */
+  void ProcessRasterizedGlyphs();
+  bool PlaceGlyph(const GlyphBitmap& bitmap, Character *ch, bool prewarm);
+  bool GetTextureLine(unsigned int width, bool prewarm, unsigned int& line);
 
   virtual CBaseTexture* ReallocTexture(unsigned int& newHeight) = 0;
-  virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
+  virtual bool CopyCharToTexture(const unsigned char* pixels, unsigned int pitch, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
   virtual void DeleteHardwareTexture() = 0;
 
   // modifying glyphs
-  void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
+  static bool LoadGlyph(FT_Face face, wchar_t letter, uint32_t style);
+  static void SetGlyphStrength(FT_Face face, FT_GlyphSlot slot, int glyphStrength);
   static void ObliqueGlyph(FT_GlyphSlot slot);
 
   CBaseTexture* m_texture;        // texture that holds our rendered characters (8bit alpha only)
 
   unsigned int m_textureWidth;       // width of our texture
   unsigned int m_textureHeight;      // height of our texture
-  int m_posX;                        // current position in the texture
-  int m_posY;
+
+  /*! \brief A line of the texture, glyph bitmaps are placed side by side
+   */
+  struct TextureLine
+  {
+    unsigned int posX;               // next free position in the line
+    unsigned int lastUsed;           // render pass the line was last used in
+  };
+  std::vector<TextureLine> m_textureLines;
+  unsigned int m_fillLine;           // line new glyphs are added to
+  unsigned int m_renderCount;        // number of render passes (outermost Begin() calls)
 
   /*! \brief the height of each line in the texture.
    Accounts for spacing between lines to avoid characters overlapping.
@@ -138,10 +189,8 @@ protected:
 
   UTILS::Color m_color;
 
-  Character *m_char;                 // our characters
+  std::vector<Character> m_char;     // our characters, sorted by letterAndStyle
   Character *m_charquick[LOOKUPTABLE_SIZE];     // ascii chars (7 styles) here
-  int m_maxChars;                    // size of character array (can be incremented)
-  int m_numChars;                    // the current number of cached characters
 
   float m_ellipsesWidth;               // this is used every character (width of '.')
 
@@ -152,7 +201,12 @@ protected:
 
   // freetype stuff
   FT_Face    m_face;
+  FT_Face    m_rasterFace;           // used on the rasterizer thread only, as is m_stroker
   FT_Stroker m_stroker;
+  long       m_borderStrength;       // 26.6 pixels added by m_stroker on each side
+
+  CCriticalSection m_rasterizedSection;
+  std::vector<GlyphBitmap> m_rasterized;  // bitmaps rendered, but not yet in the texture
 
   float m_originX;
   float m_originY;
@@ -53,6 +53,7 @@ void CGUIListItem::SetLabel(const std::string& strLabel)
   if (m_strLabel == strLabel)
     return;
   m_strLabel = strLabel;
+  m_labelFormat = 0;
   if (m_sortLabel.empty())
     SetSortLabel(strLabel);
   SetInvalid();
@@ -69,6 +70,7 @@ void CGUIListItem::SetLabel2(const std::string& strLabel2)
   if (m_strLabel2 == strLabel2)
     return;
   m_strLabel2 = strLabel2;
+  m_labelFormat = 0;
   SetInvalid();
 }
 
@@ -95,29 +97,27 @@ const std::wstring& CGUIListItem::GetSortLabel() const
 
 void CGUIListItem::SetArt(const std::string &type, const std::string &url)
 {
-  ArtMap::iterator i = m_art.find(type);
-  if (i == m_art.end() || i->second != url)
-  {
-    m_art[type] = url;
+  if (m_art.Set(type, url))
     SetInvalid();
-  }
 }
 
 void CGUIListItem::SetArt(const ArtMap &art)
 {
-  m_art = art;
+  m_art.Clear();
+  for (const auto& i : art)
+    m_art.Set(i.first, i.second);
   SetInvalid();
 }
 
 void CGUIListItem::SetArtFallback(const std::string &from, const std::string &to)
 {
-  m_artFallbacks[from] = to;
+  m_artFallbacks.Set(from, to);
 }
 
 void CGUIListItem::ClearArt()
 {
-  m_art.clear();
-  m_artFallbacks.clear();
+  m_art.Clear();
+  m_artFallbacks.Clear();
 }
 
 void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
@@ -128,22 +128,25 @@ void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
 
 std::string CGUIListItem::GetArt(const std::string &type) const
 {
-  ArtMap::const_iterator i = m_art.find(type);
-  if (i != m_art.end())
-    return i->second;
-  i = m_artFallbacks.find(type);
-  if (i != m_artFallbacks.end())
+  const std::string* url = m_art.Find(type);
+  if (url)
+    return *url;
+  const std::string* fallback = m_artFallbacks.Find(type);
+  if (fallback)
   {
-    ArtMap::const_iterator j = m_art.find(i->second);
-    if (j != m_art.end())
-      return j->second;
+    url = m_art.Find(*fallback);
+    if (url)
+      return *url;
   }
   return "";
 }
 
-const CGUIListItem::ArtMap &CGUIListItem::GetArt() const
+CGUIListItem::ArtMap CGUIListItem::GetArt() const
 {
-  return m_art;
+  ArtMap art;
+  for (const auto& i : m_art)
+    art.insert(art.end(), std::make_pair(*i.key, i.value));
+  return art;
 }
 
 bool CGUIListItem::HasArt(const std::string &type) const
@@ -151,6 +154,16 @@ bool CGUIListItem::HasArt(const std::string &type) const
   return !GetArt(type).empty();
 }
 
+bool CGUIListItem::HasArt() const
+{
+  return !m_art.Empty();
+}
+
+size_t CGUIListItem::GetArtCount() const
+{
+  return m_art.Size();
+}
+
 void CGUIListItem::SetIconImage(const std::string& strIcon)
 {
   if (m_strIcon == strIcon)
@@ -219,6 +232,8 @@ CGUIListItem& CGUIListItem::operator =(const CGUIListItem& item)
   if (&item == this) return * this;
   m_strLabel2 = item.m_strLabel2;
   m_strLabel = item.m_strLabel;
+  // copies (e.g. from the directory cache) are formatted again, the locale may have changed since
+  m_labelFormat = 0;
   m_sortLabel = item.m_sortLabel;
   FreeMemory();
   m_bSelected = item.m_bSelected;
@@ -243,23 +258,23 @@ void CGUIListItem::Archive(CArchive &ar)
     ar << m_strIcon;
     ar << m_bSelected;
     ar << m_overlayIcon;
-    ar << (int)m_mapProperties.size();
+    ar << (int)m_mapProperties.Size();
     for (const auto& it : m_mapProperties)
     {
-      ar << it.first;
-      ar << it.second;
+      ar << *it.key;
+      ar << it.value;
     }
-    ar << (int)m_art.size();
+    ar << (int)m_art.Size();
     for (const auto& i : m_art)
     {
-      ar << i.first;
-      ar << i.second;
+      ar << *i.key;
+      ar << i.value;
     }
-    ar << (int)m_artFallbacks.size();
+    ar << (int)m_artFallbacks.Size();
     for (const auto& i : m_artFallbacks)
     {
-      ar << i.first;
-      ar << i.second;
+      ar << *i.key;
+      ar << i.value;
     }
   }
   else
@@ -267,6 +282,7 @@ void CGUIListItem::Archive(CArchive &ar)
     ar >> m_bIsFolder;
     ar >> m_strLabel;
     ar >> m_strLabel2;
+    m_labelFormat = 0;
     ar >> m_sortLabel;
     ar >> m_strIcon;
     ar >> m_bSelected;
@@ -291,7 +307,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_art.insert(make_pair(key, value));
+      m_art.Set(key, value);
     }
     ar >> mapSize;
     for (int i = 0; i < mapSize; i++)
@@ -299,7 +315,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_artFallbacks.insert(make_pair(key, value));
+      m_artFallbacks.Set(key, value);
     }
     SetInvalid();
   }
@@ -315,10 +331,10 @@ void CGUIListItem::Serialize(CVariant &value)
 
   for (const auto& it : m_mapProperties)
   {
-    value["properties"][it.first] = it.second;
+    value["properties"][*it.key] = it.value;
   }
   for (const auto& it : m_art)
-    value["art"][it.first] = it.second;
+    value["art"][*it.key] = it.value;
 }
 
 void CGUIListItem::FreeIcons()
@@ -371,54 +387,42 @@ void CGUIListItem::SetInvalid()
 
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
-  {
-    m_mapProperties.insert(make_pair(strKey, value));
+  if (m_mapProperties.Set(strKey, value))
     SetInvalid();
-  }
-  else if (iter->second != value)
-  {
-    iter->second = value;
-    SetInvalid();
-  }
 }
 
 const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  const CVariant* value = m_mapProperties.Find(strKey);
   static CVariant nullVariant = CVariant(CVariant::VariantTypeNull);
 
-  if (iter == m_mapProperties.end())
+  if (!value)
     return nullVariant;
 
-  return iter->second;
+  return *value;
 }
 
 bool CGUIListItem::HasProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
-    return false;
+  return m_mapProperties.Find(strKey) != nullptr;
+}
 
-  return true;
+bool CGUIListItem::HasProperties() const
+{
+  return !m_mapProperties.Empty();
 }
 
 void CGUIListItem::ClearProperty(const std::string &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter != m_mapProperties.end())
-  {
-    m_mapProperties.erase(iter);
+  if (m_mapProperties.Erase(strKey))
     SetInvalid();
-  }
 }
 
 void CGUIListItem::ClearProperties()
 {
-  if (!m_mapProperties.empty())
+  if (!m_mapProperties.Empty())
   {
-    m_mapProperties.clear();
+    m_mapProperties.Clear();
     SetInvalid();
   }
 }
@@ -440,5 +444,5 @@ void CGUIListItem::IncrementProperty(const std::string &strKey, double dVal)
 void CGUIListItem::AppendProperties(const CGUIListItem &item)
 {
   for (const auto& i : item.m_mapProperties)
-    SetProperty(i.first, i.second);
+    SetProperty(*i.key, i.value);
 }
@@ -13,6 +13,8 @@
 \brief
 */
 
+#include "utils/InternedStringMap.h"
+
 #include <map>
 #include <memory>
 #include <string>
@@ -61,6 +63,13 @@ public:
   void SetLabel2(const std::string& strLabel);
   const std::string& GetLabel2() const;
 
+  /*! \brief Id of the label masks both labels were last formatted with
+   0 once the labels were set differently. Items changing their metadata reset it as well.
+   \sa CLabelFormatter::FormatLabels
+   */
+  unsigned int GetLabelFormat() const { return m_labelFormat; }
+  void SetLabelFormat(unsigned int format) { m_labelFormat = format; }
+
   void SetIconImage(const std::string& strIcon);
   const std::string& GetIconImage() const;
 
@@ -106,10 +115,10 @@ public:
 
   /*! \brief get artwork for an item
    Retrieves artwork in a type:url map
-   \return a type:url map for artwork
-   \sa SetArt
+   \return a type:url map for artwork, built on each call
+   \sa SetArt, HasArt, GetArtCount
    */
-  const ArtMap &GetArt() const;
+  ArtMap GetArt() const;
 
   /*! \brief Check whether an item has a particular piece of art
    Equivalent to !GetArt(type).empty()
@@ -118,6 +127,15 @@ public:
    */
   bool HasArt(const std::string &type) const;
 
+  /*! \brief Check whether an item has any art, without building the type:url map
+   \return true if the item has art set, false otherwise.
+   */
+  bool HasArt() const;
+
+  /*! \brief Get the number of art types set on an item, without building the type:url map
+   */
+  size_t GetArtCount() const;
+
   void SetSortLabel(const std::string &label);
   void SetSortLabel(const std::wstring &label);
   const std::wstring &GetSortLabel() const;
@@ -159,7 +177,7 @@ public:
   void Serialize(CVariant& value);
 
   bool       HasProperty(const std::string &strKey) const;
-  bool       HasProperties() const { return !m_mapProperties.empty(); };
+  bool       HasProperties() const;
   void       ClearProperty(const std::string &strKey);
 
   const CVariant &GetProperty(const std::string &strKey) const;
@@ -178,13 +196,17 @@ protected:
     bool operator()(const std::string &s1, const std::string &s2) const;
   };
 
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
+  // flat maps with interned keys, items have a few properties and art types
+  // from a small vocabulary but exist in huge numbers
+  typedef CInternedStringMap<CVariant, icompare> PropertyMap;
+  typedef CInternedStringMap<std::string> ArtStore;
   PropertyMap m_mapProperties;
 private:
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
+  unsigned int m_labelFormat = 0;
 
-  ArtMap m_art;
-  ArtMap m_artFallbacks;
+  ArtStore m_art;
+  ArtStore m_artFallbacks;
 };
 
@@ -159,6 +159,11 @@
  */
 #define GUI_MSG_SUBTITLE_DOWNLOADED  52
 
+/*!
+ \brief Glyphs rendered in the background are ready to be shown
+ */
+#define GUI_MSG_GLYPHS_RENDERED  53
+
 
 #define GUI_MSG_USER         1000
 
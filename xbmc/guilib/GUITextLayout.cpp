@@ -12,6 +12,7 @@
 #include "GUIComponent.h"
 #include "GUIControl.h"
 #include "GUIFont.h"
+#include "GUITextLayoutCache.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
 
@@ -224,6 +225,19 @@ bool CGUITextLayout::UpdateW(const std::wstring &text, float maxWidth /*= 0*/, b
 
 void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool forceLTRReadingOrder)
 {
+  // other labels may have laid out the same text already
+  CGUITextLayoutCache& cache = CGUITextLayoutCache::GetInstance();
+  CGUITextLayoutCache::Key key{text, m_font, m_textColor, m_wrap && maxWidth > 0 ? maxWidth : 0, m_maxHeight, forceLTRReadingOrder};
+  std::shared_ptr<const CGUITextLayoutCache::Entry> entry = cache.Get(key);
+  if (entry)
+  {
+    m_lines = entry->lines;
+    m_colors = entry->colors;
+    m_textWidth = entry->textWidth;
+    m_textHeight = entry->textHeight;
+    return;
+  }
+
   // parse the text for style information
   vecText parsedText;
   std::vector<UTILS::Color> colors;
@@ -231,6 +245,8 @@ void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool
 
   // and update
   UpdateStyled(parsedText, colors, maxWidth, forceLTRReadingOrder);
+
+  cache.Add(key, std::make_shared<CGUITextLayoutCache::Entry>(CGUITextLayoutCache::Entry{m_lines, m_colors, m_textWidth, m_textHeight}));
 }
 
 void CGUITextLayout::UpdateStyled(const vecText &text, const std::vector<UTILS::Color> &colors, float maxWidth, bool forceLTRReadingOrder)
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUITextLayoutCache.h"
+
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <functional>
+
+namespace
+{
+// characters (4 bytes each) of all cached texts and their lines
+const size_t MAX_CACHE_SIZE = 1024 * 1024;
+
+// don't let a single huge text (e.g. a long plot) push out everything else
+const size_t MAX_ENTRY_SIZE = MAX_CACHE_SIZE / 16;
+}
+
+bool CGUITextLayoutCache::Key::operator==(const Key& other) const
+{
+  return font == other.font && color == other.color &&
+         maxWidth == other.maxWidth && maxHeight == other.maxHeight &&
+         forceLTRReadingOrder == other.forceLTRReadingOrder && text == other.text;
+}
+
+size_t CGUITextLayoutCache::KeyHash::operator()(const Key& key) const
+{
+  size_t hash = std::hash<std::wstring>()(key.text);
+  hash ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  hash ^= std::hash<float>()(key.maxWidth) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+CGUITextLayoutCache& CGUITextLayoutCache::GetInstance()
+{
+  static CGUITextLayoutCache cache;
+  return cache;
+}
+
+size_t CGUITextLayoutCache::GetSize(const Key& key, const Entry& entry)
+{
+  size_t size = key.text.size();
+  for (const auto& line : entry.lines)
+    size += line.m_text.size();
+  return size;
+}
+
+std::shared_ptr<const CGUITextLayoutCache::Entry> CGUITextLayoutCache::Get(const Key& key)
+{
+  CSingleLock lock(m_section);
+  m_requests++;
+
+  auto it = m_index.find(key);
+  if (it == m_index.end())
+    return nullptr;
+
+  m_hits++;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->second;
+}
+
+void CGUITextLayoutCache::Add(const Key& key, std::shared_ptr<const Entry> entry)
+{
+  const size_t size = GetSize(key, *entry);
+  if (size > MAX_ENTRY_SIZE)
+    return;
+
+  CSingleLock lock(m_section);
+  if (m_index.find(key) != m_index.end())
+    return;
+
+  m_entries.emplace_front(key, std::move(entry));
+  m_index.insert(std::make_pair(key, m_entries.begin()));
+  m_size += size;
+
+  while (m_size > MAX_CACHE_SIZE && !m_entries.empty())
+  {
+    const auto& oldest = m_entries.back();
+    m_size -= GetSize(oldest.first, *oldest.second);
+    m_index.erase(oldest.first);
+    m_entries.pop_back();
+  }
+}
+
+void CGUITextLayoutCache::Clear()
+{
+  CSingleLock lock(m_section);
+  if (m_requests > 0)
+    CLog::Log(LOGDEBUG, "CGUITextLayoutCache: %u entries, %" PRIu64 " of %" PRIu64 " layouts (%.1f%%) taken from the cache",
+              static_cast<unsigned int>(m_index.size()), m_hits, m_requests, 100.0 * m_hits / m_requests);
+
+  m_index.clear();
+  m_entries.clear();
+  m_size = 0;
+}
+
+void CGUITextLayoutCache::GetStats(uint64_t& requests, uint64_t& hits) const
+{
+  CSingleLock lock(m_section);
+  requests = m_requests;
+  hits = m_hits;
+}
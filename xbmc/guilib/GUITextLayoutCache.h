@@ -0,0 +1,92 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "GUITextLayout.h"
+#include "threads/CriticalSection.h"
+#include "utils/Color.h"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CGUIFont;
+
+/*!
+ \brief Process wide cache of laid out text, shared by all text layouts.
+
+ Parsing the style tags, breaking text into lines and the bidi conversion
+ are only done once for each combination of text, font and layout
+ parameters. Scrolling lists and labels switching between a few values
+ take the lines in visual order from here. The least recently used entries
+ are dropped once the cached text exceeds the size limit.
+ */
+class CGUITextLayoutCache
+{
+public:
+  struct Key
+  {
+    std::wstring text;
+    const CGUIFont* font;
+    UTILS::Color color;
+    float maxWidth;
+    float maxHeight;
+    bool forceLTRReadingOrder;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct Entry
+  {
+    std::vector<CGUIString> lines;
+    std::vector<UTILS::Color> colors;
+    float textWidth;
+    float textHeight;
+  };
+
+  static CGUITextLayoutCache& GetInstance();
+
+  /*!
+   \brief Get the layout of the given text
+   \return the cached layout, nullptr if there is none
+   */
+  std::shared_ptr<const Entry> Get(const Key& key);
+
+  void Add(const Key& key, std::shared_ptr<const Entry> entry);
+
+  /*!
+   \brief Drop all entries, needed whenever fonts are unloaded or their metrics change
+   */
+  void Clear();
+
+  void GetStats(uint64_t& requests, uint64_t& hits) const;
+
+private:
+  CGUITextLayoutCache() = default;
+  CGUITextLayoutCache(const CGUITextLayoutCache&) = delete;
+  CGUITextLayoutCache& operator=(const CGUITextLayoutCache&) = delete;
+
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const;
+  };
+
+  typedef std::list<std::pair<Key, std::shared_ptr<const Entry>>> EntryList;
+
+  static size_t GetSize(const Key& key, const Entry& entry);
+
+  mutable CCriticalSection m_section;
+  EntryList m_entries; ///< most recently used first
+  std::unordered_map<Key, EntryList::iterator, KeyHash> m_index;
+  size_t m_size = 0; ///< number of characters in all entries
+  uint64_t m_requests = 0;
+  uint64_t m_hits = 0;
+};
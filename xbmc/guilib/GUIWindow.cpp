@@ -15,16 +15,20 @@
 #include "GUIControlGroup.h"
 #include "GUIControlProfiler.h"
 #include "GUIInfoManager.h"
+#include "GUIWindowCache.h"
 #include "GUIWindowManager.h"
 #include "ServiceBroker.h"
+#include "TextureManager.h"
 #include "addons/Skin.h"
 #include "input/Key.h"
 #include "input/WindowTranslator.h"
+#include "interfaces/info/InfoBool.h"
 #include "messaging/ApplicationMessenger.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/Color.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/TimeUtils.h"
 #include "utils/Variant.h"
@@ -38,6 +42,57 @@ bool CGUIWindow::icompare::operator()(const std::string &s1, const std::string &
   return StringUtils::CompareNoCase(s1, s2) < 0;
 }
 
+namespace
+{
+/*!
+ \brief Collect the file names of the textures of the visible controls of a window or control,
+ skipping info labels and large textures (those are loaded by the large texture manager)
+
+ Controls whose visible condition is false when the window is loaded are skipped with their
+ children, so textures that may never be shown aren't decompressed ahead of time.
+ */
+void GetTextureNames(const TiXmlElement* element, int contextWindow, std::vector<std::string>& textures)
+{
+  for (const TiXmlElement* child = element->FirstChildElement(); child; child = child->NextSiblingElement())
+  {
+    if (child->ValueStr() == "control")
+    {
+      std::string condition;
+      if (CGUIControlFactory::GetConditionalVisibility(child, condition) &&
+          !CServiceBroker::GetGUI()->GetInfoManager().EvaluateBool(condition, contextWindow))
+        continue;
+    }
+
+    if (child->ValueStr().find("texture") != std::string::npos)
+    {
+      const char* background = child->Attribute("background");
+      const char* diffuse = child->Attribute("diffuse");
+      if (diffuse && strchr(diffuse, '$') == nullptr)
+        textures.emplace_back(diffuse);
+      if (child->FirstChild() && child->FirstChild()->Type() == TiXmlNode::TINYXML_TEXT &&
+          (!background || !StringUtils::StartsWithNoCase(background, "true")) &&
+          strchr(child->FirstChild()->Value(), '$') == nullptr)
+        textures.emplace_back(child->FirstChild()->Value());
+    }
+    else
+      GetTextureNames(child, contextWindow, textures);
+  }
+}
+
+/*!
+ \brief Owned by a job, sets the event once the job is destroyed, whether it ran or was dropped
+ */
+class CSetEventOnDestroy
+{
+public:
+  explicit CSetEventOnDestroy(std::shared_ptr<CEvent> event) : m_event(std::move(event)) {}
+  ~CSetEventOnDestroy() { m_event->Set(); }
+
+private:
+  std::shared_ptr<CEvent> m_event;
+};
+}
+
 CGUIWindow::CGUIWindow(int id, const std::string &xmlFile)
 {
   CGUIWindow::SetID(id);
@@ -92,21 +147,23 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
   }
   CLog::Log(LOGINFO, "Loading skin file: %s, load type: %s", strFileName.c_str(), strLoadType);
 
-  // Find appropriate skin folder + resolution to load from
-  std::string strPath;
-  std::string strLowerPath;
-  if (bContainsPath)
-    strPath = strFileName;
+  bool ret;
+  if (m_preparedXML && m_preparedXML->read)
+  {
+    // read by PrepareAsync()
+    std::shared_ptr<ReadXML> xml = std::move(m_preparedXML);
+    std::unique_ptr<TiXmlElement> preparedRoot = ResolveXML(*xml);
+    ret = Load(preparedRoot.get());
+  }
   else
   {
-    // FIXME: strLowerPath needs to eventually go since resToUse can get incorrectly overridden
-    std::string strFileNameLower = strFileName;
-    StringUtils::ToLower(strFileNameLower);
-    strLowerPath =  g_SkinInfo->GetSkinPath(strFileNameLower, &m_coordsRes);
-    strPath = g_SkinInfo->GetSkinPath(strFileName, &m_coordsRes);
+    std::string strPath;
+    std::string strLowerPath;
+    GetSkinFilePath(strFileName, bContainsPath, strPath, strLowerPath);
+    m_preparedXML.reset();
+    ret = LoadXML(strPath, strLowerPath);
   }
 
-  bool ret = LoadXML(strPath, strLowerPath);
   if (ret)
   {
     m_windowLoaded = true;
@@ -116,42 +173,141 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
     int64_t end, freq;
     end = CurrentHostCounter();
     freq = CurrentHostFrequency();
-    CLog::Log(LOGDEBUG, "Skin file %s loaded in %.2fms", strPath.c_str(), 1000.f * (end - start) / freq);
+    CLog::Log(LOGDEBUG, "Skin file %s loaded in %.2fms", strFileName.c_str(), 1000.f * (end - start) / freq);
 #endif
   }
 
   return ret;
 }
 
+void CGUIWindow::GetSkinFilePath(const std::string &strFileName, bool bContainsPath, std::string &strPath, std::string &strLowerPath)
+{
+  // Find appropriate skin folder + resolution to load from
+  if (bContainsPath)
+    strPath = strFileName;
+  else
+  {
+    // FIXME: strLowerPath needs to eventually go since resToUse can get incorrectly overridden
+    std::string strFileNameLower = strFileName;
+    StringUtils::ToLower(strFileNameLower);
+    strLowerPath =  g_SkinInfo->GetSkinPath(strFileNameLower, &m_coordsRes);
+    strPath = g_SkinInfo->GetSkinPath(strFileName, &m_coordsRes);
+  }
+}
+
+std::shared_ptr<CEvent> CGUIWindow::PrepareAsync()
+{
+  // windows needing a reload are freed by AllocResources() first
+  if (m_windowLoaded || !g_SkinInfo)
+    return nullptr;
+
+  const std::string xmlFile = GetProperty("xmlfile").asString();
+  if (xmlFile.empty())
+    return nullptr;
+
+  // a preparation that wasn't loaded may be outdated
+  m_preparedXML.reset();
+
+  // the worker only reads files and XML it owns. the window, the info manager and the texture
+  // manager are left to the GUI thread.
+  const bool bHasPath = xmlFile.find("\\") != std::string::npos || xmlFile.find("/") != std::string::npos;
+  auto xml = std::make_shared<ReadXML>();
+  GetSkinFilePath(xmlFile, bHasPath, xml->strPath, xml->strLowerPath);
+  const bool bRead = !m_windowXMLRootElement;
+
+  // set when the job is gone, also if the job manager drops it without running it
+  auto prepared = std::make_shared<CEvent>(true);
+  auto done = std::make_shared<CSetEventOnDestroy>(prepared);
+  if (!CJobManager::GetInstance().Submit([xml, bRead, done]() {
+    if (bRead)
+      ReadWindowXML(*xml);
+    xml->read = true;
+  }, CJob::PRIORITY_HIGH))
+    return nullptr;
+
+  m_preparedXML = xml;
+  return prepared;
+}
+
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
+  std::unique_ptr<TiXmlElement> preparedRoot = LoadResolvedXML(strPath, strLowerPath);
+  return Load(preparedRoot.get());
+}
+
+std::unique_ptr<TiXmlElement> CGUIWindow::LoadResolvedXML(const std::string &strPath, const std::string &strLowerPath)
+{
+  ReadXML xml;
+  xml.strPath = strPath;
+  xml.strLowerPath = strLowerPath;
+  if (!m_windowXMLRootElement)
+    ReadWindowXML(xml);
+  return ResolveXML(xml);
+}
+
+void CGUIWindow::ReadWindowXML(ReadXML &xml)
+{
+  // skip parsing and resolving if the resolved window is cached, its conditions are checked by ResolveXML()
+  xml.cachedRoot = g_SkinInfo->GetWindowCache().Read(xml.strPath, xml.cachedConditions);
+  if (!xml.cachedRoot)
+    ParseWindowXML(xml);
+}
+
+void CGUIWindow::ParseWindowXML(ReadXML &xml)
+{
+  CXBMCTinyXML xmlDoc;
+  std::string strPathLower = xml.strPath;
+  StringUtils::ToLower(strPathLower);
+  if (!xmlDoc.LoadFile(xml.strPath) && !xmlDoc.LoadFile(strPathLower) && !xmlDoc.LoadFile(xml.strLowerPath))
+  {
+    CLog::Log(LOGERROR, "Unable to load window XML: %s. Line %d\n%s", xml.strPath.c_str(), xmlDoc.ErrorRow(), xmlDoc.ErrorDesc());
+    xml.fileError = true;
+    return;
+  }
+
+  // xml need a <window> root element
+  if (!StringUtils::EqualsNoCase(xmlDoc.RootElement()->Value(), "window"))
+  {
+    CLog::Log(LOGERROR, "XML file %s does not contain a <window> root element", xml.strPath.c_str());
+    return;
+  }
+
+  xml.parsedRoot.reset(static_cast<TiXmlElement*>(xmlDoc.RootElement()->Clone()));
+}
+
+std::unique_ptr<TiXmlElement> CGUIWindow::ResolveXML(ReadXML &xml)
+{
+  if (xml.cachedRoot && CGUIWindowCache::CheckConditions(xml.cachedConditions, m_xmlIncludeConditions))
+  {
+    CLog::Log(LOGDEBUG, "Using cached window xml for %s", xml.strPath.c_str());
+    return std::move(xml.cachedRoot);
+  }
+
   // load window xml if we don't have it stored yet
+  bool parsed = false;
   if (!m_windowXMLRootElement)
   {
-    CXBMCTinyXML xmlDoc;
-    std::string strPathLower = strPath;
-    StringUtils::ToLower(strPathLower);
-    if (!xmlDoc.LoadFile(strPath) && !xmlDoc.LoadFile(strPathLower) && !xmlDoc.LoadFile(strLowerPath))
-    {
-      CLog::Log(LOGERROR, "Unable to load window XML: %s. Line %d\n%s", strPath.c_str(), xmlDoc.ErrorRow(), xmlDoc.ErrorDesc());
-      SetID(WINDOW_INVALID);
-      return false;
-    }
+    // the cached window was resolved with other include conditions
+    if (xml.cachedRoot)
+      ParseWindowXML(xml);
 
-    // xml need a <window> root element
-    if (!StringUtils::EqualsNoCase(xmlDoc.RootElement()->Value(), "window"))
-    {
-      CLog::Log(LOGERROR, "XML file %s does not contain a <window> root element", GetProperty("xmlfile").c_str());
-      return false;
-    }
+    if (xml.fileError)
+      SetID(WINDOW_INVALID);
+    if (!xml.parsedRoot)
+      return nullptr;
 
     // store XML for further processing if window's load type is LOAD_EVERY_TIME or a reload is needed
-    m_windowXMLRootElement = static_cast<TiXmlElement*>(xmlDoc.RootElement()->Clone());
+    m_windowXMLRootElement = xml.parsedRoot.release();
+    parsed = true;
   }
   else
-    CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", strPath.c_str());
+    CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", xml.strPath.c_str());
+
+  std::unique_ptr<TiXmlElement> preparedRoot = Prepare(m_windowXMLRootElement);
+  if (preparedRoot && parsed)
+    g_SkinInfo->GetWindowCache().Save(xml.strPath, *preparedRoot, m_xmlIncludeConditions);
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  return preparedRoot;
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(TiXmlElement *pRootElement)
@@ -178,6 +334,11 @@ bool CGUIWindow::Load(TiXmlElement *pRootElement)
   // be done with respect to the correct aspect ratio
   CServiceBroker::GetWinSystem()->GetGfxContext().SetScalingResolution(m_coordsRes, m_needsScaling);
 
+  // decompress the bundled textures of the visible controls on worker threads while the controls are created
+  std::vector<std::string> textures;
+  GetTextureNames(pRootElement, GetID(), textures);
+  CServiceBroker::GetGUI()->GetTextureManager().PrefetchTextures(textures);
+
   // now load in the skin file
   SetDefaults();
 
@@ -567,6 +728,9 @@ void CGUIWindow::OnDeinitWindow(int nextWindowID)
 
   SaveControlStates();
   m_active = false;
+
+  if (INFO::InfoBool::IsProfiling())
+    CServiceBroker::GetGUI()->GetInfoManager().LogConditionProfile(GetID());
 }
 
 bool CGUIWindow::OnMessage(CGUIMessage& message)
@@ -784,6 +948,7 @@ void CGUIWindow::FreeResources(bool forceUnload /*= false */)
     delete m_windowXMLRootElement;
     m_windowXMLRootElement = nullptr;
     m_xmlIncludeConditions.clear();
+    m_preparedXML.reset();
   }
 }
 
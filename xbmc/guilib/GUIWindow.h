@@ -17,11 +17,14 @@
 #include "GUIControlGroup.h"
 #include <memory>
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 
 class CFileItem; typedef std::shared_ptr<CFileItem> CFileItemPtr;
 
+#include <atomic>
 #include <limits.h>
 #include <map>
+#include <utility>
 #include <vector>
 
 enum RenderOrder {
@@ -66,6 +69,15 @@ public:
   bool Initialize();  // loads the window
   bool Load(const std::string& strFileName, bool bContainsPath = false);
 
+  /*!
+   \brief Read the window XML on a worker thread
+   The worker only reads and parses files. The next load of the window on the GUI thread resolves
+   the includes, which evaluates conditions, prefetches the textures and creates the controls.
+   The window must not be loaded or activated before the returned event is set.
+   \return event set once the job is done or dropped, nullptr if the window is loaded already
+   */
+  std::shared_ptr<CEvent> PrepareAsync();
+
   void CenterWindow();
 
   void DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions) override;
@@ -201,6 +213,14 @@ protected:
    */
   virtual bool LoadXML(const std::string& strPath, const std::string &strLowerPath);
 
+  /*!
+   \brief Load the window XML from the given path and resolve its includes, using the skin's window cache
+   \param strPath the path to the window XML
+   \param strLowerPath a lowered path to the window XML
+   \return the resolved XML, nullptr on errors
+   */
+  std::unique_ptr<TiXmlElement> LoadResolvedXML(const std::string& strPath, const std::string &strLowerPath);
+
   /*!
    \brief Loads the window from the given XML element
    \param pRootElement the XML element
@@ -284,7 +304,27 @@ protected:
   bool m_custom;
 
 private:
+  /*!
+   \brief Window XML read from files, without evaluating any conditions
+   */
+  struct ReadXML
+  {
+    std::string strPath;
+    std::string strLowerPath;
+    std::unique_ptr<TiXmlElement> cachedRoot; ///< resolved XML from the window cache
+    std::vector<std::pair<std::string, bool>> cachedConditions; ///< include conditions cachedRoot depends on
+    std::unique_ptr<TiXmlElement> parsedRoot; ///< the window XML, if it isn't cached
+    bool fileError = false;
+    std::atomic<bool> read{false}; ///< set by the worker, a dropped job leaves the reading to Load()
+  };
+
+  void GetSkinFilePath(const std::string &strFileName, bool bContainsPath, std::string &strPath, std::string &strLowerPath);
+  static void ReadWindowXML(ReadXML &xml);
+  static void ParseWindowXML(ReadXML &xml);
+  std::unique_ptr<TiXmlElement> ResolveXML(ReadXML &xml);
+
   std::map<std::string, CVariant, icompare> m_mapProperties;
   std::map<INFO::InfoPtr, bool> m_xmlIncludeConditions; ///< \brief used to store conditions used to resolve includes for this window
+  std::shared_ptr<ReadXML> m_preparedXML; ///< \brief XML read by PrepareAsync(), used by the next Load()
 };
 
@@ -0,0 +1,399 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIWindowCache.h"
+
+#include "FileItem.h"
+#include "GUIComponent.h"
+#include "GUIInfoManager.h"
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/Digest.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace XFILE;
+using KODI::UTILITY::CDigest;
+
+namespace
+{
+// bump on any change of the file format
+const char CACHE_MAGIC[] = "KWC1";
+const size_t CACHE_MAGIC_SIZE = 4;
+
+const std::string CACHE_FOLDER = "special://temp/skincache/";
+
+enum NodeType : uint8_t
+{
+  NODE_ELEMENT = 0,
+  NODE_TEXT = 1,
+  NODE_CDATA = 2
+};
+
+void AppendNumber(std::string &data, uint32_t value)
+{
+  // variable length, 7 bits per byte
+  while (value >= 0x80)
+  {
+    data.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  data.push_back(static_cast<char>(value));
+}
+
+void AppendString(std::string &data, const std::string &value)
+{
+  AppendNumber(data, static_cast<uint32_t>(value.size()));
+  data.append(value);
+}
+
+/*!
+ \brief Writes a window tree. Element and attribute names and values are
+ stored once in a string table and referenced by index.
+ */
+class CWindowWriter
+{
+public:
+  void WriteString(const std::string &value)
+  {
+    auto it = m_stringIndex.find(value);
+    if (it == m_stringIndex.end())
+    {
+      it = m_stringIndex.insert(std::make_pair(value, static_cast<uint32_t>(m_strings.size()))).first;
+      m_strings.push_back(&it->first);
+    }
+    AppendNumber(m_data, it->second);
+  }
+
+  void WriteElement(const TiXmlElement &element)
+  {
+    WriteString(element.ValueStr());
+
+    uint32_t count = 0;
+    for (const TiXmlAttribute *attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+      count++;
+    AppendNumber(m_data, count);
+    for (const TiXmlAttribute *attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+    {
+      WriteString(attribute->NameTStr());
+      WriteString(attribute->ValueStr());
+    }
+
+    // comments and other nodes are of no interest to the window
+    count = 0;
+    for (const TiXmlNode *child = element.FirstChild(); child; child = child->NextSibling())
+    {
+      if (child->Type() == TiXmlNode::TINYXML_ELEMENT || child->Type() == TiXmlNode::TINYXML_TEXT)
+        count++;
+    }
+    AppendNumber(m_data, count);
+    for (const TiXmlNode *child = element.FirstChild(); child; child = child->NextSibling())
+    {
+      if (child->Type() == TiXmlNode::TINYXML_ELEMENT)
+      {
+        m_data.push_back(NODE_ELEMENT);
+        WriteElement(*child->ToElement());
+      }
+      else if (child->Type() == TiXmlNode::TINYXML_TEXT)
+      {
+        m_data.push_back(child->ToText()->CDATA() ? NODE_CDATA : NODE_TEXT);
+        WriteString(child->ValueStr());
+      }
+    }
+  }
+
+  /*!
+   \brief Assemble the file, the string table goes in front of the data referencing it
+   */
+  std::string Finish()
+  {
+    std::string body;
+    body.swap(m_data);
+
+    AppendNumber(m_data, static_cast<uint32_t>(m_strings.size()));
+    for (const std::string *value : m_strings)
+      AppendString(m_data, *value);
+    m_data.append(body);
+
+    return m_data;
+  }
+
+private:
+  std::string m_data;
+  std::unordered_map<std::string, uint32_t> m_stringIndex;
+  std::vector<const std::string*> m_strings;
+};
+
+class CWindowReader
+{
+public:
+  CWindowReader(const char *data, size_t size) : m_pos(data), m_end(data + size) { }
+
+  bool ReadNumber(uint32_t &value)
+  {
+    value = 0;
+    for (unsigned int shift = 0; shift < 32; shift += 7)
+    {
+      if (m_pos >= m_end)
+        return false;
+
+      uint8_t byte = static_cast<uint8_t>(*m_pos++);
+      value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadString(std::string &value)
+  {
+    uint32_t size;
+    if (!ReadNumber(size) || size > static_cast<size_t>(m_end - m_pos))
+      return false;
+
+    value.assign(m_pos, size);
+    m_pos += size;
+    return true;
+  }
+
+  bool ReadStringTable()
+  {
+    uint32_t count;
+    if (!ReadNumber(count) || count > static_cast<size_t>(m_end - m_pos))
+      return false;
+
+    m_strings.resize(count);
+    for (std::string &value : m_strings)
+    {
+      if (!ReadString(value))
+        return false;
+    }
+    return true;
+  }
+
+  const std::string* ReadStringRef()
+  {
+    uint32_t index;
+    if (!ReadNumber(index) || index >= m_strings.size())
+      return nullptr;
+    return &m_strings[index];
+  }
+
+  bool ReadElement(TiXmlElement &element)
+  {
+    uint32_t count;
+    if (!ReadNumber(count))
+      return false;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      const std::string *name = ReadStringRef();
+      const std::string *value = ReadStringRef();
+      if (!name || !value)
+        return false;
+      element.SetAttribute(*name, *value);
+    }
+
+    if (!ReadNumber(count))
+      return false;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      if (m_pos >= m_end)
+        return false;
+
+      uint8_t type = static_cast<uint8_t>(*m_pos++);
+      const std::string *value = ReadStringRef();
+      if (!value)
+        return false;
+
+      if (type == NODE_ELEMENT)
+      {
+        TiXmlElement *child = new TiXmlElement(*value);
+        element.LinkEndChild(child);
+        if (!ReadElement(*child))
+          return false;
+      }
+      else if (type == NODE_TEXT || type == NODE_CDATA)
+      {
+        TiXmlText *text = new TiXmlText(*value);
+        text->SetCDATA(type == NODE_CDATA);
+        element.LinkEndChild(text);
+      }
+      else
+        return false;
+    }
+    return true;
+  }
+
+  bool AtEnd() const { return m_pos == m_end; }
+
+private:
+  const char *m_pos;
+  const char *m_end;
+  std::vector<std::string> m_strings;
+};
+}
+
+void CGUIWindowCache::Initialize(const std::string &skinId, const std::string &version, const std::vector<std::string> &skinPaths)
+{
+  // any changed, added or removed window or include file invalidates the cache
+  std::string signature = skinId + "|" + version;
+  for (const std::string &path : skinPaths)
+  {
+    CFileItemList items;
+    CDirectory::GetDirectory(path, items, ".xml", DIR_FLAG_DEFAULTS);
+    items.Sort(SortByFile, SortOrderAscending);
+    for (const auto &item : items)
+    {
+      signature += StringUtils::Format("|%s:%" PRId64 ":%s",
+                                       item->GetPath().c_str(), item->m_dwSize,
+                                       item->m_dateTime.GetAsDBDateTime().c_str());
+    }
+  }
+
+  CSingleLock lock(m_section);
+  m_signature = CDigest::Calculate(CDigest::Type::MD5, signature);
+  m_cachePath = URIUtils::AddFileToFolder(CACHE_FOLDER, skinId);
+  m_skinPaths = skinPaths;
+  m_enabled = CDirectory::Exists(m_cachePath) || CDirectory::Create(m_cachePath);
+  if (!m_enabled)
+    CLog::Log(LOGWARNING, "CGUIWindowCache: unable to create %s, skin window cache disabled", m_cachePath.c_str());
+}
+
+void CGUIWindowCache::Deinitialize()
+{
+  CSingleLock lock(m_section);
+  m_enabled = false;
+  m_signature.clear();
+  m_cachePath.clear();
+  m_skinPaths.clear();
+}
+
+std::string CGUIWindowCache::GetCacheFile(const std::string &xmlFile) const
+{
+  if (!m_enabled)
+    return "";
+
+  // only files covered by the signature, e.g. not windows of add-ons
+  const std::string folder = URIUtils::GetDirectory(xmlFile);
+  if (std::none_of(m_skinPaths.begin(), m_skinPaths.end(),
+                   [&folder](const std::string &path) { return URIUtils::PathEquals(folder, path, true); }))
+    return "";
+
+  return URIUtils::AddFileToFolder(m_cachePath, CDigest::Calculate(CDigest::Type::MD5, xmlFile) + ".bin");
+}
+
+std::unique_ptr<TiXmlElement> CGUIWindowCache::Read(const std::string &xmlFile, std::vector<std::pair<std::string, bool>> &includeConditions)
+{
+  std::string cacheFile;
+  std::string signature;
+  {
+    CSingleLock lock(m_section);
+    cacheFile = GetCacheFile(xmlFile);
+    signature = m_signature;
+  }
+  if (cacheFile.empty())
+    return nullptr;
+
+  CFile file;
+  auto_buffer buffer;
+  if (!CFile::Exists(cacheFile) || file.LoadFile(cacheFile, buffer) <= 0)
+    return nullptr;
+
+  if (buffer.size() < CACHE_MAGIC_SIZE || memcmp(buffer.get(), CACHE_MAGIC, CACHE_MAGIC_SIZE) != 0)
+    return nullptr;
+
+  CWindowReader reader(buffer.get() + CACHE_MAGIC_SIZE, buffer.size() - CACHE_MAGIC_SIZE);
+
+  std::string value;
+  if (!reader.ReadString(value) || value != signature)
+    return nullptr;
+
+  // the includes were resolved depending on these conditions
+  std::vector<std::pair<std::string, bool>> conditions;
+  uint32_t count;
+  if (!reader.ReadNumber(count))
+    return nullptr;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    uint32_t expected;
+    if (!reader.ReadString(value) || !reader.ReadNumber(expected))
+      return nullptr;
+    conditions.emplace_back(value, expected != 0);
+  }
+
+  const std::string *rootName;
+  if (!reader.ReadStringTable() || !(rootName = reader.ReadStringRef()))
+    return nullptr;
+
+  std::unique_ptr<TiXmlElement> root(new TiXmlElement(*rootName));
+  if (!reader.ReadElement(*root) || !reader.AtEnd())
+  {
+    CLog::Log(LOGWARNING, "CGUIWindowCache: %s is corrupt, ignoring it", cacheFile.c_str());
+    return nullptr;
+  }
+
+  includeConditions.swap(conditions);
+  return root;
+}
+
+bool CGUIWindowCache::CheckConditions(const std::vector<std::pair<std::string, bool>> &conditions, std::map<INFO::InfoPtr, bool> &includeConditions)
+{
+  CGUIInfoManager &infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  std::map<INFO::InfoPtr, bool> registered;
+  for (const auto &condition : conditions)
+  {
+    INFO::InfoPtr info = infoMgr.Register(condition.first);
+    if (!info || info->Get() != condition.second)
+      return false;
+    registered.insert(std::make_pair(info, condition.second));
+  }
+
+  includeConditions.swap(registered);
+  return true;
+}
+
+void CGUIWindowCache::Save(const std::string &xmlFile, const TiXmlElement &root, const std::map<INFO::InfoPtr, bool> &includeConditions)
+{
+  std::string cacheFile;
+  std::string signature;
+  {
+    CSingleLock lock(m_section);
+    cacheFile = GetCacheFile(xmlFile);
+    signature = m_signature;
+  }
+  if (cacheFile.empty())
+    return;
+
+  CWindowWriter tree;
+  tree.WriteElement(root);
+
+  std::string data(CACHE_MAGIC, CACHE_MAGIC_SIZE);
+  AppendString(data, signature);
+  AppendNumber(data, static_cast<uint32_t>(includeConditions.size()));
+  for (const auto &condition : includeConditions)
+  {
+    AppendString(data, condition.first->GetExpression());
+    AppendNumber(data, condition.second ? 1 : 0);
+  }
+  data += tree.Finish();
+
+  CFile file;
+  if (!file.OpenForWrite(cacheFile, true) || file.Write(data.c_str(), data.size()) != static_cast<ssize_t>(data.size()))
+  {
+    CLog::Log(LOGWARNING, "CGUIWindowCache: unable to write %s", cacheFile.c_str());
+    file.Close();
+    CFile::Delete(cacheFile);
+  }
+}
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "interfaces/info/InfoBool.h"
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class TiXmlElement;
+
+/*!
+ \brief Stores the window XML of a skin after includes, constants and
+ expressions have been resolved, so that windows can be created without
+ parsing and resolving the skin XML again.
+
+ The resolved tree of each window is kept in a compact binary file in the
+ temp folder. A cached tree is only used if
+ - the skin id, version and all XML files of the skin are unchanged and
+ - all include conditions evaluated while resolving still have the same value.
+ */
+class CGUIWindowCache
+{
+public:
+  CGUIWindowCache() = default;
+
+  /*!
+   \brief Enable the cache for a skin. Computes the signature that
+   invalidates all cached windows once the skin is updated or edited.
+
+   \param skinId id of the skin
+   \param version version of the skin
+   \param skinPaths the folders containing the skin's window XML files
+   */
+  void Initialize(const std::string &skinId, const std::string &version, const std::vector<std::string> &skinPaths);
+
+  /*!
+   \brief Disable the cache
+   */
+  void Deinitialize();
+
+  /*!
+   \brief Read the resolved window XML of the given window file, can be called on any thread
+
+   The XML must only be used if CheckConditions() succeeds for the returned conditions.
+
+   \param xmlFile path of the window XML
+   \param includeConditions filled with the include conditions the window depends on and their values
+   \return the resolved window XML, nullptr if it isn't cached or the skin changed
+   */
+  std::unique_ptr<TiXmlElement> Read(const std::string &xmlFile, std::vector<std::pair<std::string, bool>> &includeConditions);
+
+  /*!
+   \brief Check whether read include conditions still have the value the window was resolved with.
+   Evaluates the conditions, so it must be called on the GUI thread.
+
+   \param conditions the include conditions returned by Read()
+   \param includeConditions filled with the registered conditions if all have the same value
+   \return true if the cached window XML is up to date, false otherwise
+   */
+  static bool CheckConditions(const std::vector<std::pair<std::string, bool>> &conditions, std::map<INFO::InfoPtr, bool> &includeConditions);
+
+  /*!
+   \brief Store the resolved window XML of the given window file
+
+   \param xmlFile path of the window XML
+   \param root the resolved window XML
+   \param includeConditions the include conditions used to resolve the window
+   */
+  void Save(const std::string &xmlFile, const TiXmlElement &root, const std::map<INFO::InfoPtr, bool> &includeConditions);
+
+private:
+  /*!
+   \brief Get the cache file of a window, empty if the window can't be cached
+   */
+  std::string GetCacheFile(const std::string &xmlFile) const;
+
+  CCriticalSection m_section;
+  bool m_enabled = false;
+  std::string m_cachePath;
+  std::string m_signature;
+  std::vector<std::string> m_skinPaths;
+};
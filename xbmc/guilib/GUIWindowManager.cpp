@@ -812,6 +812,9 @@ void CGUIWindowManager::ActivateWindow_Internal(int iWindowID, const std::vector
     return;
   }
 
+  // the current window is still shown while the new one is loaded
+  PrepareWindow(*pNewWindow);
+
   CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetGUIControlsInfoProvider().SetNextWindow(iWindowID);
 
   // deactivate any window
@@ -837,6 +840,38 @@ void CGUIWindowManager::ActivateWindow_Internal(int iWindowID, const std::vector
 //  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetGUIControlsInfoProvider().SetPreviousWindow(WINDOW_INVALID);
 }
 
+void CGUIWindowManager::PrepareWindow(CGUIWindow &window)
+{
+  // a nested activation of a window that is still being prepared uses its preparation
+  auto preparing = m_preparingWindows.find(&window);
+  if (preparing != m_preparingWindows.end())
+  {
+    std::shared_ptr<CEvent> prepared = preparing->second;
+    CSingleExit exitit(CServiceBroker::GetWinSystem()->GetGfxContext());
+    prepared->Wait();
+    return;
+  }
+
+  const int budget = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiWindowPrepareBudget;
+  if (budget < 0 || IsAddonWindow(window.GetID()) || IsPythonWindow(window.GetID()))
+    return;
+
+  std::shared_ptr<CEvent> prepared = window.PrepareAsync();
+  if (!prepared)
+    return;
+
+  m_preparingWindows.insert(std::make_pair(&window, prepared));
+  {
+    CSingleExit exitit(CServiceBroker::GetWinSystem()->GetGfxContext());
+    CGUIDialogBusy *busy = GetWindow<CGUIDialogBusy>(WINDOW_DIALOG_BUSY);
+    if (busy && !busy->IsDialogRunning())
+      CGUIDialogBusy::WaitOnEvent(*prepared, budget, false);
+    else
+      prepared->Wait();
+  }
+  m_preparingWindows.erase(&window);
+}
+
 void CGUIWindowManager::CloseDialogs(bool forceClose) const
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
@@ -1309,6 +1344,10 @@ void CGUIWindowManager::DeInitialize()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
+  // workers preparing windows must be done before the windows are deleted
+  for (const auto& preparing : m_preparingWindows)
+    preparing.second->Wait();
+
   // Need a copy bacause addon-dialogs remove itself on Close()
   std::unordered_map<int, CGUIWindow*> closeMap(m_mapWindows);
   for (const auto& entry : closeMap)
@@ -16,6 +16,8 @@
 #include "messaging/IMessageTarget.h"
 
 #include <list>
+#include <map>
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -244,6 +246,15 @@ private:
    */
   void ActivateWindow_Internal(int windowID, const std::vector<std::string> &params, bool swappingWindows, bool force = false);
 
+  /*! \brief Load the XML of a window about to be activated on a worker thread.
+   *
+   * The GUI keeps rendering the current window meanwhile, the busy dialog is shown
+   * once the preparation takes longer than the windowpreparebudget advanced setting.
+   *
+   * \param window The window to prepare.
+   */
+  void PrepareWindow(CGUIWindow &window);
+
   bool ProcessRenderLoop(bool renderOnly);
 
   bool HandleAction(const CAction &action) const;
@@ -262,6 +273,7 @@ private:
 
   int  m_iNested;
   bool m_initialized;
+  std::map<CGUIWindow*, std::shared_ptr<CEvent>> m_preparingWindows; ///< windows prepared by workers, waited for by nested activations
   mutable bool m_touchGestureActive{false};
   mutable bool m_inhibitTouchGestureEvents{false};
 
@@ -18,6 +18,9 @@
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 /*! \brief Tries to load ids and strings from a strings.po file to the `strings` map.
  * It should only be called from the LoadStr2Mem function to have a fallback.
@@ -198,6 +201,35 @@ const std::string& CLocalizeStrings::Get(uint32_t dwCode) const
   return i->second.strTranslated;
 }
 
+std::wstring CLocalizeStrings::GetFrequentCharacters(size_t count) const
+{
+  std::unordered_map<wchar_t, unsigned int> frequency;
+  {
+    CSharedLock lock(m_stringsMutex);
+    std::wstring text;
+    for (const auto& string : m_strings)
+    {
+      g_charsetConverter.utf8ToW(string.second.strTranslated, text, false);
+      for (wchar_t letter : text)
+      {
+        if (letter >= L' ')
+          frequency[letter]++;
+      }
+    }
+  }
+
+  std::vector<std::pair<wchar_t, unsigned int>> letters(frequency.begin(), frequency.end());
+  std::sort(letters.begin(), letters.end(),
+            [](const std::pair<wchar_t, unsigned int>& a, const std::pair<wchar_t, unsigned int>& b) { return a.second > b.second; });
+  if (letters.size() > count)
+    letters.resize(count);
+
+  std::wstring characters;
+  for (const auto& letter : letters)
+    characters += letter.first;
+  return characters;
+}
+
 void CLocalizeStrings::Clear()
 {
   CExclusiveLock lock(m_stringsMutex);
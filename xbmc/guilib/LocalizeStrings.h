@@ -45,6 +45,13 @@ public:
   bool LoadAddonStrings(const std::string& path, const std::string& language, const std::string& addonId);
   void ClearSkinStrings();
   const std::string& Get(uint32_t code) const;
+
+  /*! \brief Get the characters used most often in the strings
+   \param count the maximum number of characters to return
+   \return the characters, the most frequent first
+   */
+  std::wstring GetFrequentCharacters(size_t count) const;
+
   std::string GetAddonString(const std::string& addonId, uint32_t code);
   void Clear();
 
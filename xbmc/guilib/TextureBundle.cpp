@@ -66,6 +66,14 @@ int CTextureBundle::LoadAnim(const std::string& Filename, CBaseTexture*** ppText
   return 0;
 }
 
+void CTextureBundle::PrefetchTextures(const std::vector<std::string>& filenames)
+{
+  if (m_useXBT)
+  {
+    m_tbXBT.PrefetchTextures(filenames);
+  }
+}
+
 void CTextureBundle::Close()
 {
   m_tbXBT.CloseBundle();
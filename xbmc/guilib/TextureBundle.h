@@ -28,6 +28,7 @@ public:
   bool LoadTexture(const std::string& Filename, CBaseTexture** ppTexture, int &width, int &height);
 
   int LoadAnim(const std::string& Filename, CBaseTexture*** ppTextures, int &width, int &height, int& nLoops, int** ppDelays);
+  void PrefetchTextures(const std::vector<std::string>& filenames);
   void Close();
 private:
   CTextureBundleXBT m_tbXBT;
@@ -16,11 +16,16 @@
 #include "filesystem/XbtManager.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <cstring>
+
 #include <lzo/lzo1x.h>
 
 #ifdef TARGET_WINDOWS_DESKTOP
@@ -33,15 +38,35 @@
 #endif
 #endif
 
+namespace
+{
+// upper limit of the decompressed frames waiting to be loaded
+const uint64_t MAX_PREFETCH_SIZE = 32 * 1024 * 1024;
+}
+
+struct CTextureBundleXBT::CPrefetchedFile
+{
+  CEvent decoded{true};
+  std::vector<std::shared_ptr<const uint8_t>> frames; ///< empty on error
+};
+
+struct CTextureBundleXBT::CPrefetchCache
+{
+  CCriticalSection section;
+  std::map<std::string, std::shared_ptr<CPrefetchedFile>> files; ///< decompressed or being decompressed, not loaded yet
+};
+
 CTextureBundleXBT::CTextureBundleXBT()
   : m_TimeStamp{0}
   , m_themeBundle{false}
+  , m_prefetchCache{std::make_shared<CPrefetchCache>()}
 {
 }
 
 CTextureBundleXBT::CTextureBundleXBT(bool themeBundle)
   : m_TimeStamp{0}
   , m_themeBundle{themeBundle}
+  , m_prefetchCache{std::make_shared<CPrefetchCache>()}
 {
 }
 
@@ -52,6 +77,8 @@ CTextureBundleXBT::~CTextureBundleXBT(void)
 
 void CTextureBundleXBT::CloseBundle()
 {
+  ClearPrefetchedFiles();
+
   if (m_XBTFReader != nullptr && m_XBTFReader->IsOpen())
   {
     XFILE::CXbtManager::GetInstance().Release(CURL(m_path));
@@ -93,6 +120,9 @@ bool CTextureBundleXBT::OpenBundle()
 
   m_path = CSpecialProtocol::TranslatePathConvertCase(m_path);
 
+  // frames of a replaced bundle mustn't be used
+  ClearPrefetchedFiles();
+
   // Load the texture file
   if (!XFILE::CXbtManager::GetInstance().GetReader(CURL(m_path), m_XBTFReader))
   {
@@ -159,8 +189,12 @@ bool CTextureBundleXBT::LoadTexture(const std::string& Filename, CBaseTexture**
   if (file.GetFrames().empty())
     return false;
 
-  CXBTFFrame& frame = file.GetFrames().at(0);
-  if (!ConvertFrameToTexture(Filename, frame, ppTexture))
+  std::vector<std::shared_ptr<const uint8_t>> pixels = GetFramePixels(name, file.GetFrames());
+  if (pixels.empty())
+    return false;
+
+  const CXBTFFrame& frame = file.GetFrames().at(0);
+  if (!ConvertFrameToTexture(Filename, frame, pixels.at(0), ppTexture))
   {
     return false;
   }
@@ -183,6 +217,10 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppT
   if (file.GetFrames().empty())
     return false;
 
+  std::vector<std::shared_ptr<const uint8_t>> pixels = GetFramePixels(name, file.GetFrames());
+  if (pixels.empty())
+    return false;
+
   size_t nTextures = file.GetFrames().size();
   *ppTextures = new CBaseTexture*[nTextures];
   *ppDelays = new int[nTextures];
@@ -191,7 +229,7 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppT
   {
     CXBTFFrame& frame = file.GetFrames().at(i);
 
-    if (!ConvertFrameToTexture(Filename, frame, &((*ppTextures)[i])))
+    if (!ConvertFrameToTexture(Filename, frame, pixels.at(i), &((*ppTextures)[i])))
     {
       return false;
     }
@@ -206,54 +244,116 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppT
   return nTextures;
 }
 
-bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture)
+bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, const CXBTFFrame& frame,
+                                              const std::shared_ptr<const uint8_t>& pixels, CBaseTexture** ppTexture)
 {
-  // found texture - allocate the necessary buffers
-  unsigned char *buffer = new unsigned char [(size_t)frame.GetPackedSize()];
-  if (buffer == NULL)
-  {
-    CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
-    return false;
-  }
-
-  // load the compressed texture
-  if (!m_XBTFReader->Load(frame, buffer))
+  if (pixels == nullptr)
   {
     CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
-    delete[] buffer;
     return false;
   }
 
-  // check if it's packed with lzo
-  if (frame.IsPacked())
-  { // unpack
-    unsigned char *unpacked = new unsigned char[(size_t)frame.GetUnpackedSize()];
-    if (unpacked == NULL)
+  // create an xbmc texture
+  *ppTexture = new CTexture();
+  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), pixels.get());
+
+  return true;
+}
+
+std::vector<std::shared_ptr<const uint8_t>> CTextureBundleXBT::GetFramePixels(const std::string& name, const std::vector<CXBTFFrame>& frames)
+{
+  std::shared_ptr<CPrefetchedFile> prefetched;
+  {
+    CSingleLock lock(m_prefetchCache->section);
+    auto it = m_prefetchCache->files.find(name);
+    if (it != m_prefetchCache->files.end())
     {
-      CLog::Log(LOGERROR, "Out of memory unpacking texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetUnpackedSize());
-      delete[] buffer;
-      return false;
+      prefetched = it->second;
+      m_prefetchCache->files.erase(it);
     }
-    lzo_uint s = (lzo_uint)frame.GetUnpackedSize();
-    if (lzo1x_decompress_safe(buffer, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
-        s != frame.GetUnpackedSize())
+  }
+
+  std::vector<std::shared_ptr<const uint8_t>> pixels;
+  if (prefetched)
+  {
+    // a worker may still be decompressing it, waiting is never longer than doing it here
+    prefetched->decoded.Wait();
+    if (prefetched->frames.size() == frames.size())
+      return prefetched->frames;
+  }
+
+  for (const auto& frame : frames)
+  {
+    std::shared_ptr<const uint8_t> framePixels = DecodeFrame(*m_XBTFReader, frame);
+    if (framePixels == nullptr)
     {
-      CLog::Log(LOGERROR, "Error loading texture: %s: Decompression error", name.c_str());
-      delete[] buffer;
-      delete[] unpacked;
-      return false;
+      CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
+      return {};
     }
-    delete[] buffer;
-    buffer = unpacked;
+    pixels.push_back(std::move(framePixels));
   }
 
-  // create an xbmc texture
-  *ppTexture = new CTexture();
-  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), buffer);
+  return pixels;
+}
 
-  delete[] buffer;
+void CTextureBundleXBT::PrefetchTextures(const std::vector<std::string>& filenames)
+{
+  if (m_XBTFReader == nullptr || !m_XBTFReader->IsOpen())
+    return;
 
-  return true;
+  CSingleLock lock(m_prefetchCache->section);
+
+  // files of an earlier call that are requested again are kept, the others are dropped
+  std::map<std::string, std::shared_ptr<CPrefetchedFile>> cached;
+  cached.swap(m_prefetchCache->files);
+
+  uint64_t size = 0;
+  for (const auto& filename : filenames)
+  {
+    const std::string name = Normalize(filename);
+    if (m_prefetchCache->files.find(name) != m_prefetchCache->files.end())
+      continue;
+
+    CXBTFFile file;
+    if (!m_XBTFReader->Get(name, file) || file.GetFrames().empty())
+      continue;
+
+    size += file.GetUnpackedSize();
+    if (size > MAX_PREFETCH_SIZE)
+      break;
+
+    auto it = cached.find(name);
+    if (it != cached.end())
+    {
+      m_prefetchCache->files.insert(*it);
+      continue;
+    }
+
+    auto prefetched = std::make_shared<CPrefetchedFile>();
+    m_prefetchCache->files.insert(std::make_pair(name, prefetched));
+
+    // the job keeps the reader alive, reading fails once the bundle is closed
+    CXBTFReaderPtr reader = m_XBTFReader;
+    CJobManager::GetInstance().Submit([reader, file, prefetched]() {
+      for (const auto& frame : file.GetFrames())
+      {
+        std::shared_ptr<const uint8_t> pixels = DecodeFrame(*reader, frame);
+        if (pixels == nullptr)
+        {
+          prefetched->frames.clear();
+          break;
+        }
+        prefetched->frames.push_back(std::move(pixels));
+      }
+      prefetched->decoded.Set();
+    }, CJob::PRIORITY_HIGH);
+  }
+}
+
+void CTextureBundleXBT::ClearPrefetchedFiles()
+{
+  CSingleLock lock(m_prefetchCache->section);
+  m_prefetchCache->files.clear();
 }
 
 void CTextureBundleXBT::SetThemeBundle(bool themeBundle)
@@ -274,54 +374,46 @@ std::string CTextureBundleXBT::Normalize(const std::string &name)
   return newName;
 }
 
-uint8_t* CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame)
+std::shared_ptr<const uint8_t> CTextureBundleXBT::DecodeFrame(const CXBTFReader& reader, const CXBTFFrame& frame)
 {
-  uint8_t* packedBuffer = new uint8_t[static_cast<size_t>(frame.GetPackedSize())];
-  if (packedBuffer == nullptr)
-  {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: out of memory loading frame with %" PRIu64" packed bytes", frame.GetPackedSize());
-    return nullptr;
-  }
-
-  // load the compressed texture
-  if (!reader.Load(frame, packedBuffer))
+  std::shared_ptr<const uint8_t> packed = reader.GetFrameData(frame);
+  if (packed == nullptr)
   {
     CLog::Log(LOGERROR, "CTextureBundleXBT: error loading frame");
-    delete[] packedBuffer;
     return nullptr;
   }
 
-  // if the frame isn't packed there's nothing else to be done
+  // if the frame isn't packed the data read from the bundle are the pixels
   if (!frame.IsPacked())
-    return packedBuffer;
+    return packed;
 
-  uint8_t* unpackedBuffer = new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())];
-  if (unpackedBuffer == nullptr)
+  // lzo decompression doesn't need a work buffer and is safe to run on several threads at once
+  std::shared_ptr<uint8_t> unpacked(new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())], std::default_delete<uint8_t[]>());
+  lzo_uint size = static_cast<lzo_uint>(frame.GetUnpackedSize());
+  if (lzo1x_decompress_safe(packed.get(), static_cast<lzo_uint>(frame.GetPackedSize()), unpacked.get(), &size, nullptr) != LZO_E_OK || size != frame.GetUnpackedSize())
   {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: out of memory loading frame with %" PRIu64" unpacked bytes", frame.GetPackedSize());
-    delete[] packedBuffer;
+    CLog::Log(LOGERROR, "CTextureBundleXBT: failed to decompress frame with %" PRIu64" packed bytes to %" PRIu64" bytes", frame.GetPackedSize(), frame.GetUnpackedSize());
     return nullptr;
   }
 
+  return unpacked;
+}
+
+uint8_t* CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame)
+{
   // make sure lzo is initialized
   if (lzo_init() != LZO_E_OK)
   {
     CLog::Log(LOGERROR, "CTextureBundleXBT: failed to initialize lzo");
-    delete[] packedBuffer;
-    delete[] unpackedBuffer;
     return nullptr;
   }
 
-  lzo_uint size = static_cast<lzo_uint>(frame.GetUnpackedSize());
-  if (lzo1x_decompress_safe(packedBuffer, static_cast<lzo_uint>(frame.GetPackedSize()), unpackedBuffer, &size, nullptr) != LZO_E_OK || size != frame.GetUnpackedSize())
-  {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: failed to decompress frame with %" PRIu64" unpacked bytes to %" PRIu64" bytes", frame.GetPackedSize(), frame.GetUnpackedSize());
-    delete[] packedBuffer;
-    delete[] unpackedBuffer;
+  std::shared_ptr<const uint8_t> pixels = DecodeFrame(reader, frame);
+  if (pixels == nullptr)
     return nullptr;
-  }
 
-  delete[] packedBuffer;
+  uint8_t* unpackedBuffer = new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())];
+  memcpy(unpackedBuffer, pixels.get(), static_cast<size_t>(frame.GetUnpackedSize()));
 
   return unpackedBuffer;
 }
@@ -36,19 +36,43 @@ public:
   int LoadAnim(const std::string& Filename, CBaseTexture*** ppTextures,
                 int &width, int &height, int& nLoops, int** ppDelays);
 
+  /*!
+   \brief Decompress the frames of the given textures on worker threads
+   \param filenames names of the textures, as passed to LoadTexture() and LoadAnim()
+
+   The following LoadTexture() and LoadAnim() calls for these textures take
+   the decompressed frames instead of decompressing them on the calling
+   thread. Textures of an earlier call that haven't been loaded since are
+   dropped, unless they are requested again.
+   */
+  void PrefetchTextures(const std::vector<std::string>& filenames);
+
   static uint8_t* UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame);
   
   void CloseBundle();
 
 private:
+  struct CPrefetchedFile;
+  struct CPrefetchCache;
+
   bool OpenBundle();
-  bool ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture);
+  bool ConvertFrameToTexture(const std::string& name, const CXBTFFrame& frame,
+                             const std::shared_ptr<const uint8_t>& pixels, CBaseTexture** ppTexture);
+  std::vector<std::shared_ptr<const uint8_t>> GetFramePixels(const std::string& name, const std::vector<CXBTFFrame>& frames);
+  void ClearPrefetchedFiles();
+
+  /*!
+   \brief Get the pixels of a frame, the frame data itself if it isn't packed
+   \return the pixels, nullptr on error
+   */
+  static std::shared_ptr<const uint8_t> DecodeFrame(const CXBTFReader& reader, const CXBTFFrame& frame);
 
   time_t m_TimeStamp;
 
   bool m_themeBundle;
   std::string m_path;
   std::shared_ptr<CXBTFReader> m_XBTFReader;
+  std::shared_ptr<CPrefetchCache> m_prefetchCache;
 };
 
 
@@ -644,3 +644,49 @@ void CGUITextureManager::GetBundledTexturesFromPath(const std::string& texturePa
   if (items.empty())
     m_TexBundle[1].GetTexturesFromPath(texturePath, items);
 }
+
+void CGUITextureManager::PrefetchTextures(const std::vector<std::string>& textureNames)
+{
+  CSingleLock lock(m_section);
+
+  // same lookup order as HasTexture(), loaded textures and textures outside the bundles are skipped
+  std::vector<std::string> bundled[2];
+  for (const auto& textureName : textureNames)
+  {
+    if (textureName.empty() || !CanLoad(textureName))
+      continue;
+
+    bool loaded = false;
+    for (const auto& texture : m_vecTextures)
+    {
+      if (texture->GetName() == textureName)
+      {
+        loaded = true;
+        break;
+      }
+    }
+    for (const auto& texture : m_unusedTextures)
+    {
+      if (texture.first->GetName() == textureName)
+      {
+        loaded = true;
+        break;
+      }
+    }
+    if (loaded)
+      continue;
+
+    std::string bundledName = CTextureBundle::Normalize(textureName);
+    for (int i = 0; i < 2; i++)
+    {
+      if (m_TexBundle[i].HasFile(bundledName))
+      {
+        bundled[i].push_back(textureName);
+        break;
+      }
+    }
+  }
+
+  for (int i = 0; i < 2; i++)
+    m_TexBundle[i].PrefetchTextures(bundled[i]);
+}
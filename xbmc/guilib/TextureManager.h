@@ -103,6 +103,12 @@ public:
   std::string GetTexturePath(const std::string& textureName, bool directory = false);
   void GetBundledTexturesFromPath(const std::string& texturePath, std::vector<std::string> &items);
 
+  /*!
+   \brief Start decompressing bundled textures that are about to be loaded
+   \param textureNames names as they are later passed to Load(), e.g. all textures of a window
+   */
+  void PrefetchTextures(const std::vector<std::string>& textureNames);
+
   void AddTexturePath(const std::string &texturePath);    ///< Add a new path to the paths to check when loading media
   void SetTexturePath(const std::string &texturePath);    ///< Set a single path as the path to check when loading media (clear then add)
   void RemoveTexturePath(const std::string &texturePath); ///< Remove a path from the paths to check when loading media
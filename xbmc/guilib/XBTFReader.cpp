@@ -19,6 +19,8 @@
 #include "filesystem/SpecialProtocol.h"
 #include "utils/CharsetConverter.h"
 #include "platform/win32/PlatformDefs.h"
+#else
+#include <unistd.h>
 #endif
 
 static bool ReadString(FILE* file, char* str, size_t max_length)
@@ -174,6 +176,9 @@ bool CXBTFReader::IsOpen() const
 
 void CXBTFReader::Close()
 {
+  // waits for frames being read on other threads
+  CExclusiveLock lock(m_fileSection);
+
   if (m_file != nullptr)
   {
     fclose(m_file);
@@ -198,20 +203,46 @@ time_t CXBTFReader::GetLastModificationTimestamp() const
 
 bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer) const
 {
+#ifndef TARGET_WINDOWS
+  // pread doesn't move the shared file position, frames are read on several threads at once
+  CSharedLock lock(m_fileSection);
   if (m_file == nullptr)
     return false;
 
-#if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
-  if (fseeko(m_file, static_cast<off_t>(frame.GetOffset()), SEEK_SET) == -1)
-#elif defined(TARGET_ANDROID)
-  if (fseek(m_file, static_cast<long>(frame.GetOffset()), SEEK_SET) == -1)  // No fseeko64 before N
+  size_t size = static_cast<size_t>(frame.GetPackedSize());
+  off_t offset = static_cast<off_t>(frame.GetOffset());
+  while (size > 0)
+  {
+    ssize_t read = pread(fileno(m_file), buffer, size, offset);
+    if (read <= 0)
+      return false;
+
+    buffer += read;
+    size -= static_cast<size_t>(read);
+    offset += read;
+  }
+
+  return true;
 #else
+  CExclusiveLock lock(m_fileSection);
+  if (m_file == nullptr)
+    return false;
+
   if (fseeko64(m_file, static_cast<off_t>(frame.GetOffset()), SEEK_SET) == -1)
-#endif
     return false;
 
   if (fread(buffer, 1, static_cast<size_t>(frame.GetPackedSize()), m_file) != frame.GetPackedSize())
     return false;
 
   return true;
+#endif
+}
+
+std::shared_ptr<const uint8_t> CXBTFReader::GetFrameData(const CXBTFFrame& frame) const
+{
+  std::shared_ptr<uint8_t> buffer(new uint8_t[static_cast<size_t>(frame.GetPackedSize())], std::default_delete<uint8_t[]>());
+  if (!Load(frame, buffer.get()))
+    return nullptr;
+
+  return buffer;
 }
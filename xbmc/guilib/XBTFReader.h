@@ -9,6 +9,7 @@
 #pragma once
 
 #include "XBTF.h"
+#include "threads/SharedSection.h"
 
 #include <memory>
 #include <stdint.h>
@@ -29,9 +30,19 @@ public:
 
   bool Load(const CXBTFFrame& frame, unsigned char* buffer) const;
 
+  /*!
+   \brief Get a copy of the packed data of a frame
+   \return the data, nullptr on error
+
+   Can be called from any thread. Frames are read concurrently with pread,
+   only platforms without it serialize seek and read on the file.
+   */
+  std::shared_ptr<const uint8_t> GetFrameData(const CXBTFFrame& frame) const;
+
 private:
   std::string m_path;
   FILE* m_file = nullptr;
+  mutable CSharedSection m_fileSection; ///< shared while reading frames, exclusive to close m_file
 };
 
 typedef std::shared_ptr<CXBTFReader> CXBTFReaderPtr;
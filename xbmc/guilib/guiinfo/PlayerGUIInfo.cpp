@@ -334,6 +334,13 @@ bool CPlayerGUIInfo::GetLabel(std::string& value, const CFileItem *item, int con
     case PLAYER_PROCESS_AUDIOBITSPERSAMPLE:
       value = StringUtils::FormatNumber(CServiceBroker::GetDataCacheCore().GetAudioBitsPerSample());
       return true;
+    case PLAYER_PROCESS_AUDIOLATENCY:
+    {
+      int latency = CServiceBroker::GetDataCacheCore().GetAudioLatency();
+      if (latency > 0)
+        value = StringUtils::FormatNumber(latency);
+      return true;
+    }
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // PLAYLIST_*
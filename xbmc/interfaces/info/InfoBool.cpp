@@ -9,6 +9,7 @@
 #include "InfoBool.h"
 
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 
 namespace INFO
 {
@@ -22,4 +23,26 @@ namespace INFO
   {
     StringUtils::ToLower(m_expression);
   }
+
+  bool InfoBool::m_profiling = false;
+
+  void InfoBool::UpdateProfiled(const CGUIListItem *item)
+  {
+    const int64_t start = CurrentHostCounter();
+    Update(item);
+    m_profileTime += CurrentHostCounter() - start;
+    m_profileUpdates++;
+  }
+
+  void InfoBool::GetProfile(int64_t &time, unsigned int &updates) const
+  {
+    time = m_profileTime;
+    updates = m_profileUpdates;
+  }
+
+  void InfoBool::ResetProfile()
+  {
+    m_profileTime = 0;
+    m_profileUpdates = 0;
+  }
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -34,10 +35,10 @@ public:
   inline bool Get(const CGUIListItem *item = NULL)
   {
     if (item && m_listItemDependent)
-      Update(item);
+      UpdateValue(item);
     else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
     {
-      Update(NULL);
+      UpdateValue(NULL);
       m_refreshCounter = m_parentRefreshCounter;
     }
     return m_value;
@@ -66,6 +67,25 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+  int GetContext() const { return m_context; }
+
+  /*! \brief Adapt the order of evaluation to the values seen so far
+   Called on the GUI thread, while Get() may be running on other threads.
+   */
+  virtual void Reorder() {}
+
+  /*! \brief Measure the time spent updating each info bool
+   \sa CGUIInfoManager::LogConditionProfile
+   */
+  static void SetProfiling(bool profiling) { m_profiling = profiling; }
+  static bool IsProfiling() { return m_profiling; }
+
+  /*! \brief Time spent in updates since the last reset, including the time of the info bools this one depends on
+   \param time host counter ticks spent updating
+   \param updates number of updates
+   */
+  void GetProfile(int64_t &time, unsigned int &updates) const;
+  void ResetProfile();
 protected:
 
   bool m_value;                ///< current value
@@ -74,8 +94,21 @@ protected:
   std::string  m_expression;   ///< original expression
 
 private:
+  inline void UpdateValue(const CGUIListItem *item)
+  {
+    if (m_profiling)
+      UpdateProfiled(item);
+    else
+      Update(item);
+  }
+  void UpdateProfiled(const CGUIListItem *item);
+
   unsigned int m_refreshCounter;
   unsigned int &m_parentRefreshCounter;
+  int64_t m_profileTime = 0;
+  unsigned int m_profileUpdates = 0;
+
+  static bool m_profiling;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
@@ -13,20 +13,25 @@
 #include "guilib/GUIComponent.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <stack>
+#include <utility>
+#include <vector>
 
 using namespace INFO;
 
 void InfoSingle::Initialize()
 {
-  m_condition = CServiceBroker::GetGUI()->GetInfoManager().TranslateSingleString(m_expression, m_listItemDependent);
+  m_infoManager = &CServiceBroker::GetGUI()->GetInfoManager();
+  m_condition = m_infoManager->TranslateSingleString(m_expression, m_listItemDependent);
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
 {
-  m_value = CServiceBroker::GetGUI()->GetInfoManager().GetBool(m_condition, m_context, item);
+  m_value = m_infoManager->GetBool(m_condition, m_context, item);
 }
 
 void InfoExpression::Initialize()
@@ -34,19 +39,40 @@ void InfoExpression::Initialize()
   if (!Parse(m_expression))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", m_expression.c_str());
-    m_expression_tree = std::make_shared<InfoLeaf>(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0), false);
+    m_expression_tree = std::make_shared<InfoLeaf>(Register("false"), false);
   }
+  else
+    ShareSubexpressions();
+
+  std::shared_ptr<Code> code = std::make_shared<Code>();
+  Compile(*m_expression_tree, *code);
+  m_code = code;
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  m_value = Evaluate(item);
+}
+
+void InfoExpression::Reorder()
+{
+  if (!SortGroups(*m_expression_tree))
+    return;
+
+  std::shared_ptr<Code> code = std::make_shared<Code>();
+  Compile(*m_expression_tree, *code);
+  std::atomic_store(&m_code, std::shared_ptr<const Code>(code));
+}
+
+InfoPtr InfoExpression::Register(const std::string &expression)
+{
+  return CServiceBroker::GetGUI()->GetInfoManager().Register(expression, m_context);
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
- * formation of groups of associative nodes. These groups are then reordered at
- * evaluation time such that nodes whose value renders the evaluation of the
- * remainder of the group unnecessary tend to be evaluated first (these are
+ * formation of groups of associative nodes. These groups are then reordered
+ * every few frames such that nodes whose value renders the evaluation of
+ * the remainder of the group unnecessary tend to be evaluated first (these are
  * true nodes for OR subexpressions, or false nodes for AND subexpressions).
  * The end effect is to minimise the number of leaf nodes that need to be
  * evaluated in order to determine the value of the expression. The runtime
@@ -61,9 +87,13 @@ void InfoExpression::Update(const CGUIListItem *item)
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
+std::string InfoExpression::InfoLeaf::GetExpression() const
 {
-  return m_invert ^ m_info->Get(item);
+  std::string expression = m_info->GetExpression();
+  // a shared subexpression
+  if (expression.find_first_of("|+[]!") != std::string::npos)
+    expression = "[" + expression + "]";
+  return m_invert ? "!" + expression : expression;
 }
 
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
@@ -86,27 +116,140 @@ void InfoExpression::InfoAssociativeGroup::Merge(std::shared_ptr<InfoAssociative
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
+std::string InfoExpression::InfoAssociativeGroup::GetExpression() const
+{
+  std::string expression;
+  for (const auto &child : m_children)
+  {
+    if (!expression.empty())
+      expression += m_type == NODE_AND ? "+" : "|";
+    if (child->Type() == NODE_LEAF)
+      expression += child->GetExpression();
+    else
+      expression += "[" + child->GetExpression() + "]";
+  }
+  return expression;
+}
+
+/* Groups nested in the top level group are registered as expressions of their
+ * own and replaced by a leaf. Skins repeat the same subexpressions in many
+ * conditions (e.g. [Window.IsActive(a) | Window.IsActive(b)]), these are then
+ * evaluated once per frame for all of them. Registering them recursively does
+ * the same for the groups nested deeper.
+ */
+void InfoExpression::ShareSubexpressions()
+{
+  if (m_expression_tree->Type() == NODE_LEAF)
+    return;
+
+  InfoAssociativeGroup &group = static_cast<InfoAssociativeGroup&>(*m_expression_tree);
+  for (auto &child : group.m_children)
+  {
+    if (child->Type() == NODE_LEAF)
+      continue;
+
+    InfoPtr info = Register(child->GetExpression());
+    if (info)
+      child = std::make_shared<InfoLeaf>(info, false);
+  }
+}
+
+/* The tree is compiled into a list of instructions evaluated in a single loop.
+ * A leaf loads its (possibly inverted) value, every child of a group is
+ * followed by a jump past the group taken when the value decides the group:
+ * true for OR groups, false for AND groups. The jump after the last child
+ * only counts for the reordering. Nested groups leave their value for the
+ * jump of their parent group. For example [A|B]+C compiles to
+ *
+ *   0: LOAD A
+ *   1: JUMP_IF_TRUE 4
+ *   2: LOAD B
+ *   3: JUMP_IF_TRUE 4
+ *   4: JUMP_IF_FALSE 7
+ *   5: LOAD C
+ *   6: JUMP_IF_FALSE 7
+ */
+void InfoExpression::Compile(const InfoSubexpression &node, std::vector<Instruction> &code)
+{
+  if (node.Type() == NODE_LEAF)
+  {
+    const InfoLeaf &leaf = static_cast<const InfoLeaf&>(node);
+    code.push_back({Instruction::LOAD, leaf.m_invert, leaf.m_info.get(), 0, nullptr});
+    return;
+  }
+
+  const InfoAssociativeGroup &group = static_cast<const InfoAssociativeGroup&>(node);
+  const Instruction::opcode_t op = group.m_type == NODE_AND ? Instruction::JUMP_IF_FALSE : Instruction::JUMP_IF_TRUE;
+  std::vector<size_t> jumps;
+  for (const auto &child : group.m_children)
+  {
+    Compile(*child, code);
+    jumps.push_back(code.size());
+    code.push_back({op, false, nullptr, 0, child.get()});
+  }
+  for (size_t jump : jumps)
+    code[jump].m_target = code.size();
+}
+
+bool InfoExpression::Evaluate(const CGUIListItem *item)
 {
-  /* Handle either AND or OR by using the relation
-   * A AND B == !(!A OR !B)
-   * to convert ANDs into ORs
-   */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
+  const std::shared_ptr<const Code> code = std::atomic_load(&m_code);
+  bool value = false;
+  const size_t size = code->size();
+  size_t pc = 0;
+  while (pc < size)
   {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
+    const Instruction &instruction = (*code)[pc];
+    if (instruction.m_op == Instruction::LOAD)
     {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
+      value = instruction.m_invert ^ instruction.m_info->Get(item);
+      pc++;
     }
+    else if (value == (instruction.m_op == Instruction::JUMP_IF_TRUE))
+    {
+      instruction.m_node->m_shortCircuits.fetch_add(1, std::memory_order_relaxed);
+      pc = instruction.m_target;
+    }
+    else
+      pc++;
   }
-  return use_and ^ result;
+  return value;
+}
+
+/* Sort the children of all groups by the number of times they decided their
+ * group. The counts are halved afterwards, so the order follows changes of the
+ * GUI state. Returns true if the order of any group changed. Evaluations only
+ * touch the counts, so the tree can be sorted while they run.
+ */
+bool InfoExpression::SortGroups(InfoSubexpression &node)
+{
+  if (node.Type() == NODE_LEAF)
+    return false;
+
+  InfoAssociativeGroup &group = static_cast<InfoAssociativeGroup&>(node);
+
+  // sort a snapshot of the counts, evaluations keep counting meanwhile
+  std::vector<std::pair<unsigned int, InfoSubexpressionPtr>> children;
+  for (const auto &child : group.m_children)
+    children.emplace_back(child->m_shortCircuits.exchange(0, std::memory_order_relaxed), child);
+
+  // stable, ties keep their order
+  std::stable_sort(children.begin(), children.end(),
+                   [](const std::pair<unsigned int, InfoSubexpressionPtr> &a, const std::pair<unsigned int, InfoSubexpressionPtr> &b)
+                   {
+                     return a.first > b.first;
+                   });
+
+  bool changed = false;
+  auto it = group.m_children.begin();
+  for (const auto &child : children)
+  {
+    changed |= *it != child.second;
+    *it++ = child.second;
+    changed |= SortGroups(*child.second);
+    child.second->m_shortCircuits.fetch_add(child.first / 2, std::memory_order_relaxed);
+  }
+  return changed;
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
@@ -208,8 +351,6 @@ bool InfoExpression::Parse(const std::string &expression)
   bool after_binaryoperator = true;
   int bracket_count = 0;
 
-  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
-
   char c;
   // Skip leading whitespace - don't want it to count as an operand if that's all there is
   while (isspace((unsigned char)(c=*s)))
@@ -236,7 +377,7 @@ bool InfoExpression::Parse(const std::string &expression)
       }
       if (!operand.empty())
       {
-        InfoPtr info = infoMgr.Register(operand, m_context);
+        InfoPtr info = Register(operand);
         if (!info)
         {
           CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
@@ -287,7 +428,7 @@ bool InfoExpression::Parse(const std::string &expression)
   }
   if (!operand.empty())
   {
-    InfoPtr info = infoMgr.Register(operand, m_context);
+    InfoPtr info = Register(operand);
     if (!info)
     {
       CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
@@ -10,10 +10,14 @@
 
 #include "InfoBool.h"
 
+#include <atomic>
 #include <list>
+#include <memory>
 #include <stack>
+#include <string>
 #include <vector>
 
+class CGUIInfoManager;
 class CGUIListItem;
 
 namespace INFO
@@ -30,9 +34,17 @@ public:
   void Update(const CGUIListItem *item) override;
 private:
   int m_condition;             ///< actual condition this represents
+  CGUIInfoManager *m_infoManager = nullptr;
 };
 
 /*! \brief Class to wrap active boolean expressions
+
+ The expression is parsed into a tree, which is then compiled into a flat list
+ of instructions that is evaluated without any recursion or virtual calls.
+ Bracketed subexpressions are registered as info bools of their own, so all
+ expressions using the same subexpression share it and its cached value.
+ Reorder() compiles a new list and swaps it in, evaluations running meanwhile
+ finish on the old one.
  */
 class InfoExpression : public InfoBool
 {
@@ -44,6 +56,14 @@ public:
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
+  void Reorder() override;
+
+protected:
+  /*! \brief Get the info bool of an operand or a subexpression
+   \return the info bool, nullptr if the expression is invalid
+   */
+  virtual InfoPtr Register(const std::string &expression);
+
 private:
   typedef enum
   {
@@ -67,8 +87,10 @@ private:
   {
   public:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(const CGUIListItem *item) = 0;
     virtual node_type_t Type() const=0;
+    virtual std::string GetExpression() const=0;
+
+    std::atomic<unsigned int> m_shortCircuits{0}; ///< number of times this node decided the value of its group
   };
 
   typedef std::shared_ptr<InfoSubexpression> InfoSubexpressionPtr;
@@ -78,9 +100,9 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(info), m_invert(invert) {};
-    bool Evaluate(const CGUIListItem *item) override;
     node_type_t Type() const override { return NODE_LEAF; };
-  private:
+    std::string GetExpression() const override;
+
     InfoPtr m_info;
     bool m_invert;
   };
@@ -92,17 +114,45 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(std::shared_ptr<InfoAssociativeGroup> other);
-    bool Evaluate(const CGUIListItem *item) override;
     node_type_t Type() const override { return m_type; };
-  private:
+    std::string GetExpression() const override;
+
     node_type_t m_type;
     std::list<InfoSubexpressionPtr> m_children;
   };
 
+  /*! \brief Instruction of the compiled expression
+   Leaves load their value into a single register, groups jump past their
+   remaining children as soon as the register decides their value.
+   */
+  struct Instruction
+  {
+    typedef enum
+    {
+      LOAD,
+      JUMP_IF_TRUE,
+      JUMP_IF_FALSE,
+    } opcode_t;
+
+    opcode_t m_op;
+    bool m_invert;              ///< LOAD: invert the value of the info bool
+    InfoBool *m_info;           ///< LOAD: kept alive by the expression tree
+    size_t m_target;            ///< JUMP: index of the first instruction after the group
+    InfoSubexpression *m_node;  ///< JUMP: child of the group that was just evaluated
+  };
+
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
   bool Parse(const std::string &expression);
+  void ShareSubexpressions();
+  static void Compile(const InfoSubexpression &node, std::vector<Instruction> &code);
+  static bool SortGroups(InfoSubexpression &node);
+  bool Evaluate(const CGUIListItem *item);
+
+  typedef std::vector<Instruction> Code;
+
   InfoSubexpressionPtr m_expression_tree;
+  std::shared_ptr<const Code> m_code; ///< swapped atomically by Reorder()
 };
 
 };
@@ -0,0 +1,198 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/info/InfoExpression.h"
+#include "utils/StringUtils.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace INFO;
+
+namespace
+{
+// a condition with a value set by the test, counting its updates
+class TestCondition : public InfoBool
+{
+public:
+  TestCondition(const std::string &expression, unsigned int &refreshCounter)
+    : InfoBool(expression, 0, refreshCounter) {}
+
+  void Update(const CGUIListItem *item) override
+  {
+    m_value = value;
+    updates++;
+  }
+
+  bool value = false;
+  unsigned int updates = 0;
+};
+
+class TestInfoExpression : public ::testing::Test
+{
+protected:
+  // registers conditions and subexpressions like the info manager, without a GUI
+  class TestExpression : public InfoExpression
+  {
+  public:
+    TestExpression(const std::string &expression, TestInfoExpression &test)
+      : InfoExpression(expression, 0, test.m_refreshCounter), m_test(test) {}
+
+  protected:
+    InfoPtr Register(const std::string &expression) override
+    {
+      return m_test.Register(expression);
+    }
+
+  private:
+    TestInfoExpression &m_test;
+  };
+
+  InfoPtr Register(std::string expression)
+  {
+    StringUtils::Trim(expression);
+    auto it = m_bools.find(expression);
+    if (it != m_bools.end())
+      return it->second;
+
+    InfoPtr info;
+    if (expression.find_first_of("|+[]!") != std::string::npos)
+      info = std::make_shared<TestExpression>(expression, *this);
+    else
+      info = m_conditions[expression] = std::make_shared<TestCondition>(expression, m_refreshCounter);
+    m_bools[expression] = info;
+    info->Initialize();
+    return info;
+  }
+
+  TestCondition &Condition(const std::string &name)
+  {
+    return *m_conditions[name];
+  }
+
+  // 0 refreshes info bools on every Get()
+  unsigned int m_refreshCounter = 0;
+  std::map<std::string, InfoPtr> m_bools;
+  std::map<std::string, std::shared_ptr<TestCondition>> m_conditions;
+};
+}
+
+TEST_F(TestInfoExpression, Evaluate)
+{
+  InfoPtr expression = Register("a + [b | !c] + !d");
+  for (int values = 0; values < 16; values++)
+  {
+    const bool a = values & 1, b = values & 2, c = values & 4, d = values & 8;
+    Condition("a").value = a;
+    Condition("b").value = b;
+    Condition("c").value = c;
+    Condition("d").value = d;
+    EXPECT_EQ(a && (b || !c) && !d, expression->Get()) << "values " << values;
+  }
+}
+
+TEST_F(TestInfoExpression, NotOfGroup)
+{
+  InfoPtr expression = Register("![a + b] | c");
+  for (int values = 0; values < 8; values++)
+  {
+    const bool a = values & 1, b = values & 2, c = values & 4;
+    Condition("a").value = a;
+    Condition("b").value = b;
+    Condition("c").value = c;
+    EXPECT_EQ(!(a && b) || c, expression->Get()) << "values " << values;
+  }
+}
+
+TEST_F(TestInfoExpression, ShortCircuits)
+{
+  InfoPtr expression = Register("a | b");
+  Condition("a").value = true;
+  EXPECT_TRUE(expression->Get());
+  EXPECT_EQ(1U, Condition("a").updates);
+  EXPECT_EQ(0U, Condition("b").updates);
+
+  Condition("a").value = false;
+  EXPECT_FALSE(expression->Get());
+  EXPECT_EQ(2U, Condition("a").updates);
+  EXPECT_EQ(1U, Condition("b").updates);
+}
+
+TEST_F(TestInfoExpression, SharesSubexpressions)
+{
+  InfoPtr first = Register("a + [b | c]");
+  InfoPtr second = Register("d + [b | c]");
+  ASSERT_EQ(1U, m_bools.count("b|c"));
+
+  Condition("a").value = true;
+  Condition("b").value = true;
+  EXPECT_TRUE(first->Get());
+  EXPECT_FALSE(second->Get());
+  Condition("d").value = true;
+  EXPECT_TRUE(second->Get());
+}
+
+TEST_F(TestInfoExpression, ParseError)
+{
+  // evaluates to false
+  InfoPtr expression = Register("a + [b");
+  Condition("a").value = true;
+  EXPECT_FALSE(expression->Get());
+  EXPECT_EQ(1U, m_conditions.count("false"));
+}
+
+TEST_F(TestInfoExpression, Reorder)
+{
+  InfoPtr expression = Register("a | b | c");
+
+  // c decides the group every time, it's evaluated first after reordering
+  Condition("c").value = true;
+  for (int i = 0; i < 10; i++)
+    EXPECT_TRUE(expression->Get());
+  EXPECT_EQ(10U, Condition("a").updates);
+  EXPECT_EQ(10U, Condition("b").updates);
+
+  expression->Reorder();
+  EXPECT_TRUE(expression->Get());
+  EXPECT_EQ(10U, Condition("a").updates);
+  EXPECT_EQ(10U, Condition("b").updates);
+  EXPECT_EQ(11U, Condition("c").updates);
+
+  // the value doesn't depend on the order
+  Condition("c").value = false;
+  EXPECT_FALSE(expression->Get());
+  Condition("a").value = true;
+  EXPECT_TRUE(expression->Get());
+}
+
+TEST_F(TestInfoExpression, ReorderNestedGroups)
+{
+  InfoPtr expression = Register("[a + b] | [c + d]");
+  ASSERT_EQ(1U, m_bools.count("a+b"));
+  ASSERT_EQ(1U, m_bools.count("c+d"));
+  InfoPtr first = m_bools["a+b"];
+
+  // b decides a + b, so it moves in front of a
+  Condition("a").value = true;
+  for (int i = 0; i < 10; i++)
+    EXPECT_FALSE(first->Get());
+
+  first->Reorder();
+  const unsigned int updates = Condition("a").updates;
+  EXPECT_FALSE(first->Get());
+  EXPECT_EQ(updates, Condition("a").updates);
+
+  Condition("c").value = true;
+  Condition("d").value = true;
+  EXPECT_TRUE(expression->Get());
+  Condition("b").value = true;
+  EXPECT_TRUE(first->Get());
+}
@@ -7551,6 +7551,257 @@ int CMusicDatabase::GetSongsCount(const Filter &filter)
   return 0;
 }
 
+bool CMusicDatabase::CanSortSongsInSQL(const SortDescription &sortDescription)
+{
+  switch (sortDescription.sortBy)
+  {
+    case SortByNone:
+    case SortByTitle:
+    case SortByArtist:
+    case SortByArtistThenYear:
+    case SortByAlbum:
+    case SortByTrackNumber:
+    case SortByYear:
+    case SortByTime:
+    case SortByDateAdded:
+    case SortByPlaycount:
+    case SortByLastPlayed:
+    case SortByRating:
+    case SortByUserRating:
+    case SortByGenre:
+      return true;
+    default:
+      // also SortByLabel, labels are formatted with the user's track format and have no column
+      return false;
+  }
+}
+
+bool CMusicDatabase::GetSongsSortExpression(const SortDescription &sortDescription, std::string &expression, bool &text, std::vector<std::string> &thenBy)
+{
+  // text columns are compared case insensitive and honour the sort attributes
+  auto textColumn = [this, &sortDescription](const std::string &column, bool useArtistSort)
+  {
+    std::string sortSQL;
+    if (useArtistSort && (sortDescription.sortAttributes & SortAttributeUseArtistSortName))
+      sortSQL = "WHEN strArtistSort IS NOT NULL THEN strArtistSort ";
+    if (sortDescription.sortAttributes & SortAttributeIgnoreArticle)
+      sortSQL += GetIgnoreArticleSQL(column);
+    // Not prepared as the ignore article clauses may contain ' and %
+    if (sortSQL.empty())
+      return column;
+    return "CASE " + sortSQL + " ELSE " + column + " END";
+  };
+
+  // the same keys as the sort labels of SortUtils, e.g. album, artist and track number when sorting by album
+  text = false;
+  thenBy.clear();
+  switch (sortDescription.sortBy)
+  {
+    case SortByNone:
+      expression = "idSong";
+      return true;
+    case SortByTitle:
+      expression = textColumn("strTitle", false);
+      text = true;
+      break;
+    case SortByArtist:
+      expression = textColumn("strArtists", true);
+      text = true;
+      thenBy.push_back(textColumn("strAlbum", false) + " COLLATE NOCASE");
+      thenBy.push_back("iTrack");
+      break;
+    case SortByArtistThenYear:
+      expression = textColumn("strArtists", true);
+      text = true;
+      thenBy.push_back("iYear");
+      thenBy.push_back(textColumn("strAlbum", false) + " COLLATE NOCASE");
+      thenBy.push_back("iTrack");
+      break;
+    case SortByAlbum:
+      expression = textColumn("strAlbum", false);
+      text = true;
+      thenBy.push_back(textColumn("strArtists", false) + " COLLATE NOCASE");
+      thenBy.push_back("iTrack");
+      break;
+    case SortByGenre:
+      expression = textColumn("strGenres", false);
+      text = true;
+      break;
+    case SortByTrackNumber:
+      expression = "iTrack";
+      break;
+    case SortByYear:
+      expression = "iYear";
+      thenBy.push_back(textColumn("strAlbum", false) + " COLLATE NOCASE");
+      thenBy.push_back("iTrack");
+      break;
+    case SortByTime:
+      expression = "iDuration";
+      break;
+    case SortByDateAdded:
+      expression = "dateAdded";
+      break;
+    case SortByPlaycount:
+      expression = "iTimesPlayed";
+      break;
+    case SortByLastPlayed:
+      expression = "lastplayed";
+      break;
+    case SortByRating:
+      expression = "rating";
+      break;
+    case SortByUserRating:
+      expression = "userrating";
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+bool CMusicDatabase::GetSongsSubquerySQL(const std::string &baseDir, CMusicDbUrl &musicUrl, std::string &strSQL)
+{
+  Filter extFilter;
+  SortDescription sorting;
+  if (!musicUrl.FromString(baseDir) || musicUrl.GetType() != "songs" || !GetFilter(musicUrl, extFilter, sorting))
+    return false;
+
+  // same as GetSongsFullByWhere, conditions might need access to albumview
+  if (extFilter.where.find("albumview") != std::string::npos)
+  {
+    extFilter.AppendJoin("JOIN albumview ON albumview.idAlbum = songview.idAlbum");
+    extFilter.AppendGroup("songview.idSong");
+  }
+
+  std::string strSQLExtra;
+  if (!BuildSQL(strSQLExtra, extFilter, strSQLExtra))
+    return false;
+
+  // a subquery so the columns can be used unqualified even with the albumview join
+  strSQL = "(SELECT songview.* FROM songview " + strSQLExtra + ") AS songs";
+  return true;
+}
+
+int CMusicDatabase::GetSongsCountByUrl(const std::string &baseDir)
+{
+  if (m_pDB.get() == NULL || m_pDS.get() == NULL)
+    return 0;
+
+  try
+  {
+    CMusicDbUrl musicUrl;
+    std::string strSongs;
+    if (!GetSongsSubquerySQL(baseDir, musicUrl, strSongs))
+      return 0;
+
+    return (int)strtol(GetSingleValue("SELECT COUNT(1) FROM " + strSongs, m_pDS).c_str(), NULL, 10);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s(%s) failed", __FUNCTION__, baseDir.c_str());
+  }
+  return 0;
+}
+
+bool CMusicDatabase::GetSongsPage(const std::string &baseDir, const SortDescription &sortDescription, int start, int count, CFileItemList &items)
+{
+  if (m_pDB.get() == NULL || m_pDS.get() == NULL)
+    return false;
+
+  try
+  {
+    CMusicDbUrl musicUrl;
+    std::string strSongs;
+    std::string sortExpression;
+    bool text;
+    std::vector<std::string> thenBy;
+    if (!GetSongsSubquerySQL(baseDir, musicUrl, strSongs) ||
+        !GetSongsSortExpression(sortDescription, sortExpression, text, thenBy))
+      return false;
+
+    std::string DESC;
+    if (sortDescription.sortOrder == SortOrderDescending)
+      DESC = " DESC";
+
+    // idSong keeps the order of songs with the same sort values stable between pages
+    std::string strSQL = "SELECT * FROM " + strSongs + " ORDER BY " + sortExpression;
+    strSQL += PrepareSQL("%s%s", text ? " COLLATE NOCASE" : "", DESC.c_str());
+    for (const auto& term : thenBy)
+      strSQL += ", " + term + DESC;
+    strSQL += PrepareSQL(", idSong%s", DESC.c_str());
+    strSQL += DatabaseUtils::BuildLimitClause(start + count, start);
+
+    CLog::Log(LOGDEBUG, "%s query = %s", __FUNCTION__, strSQL.c_str());
+    if (!m_pDS->query(strSQL))
+      return false;
+
+    items.Reserve(m_pDS->num_rows());
+    while (!m_pDS->eof())
+    {
+      CFileItemPtr item(new CFileItem);
+      GetFileItemFromDataset(item.get(), musicUrl);
+      items.Add(item);
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    m_pDS->close();
+    CLog::Log(LOGERROR, "%s(%s) failed", __FUNCTION__, baseDir.c_str());
+  }
+  return false;
+}
+
+bool CMusicDatabase::GetSongsLetterOffsets(const std::string &baseDir, const SortDescription &sortDescription, std::vector<std::pair<int, std::string>> &offsets)
+{
+  offsets.clear();
+  if (m_pDB.get() == NULL || m_pDS.get() == NULL)
+    return false;
+
+  try
+  {
+    CMusicDbUrl musicUrl;
+    std::string strSongs;
+    std::string sortExpression;
+    bool text;
+    std::vector<std::string> thenBy;
+    if (!GetSongsSubquerySQL(baseDir, musicUrl, strSongs) ||
+        !GetSongsSortExpression(sortDescription, sortExpression, text, thenBy))
+      return false;
+
+    // no letters to jump to when sorting by numbers or dates
+    if (!text)
+      return true;
+
+    std::string strSQL = "SELECT SUBSTR(" + sortExpression + ", 1, 1) AS letter, COUNT(1) AS songs FROM " + strSongs;
+    strSQL += PrepareSQL(" GROUP BY UPPER(letter) ORDER BY letter COLLATE NOCASE%s",
+                         sortDescription.sortOrder == SortOrderDescending ? " DESC" : "");
+    if (!m_pDS->query(strSQL))
+      return false;
+
+    int offset = 0;
+    while (!m_pDS->eof())
+    {
+      std::string letter = m_pDS->fv("letter").get_asString();
+      StringUtils::ToUpper(letter);
+      if (offsets.empty() || offsets.back().second != letter)
+        offsets.push_back(std::make_pair(offset, letter));
+      offset += m_pDS->fv("songs").get_asInt();
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    m_pDS->close();
+    CLog::Log(LOGERROR, "%s(%s) failed", __FUNCTION__, baseDir.c_str());
+  }
+  return false;
+}
+
 bool CMusicDatabase::GetAlbumPath(int idAlbum, std::string& basePath)
 {
   basePath.clear();
@@ -451,6 +451,16 @@ public:
   bool GetAlbumsByWhere(const std::string &baseDir, const Filter &filter, CFileItemList &items, const SortDescription &sortDescription = SortDescription(), bool countOnly = false);
   bool GetArtistsByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, const SortDescription &sortDescription = SortDescription(), bool countOnly = false);
   int GetSongsCount(const Filter &filter = Filter());
+
+  /*! \brief Queries on the songs of a musicdb:// path for virtual lists, which never load all songs at once
+  \param baseDir the musicdb:// path, including its options
+  \param sortDescription only the sort method, order and attributes are used, sorting by an
+  unsupported method fails
+  */
+  int GetSongsCountByUrl(const std::string &baseDir);
+  bool GetSongsPage(const std::string &baseDir, const SortDescription &sortDescription, int start, int count, CFileItemList &items);
+  bool GetSongsLetterOffsets(const std::string &baseDir, const SortDescription &sortDescription, std::vector<std::pair<int, std::string>> &offsets);
+  static bool CanSortSongsInSQL(const SortDescription &sortDescription);
   bool GetFilter(CDbUrl &musicUrl, Filter &filter, SortDescription &sorting) override;
 
   /////////////////////////////////////////////////
@@ -685,6 +695,19 @@ private:
   */
   std::string GetIgnoreArticleSQL(const std::string& strField);
 
+  /*! \brief Build the subquery selecting the songs of a musicdb:// path as "songs"
+  \return false if the path is no valid songs path
+  */
+  bool GetSongsSubquerySQL(const std::string &baseDir, CMusicDbUrl &musicUrl, std::string &strSQL);
+
+  /*! \brief Build the expressions songs are sorted by in SQL
+  \param expression the first sort key
+  \param text set to true if the first key is a text whose first letters can be jumped to
+  \param thenBy the keys sorting songs with the same first key, e.g. artist and track number for albums
+  \return false if sorting by this method isn't supported in SQL
+  */
+  bool GetSongsSortExpression(const SortDescription &sortDescription, std::string &expression, bool &text, std::vector<std::string> &thenBy);
+
   /*! \brief Build SQL for sort name scalar subquery from sort attributes and ignore article list.
   \param strAlias alias name of scalar subquery field
   \param sortAttributes the sort attributes e.g. SortAttributeIgnoreArticle
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "MusicDatabaseSongSource.h"
+
+#include "FileItem.h"
+
+CMusicDatabaseSongSource::CMusicDatabaseSongSource(const std::string &baseDir)
+  : m_baseDir(baseDir)
+{
+  m_open = m_database.Open();
+}
+
+CMusicDatabaseSongSource::~CMusicDatabaseSongSource()
+{
+  if (m_open)
+    m_database.Close();
+}
+
+std::unique_ptr<IFileItemListSource> CMusicDatabaseSongSource::Clone() const
+{
+  std::unique_ptr<CMusicDatabaseSongSource> source(new CMusicDatabaseSongSource(m_baseDir));
+  source->m_sortDescription = m_sortDescription;
+  return std::move(source);
+}
+
+int CMusicDatabaseSongSource::GetCount()
+{
+  if (!m_open)
+    return 0;
+
+  return m_database.GetSongsCountByUrl(m_baseDir);
+}
+
+bool CMusicDatabaseSongSource::GetItems(int start, int count, CFileItemList &items)
+{
+  if (!m_open)
+    return false;
+
+  return m_database.GetSongsPage(m_baseDir, m_sortDescription, start, count, items);
+}
+
+bool CMusicDatabaseSongSource::CanSort(const SortDescription &sortDescription) const
+{
+  return CMusicDatabase::CanSortSongsInSQL(sortDescription);
+}
+
+bool CMusicDatabaseSongSource::Sort(const SortDescription &sortDescription)
+{
+  if (!CanSort(sortDescription))
+    return false;
+
+  m_sortDescription = sortDescription;
+  return true;
+}
+
+bool CMusicDatabaseSongSource::GetLetterOffsets(std::vector<std::pair<int, std::string>> &offsets)
+{
+  if (!m_open)
+    return false;
+
+  return m_database.GetSongsLetterOffsets(m_baseDir, m_sortDescription, offsets);
+}
@@ -0,0 +1,40 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "IFileItemListSource.h"
+#include "music/MusicDatabase.h"
+
+#include <memory>
+#include <string>
+
+/*!
+ \brief Songs of a musicdb:// path for virtual lists, counted, sorted and paged in SQL.
+
+ Keeps its database connection open for as long as the list is shown.
+ */
+class CMusicDatabaseSongSource : public IFileItemListSource
+{
+public:
+  explicit CMusicDatabaseSongSource(const std::string &baseDir);
+  ~CMusicDatabaseSongSource() override;
+
+  std::unique_ptr<IFileItemListSource> Clone() const override;
+  int GetCount() override;
+  bool GetItems(int start, int count, CFileItemList &items) override;
+  bool CanSort(const SortDescription &sortDescription) const override;
+  bool Sort(const SortDescription &sortDescription) override;
+  bool GetLetterOffsets(std::vector<std::pair<int, std::string>> &offsets) override;
+
+private:
+  CMusicDatabase m_database;
+  bool m_open;
+  std::string m_baseDir;
+  SortDescription m_sortDescription;
+};
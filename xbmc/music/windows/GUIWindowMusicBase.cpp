@@ -317,9 +317,10 @@ void CGUIWindowMusicBase::RetrieveMusicInfo()
   OnRetrieveMusicInfo(*m_vecItems);
 
   //! @todo Scan for multitrack items here...
+  // (virtual lists only page in songs of the library, the scanner split their cue sheets already)
   std::vector<std::string> itemsForRemove;
   CFileItemList itemsForAdd;
-  for (int i = 0; i < m_vecItems->Size(); ++i)
+  for (int i = 0; i < m_vecItems->GetAddedCount(); ++i)
   {
     CFileItemPtr pItem = (*m_vecItems)[i];
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics() || pItem->IsVideo())
@@ -337,7 +338,7 @@ void CGUIWindowMusicBase::RetrieveMusicInfo()
   }
   for (size_t i = 0; i < itemsForRemove.size(); ++i)
   {
-    for (int j = 0; j < m_vecItems->Size(); ++j)
+    for (int j = 0; j < m_vecItems->GetAddedCount(); ++j)
     {
       if ((*m_vecItems)[j]->GetPath() == itemsForRemove[i])
       {
@@ -907,7 +908,9 @@ bool CGUIWindowMusicBase::GetDirectory(const std::string &strDirectory, CFileIte
   if (bResult)
   {
     // We always want to expand disc images in music windows.
-    CDirectory::FilterFileDirectories(items, ".iso", true);
+    // (virtual lists only have songs of the library)
+    if (!items.IsVirtual())
+      CDirectory::FilterFileDirectories(items, ".iso", true);
 
     CMusicThumbLoader loader;
     loader.FillThumb(items);
@@ -29,11 +29,14 @@
 #include "input/Key.h"
 #include "messaging/ApplicationMessenger.h"
 #include "messaging/helpers/DialogOKHelper.h"
+#include "music/MusicDatabaseSongSource.h"
+#include "music/MusicThumbLoader.h"
 #include "music/dialogs/GUIDialogInfoProviderSettings.h"
 #include "music/tags/MusicInfoTag.h"
 #include "playlists/PlayList.h"
 #include "playlists/PlayListFactory.h"
 #include "profiles/ProfileManager.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "storage/MediaManager.h"
@@ -99,10 +102,12 @@ bool CGUIWindowMusicNav::OnMessage(CGUIMessage& message)
       {
         CURL url(message.GetStringParam(0));
 
-        int i = 0;
-        for (; i < m_vecItems->Size(); i++)
+        // only the loaded items of virtual lists, loading all of them would block the GUI
+        std::vector<std::pair<int, CFileItemPtr>> items;
+        m_vecItems->GetLoadedItems(items);
+        for (const auto& item : items)
         {
-          CFileItemPtr pItem = m_vecItems->Get(i);
+          CFileItemPtr pItem = item.second;
 
           // skip ".."
           if (pItem->IsParentFolder())
@@ -110,10 +115,9 @@ bool CGUIWindowMusicNav::OnMessage(CGUIMessage& message)
 
           if (URIUtils::PathEquals(pItem->GetPath(), message.GetStringParam(0), true, true))
           {
-            m_viewControl.SetSelectedItem(i);
-            i = -1;
+            m_viewControl.SetSelectedItem(item.first);
             if (url.GetOption("showinfo") == "true")
-              OnItemInfo(i);
+              OnItemInfo(-1);
             break;
           }
         }
@@ -395,7 +399,11 @@ bool CGUIWindowMusicNav::Update(const std::string &strDirectory, bool updateFilt
 
   if (CGUIWindowMusicBase::Update(strDirectory, updateFilterPath))
   {
-    m_thumbLoader.Load(*m_unfilteredItems);
+    // the art of virtual lists is looked up page by page in OnPrepareVirtualItems
+    if (!m_unfilteredItems->IsVirtual())
+      m_thumbLoader.Load(*m_unfilteredItems);
+    else if (!m_vecItems->IsVirtual())
+      m_thumbLoader.Load(*m_vecItems); // all items were loaded to sort them in memory
     return true;
   }
 
@@ -412,6 +420,10 @@ bool CGUIWindowMusicNav::GetDirectory(const std::string &strDirectory, CFileItem
   {
     if (items.IsPlayList())
       OnRetrieveMusicInfo(items);
+
+    std::string label;
+    if (items.IsVirtual() && CMusicDatabaseDirectory::GetLabel(strDirectory, label))
+      items.SetLabel(label);
   }
 
   // update our content in the info manager
@@ -490,6 +502,36 @@ bool CGUIWindowMusicNav::GetDirectory(const std::string &strDirectory, CFileItem
   return bResult;
 }
 
+std::unique_ptr<IFileItemListSource> CGUIWindowMusicNav::GetVirtualSource(const std::string &strDirectory)
+{
+  const int threshold = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiVirtualListThreshold;
+  if (threshold <= 0 || !StringUtils::StartsWithNoCase(strDirectory, "musicdb://"))
+    return nullptr;
+
+  // only the songs nodes without extra items and limits
+  CMusicDatabaseDirectory dir;
+  if (dir.GetDirectoryChildType(strDirectory) != NODE_TYPE_SONG)
+    return nullptr;
+
+  std::unique_ptr<CMusicDatabaseSongSource> source(new CMusicDatabaseSongSource(strDirectory));
+  if (source->GetCount() < threshold)
+    return nullptr;
+
+  CLog::Log(LOGDEBUG, "CGUIWindowMusicNav::GetVirtualSource - paging in the songs of %s",
+            CURL::GetRedacted(strDirectory).c_str());
+  return std::move(source);
+}
+
+void CGUIWindowMusicNav::OnPrepareVirtualItems(CFileItemList &items)
+{
+  // only the art already cached, looking it up in the files of every page would stall scrolling
+  CMusicThumbLoader loader;
+  loader.OnLoaderStart();
+  for (int i = 0; i < items.Size(); i++)
+    loader.LoadItemCached(items[i].get());
+  loader.OnLoaderFinish();
+}
+
 void CGUIWindowMusicNav::UpdateButtons()
 {
   CGUIWindowMusicBase::UpdateButtons();
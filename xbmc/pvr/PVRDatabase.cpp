@@ -26,7 +26,9 @@
 #include <cstdlib>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -673,13 +675,17 @@ bool CPVRDatabase::PersistChannels(CPVRChannelGroup &group)
 {
   bool bReturn(true);
 
+  /* look up the ids of all stored channels at once instead of once per channel */
+  std::map<std::pair<int, int>, int> channelIds = GetChannelIds();
+
   CPVRChannelPtr channel;
   for (const auto& groupMember : group.m_members)
   {
     channel = groupMember.second.channel;
     if (channel->IsChanged() || channel->IsNew())
     {
-      if (Persist(*channel, false))
+      const auto it = channelIds.find(std::make_pair(channel->ClientID(), channel->UniqueID()));
+      if (QueuePersistQuery(*channel, it != channelIds.end() ? it->second : -1))
       {
         groupMember.second.channel->Persisted();
         bReturn = true;
@@ -691,21 +697,45 @@ bool CPVRDatabase::PersistChannels(CPVRChannelGroup &group)
 
   if (bReturn)
   {
-    std::string strQuery;
-    std::string strValue;
+    channelIds = GetChannelIds();
     for (const auto& groupMember : group.m_members)
     {
       channel = groupMember.second.channel;
-      strQuery = PrepareSQL("iUniqueId = %u AND iClientId = %u", channel->UniqueID(), channel->ClientID());
-      strValue = GetSingleValue("channels", "idChannel", strQuery);
-      if (!strValue.empty() && StringUtils::IsInteger(strValue))
-        channel->SetChannelID(atoi(strValue.c_str()));
+      const auto it = channelIds.find(std::make_pair(channel->ClientID(), channel->UniqueID()));
+      if (it != channelIds.end())
+        channel->SetChannelID(it->second);
     }
   }
 
   return bReturn;
 }
 
+std::map<std::pair<int, int>, int> CPVRDatabase::GetChannelIds()
+{
+  std::map<std::pair<int, int>, int> channelIds;
+
+  CSingleLock lock(m_critSection);
+  if (ResultQuery("SELECT idChannel, iClientId, iUniqueId FROM channels"))
+  {
+    try
+    {
+      while (!m_pDS->eof())
+      {
+        channelIds.insert(std::make_pair(std::make_pair(m_pDS->fv("iClientId").get_asInt(), m_pDS->fv("iUniqueId").get_asInt()),
+                                         m_pDS->fv("idChannel").get_asInt()));
+        m_pDS->next();
+      }
+      m_pDS->close();
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Couldn't load channel ids from PVR database");
+    }
+  }
+
+  return channelIds;
+}
+
 bool CPVRDatabase::PersistGroupMembers(const CPVRChannelGroup &group)
 {
   bool bReturn = true;
@@ -715,13 +745,33 @@ bool CPVRDatabase::PersistGroupMembers(const CPVRChannelGroup &group)
 
   if (group.HasChannels())
   {
-    for (const auto& groupMember : group.m_sortedMembers)
+    /* get the stored members at once instead of checking every member on its own */
+    std::set<std::tuple<int, unsigned int, unsigned int>> storedMembers;
+    if (group.GroupID() > 0 &&
+        ResultQuery(PrepareSQL("SELECT idChannel, iChannelNumber, iSubChannelNumber FROM map_channelgroups_channels WHERE idGroup = %u", group.GroupID())))
     {
-      const std::string strWhereClause = PrepareSQL("idChannel = %u AND idGroup = %u AND iChannelNumber = %u AND iSubChannelNumber = %u",
-          groupMember.channel->ChannelID(), group.GroupID(), groupMember.channelNumber.GetChannelNumber(), groupMember.channelNumber.GetSubChannelNumber());
+      try
+      {
+        while (!m_pDS->eof())
+        {
+          storedMembers.insert(std::make_tuple(m_pDS->fv("idChannel").get_asInt(),
+                                               static_cast<unsigned int>(m_pDS->fv("iChannelNumber").get_asInt()),
+                                               static_cast<unsigned int>(m_pDS->fv("iSubChannelNumber").get_asInt())));
+          m_pDS->next();
+        }
+        m_pDS->close();
+      }
+      catch (...)
+      {
+        CLog::LogF(LOGERROR, "Couldn't load channel group members from PVR database");
+      }
+    }
 
-      const std::string strValue = GetSingleValue("map_channelgroups_channels", "idChannel", strWhereClause);
-      if (strValue.empty())
+    for (const auto& groupMember : group.m_sortedMembers)
+    {
+      if (storedMembers.find(std::make_tuple(groupMember.channel->ChannelID(),
+                                             groupMember.channelNumber.GetChannelNumber(),
+                                             groupMember.channelNumber.GetSubChannelNumber())) == storedMembers.end())
       {
         strQuery = PrepareSQL("REPLACE INTO map_channelgroups_channels ("
             "idGroup, idChannel, iChannelNumber, iSubChannelNumber) "
@@ -791,21 +841,29 @@ bool CPVRDatabase::Persist(CPVRChannelGroup &group)
 
 bool CPVRDatabase::Persist(CPVRChannel &channel, bool bCommit)
 {
-  bool bReturn(false);
+  CSingleLock lock(m_critSection);
+
+  // Note: Do not use channel.ChannelID value to check presence of channel in channels table. It might not yet be set correctly.
+  const std::string strQuery = PrepareSQL("iUniqueId = %u AND iClientId = %u", channel.UniqueID(), channel.ClientID());
+  const std::string strValue = GetSingleValue("channels", "idChannel", strQuery);
+
+  if (!QueuePersistQuery(channel, strValue.empty() ? -1 : std::atoi(strValue.c_str())))
+    return false;
 
+  return bCommit ? CommitInsertQueries() : true;
+}
+
+bool CPVRDatabase::QueuePersistQuery(const CPVRChannel &channel, int iChannelId)
+{
   /* invalid channel */
   if (channel.UniqueID() <= 0)
   {
     CLog::LogF(LOGERROR, "Invalid channel uid: %d", channel.UniqueID());
-    return bReturn;
+    return false;
   }
 
-  CSingleLock lock(m_critSection);
-
-  // Note: Do not use channel.ChannelID value to check presence of channel in channels table. It might not yet be set correctly.
-  std::string strQuery = PrepareSQL("iUniqueId = %u AND iClientId = %u", channel.UniqueID(), channel.ClientID());
-  const std::string strValue = GetSingleValue("channels", "idChannel", strQuery);
-  if (strValue.empty())
+  std::string strQuery;
+  if (iChannelId < 0)
   {
     /* new channel */
     strQuery = PrepareSQL("INSERT INTO channels ("
@@ -824,22 +882,15 @@ bool CPVRDatabase::Persist(CPVRChannel &channel, bool bCommit)
         "iUniqueId, bIsRadio, bIsHidden, bIsUserSetIcon, bIsUserSetName, bIsLocked, "
         "sIconPath, sChannelName, bIsVirtual, bEPGEnabled, sEPGScraper, iLastWatched, iClientId, "
         "idChannel, idEpg, bHasArchive) "
-        "VALUES (%i, %i, %i, %i, %i, %i, '%s', '%s', %i, %i, '%s', %u, %i, %s, %i, %i)",
+        "VALUES (%i, %i, %i, %i, %i, %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i)",
         channel.UniqueID(), (channel.IsRadio() ? 1 :0), (channel.IsHidden() ? 1 : 0), (channel.IsUserSetIcon() ? 1 : 0), (channel.IsUserSetName() ? 1 : 0), (channel.IsLocked() ? 1 : 0),
         channel.IconPath().c_str(), channel.ChannelName().c_str(), 0, (channel.EPGEnabled() ? 1 : 0), channel.EPGScraper().c_str(), static_cast<unsigned int>(channel.LastWatched()), channel.ClientID(),
-        strValue.c_str(),
+        iChannelId,
         channel.EpgID(), channel.HasArchive());
   }
 
-  if (QueueInsertQuery(strQuery))
-  {
-    bReturn = true;
-
-    if (bCommit)
-      bReturn = CommitInsertQueries();
-  }
-
-  return bReturn;
+  CSingleLock lock(m_critSection);
+  return QueueInsertQuery(strQuery);
 }
 
 bool CPVRDatabase::UpdateLastWatched(const CPVRChannel &channel)
@@ -13,6 +13,7 @@
 #include "threads/CriticalSection.h"
 
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace PVR
@@ -233,6 +234,9 @@ namespace PVR
 
     bool PersistChannels(CPVRChannelGroup &group);
 
+    std::map<std::pair<int, int>, int> GetChannelIds();
+    bool QueuePersistQuery(const CPVRChannel &channel, int iChannelId);
+
     bool RemoveChannelsFromGroup(const CPVRChannelGroup &group);
 
     int GetClientIdByChannelId(int iChannelId);
@@ -55,8 +55,10 @@
 #include "pvr/timers/PVRTimerInfoTag.h"
 #include "pvr/timers/PVRTimers.h"
 #include "pvr/windows/GUIWindowPVRSearch.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/MediaSettings.h"
 #include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/IRunnable.h"
 #include "threads/SingleLock.h"
 #include "utils/StringUtils.h"
@@ -1200,7 +1202,10 @@ namespace PVR
       CPVRStreamProperties props;
 
       if (item->IsPVRChannel())
-        client->GetChannelStreamProperties(item->GetPVRChannelInfoTag(), props);
+      {
+        if (!m_streamPreloader.TakePreloaded(item->GetPVRChannelInfoTag(), props))
+          client->GetChannelStreamProperties(item->GetPVRChannelInfoTag(), props);
+      }
       else if (item->IsPVRRecording())
         client->GetRecordingStreamProperties(item->GetPVRRecordingInfoTag(), props);
       else if (item->IsEPG())
@@ -2214,6 +2219,9 @@ namespace PVR
       const CPVRChannelPtr channel = item->GetPVRChannelInfoTag();
       m_channelNavigator.SetPlayingChannel(channel);
       SetSelectedItemPath(channel->IsRadio(), channel->Path());
+
+      if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bPVRPreloadChannelStreams)
+        m_streamPreloader.Preload(m_channelNavigator.GetNeighbourChannels());
     }
   }
 
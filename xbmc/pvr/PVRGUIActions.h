@@ -12,6 +12,7 @@
 #include "pvr/PVRGUIChannelNavigator.h"
 #include "pvr/PVRSettings.h"
 #include "pvr/PVRTypes.h"
+#include "pvr/channels/PVRChannelStreamPreloader.h"
 #include "threads/CriticalSection.h"
 
 #include <memory>
@@ -532,6 +533,7 @@ namespace PVR
     bool m_bChannelScanRunning = false;
     CPVRSettings m_settings;
     CPVRGUIChannelNavigator m_channelNavigator;
+    mutable CPVRChannelStreamPreloader m_streamPreloader;
     std::string m_selectedItemPathTV;
     std::string m_selectedItemPathRadio;
     mutable bool m_bReminderAnnouncementRunning = false;
@@ -68,6 +68,21 @@ namespace PVR
     return {};
   }
 
+  std::vector<CPVRChannelPtr> CPVRGUIChannelNavigator::GetNeighbourChannels()
+  {
+    std::vector<CPVRChannelPtr> channels;
+
+    const CPVRChannelPtr nextChannel = GetNextOrPrevChannel(true);
+    if (nextChannel)
+      channels.emplace_back(nextChannel);
+
+    const CPVRChannelPtr prevChannel = GetNextOrPrevChannel(false);
+    if (prevChannel && prevChannel != nextChannel)
+      channels.emplace_back(prevChannel);
+
+    return channels;
+  }
+
   void CPVRGUIChannelNavigator::SelectChannel(const CPVRChannelPtr channel, ChannelSwitchMode eSwitchMode)
   {
     CServiceBroker::GetGUI()->GetInfoManager().SetCurrentItem(CFileItem(channel));
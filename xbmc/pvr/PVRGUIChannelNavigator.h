@@ -11,6 +11,8 @@
 #include "pvr/PVRTypes.h"
 #include "threads/CriticalSection.h"
 
+#include <vector>
+
 namespace PVR
 {
   enum class ChannelSwitchMode
@@ -79,6 +81,12 @@ namespace PVR
      */
     void ClearPlayingChannel();
 
+    /*!
+     * @brief Get the channels next to the currently selected channel in the playing channel group.
+     * @return The next and the previous channel, if any.
+     */
+    std::vector<CPVRChannelPtr> GetNeighbourChannels();
+
   private:
     /*!
      * @brief Get next or previous channel of the playing channel group, relative to the currently selected channel.
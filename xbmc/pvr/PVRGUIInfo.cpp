@@ -32,9 +32,11 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
-#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/StringUtils.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <ctime>
 #include <memory>
@@ -45,7 +47,8 @@ using namespace PVR;
 using namespace KODI::GUILIB::GUIINFO;
 
 CPVRGUIInfo::CPVRGUIInfo(void) :
-    CThread("PVRGUIInfo")
+    CThread("PVRGUIInfo"),
+    m_pendingUpdates(UPDATE_NONE)
 {
   ResetProperties();
 }
@@ -56,39 +59,19 @@ CPVRGUIInfo::~CPVRGUIInfo(void)
 
 void CPVRGUIInfo::ResetProperties(void)
 {
-  CSingleLock lock(m_critSection);
-
   m_anyTimersInfo.ResetProperties();
   m_tvTimersInfo.ResetProperties();
   m_radioTimersInfo.ResetProperties();
   m_timesInfo.Reset();
-  m_bHasTVRecordings            = false;
-  m_bHasRadioRecordings         = false;
-  m_iCurrentActiveClient        = 0;
-  m_strPlayingClientName        .clear();
-  m_strBackendName              .clear();
-  m_strBackendVersion           .clear();
-  m_strBackendHost              .clear();
-  m_strBackendTimers            .clear();
-  m_strBackendRecordings        .clear();
-  m_strBackendDeletedRecordings .clear();
-  m_strBackendChannels          .clear();
-  m_iBackendDiskTotal           = 0;
-  m_iBackendDiskUsed            = 0;
-  m_bIsPlayingTV                = false;
-  m_bIsPlayingRadio             = false;
-  m_bIsPlayingRecording         = false;
-  m_bIsPlayingEpgTag            = false;
-  m_bIsPlayingEncryptedStream   = false;
-  m_bIsRecordingPlayingChannel  = false;
-  m_bCanRecordPlayingChannel    = false;
-  m_bIsPlayingActiveRecording   = false;
-  m_bHasTVChannels              = false;
-  m_bHasRadioChannels           = false;
-
-  ClearQualityInfo(m_qualityInfo);
-  ClearDescrambleInfo(m_descrambleInfo);
 
+  const std::shared_ptr<State> state = std::make_shared<State>();
+  ClearQualityInfo(state->qualityInfo);
+  ClearDescrambleInfo(state->descrambleInfo);
+  std::atomic_store(&m_state, std::shared_ptr<const State>(state));
+
+  m_iCurrentActiveClient = 0;
+  m_backendProperties.clear();
+  m_pendingUpdates = UPDATE_NONE;
   m_updateBackendCacheRequested = false;
   m_bRegistered = false;
 }
@@ -116,6 +99,7 @@ void CPVRGUIInfo::Stop(void)
 {
   StopThread();
   CServiceBroker::GetPVRManager().UnregisterObserver(this);
+  CServiceBroker::GetPVRManager().Events().Unsubscribe(this);
 
   CGUIComponent* gui = CServiceBroker::GetGUI();
   if (gui)
@@ -127,18 +111,73 @@ void CPVRGUIInfo::Stop(void)
 
 void CPVRGUIInfo::Notify(const Observable &obs, const ObservableMessage msg)
 {
-  if (msg == ObservableMessageTimers || msg == ObservableMessageTimersReset)
-    UpdateTimersCache();
+  switch (msg)
+  {
+    case ObservableMessageTimers:
+    case ObservableMessageTimersReset:
+      // the recording state of the playing channel depends on the timers
+      RequestUpdate(UPDATE_TIMERS | UPDATE_MISC);
+      break;
+    case ObservableMessageChannelGroup:
+    case ObservableMessageChannelGroupReset:
+    case ObservableMessageChannelGroupsLoaded:
+    case ObservableMessageRecordings:
+    case ObservableMessageChannelPlaybackStopped:
+      RequestUpdate(UPDATE_MISC);
+      break;
+    default:
+      break;
+  }
+}
+
+void CPVRGUIInfo::OnPVRManagerEvent(const PVREvent& event)
+{
+  switch (event)
+  {
+    case PVREvent::TimersInvalidated:
+      RequestUpdate(UPDATE_TIMERS | UPDATE_MISC);
+      break;
+    case PVREvent::ManagerStarted:
+    case PVREvent::RecordingsInvalidated:
+    case PVREvent::ChannelGroupsInvalidated:
+      RequestUpdate(UPDATE_MISC);
+      break;
+    default:
+      break;
+  }
+}
+
+void CPVRGUIInfo::OnPlaybackStarted()
+{
+  RequestUpdate(UPDATE_MISC);
+}
+
+void CPVRGUIInfo::OnPlaybackStopped()
+{
+  RequestUpdate(UPDATE_MISC);
+}
+
+void CPVRGUIInfo::RequestUpdate(int iFlags)
+{
+  // requests made before the update thread wakes up are handled in one go
+  m_pendingUpdates |= iFlags;
+  m_updateEvent.Set();
+}
+
+std::shared_ptr<const CPVRGUIInfo::State> CPVRGUIInfo::GetState() const
+{
+  return std::atomic_load(&m_state);
 }
 
 void CPVRGUIInfo::Process(void)
 {
-  unsigned int iLoop = 0;
-  int toggleInterval = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRInfoToggleInterval / 1000;
+  const unsigned int iToggleInterval = std::max(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRInfoToggleInterval, 500);
+  XbmcThreads::EndTime toggleTimeout;
 
   /* updated on request */
   CServiceBroker::GetPVRManager().RegisterObserver(this);
-  UpdateTimersCache();
+  CServiceBroker::GetPVRManager().Events().Subscribe(this, &CPVRGUIInfo::OnPVRManagerEvent);
+  RequestUpdate(UPDATE_TIMERS | UPDATE_MISC);
 
   /* update the backend cache once initially */
   m_updateBackendCacheRequested = true;
@@ -155,43 +194,49 @@ void CPVRGUIInfo::Process(void)
       }
     }
 
-    if (!m_bStop)
-      UpdateQualityData();
-    Sleep(0);
+    const int iUpdates = m_pendingUpdates.exchange(UPDATE_NONE);
+    const bool bPlaying = CServiceBroker::GetPVRManager().IsPlaying();
 
-    if (!m_bStop)
-      UpdateDescrambleData();
-    Sleep(0);
+    // the published state is never modified, a new one is built from a copy
+    const std::shared_ptr<State> state = std::make_shared<State>(*GetState());
 
-    if (!m_bStop)
-      UpdateMisc();
-    Sleep(0);
+    if (iUpdates & UPDATE_TIMERS)
+      UpdateTimersCache();
 
-    if (!m_bStop)
+    if (iUpdates & UPDATE_MISC)
+      UpdateMisc(*state);
+
+    // the stream values change all the time, they are polled while playing
+    if (bPlaying)
+    {
+      UpdateQualityData(*state);
+      UpdateDescrambleData(*state);
+    }
+
+    if (bPlaying || (iUpdates & UPDATE_MISC))
       UpdateTimeshiftData();
-    Sleep(0);
 
-    if (!m_bStop)
-      UpdateTimersToggle();
-    Sleep(0);
+    UpdateTimersToggle();
 
-    if (!m_bStop)
+    if ((iUpdates & UPDATE_TIMERS) || toggleTimeout.IsTimePast())
       UpdateNextTimer();
-    Sleep(0);
 
-    // Update the backend cache every toggleInterval seconds
-    if (!m_bStop && iLoop % toggleInterval == 0)
-      UpdateBackendCache();
+    if (toggleTimeout.IsTimePast())
+    {
+      UpdateBackendCache(*state);
+      toggleTimeout.Set(iToggleInterval);
+    }
 
-    if (++iLoop == 1000)
-      iLoop = 0;
+    std::atomic_store(&m_state, std::shared_ptr<const State>(state));
 
+    // timers of active recordings are toggled, wake up for that as well
+    const bool bToggleTimers = m_anyTimersInfo.HasRecordingTimers();
     if (!m_bStop)
-      Sleep(500);
+      AbortableWait(m_updateEvent, (bPlaying || bToggleTimers) ? 500 : toggleTimeout.MillisLeft());
   }
 }
 
-void CPVRGUIInfo::UpdateQualityData(void)
+void CPVRGUIInfo::UpdateQualityData(State& state)
 {
   PVR_SIGNAL_STATUS qualityInfo;
   ClearQualityInfo(qualityInfo);
@@ -205,13 +250,13 @@ void CPVRGUIInfo::UpdateQualityData(void)
       CServiceBroker::GetPVRManager().Clients()->GetCreatedClient(CServiceBroker::GetPVRManager().GetPlayingClientID(), client);
       if (client && client->SignalQuality(qualityInfo) == PVR_ERROR_NO_ERROR)
       {
-        m_qualityInfo = qualityInfo;
+        state.qualityInfo = qualityInfo;
       }
     }
   }
 }
 
-void CPVRGUIInfo::UpdateDescrambleData(void)
+void CPVRGUIInfo::UpdateDescrambleData(State& state)
 {
   PVR_DESCRAMBLE_INFO descrambleInfo;
   ClearDescrambleInfo(descrambleInfo);
@@ -223,47 +268,30 @@ void CPVRGUIInfo::UpdateDescrambleData(void)
     CServiceBroker::GetPVRManager().Clients()->GetCreatedClient(CServiceBroker::GetPVRManager().GetPlayingClientID(), client);
     if (client && client->GetDescrambleInfo(descrambleInfo) == PVR_ERROR_NO_ERROR)
     {
-      m_descrambleInfo = descrambleInfo;
+      state.descrambleInfo = descrambleInfo;
     }
   }
 }
 
-void CPVRGUIInfo::UpdateMisc(void)
+void CPVRGUIInfo::UpdateMisc(State& state)
 {
   bool bStarted = CServiceBroker::GetPVRManager().IsStarted();
   /* safe to fetch these unlocked, since they're updated from the same thread as this one */
-  std::string strPlayingClientName     = bStarted ? CServiceBroker::GetPVRManager().GetPlayingClientName() : "";
-  bool       bHasTVRecordings          = bStarted && CServiceBroker::GetPVRManager().Recordings()->GetNumTVRecordings() > 0;
-  bool       bHasRadioRecordings       = bStarted && CServiceBroker::GetPVRManager().Recordings()->GetNumRadioRecordings() > 0;
-  bool       bIsPlayingTV              = bStarted && CServiceBroker::GetPVRManager().IsPlayingTV();
-  bool       bIsPlayingRadio           = bStarted && CServiceBroker::GetPVRManager().IsPlayingRadio();
-  bool       bIsPlayingRecording       = bStarted && CServiceBroker::GetPVRManager().IsPlayingRecording();
-  bool       bIsPlayingEpgTag          = bStarted && CServiceBroker::GetPVRManager().IsPlayingEpgTag();
-  bool       bIsPlayingEncryptedStream = bStarted && CServiceBroker::GetPVRManager().IsPlayingEncryptedChannel();
-  bool       bHasTVChannels            = bStarted && CServiceBroker::GetPVRManager().ChannelGroups()->GetGroupAllTV()->HasChannels();
-  bool       bHasRadioChannels         = bStarted && CServiceBroker::GetPVRManager().ChannelGroups()->GetGroupAllRadio()->HasChannels();
-  bool bCanRecordPlayingChannel        = bStarted && CServiceBroker::GetPVRManager().CanRecordOnPlayingChannel();
-  bool bIsRecordingPlayingChannel      = bStarted && CServiceBroker::GetPVRManager().IsRecordingOnPlayingChannel();
-  bool bIsPlayingActiveRecording       = bStarted && CServiceBroker::GetPVRManager().IsPlayingActiveRecording();
-  std::string strPlayingTVGroup        = (bStarted && bIsPlayingTV) ? CServiceBroker::GetPVRManager().GetPlayingGroup(false)->GroupName() : "";
-  std::string strPlayingRadioGroup     = (bStarted && bIsPlayingRadio) ? CServiceBroker::GetPVRManager().GetPlayingGroup(true)->GroupName() : "";
-
-  CSingleLock lock(m_critSection);
-  m_strPlayingClientName      = strPlayingClientName;
-  m_bHasTVRecordings          = bHasTVRecordings;
-  m_bHasRadioRecordings       = bHasRadioRecordings;
-  m_bIsPlayingTV              = bIsPlayingTV;
-  m_bIsPlayingRadio           = bIsPlayingRadio;
-  m_bIsPlayingRecording       = bIsPlayingRecording;
-  m_bIsPlayingEpgTag          = bIsPlayingEpgTag;
-  m_bIsPlayingEncryptedStream = bIsPlayingEncryptedStream;
-  m_bHasTVChannels            = bHasTVChannels;
-  m_bHasRadioChannels         = bHasRadioChannels;
-  m_strPlayingTVGroup         = strPlayingTVGroup;
-  m_strPlayingRadioGroup      = strPlayingRadioGroup;
-  m_bCanRecordPlayingChannel  = bCanRecordPlayingChannel;
-  m_bIsRecordingPlayingChannel = bIsRecordingPlayingChannel;
-  m_bIsPlayingActiveRecording = bIsPlayingActiveRecording;
+  state.strPlayingClientName       = bStarted ? CServiceBroker::GetPVRManager().GetPlayingClientName() : "";
+  state.bHasTVRecordings           = bStarted && CServiceBroker::GetPVRManager().Recordings()->GetNumTVRecordings() > 0;
+  state.bHasRadioRecordings        = bStarted && CServiceBroker::GetPVRManager().Recordings()->GetNumRadioRecordings() > 0;
+  state.bIsPlayingTV               = bStarted && CServiceBroker::GetPVRManager().IsPlayingTV();
+  state.bIsPlayingRadio            = bStarted && CServiceBroker::GetPVRManager().IsPlayingRadio();
+  state.bIsPlayingRecording        = bStarted && CServiceBroker::GetPVRManager().IsPlayingRecording();
+  state.bIsPlayingEpgTag           = bStarted && CServiceBroker::GetPVRManager().IsPlayingEpgTag();
+  state.bIsPlayingEncryptedStream  = bStarted && CServiceBroker::GetPVRManager().IsPlayingEncryptedChannel();
+  state.bHasTVChannels             = bStarted && CServiceBroker::GetPVRManager().ChannelGroups()->GetGroupAllTV()->HasChannels();
+  state.bHasRadioChannels          = bStarted && CServiceBroker::GetPVRManager().ChannelGroups()->GetGroupAllRadio()->HasChannels();
+  state.bCanRecordPlayingChannel   = bStarted && CServiceBroker::GetPVRManager().CanRecordOnPlayingChannel();
+  state.bIsRecordingPlayingChannel = bStarted && CServiceBroker::GetPVRManager().IsRecordingOnPlayingChannel();
+  state.bIsPlayingActiveRecording  = bStarted && CServiceBroker::GetPVRManager().IsPlayingActiveRecording();
+  state.strPlayingTVGroup          = (bStarted && state.bIsPlayingTV) ? CServiceBroker::GetPVRManager().GetPlayingGroup(false)->GroupName() : "";
+  state.strPlayingRadioGroup       = (bStarted && state.bIsPlayingRadio) ? CServiceBroker::GetPVRManager().GetPlayingGroup(true)->GroupName() : "";
 }
 
 void CPVRGUIInfo::UpdateTimeshiftData(void)
@@ -421,8 +449,8 @@ bool CPVRGUIInfo::GetListItemAndPlayerLabel(const CFileItem *item, const CGUIInf
       }
       case VIDEOPLAYER_CHANNEL_GROUP:
       {
-        CSingleLock lock(m_critSection);
-        strValue = recording->IsRadio() ? m_strPlayingRadioGroup : m_strPlayingTVGroup;
+        const std::shared_ptr<const State> state = GetState();
+        strValue = recording->IsRadio() ? state->strPlayingRadioGroup : state->strPlayingTVGroup;
         return true;
       }
     }
@@ -655,8 +683,8 @@ bool CPVRGUIInfo::GetListItemAndPlayerLabel(const CFileItem *item, const CGUIInf
       case MUSICPLAYER_CHANNEL_GROUP:
       case VIDEOPLAYER_CHANNEL_GROUP:
       {
-        CSingleLock lock(m_critSection);
-        strValue = channel->IsRadio() ? m_strPlayingRadioGroup : m_strPlayingTVGroup;
+        const std::shared_ptr<const State> state = GetState();
+        strValue = channel->IsRadio() ? state->strPlayingRadioGroup : state->strPlayingTVGroup;
         return true;
       }
     }
@@ -667,8 +695,6 @@ bool CPVRGUIInfo::GetListItemAndPlayerLabel(const CFileItem *item, const CGUIInf
 
 bool CPVRGUIInfo::GetPVRLabel(const CFileItem *item, const CGUIInfo &info, std::string &strValue) const
 {
-  CSingleLock lock(m_critSection);
-
   switch (info.m_info)
   {
     case PVR_EPG_EVENT_ICON:
@@ -1046,7 +1072,7 @@ bool CPVRGUIInfo::GetListItemAndPlayerInt(const CFileItem *item, const CGUIInfo
 
 bool CPVRGUIInfo::GetPVRInt(const CFileItem *item, const CGUIInfo &info, int& iValue) const
 {
-  CSingleLock lock(m_critSection);
+  const std::shared_ptr<const State> state = GetState();
 
   switch (info.m_info)
   {
@@ -1084,14 +1110,14 @@ bool CPVRGUIInfo::GetPVRInt(const CFileItem *item, const CGUIInfo &info, int& iV
       iValue = m_timesInfo.GetTimeshiftProgressBufferEnd();
       return true;
     case PVR_ACTUAL_STREAM_SIG_PROGR:
-      iValue = std::lrintf(static_cast<float>(m_qualityInfo.iSignal) / 0xFFFF * 100);
+      iValue = std::lrintf(static_cast<float>(state->qualityInfo.iSignal) / 0xFFFF * 100);
       return true;
     case PVR_ACTUAL_STREAM_SNR_PROGR:
-      iValue = std::lrintf(static_cast<float>(m_qualityInfo.iSNR) / 0xFFFF * 100);
+      iValue = std::lrintf(static_cast<float>(state->qualityInfo.iSNR) / 0xFFFF * 100);
       return true;
     case PVR_BACKEND_DISKSPACE_PROGR:
-      if (m_iBackendDiskTotal > 0)
-        iValue = std::lrintf(static_cast<float>(m_iBackendDiskUsed) / m_iBackendDiskTotal * 100);
+      if (state->iBackendDiskTotal > 0)
+        iValue = std::lrintf(static_cast<float>(state->iBackendDiskUsed) / state->iBackendDiskTotal * 100);
       else
         iValue = 0xFF;
       return true;
@@ -1299,7 +1325,7 @@ bool CPVRGUIInfo::GetListItemAndPlayerBool(const CFileItem *item, const CGUIInfo
 
 bool CPVRGUIInfo::GetPVRBool(const CFileItem *item, const CGUIInfo &info, bool& bValue) const
 {
-  CSingleLock lock(m_critSection);
+  const std::shared_ptr<const State> state = GetState();
 
   switch (info.m_info)
   {
@@ -1322,10 +1348,10 @@ bool CPVRGUIInfo::GetPVRBool(const CFileItem *item, const CGUIInfo &info, bool&
       bValue = m_radioTimersInfo.HasTimers();
       return true;
     case PVR_HAS_TV_CHANNELS:
-      bValue = m_bHasTVChannels;
+      bValue = state->bHasTVChannels;
       return true;
     case PVR_HAS_RADIO_CHANNELS:
-      bValue = m_bHasRadioChannels;
+      bValue = state->bHasRadioChannels;
       return true;
     case PVR_HAS_NONRECORDING_TIMER:
       bValue = m_anyTimersInfo.HasNonRecordingTimers();
@@ -1337,31 +1363,31 @@ bool CPVRGUIInfo::GetPVRBool(const CFileItem *item, const CGUIInfo &info, bool&
       bValue = m_radioTimersInfo.HasNonRecordingTimers();
       return true;
     case PVR_IS_PLAYING_TV:
-      bValue = m_bIsPlayingTV;
+      bValue = state->bIsPlayingTV;
       return true;
     case PVR_IS_PLAYING_RADIO:
-      bValue = m_bIsPlayingRadio;
+      bValue = state->bIsPlayingRadio;
       return true;
     case PVR_IS_PLAYING_RECORDING:
-      bValue = m_bIsPlayingRecording;
+      bValue = state->bIsPlayingRecording;
       return true;
     case PVR_IS_PLAYING_EPGTAG:
-      bValue = m_bIsPlayingEpgTag;
+      bValue = state->bIsPlayingEpgTag;
       return true;
     case PVR_ACTUAL_STREAM_ENCRYPTED:
-      bValue = m_bIsPlayingEncryptedStream;
+      bValue = state->bIsPlayingEncryptedStream;
       return true;
     case PVR_IS_TIMESHIFTING:
       bValue = m_timesInfo.IsTimeshifting();
       return true;
     case PVR_CAN_RECORD_PLAYING_CHANNEL:
-      bValue = m_bCanRecordPlayingChannel;
+      bValue = state->bCanRecordPlayingChannel;
       return true;
     case PVR_IS_RECORDING_PLAYING_CHANNEL:
-      bValue = m_bIsRecordingPlayingChannel;
+      bValue = state->bIsRecordingPlayingChannel;
       return true;
     case PVR_IS_PLAYING_ACTIVE_RECORDING:
-      bValue = m_bIsPlayingActiveRecording;
+      bValue = state->bIsPlayingActiveRecording;
       return true;
   }
   return false;
@@ -1404,79 +1430,90 @@ bool CPVRGUIInfo::GetRadioRDSBool(const CFileItem *item, const CGUIInfo &info, b
 
 void CPVRGUIInfo::CharInfoBackendNumber(std::string &strValue) const
 {
-  size_t numBackends = m_backendProperties.size();
+  const std::shared_ptr<const State> state = GetState();
 
-  if (numBackends > 0)
-    strValue = StringUtils::Format("{0} {1} {2}", m_iCurrentActiveClient + 1, g_localizeStrings.Get(20163).c_str(), numBackends);
+  if (state->iBackendCount > 0)
+    strValue = StringUtils::Format("{0} {1} {2}", state->iCurrentActiveClient + 1, g_localizeStrings.Get(20163).c_str(), state->iBackendCount);
   else
     strValue = g_localizeStrings.Get(14023);
 }
 
 void CPVRGUIInfo::CharInfoTotalDiskSpace(std::string &strValue) const
 {
-  strValue = StringUtils::SizeToString(m_iBackendDiskTotal).c_str();
+  const std::shared_ptr<const State> state = GetState();
+  strValue = StringUtils::SizeToString(state->iBackendDiskTotal).c_str();
 }
 
 void CPVRGUIInfo::CharInfoSignal(std::string &strValue) const
 {
-  strValue = StringUtils::Format("%d %%", m_qualityInfo.iSignal / 655);
+  const std::shared_ptr<const State> state = GetState();
+  strValue = StringUtils::Format("%d %%", state->qualityInfo.iSignal / 655);
 }
 
 void CPVRGUIInfo::CharInfoSNR(std::string &strValue) const
 {
-  strValue = StringUtils::Format("%d %%", m_qualityInfo.iSNR / 655);
+  const std::shared_ptr<const State> state = GetState();
+  strValue = StringUtils::Format("%d %%", state->qualityInfo.iSNR / 655);
 }
 
 void CPVRGUIInfo::CharInfoBER(std::string &strValue) const
 {
-  strValue = StringUtils::Format("%08lX", m_qualityInfo.iBER);
+  const std::shared_ptr<const State> state = GetState();
+  strValue = StringUtils::Format("%08lX", state->qualityInfo.iBER);
 }
 
 void CPVRGUIInfo::CharInfoUNC(std::string &strValue) const
 {
-  strValue = StringUtils::Format("%08lX", m_qualityInfo.iUNC);
+  const std::shared_ptr<const State> state = GetState();
+  strValue = StringUtils::Format("%08lX", state->qualityInfo.iUNC);
 }
 
 void CPVRGUIInfo::CharInfoFrontendName(std::string &strValue) const
 {
-  if (!strlen(m_qualityInfo.strAdapterName))
+  const std::shared_ptr<const State> state = GetState();
+  if (!strlen(state->qualityInfo.strAdapterName))
     strValue = g_localizeStrings.Get(13205);
   else
-    strValue = m_qualityInfo.strAdapterName;
+    strValue = state->qualityInfo.strAdapterName;
 }
 
 void CPVRGUIInfo::CharInfoFrontendStatus(std::string &strValue) const
 {
-  if (!strlen(m_qualityInfo.strAdapterStatus))
+  const std::shared_ptr<const State> state = GetState();
+  if (!strlen(state->qualityInfo.strAdapterStatus))
     strValue = g_localizeStrings.Get(13205);
   else
-    strValue = m_qualityInfo.strAdapterStatus;
+    strValue = state->qualityInfo.strAdapterStatus;
 }
 
 void CPVRGUIInfo::CharInfoBackendName(std::string &strValue) const
 {
+  const std::shared_ptr<const State> state = GetState();
   m_updateBackendCacheRequested = true;
-  strValue = m_strBackendName;
+  strValue = state->strBackendName;
 }
 
 void CPVRGUIInfo::CharInfoBackendVersion(std::string &strValue) const
 {
+  const std::shared_ptr<const State> state = GetState();
   m_updateBackendCacheRequested = true;
-  strValue = m_strBackendVersion;
+  strValue = state->strBackendVersion;
 }
 
 void CPVRGUIInfo::CharInfoBackendHost(std::string &strValue) const
 {
+  const std::shared_ptr<const State> state = GetState();
   m_updateBackendCacheRequested = true;
-  strValue = m_strBackendHost;
+  strValue = state->strBackendHost;
 }
 
 void CPVRGUIInfo::CharInfoBackendDiskspace(std::string &strValue) const
 {
+  const std::shared_ptr<const State> state = GetState();
   m_updateBackendCacheRequested = true;
 
-  auto diskTotal = m_iBackendDiskTotal;
-  auto diskUsed = m_iBackendDiskUsed;
+  auto diskTotal = state->iBackendDiskTotal;
+  auto diskUsed = state->iBackendDiskUsed;
 
   if (diskTotal > 0)
   {
@@ -1490,42 +1527,48 @@ void CPVRGUIInfo::CharInfoBackendDiskspace(std::string &strValue) const
 
 void CPVRGUIInfo::CharInfoBackendChannels(std::string &strValue) const
 {
+  const std::shared_ptr<const State> state = GetState();
   m_updateBackendCacheRequested = true;
-  strValue = m_strBackendChannels;
+  strValue = state->strBackendChannels;
 }
 
 void CPVRGUIInfo::CharInfoBackendTimers(std::string &strValue) const
 {
+  const std::shared_ptr<const State> state = GetState();
   m_updateBackendCacheRequested = true;
-  strValue = m_strBackendTimers;
+  strValue = state->strBackendTimers;
 }
 
 void CPVRGUIInfo::CharInfoBackendRecordings(std::string &strValue) const
 {
+  const std::shared_ptr<const State> state = GetState();
   m_updateBackendCacheRequested = true;
-  strValue = m_strBackendRecordings;
+  strValue = state->strBackendRecordings;
 }
 
 void CPVRGUIInfo::CharInfoBackendDeletedRecordings(std::string &strValue) const
 {
+  const std::shared_ptr<const State> state = GetState();
   m_updateBackendCacheRequested = true;
-  strValue = m_strBackendDeletedRecordings;
+  strValue = state->strBackendDeletedRecordings;
 }
 
 void CPVRGUIInfo::CharInfoPlayingClientName(std::string &strValue) const
 {
-  if (m_strPlayingClientName.empty())
+  const std::shared_ptr<const State> state = GetState();
+  if (state->strPlayingClientName.empty())
     strValue = g_localizeStrings.Get(13205);
   else
-    strValue = m_strPlayingClientName;
+    strValue = state->strPlayingClientName;
 }
 
 void CPVRGUIInfo::CharInfoEncryption(std::string &strValue) const
 {
-  if (m_descrambleInfo.iCaid != PVR_DESCRAMBLE_INFO_NOT_AVAILABLE)
+  const std::shared_ptr<const State> state = GetState();
+  if (state->descrambleInfo.iCaid != PVR_DESCRAMBLE_INFO_NOT_AVAILABLE)
   {
     // prefer dynamically updated info, if available
-    strValue = CPVRChannel::GetEncryptionName(m_descrambleInfo.iCaid);
+    strValue = CPVRChannel::GetEncryptionName(state->descrambleInfo.iCaid);
     return;
   }
   else
@@ -1543,85 +1586,83 @@ void CPVRGUIInfo::CharInfoEncryption(std::string &strValue) const
 
 void CPVRGUIInfo::CharInfoService(std::string &strValue) const
 {
-  if (!strlen(m_qualityInfo.strServiceName))
+  const std::shared_ptr<const State> state = GetState();
+  if (!strlen(state->qualityInfo.strServiceName))
     strValue = g_localizeStrings.Get(13205);
   else
-    strValue = m_qualityInfo.strServiceName;
+    strValue = state->qualityInfo.strServiceName;
 }
 
 void CPVRGUIInfo::CharInfoMux(std::string &strValue) const
 {
-  if (!strlen(m_qualityInfo.strMuxName))
+  const std::shared_ptr<const State> state = GetState();
+  if (!strlen(state->qualityInfo.strMuxName))
     strValue = g_localizeStrings.Get(13205);
   else
-    strValue = m_qualityInfo.strMuxName;
+    strValue = state->qualityInfo.strMuxName;
 }
 
 void CPVRGUIInfo::CharInfoProvider(std::string &strValue) const
 {
-  if (!strlen(m_qualityInfo.strProviderName))
+  const std::shared_ptr<const State> state = GetState();
+  if (!strlen(state->qualityInfo.strProviderName))
     strValue = g_localizeStrings.Get(13205);
   else
-    strValue = m_qualityInfo.strProviderName;
+    strValue = state->qualityInfo.strProviderName;
 }
 
-void CPVRGUIInfo::UpdateBackendCache(void)
+void CPVRGUIInfo::UpdateBackendCache(State& state)
 {
-  CSingleLock lock(m_critSection);
-
   // Update the backend information for all backends if
   // an update has been requested
   if (m_iCurrentActiveClient == 0 && m_updateBackendCacheRequested)
   {
-    std::vector<SBackend> backendProperties;
-    {
-      CSingleExit exit(m_critSection);
-      backendProperties = CServiceBroker::GetPVRManager().Clients()->GetBackendProperties();
-    }
-
-    m_backendProperties = backendProperties;
+    m_backendProperties = CServiceBroker::GetPVRManager().Clients()->GetBackendProperties();
     m_updateBackendCacheRequested = false;
   }
 
   // Store some defaults
-  m_strBackendName = g_localizeStrings.Get(13205);
-  m_strBackendVersion = g_localizeStrings.Get(13205);
-  m_strBackendHost = g_localizeStrings.Get(13205);
-  m_strBackendChannels = g_localizeStrings.Get(13205);
-  m_strBackendTimers = g_localizeStrings.Get(13205);
-  m_strBackendRecordings = g_localizeStrings.Get(13205);
-  m_strBackendDeletedRecordings = g_localizeStrings.Get(13205);
-  m_iBackendDiskTotal = 0;
-  m_iBackendDiskUsed = 0;
+  state.strBackendName = g_localizeStrings.Get(13205);
+  state.strBackendVersion = g_localizeStrings.Get(13205);
+  state.strBackendHost = g_localizeStrings.Get(13205);
+  state.strBackendChannels = g_localizeStrings.Get(13205);
+  state.strBackendTimers = g_localizeStrings.Get(13205);
+  state.strBackendRecordings = g_localizeStrings.Get(13205);
+  state.strBackendDeletedRecordings = g_localizeStrings.Get(13205);
+  state.iBackendDiskTotal = 0;
+  state.iBackendDiskUsed = 0;
 
   // Update with values from the current client when we have at least one
   if (!m_backendProperties.empty())
   {
     const auto &backend = m_backendProperties[m_iCurrentActiveClient];
 
-    m_strBackendName = backend.name;
-    m_strBackendVersion = backend.version;
-    m_strBackendHost = backend.host;
+    state.strBackendName = backend.name;
+    state.strBackendVersion = backend.version;
+    state.strBackendHost = backend.host;
 
     if (backend.numChannels >= 0)
-      m_strBackendChannels = StringUtils::Format("%i", backend.numChannels);
+      state.strBackendChannels = StringUtils::Format("%i", backend.numChannels);
 
     if (backend.numTimers >= 0)
-      m_strBackendTimers = StringUtils::Format("%i", backend.numTimers);
+      state.strBackendTimers = StringUtils::Format("%i", backend.numTimers);
 
     if (backend.numRecordings >= 0)
-      m_strBackendRecordings = StringUtils::Format("%i", backend.numRecordings);
+      state.strBackendRecordings = StringUtils::Format("%i", backend.numRecordings);
 
     if (backend.numDeletedRecordings >= 0)
-      m_strBackendDeletedRecordings = StringUtils::Format("%i", backend.numDeletedRecordings);
+      state.strBackendDeletedRecordings = StringUtils::Format("%i", backend.numDeletedRecordings);
 
-    m_iBackendDiskTotal = backend.diskTotal;
-    m_iBackendDiskUsed = backend.diskUsed;
+    state.iBackendDiskTotal = backend.diskTotal;
+    state.iBackendDiskUsed = backend.diskUsed;
   }
 
   // Update the current active client, eventually wrapping around
   if (++m_iCurrentActiveClient >= m_backendProperties.size())
     m_iCurrentActiveClient = 0;
+
+  state.iCurrentActiveClient = m_iCurrentActiveClient;
+  state.iBackendCount = m_backendProperties.size();
 }
 
 void CPVRGUIInfo::UpdateTimersCache(void)
@@ -13,11 +13,12 @@
 #include "pvr/PVRGUITimerInfo.h"
 #include "pvr/PVRGUITimesInfo.h"
 #include "pvr/addons/PVRClients.h"
-#include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "threads/Thread.h"
 #include "utils/Observer.h"
 
 #include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,8 @@ namespace GUIINFO
 
 namespace PVR
 {
+  enum class PVREvent;
+
   class CPVRGUIInfo : public KODI::GUILIB::GUIINFO::CGUIInfoProvider, private CThread, private Observer
   {
   public:
@@ -47,6 +50,16 @@ namespace PVR
 
     void Notify(const Observable &obs, const ObservableMessage msg) override;
 
+    /*!
+     * @brief Inform GUI info that playback of an item just started.
+     */
+    void OnPlaybackStarted();
+
+    /*!
+     * @brief Inform GUI info that playback of an item was stopped.
+     */
+    void OnPlaybackStopped();
+
     // KODI::GUILIB::GUIINFO::IGUIInfoProvider implementation
     bool InitCurrentItem(CFileItem *item) override;
     bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const KODI::GUILIB::GUIINFO::CGUIInfo &info, std::string *fallback) const override;
@@ -54,17 +67,67 @@ namespace PVR
     bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const KODI::GUILIB::GUIINFO::CGUIInfo &info) const override;
 
   private:
+    /*!
+     * @brief The info values published by the update thread. A published state is never modified,
+     * so it can be read without locking.
+     */
+    struct State
+    {
+      bool                            bHasTVRecordings = false;
+      bool                            bHasRadioRecordings = false;
+      unsigned int                    iCurrentActiveClient = 0;
+      size_t                          iBackendCount = 0;
+      std::string                     strPlayingClientName;
+      std::string                     strBackendName;
+      std::string                     strBackendVersion;
+      std::string                     strBackendHost;
+      std::string                     strBackendTimers;
+      std::string                     strBackendRecordings;
+      std::string                     strBackendDeletedRecordings;
+      std::string                     strBackendChannels;
+      long long                       iBackendDiskTotal = 0;
+      long long                       iBackendDiskUsed = 0;
+      bool                            bIsPlayingTV = false;
+      bool                            bIsPlayingRadio = false;
+      bool                            bIsPlayingRecording = false;
+      bool                            bIsPlayingEpgTag = false;
+      bool                            bIsPlayingEncryptedStream = false;
+      bool                            bHasTVChannels = false;
+      bool                            bHasRadioChannels = false;
+      bool                            bCanRecordPlayingChannel = false;
+      bool                            bIsRecordingPlayingChannel = false;
+      bool                            bIsPlayingActiveRecording = false;
+      std::string                     strPlayingTVGroup;
+      std::string                     strPlayingRadioGroup;
+      PVR_SIGNAL_STATUS               qualityInfo;       /*!< stream quality information */
+      PVR_DESCRAMBLE_INFO             descrambleInfo;    /*!< stream descramble information */
+    };
+
+    /*!
+     * @brief The parts of the state to update, requests are collected until the update thread runs.
+     */
+    enum UpdateFlags
+    {
+      UPDATE_NONE = 0x00,
+      UPDATE_TIMERS = 0x01,
+      UPDATE_MISC = 0x02,
+    };
+
     void ResetProperties(void);
-    void ClearQualityInfo(PVR_SIGNAL_STATUS &qualityInfo);
-    void ClearDescrambleInfo(PVR_DESCRAMBLE_INFO &descrambleInfo);
+    static void ClearQualityInfo(PVR_SIGNAL_STATUS &qualityInfo);
+    static void ClearDescrambleInfo(PVR_DESCRAMBLE_INFO &descrambleInfo);
 
     void Process(void) override;
 
+    void OnPVRManagerEvent(const PVREvent& event);
+    void RequestUpdate(int iFlags);
+    std::shared_ptr<const State> GetState() const;
+
     void UpdateTimersCache(void);
-    void UpdateBackendCache(void);
-    void UpdateQualityData(void);
-    void UpdateDescrambleData(void);
-    void UpdateMisc(void);
+    void UpdateBackendCache(State& state);
+    void UpdateQualityData(State& state);
+    void UpdateDescrambleData(State& state);
+    void UpdateMisc(State& state);
     void UpdateNextTimer(void);
     void UpdateTimeshiftData(void);
     void UpdateTimeshiftProgressData();
@@ -104,47 +167,22 @@ namespace PVR
     void CharInfoMux(std::string &strValue) const;
     void CharInfoProvider(std::string &strValue) const;
 
-    /** @name PVRGUIInfo data */
-    //@{
     CPVRGUIAnyTimerInfo   m_anyTimersInfo; // tv + radio
     CPVRGUITVTimerInfo    m_tvTimersInfo;
     CPVRGUIRadioTimerInfo m_radioTimersInfo;
 
     CPVRGUITimesInfo m_timesInfo;
 
-    bool                            m_bHasTVRecordings;
-    bool                            m_bHasRadioRecordings;
-    unsigned int                    m_iCurrentActiveClient;
-    std::string                     m_strPlayingClientName;
-    std::string                     m_strBackendName;
-    std::string                     m_strBackendVersion;
-    std::string                     m_strBackendHost;
-    std::string                     m_strBackendTimers;
-    std::string                     m_strBackendRecordings;
-    std::string                     m_strBackendDeletedRecordings;
-    std::string                     m_strBackendChannels;
-    long long                       m_iBackendDiskTotal;
-    long long                       m_iBackendDiskUsed;
-    bool                            m_bIsPlayingTV;
-    bool                            m_bIsPlayingRadio;
-    bool                            m_bIsPlayingRecording;
-    bool                            m_bIsPlayingEpgTag;
-    bool                            m_bIsPlayingEncryptedStream;
-    bool                            m_bHasTVChannels;
-    bool                            m_bHasRadioChannels;
-    bool                            m_bCanRecordPlayingChannel;
-    bool                            m_bIsRecordingPlayingChannel;
-    bool                            m_bIsPlayingActiveRecording;
-    std::string                     m_strPlayingTVGroup;
-    std::string                     m_strPlayingRadioGroup;
-
-    //@}
+    std::shared_ptr<const State> m_state; /*!< the published state, only accessed atomically */
 
-    PVR_SIGNAL_STATUS               m_qualityInfo;       /*!< stream quality information */
-    PVR_DESCRAMBLE_INFO             m_descrambleInfo;    /*!< stream descramble information */
+    /** @name Update thread data */
+    //@{
+    unsigned int                    m_iCurrentActiveClient;
     std::vector<SBackend>           m_backendProperties;
+    //@}
 
-    mutable CCriticalSection m_critSection;
+    std::atomic<int> m_pendingUpdates; /*!< the UpdateFlags requested since the last update */
+    CEvent m_updateEvent;
 
     /**
      * The various backend-related fields will only be updated when this
@@ -860,6 +860,7 @@ void CPVRManager::OnPlaybackStarted(const CFileItemPtr item)
   }
 
   m_guiActions->OnPlaybackStarted(item);
+  m_guiInfo->OnPlaybackStarted();
   m_epgContainer.OnPlaybackStarted();
 }
 
@@ -912,6 +913,7 @@ void CPVRManager::OnPlaybackStopped(const CFileItemPtr item)
   }
 
   m_guiActions->OnPlaybackStopped(item);
+  m_guiInfo->OnPlaybackStopped();
   m_epgContainer.OnPlaybackStopped();
 }
 
@@ -15,10 +15,14 @@
 #include "pvr/PVRJobs.h"
 #include "pvr/PVRManager.h"
 #include "pvr/channels/PVRChannelGroupInternal.h"
+#include "threads/SingleLock.h"
+#include "utils/ParallelJobs.h"
 #include "utils/log.h"
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -477,11 +481,11 @@ PVR_ERROR CPVRClients::GetTimerTypes(CPVRTimerTypes& results) const
   });
 }
 
-PVR_ERROR CPVRClients::GetRecordings(CPVRRecordings *recordings, bool deleted)
+PVR_ERROR CPVRClients::GetRecordings(CPVRRecordings *recordings, bool deleted, std::vector<int> &failedClients)
 {
   return ForCreatedClients(__FUNCTION__, [recordings, deleted](const CPVRClientPtr &client) {
     return client->GetRecordings(recordings, deleted);
-  });
+  }, failedClients);
 }
 
 PVR_ERROR CPVRClients::DeleteAllRecordingsFromTrash()
@@ -500,23 +504,67 @@ PVR_ERROR CPVRClients::SetEPGTimeFrame(int iDays)
 
 PVR_ERROR CPVRClients::GetChannels(CPVRChannelGroupInternal *group, std::vector<int> &failedClients)
 {
-  return ForCreatedClients(__FUNCTION__, [group](const CPVRClientPtr &client) {
-    return client->GetChannels(*group, group->IsRadio());
+  // channels get their number in the order they are added. each client fills a group of its own,
+  // which are merged in client order, so the numbers don't depend on which client answers first.
+  std::map<int, std::unique_ptr<CPVRChannelGroupInternal>> clientGroups;
+  CCriticalSection clientGroupsLock;
+
+  const PVR_ERROR error = ForCreatedClientsInParallel(__FUNCTION__, [group, &clientGroups, &clientGroupsLock](const CPVRClientPtr &client) {
+    std::unique_ptr<CPVRChannelGroupInternal> clientGroup(new CPVRChannelGroupInternal(group->IsRadio()));
+    clientGroup->SetPreventSortAndRenumber();
+    const PVR_ERROR currentError = client->GetChannels(*clientGroup, group->IsRadio());
+
+    CSingleLock lock(clientGroupsLock);
+    clientGroups[client->GetID()] = std::move(clientGroup);
+    return currentError;
   }, failedClients);
+
+  for (const auto &clientGroup : clientGroups)
+  {
+    for (const auto &member : clientGroup.second->GetMembers())
+      group->UpdateFromClient(member.channel, CPVRChannelNumber());
+  }
+
+  return error;
 }
 
 PVR_ERROR CPVRClients::GetChannelGroups(CPVRChannelGroups *groups, std::vector<int> &failedClients)
 {
-  return ForCreatedClients(__FUNCTION__, [groups](const CPVRClientPtr &client) {
+  return ForCreatedClientsInParallel(__FUNCTION__, [groups](const CPVRClientPtr &client) {
     return client->GetChannelGroups(groups);
   }, failedClients);
 }
 
-PVR_ERROR CPVRClients::GetChannelGroupMembers(CPVRChannelGroup *group, std::vector<int> &failedClients)
+PVR_ERROR CPVRClients::GetChannelGroupMembers(const std::vector<CPVRChannelGroup*>& groups, std::vector<std::vector<int>>& failedClients)
 {
-  return ForCreatedClients(__FUNCTION__, [group](const CPVRClientPtr &client) {
-    return client->GetChannelGroupMembers(group);
-  }, failedClients);
+  failedClients.assign(groups.size(), {});
+
+  PVR_ERROR lastError = PVR_ERROR_NO_ERROR;
+  CCriticalSection resultLock;
+
+  // errors are recorded per group here, so only the clients not ready to use are returned as failed
+  std::vector<int> clientsNotReady;
+  ForCreatedClientsInParallel(__FUNCTION__, [&groups, &failedClients, &lastError, &resultLock](const CPVRClientPtr &client) {
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+      const PVR_ERROR error = client->GetChannelGroupMembers(groups[i]);
+      if (error != PVR_ERROR_NO_ERROR && error != PVR_ERROR_NOT_IMPLEMENTED)
+      {
+        CLog::LogF(LOGERROR, "PVR client '%s' returned an error for group '%s': %s",
+                   client->GetFriendlyName().c_str(), groups[i]->GroupName().c_str(), CPVRClient::ToString(error));
+
+        CSingleLock lock(resultLock);
+        failedClients[i].emplace_back(client->GetID());
+        lastError = error;
+      }
+    }
+    return PVR_ERROR_NO_ERROR;
+  }, clientsNotReady);
+
+  for (auto& groupFailedClients : failedClients)
+    groupFailedClients.insert(groupFailedClients.end(), clientsNotReady.begin(), clientsNotReady.end());
+
+  return lastError;
 }
 
 std::vector<CPVRClientPtr> CPVRClients::GetClientsSupportingChannelScan(void) const
@@ -674,3 +722,56 @@ PVR_ERROR CPVRClients::ForCreatedClients(const char* strFunctionName, PVRClientF
   }
   return lastError;
 }
+
+PVR_ERROR CPVRClients::ForCreatedClientsInParallel(const char* strFunctionName, PVRClientFunction function, std::vector<int> &failedClients) const
+{
+  PVR_ERROR lastError = PVR_ERROR_NO_ERROR;
+
+  CPVRClientMap clients;
+  GetCreatedClients(clients, failedClients);
+
+  if (clients.empty())
+    return lastError;
+
+  CCriticalSection resultLock;
+  std::set<int> doneClients;
+
+  CParallelJobs jobs;
+  for (const auto &clientEntry : clients)
+  {
+    jobs.Submit([&]() {
+      const PVR_ERROR currentError = function(clientEntry.second);
+
+      if (currentError != PVR_ERROR_NO_ERROR && currentError != PVR_ERROR_NOT_IMPLEMENTED)
+      {
+        CLog::LogFunction(LOGERROR, strFunctionName,
+                          "PVR client '%s' returned an error: %s",
+                          clientEntry.second->GetFriendlyName().c_str(), CPVRClient::ToString(currentError));
+
+        CSingleLock lock(resultLock);
+        lastError = currentError;
+        failedClients.emplace_back(clientEntry.first);
+      }
+
+      CSingleLock lock(resultLock);
+      doneClients.insert(clientEntry.first);
+    });
+  }
+
+  if (!jobs.Wait([]() { return CServiceBroker::GetPVRManager().IsStopping(); }))
+  {
+    // the jobs of these clients were rejected, dropped or cancelled on shutdown
+    for (const auto &clientEntry : clients)
+    {
+      if (doneClients.find(clientEntry.first) != doneClients.end())
+        continue;
+
+      CLog::LogFunction(LOGERROR, strFunctionName,
+                        "PVR client '%s' was not called", clientEntry.second->GetFriendlyName().c_str());
+      lastError = PVR_ERROR_FAILED;
+      failedClients.emplace_back(clientEntry.first);
+    }
+  }
+
+  return lastError;
+}
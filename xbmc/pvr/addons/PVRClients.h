@@ -200,9 +200,10 @@ namespace PVR
      * @brief Get all recordings from clients
      * @param recordings Store the recordings in this container.
      * @param deleted If true, return deleted recordings, return not deleted recordings otherwise.
+     * @param failedClients in case of errors will contain the ids of the clients for which the recordings could not be obtained.
      * @return PVR_ERROR_NO_ERROR if the operation succeeded, the respective PVR_ERROR value otherwise.
      */
-    PVR_ERROR GetRecordings(CPVRRecordings *recordings, bool deleted);
+    PVR_ERROR GetRecordings(CPVRRecordings *recordings, bool deleted, std::vector<int> &failedClients);
 
     /*!
      * @brief Delete all "soft" deleted recordings permanently on the backend.
@@ -230,7 +231,7 @@ namespace PVR
     //@{
 
     /*!
-     * @brief Get all channels from backends.
+     * @brief Get all channels from backends. The backends are asked in parallel.
      * @param group The container to store the channels in.
      * @param failedClients in case of errors will contain the ids of the clients for which the channels could not be obtained.
      * @return PVR_ERROR_NO_ERROR if the channels were fetched successfully, last error otherwise.
@@ -238,7 +239,7 @@ namespace PVR
     PVR_ERROR GetChannels(CPVRChannelGroupInternal *group, std::vector<int> &failedClients);
 
     /*!
-     * @brief Get all channel groups from backends.
+     * @brief Get all channel groups from backends. The backends are asked in parallel.
      * @param groups Store the channel groups in this container.
      * @param failedClients in case of errors will contain the ids of the clients for which the channel groups could not be obtained.
      * @return PVR_ERROR_NO_ERROR if the channel groups were fetched successfully, last error otherwise.
@@ -246,12 +247,12 @@ namespace PVR
     PVR_ERROR GetChannelGroups(CPVRChannelGroups *groups, std::vector<int> &failedClients);
 
     /*!
-     * @brief Get all group members of a channel group.
-     * @param group The group to get the member for.
-     * @param failedClients in case of errors will contain the ids of the clients for which the channel group members could not be obtained.
+     * @brief Get all group members of several channel groups. The backends are asked in parallel, each of them for one group after the other.
+     * @param groups The groups to get the members for.
+     * @param failedClients in case of errors will contain, per group, the ids of the clients for which the channel group members could not be obtained.
      * @return PVR_ERROR_NO_ERROR if the channel group members were fetched successfully, last error otherwise.
      */
-    PVR_ERROR GetChannelGroupMembers(CPVRChannelGroup *group, std::vector<int> &failedClients);
+    PVR_ERROR GetChannelGroupMembers(const std::vector<CPVRChannelGroup*>& groups, std::vector<std::vector<int>>& failedClients);
 
     /*!
      * @brief Get a list of clients providing a channel scan dialog.
@@ -351,6 +352,15 @@ namespace PVR
      */
     PVR_ERROR ForCreatedClients(const char* strFunctionName, PVRClientFunction function, std::vector<int> &failedClients) const;
 
+    /*!
+     * @brief Like ForCreatedClients, but calls all clients at the same time, each of them on its own thread.
+     * @param strFunctionName The function name, for logging purposes.
+     * @param function The function to wrap. It is called from several threads at once, once per client.
+     * @param failedClients Contains a list of the ids of clients for that the call failed or did not run (e.g. when PVR is stopping), if any.
+     * @return PVR_ERROR_NO_ERROR on success, any other PVR_ERROR_* value otherwise.
+     */
+    PVR_ERROR ForCreatedClientsInParallel(const char* strFunctionName, PVRClientFunction function, std::vector<int> &failedClients) const;
+
     mutable CCriticalSection m_critSection;
     CPVRClientMap m_clientMap;
   };
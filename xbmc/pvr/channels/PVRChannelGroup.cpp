@@ -84,7 +84,7 @@ void CPVRChannelGroup::OnInit(void)
   });
 }
 
-bool CPVRChannelGroup::Load(std::vector<std::shared_ptr<CPVRChannel>>& channelsToRemove)
+bool CPVRChannelGroup::Load(std::vector<std::shared_ptr<CPVRChannel>>& channelsToRemove, bool bUpdateFromClients)
 {
   /* make sure this container is empty before loading */
   Unload();
@@ -96,13 +96,13 @@ bool CPVRChannelGroup::Load(std::vector<std::shared_ptr<CPVRChannel>>& channelsT
   int iChannelCount = m_iGroupId > 0 ? LoadFromDb() : 0;
   CLog::LogFC(LOGDEBUG, LOGPVR, "%d channels loaded from the database for group '%s'", iChannelCount, GroupName().c_str());
 
-  if (!Update(channelsToRemove))
+  if (bUpdateFromClients && !Update(channelsToRemove))
   {
     CLog::LogF(LOGERROR, "Failed to update channels for group '%s'", GroupName().c_str());
     return false;
   }
 
-  if (Size() - iChannelCount > 0)
+  if (bUpdateFromClients && Size() - iChannelCount > 0)
   {
     CLog::LogFC(LOGDEBUG, LOGPVR, "%d channels added from clients to group '%s'",
                 static_cast<int>(Size() - iChannelCount), GroupName().c_str());
@@ -137,6 +137,44 @@ bool CPVRChannelGroup::Update(std::vector<std::shared_ptr<CPVRChannel>>& channel
   return UpdateGroupEntries(PVRChannels_tmp, channelsToRemove);
 }
 
+bool CPVRChannelGroup::UpdateAll(const std::vector<std::shared_ptr<CPVRChannelGroup>>& groups, std::vector<std::shared_ptr<CPVRChannel>>& channelsToRemove)
+{
+  if (!CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_PVRMANAGER_SYNCCHANNELGROUPS))
+    return true;
+
+  std::vector<std::shared_ptr<CPVRChannelGroup>> groupsToUpdate;
+  std::vector<std::unique_ptr<CPVRChannelGroup>> clientGroups;
+  std::vector<CPVRChannelGroup*> clientGroupPtrs;
+  for (const auto& group : groups)
+  {
+    if (group->IsInternalGroup() || group->GroupType() == PVR_GROUP_TYPE_USER_DEFINED)
+      continue;
+
+    groupsToUpdate.emplace_back(group);
+    clientGroups.emplace_back(new CPVRChannelGroup(group->GetPath(), group->GroupID(), group->m_allChannelsGroup));
+    clientGroups.back()->SetPreventSortAndRenumber();
+    clientGroupPtrs.emplace_back(clientGroups.back().get());
+  }
+
+  if (groupsToUpdate.empty())
+    return true;
+
+  /* one request per client and group, all clients at once */
+  std::vector<std::vector<int>> failedClients;
+  CServiceBroker::GetPVRManager().Clients()->GetChannelGroupMembers(clientGroupPtrs, failedClients);
+
+  bool bReturn = true;
+  for (size_t i = 0; i < groupsToUpdate.size(); ++i)
+  {
+    std::vector<std::shared_ptr<CPVRChannel>> removedChannels;
+    groupsToUpdate[i]->m_failedClientsForChannelGroupMembers = failedClients[i];
+    bReturn = groupsToUpdate[i]->UpdateGroupEntries(*clientGroups[i], removedChannels) && bReturn;
+    channelsToRemove.insert(channelsToRemove.end(), removedChannels.begin(), removedChannels.end());
+  }
+
+  return bReturn;
+}
+
 const CPVRChannelsPath& CPVRChannelGroup::GetPath() const
 {
   CSingleLock lock(m_critSection);
@@ -455,7 +493,10 @@ int CPVRChannelGroup::LoadFromDb(bool bCompress /* = false */)
 bool CPVRChannelGroup::LoadFromClients(void)
 {
   /* get the channels from the backends */
-  return CServiceBroker::GetPVRManager().Clients()->GetChannelGroupMembers(this, m_failedClientsForChannelGroupMembers) == PVR_ERROR_NO_ERROR;
+  std::vector<std::vector<int>> failedClients;
+  const PVR_ERROR error = CServiceBroker::GetPVRManager().Clients()->GetChannelGroupMembers({this}, failedClients);
+  m_failedClientsForChannelGroupMembers = failedClients.front();
+  return error == PVR_ERROR_NO_ERROR;
 }
 
 bool CPVRChannelGroup::AddAndUpdateChannels(const CPVRChannelGroup &channels, bool bUseBackendChannelNumbers)
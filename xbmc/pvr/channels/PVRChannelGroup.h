@@ -90,9 +90,10 @@ namespace PVR
     /*!
      * @brief Load the channels from the database.
      * @param channelsToRemove Returns the channels to be removed from all groups, if any
+     * @param bUpdateFromClients True to refresh the channels from the clients after loading them, false to only load them from the database.
      * @return True when loaded successfully, false otherwise.
      */
-    virtual bool Load(std::vector<std::shared_ptr<CPVRChannel>>& channelsToRemove);
+    virtual bool Load(std::vector<std::shared_ptr<CPVRChannel>>& channelsToRemove, bool bUpdateFromClients);
 
     /*!
      * @return The amount of group members
@@ -105,6 +106,14 @@ namespace PVR
      */
     virtual bool Update(std::vector<std::shared_ptr<CPVRChannel>>& channelsToRemove);
 
+    /*!
+     * @brief Refresh the channel lists of several groups from the clients. All clients are asked at the same time, each of them for one group after the other.
+     * @param groups The groups to refresh. Internal groups are skipped.
+     * @param channelsToRemove Returns the channels to be removed from all groups, if any
+     * @return True if all groups were refreshed successfully, false otherwise.
+     */
+    static bool UpdateAll(const std::vector<std::shared_ptr<CPVRChannelGroup>>& groups, std::vector<std::shared_ptr<CPVRChannel>>& channelsToRemove);
+
     /*!
      * @brief Get the path of this group.
      * @return the path.
@@ -133,9 +133,10 @@ namespace PVR
      * If no channels are stored in the database, then the channels will be loaded from the clients.
      *
      * @param channelsToRemove Returns the channels to be removed from all groups, if any
+     * @param bUpdateFromClients True to refresh the channels from the clients after loading them, false to only load them from the database.
      * @return True when loaded successfully, false otherwise.
      */
-    bool Load(std::vector<std::shared_ptr<CPVRChannel>>& channelsToRemove) override;
+    bool Load(std::vector<std::shared_ptr<CPVRChannel>>& channelsToRemove, bool bUpdateFromClients) override;
 
     /*!
      * @brief Update the vfs paths of all channels.
@@ -22,6 +22,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <vector>
@@ -212,6 +213,18 @@ void CPVRChannelGroups::RemoveFromAllGroups(const CPVRChannelPtr &channel)
   }
 }
 
+void CPVRChannelGroups::DeleteEmptyGroups(const std::vector<CPVRChannelGroupPtr>& groups)
+{
+  for (const auto& group : groups)
+  {
+    if (!group->IsInternalGroup() && group->Size() == 0)
+    {
+      CLog::LogFC(LOGDEBUG, LOGPVR, "Deleting empty channel group '%s'", group->GroupName().c_str());
+      DeleteGroup(*group);
+    }
+  }
+}
+
 bool CPVRChannelGroups::Update(bool bChannelsOnly /* = false */)
 {
   bool bUpdateAllGroups = !bChannelsOnly && CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_PVRMANAGER_SYNCCHANNELGROUPS);
@@ -228,72 +241,84 @@ bool CPVRChannelGroups::Update(bool bChannelsOnly /* = false */)
     groups = m_groups;
   }
 
-  for (const auto &group : groups)
+  // the internal group first, the other groups refer to its channels
+  const CPVRChannelGroupPtr internalGroup = GetGroupAll();
+  if (internalGroup)
   {
-    if (bUpdateAllGroups || group->IsInternalGroup())
-    {
-      std::vector<std::shared_ptr<CPVRChannel>> channelsToRemove;
-      bReturn = group->Update(channelsToRemove) && bReturn;
-      RemoveFromAllGroups(channelsToRemove);
-    }
+    std::vector<std::shared_ptr<CPVRChannel>> channelsToRemove;
+    bReturn = internalGroup->Update(channelsToRemove);
+    RemoveFromAllGroups(channelsToRemove);
 
-    if (bReturn &&
-        group->IsInternalGroup() &&
-        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bPVRChannelIconsAutoScan)
-    {
-      CServiceBroker::GetPVRManager().TriggerSearchMissingChannelIcons(group);
-    }
+    if (bReturn && CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bPVRChannelIconsAutoScan)
+      CServiceBroker::GetPVRManager().TriggerSearchMissingChannelIcons(internalGroup);
+  }
+
+  // the members of all other groups at once
+  if (bUpdateAllGroups)
+  {
+    std::vector<std::shared_ptr<CPVRChannel>> channelsToRemove;
+    const bool bUpdated = CPVRChannelGroup::UpdateAll(groups, channelsToRemove);
+    RemoveFromAllGroups(channelsToRemove);
+
+    // like on startup, which leaves this to the background sync if enabled
+    if (bUpdated)
+      DeleteEmptyGroups(groups);
+
+    bReturn = bUpdated && bReturn;
   }
 
   // persist changes
   return PersistAll() && bReturn;
 }
 
-bool CPVRChannelGroups::LoadUserDefinedChannelGroups(void)
+bool CPVRChannelGroups::LoadUserDefinedChannelGroups(bool bSyncWithClients)
 {
-  bool bSyncWithBackends = CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_PVRMANAGER_SYNCCHANNELGROUPS);
-
-  CSingleLock lock(m_critSection);
+  bool bSyncWithBackends = bSyncWithClients && CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_PVRMANAGER_SYNCCHANNELGROUPS);
 
-  // load groups from the backends if the option is enabled
-  int iSize = m_groups.size();
+  // load groups from the backends if the option is enabled. the clients call back from other
+  // threads, which lock this container, so it must not be locked here.
   if (bSyncWithBackends)
   {
+    const size_t iSize = GetMembers().size();
     GetGroupsFromClients();
-    CLog::LogFC(LOGDEBUG, LOGPVR, "%d new user defined %s channel groups fetched from clients", (m_groups.size() - iSize), m_bRadio ? "radio" : "TV");
+    CLog::LogFC(LOGDEBUG, LOGPVR, "%d new user defined %s channel groups fetched from clients",
+                static_cast<int>(GetMembers().size() - iSize), m_bRadio ? "radio" : "TV");
   }
-  else
+  else if (bSyncWithClients)
     CLog::LogFC(LOGDEBUG, LOGPVR, "'sync channelgroups' is disabled; skipping groups from clients");
 
-  std::vector<CPVRChannelGroupPtr> emptyGroups;
+  // load only user defined groups, as internal group is already loaded
+  std::vector<CPVRChannelGroupPtr> groups;
+  {
+    CSingleLock lock(m_critSection);
+    std::copy_if(m_groups.begin(), m_groups.end(), std::back_inserter(groups),
+                 [](const CPVRChannelGroupPtr& group) { return !group->IsInternalGroup(); });
+  }
 
-  // load group members
-  for (std::vector<CPVRChannelGroupPtr>::iterator it = m_groups.begin(); it != m_groups.end(); ++it)
+  // load group members from the database
+  std::vector<std::shared_ptr<CPVRChannel>> channelsToRemove;
+  for (const auto& group : groups)
   {
-    // load only user defined groups, as internal group is already loaded
-    if (!(*it)->IsInternalGroup())
+    if (!group->Load(channelsToRemove, false))
     {
-      std::vector<std::shared_ptr<CPVRChannel>> channelsToRemove;
-      if (!(*it)->Load(channelsToRemove))
-      {
-        CLog::LogFC(LOGDEBUG, LOGPVR, "Failed to load user defined channel group '%s'", (*it)->GroupName().c_str());
-        return false;
-      }
-
-      RemoveFromAllGroups(channelsToRemove);
-
-      // remove empty groups when sync with backend is enabled
-      if (bSyncWithBackends && (*it)->Size() == 0)
-        emptyGroups.push_back(*it);
+      CLog::LogFC(LOGDEBUG, LOGPVR, "Failed to load user defined channel group '%s'", group->GroupName().c_str());
+      return false;
     }
   }
 
-  for (std::vector<CPVRChannelGroupPtr>::iterator it = emptyGroups.begin(); it != emptyGroups.end(); ++it)
+  // and from the clients, all groups at once
+  if (bSyncWithBackends && !CPVRChannelGroup::UpdateAll(groups, channelsToRemove))
   {
-    CLog::LogFC(LOGDEBUG, LOGPVR, "Deleting empty channel group '%s'", (*it)->GroupName().c_str());
-    DeleteGroup(*(*it));
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Failed to update user defined channel groups");
+    return false;
   }
 
+  RemoveFromAllGroups(channelsToRemove);
+
+  // remove empty groups when sync with backend is enabled
+  if (bSyncWithBackends)
+    DeleteEmptyGroups(groups);
+
   // persist changes if we fetched groups from the backends
   return bSyncWithBackends ? PersistAll() : true;
 }
@@ -304,38 +329,62 @@ bool CPVRChannelGroups::Load(void)
   if (!database)
     return false;
 
-  CSingleLock lock(m_critSection);
+  CPVRChannelGroupPtr internalGroup;
+  {
+    CSingleLock lock(m_critSection);
 
-  // remove previous contents
-  Clear();
+    // remove previous contents
+    Clear();
 
-  CLog::LogFC(LOGDEBUG, LOGPVR, "Loading all %s channel groups", m_bRadio ? "radio" : "TV");
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Loading all %s channel groups", m_bRadio ? "radio" : "TV");
 
-  // create the internal channel group
-  CPVRChannelGroupPtr internalGroup = CPVRChannelGroupPtr(new CPVRChannelGroupInternal(m_bRadio));
-  m_groups.push_back(internalGroup);
+    // create the internal channel group
+    internalGroup = CPVRChannelGroupPtr(new CPVRChannelGroupInternal(m_bRadio));
+    m_groups.push_back(internalGroup);
 
-  // load groups from the database
-  database->Get(*this);
-  CLog::LogFC(LOGDEBUG, LOGPVR, "%d %s groups fetched from the database", m_groups.size(), m_bRadio ? "radio" : "TV");
+    // load groups from the database
+    database->Get(*this);
+    CLog::LogFC(LOGDEBUG, LOGPVR, "%d %s groups fetched from the database", m_groups.size(), m_bRadio ? "radio" : "TV");
+  }
 
-  // load channels of internal group
+  // load channels of internal group. the container is not locked while the clients are asked,
+  // they call back from other threads.
   std::vector<std::shared_ptr<CPVRChannel>> channelsToRemove;
-  if (!internalGroup->Load(channelsToRemove))
+  if (!internalGroup->Load(channelsToRemove, false))
   {
     CLog::LogF(LOGERROR, "Failed to load 'all channels' group");
     return false;
   }
 
-  RemoveFromAllGroups(channelsToRemove);
+  // with channels in the database, start with those and sync with the clients in the background
+  const bool bSyncWithClients = internalGroup->Size() == 0 ||
+                                !CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bPVRBackgroundChannelSync;
+  if (bSyncWithClients)
+  {
+    if (!internalGroup->Update(channelsToRemove))
+    {
+      CLog::LogF(LOGERROR, "Failed to update 'all channels' group");
+      return false;
+    }
+
+    RemoveFromAllGroups(channelsToRemove);
+  }
 
   // load the other groups from the database
-  if (!LoadUserDefinedChannelGroups())
+  if (!LoadUserDefinedChannelGroups(bSyncWithClients))
   {
     CLog::LogF(LOGERROR, "Failed to load user defined channel groups");
     return false;
   }
 
+  if (!bSyncWithClients)
+  {
+    CLog::LogFC(LOGDEBUG, LOGPVR, "%s channels loaded from the database, syncing with clients in the background", m_bRadio ? "Radio" : "TV");
+    CServiceBroker::GetPVRManager().TriggerChannelGroupsUpdate();
+  }
+
+  CSingleLock lock(m_critSection);
+
   // set the last played group as selected group at startup
   CPVRChannelGroupPtr lastPlayedGroup = GetLastPlayedGroup();
   SetSelectedGroup(lastPlayedGroup ? lastPlayedGroup : internalGroup);
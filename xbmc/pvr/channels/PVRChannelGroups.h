@@ -196,7 +196,7 @@ namespace PVR
     bool Update(bool bChannelsOnly = false);
 
   private:
-    bool LoadUserDefinedChannelGroups(void);
+    bool LoadUserDefinedChannelGroups(bool bSyncWithClients);
     bool GetGroupsFromClients(void);
     void SortGroups(void);
 
@@ -212,6 +212,12 @@ namespace PVR
      */
     void RemoveFromAllGroups(const std::shared_ptr<CPVRChannel>& channel);
 
+    /*!
+     * @brief Delete the given groups that have no members (left) after syncing with the clients.
+     * @param groups The groups, the internal group is never deleted.
+     */
+    void DeleteEmptyGroups(const std::vector<CPVRChannelGroupPtr>& groups);
+
     bool                             m_bRadio;         /*!< true if this is a container for radio channels, false if it is for tv channels */
     CPVRChannelGroupPtr              m_selectedGroup;  /*!< the group that's currently selected in the UI */
     std::vector<CPVRChannelGroupPtr> m_groups;         /*!< the groups in this container */
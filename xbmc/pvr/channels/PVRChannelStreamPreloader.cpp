@@ -0,0 +1,212 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRChannelStreamPreloader.h"
+
+#include "ServiceBroker.h"
+#include "addons/PVRClient.h"
+#include "pvr/PVRManager.h"
+#include "pvr/channels/PVRChannel.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+using namespace PVR;
+
+// shared with the requests, whose jobs may be destroyed after the preloader stopped waiting for them
+struct CPVRChannelStreamPreloader::RequestState
+{
+  CCriticalSection section;
+  CEvent idleEvent{true, true}; ///< set while no request is submitted
+  size_t iSubmitted = 0; ///< requests not destroyed yet, whether they ran or not
+  std::map<int, unsigned int> busyClients; ///< client id, id of the request running for it
+};
+
+// owned by the job of a request, destroyed with the job once it ran or was dropped. may be
+// destroyed while the job manager's lock is held, so it must not take the preloader's lock.
+class CPVRChannelStreamPreloader::CRequestToken
+{
+public:
+  CRequestToken(const std::shared_ptr<RequestState>& state, int iClientId, unsigned int iRequestId)
+  : m_state(state), m_iClientId(iClientId), m_iRequestId(iRequestId) {}
+
+  ~CRequestToken()
+  {
+    CSingleLock lock(m_state->section);
+    const auto it = m_state->busyClients.find(m_iClientId);
+    if (it != m_state->busyClients.end() && it->second == m_iRequestId)
+      m_state->busyClients.erase(it);
+
+    if (--m_state->iSubmitted == 0)
+      m_state->idleEvent.Set();
+  }
+
+private:
+  const std::shared_ptr<RequestState> m_state;
+  const int m_iClientId;
+  const unsigned int m_iRequestId;
+};
+
+CPVRChannelStreamPreloader::CPVRChannelStreamPreloader(std::chrono::seconds lifetime /* = std::chrono::seconds(60) */)
+: m_lifetime(lifetime),
+  m_requestState(std::make_shared<RequestState>())
+{
+}
+
+CPVRChannelStreamPreloader::~CPVRChannelStreamPreloader()
+{
+  {
+    CSingleLock lock(m_critSection);
+    m_bStopped = true;
+    m_pending.clear();
+  }
+
+  // submitted requests refer to this instance. the jobs that get dropped without running release
+  // their token as well, so this doesn't wait for requests that will never run.
+  m_requestState->idleEvent.Wait();
+}
+
+void CPVRChannelStreamPreloader::Preload(const std::vector<std::shared_ptr<CPVRChannel>>& channels)
+{
+  CSingleLock lock(m_critSection);
+  if (m_bStopped)
+    return;
+
+  RemoveExpired();
+
+  // the channels requested before are no longer the neighbours
+  m_pending.clear();
+
+  for (const auto& channel : channels)
+  {
+    if (!channel)
+      continue;
+
+    const int iClientId = channel->ClientID();
+    if (m_unsupportedClients.find(iClientId) != m_unsupportedClients.end() ||
+        m_preloaded.find(std::make_pair(iClientId, channel->UniqueID())) != m_preloaded.end() ||
+        !CanPreload(channel))
+      continue;
+
+    m_pending[iClientId].emplace_back(channel);
+  }
+
+  std::vector<int> clientIds;
+  for (const auto& pending : m_pending)
+    clientIds.emplace_back(pending.first);
+
+  for (int iClientId : clientIds)
+    StartNextRequest(iClientId);
+}
+
+bool CPVRChannelStreamPreloader::TakePreloaded(const std::shared_ptr<CPVRChannel>& channel, CPVRStreamProperties& props)
+{
+  if (!channel)
+    return false;
+
+  CSingleLock lock(m_critSection);
+  RemoveExpired();
+
+  const auto it = m_preloaded.find(std::make_pair(channel->ClientID(), channel->UniqueID()));
+  if (it == m_preloaded.end())
+    return false;
+
+  props = std::move(it->second.props);
+  m_preloaded.erase(it);
+
+  CLog::LogFC(LOGDEBUG, LOGPVR, "Using preloaded stream properties of channel '%s'", channel->ChannelName().c_str());
+  return true;
+}
+
+bool CPVRChannelStreamPreloader::CanPreload(const std::shared_ptr<CPVRChannel>& channel) const
+{
+  const std::shared_ptr<CPVRClient> client = CServiceBroker::GetPVRManager().GetClient(channel->ClientID());
+  return client && !client->GetClientCapabilities().HandlesInputStream();
+}
+
+bool CPVRChannelStreamPreloader::FetchStreamProperties(const std::shared_ptr<CPVRChannel>& channel, CPVRStreamProperties& props)
+{
+  const std::shared_ptr<CPVRClient> client = CServiceBroker::GetPVRManager().GetClient(channel->ClientID());
+  return client && client->GetChannelStreamProperties(channel, props) == PVR_ERROR_NO_ERROR;
+}
+
+void CPVRChannelStreamPreloader::Submit(const std::function<void()>& job)
+{
+  CJobManager::GetInstance().Submit(job, CJob::PRIORITY_LOW);
+}
+
+void CPVRChannelStreamPreloader::StartNextRequest(int iClientId)
+{
+  const auto it = m_pending.find(iClientId);
+  if (it == m_pending.end())
+    return;
+
+  const unsigned int iRequestId = ++m_iLastRequestId;
+  {
+    CSingleLock lock(m_requestState->section);
+    if (m_requestState->busyClients.find(iClientId) != m_requestState->busyClients.end())
+      return;
+
+    m_requestState->busyClients.emplace(iClientId, iRequestId);
+    if (m_requestState->iSubmitted++ == 0)
+      m_requestState->idleEvent.Reset();
+  }
+
+  const std::shared_ptr<CPVRChannel> channel = it->second.front();
+  it->second.pop_front();
+  if (it->second.empty())
+    m_pending.erase(it);
+
+  const std::shared_ptr<CRequestToken> token = std::make_shared<CRequestToken>(m_requestState, iClientId, iRequestId);
+  Submit([this, channel, token]() { Fetch(channel); });
+}
+
+void CPVRChannelStreamPreloader::Fetch(const std::shared_ptr<CPVRChannel>& channel)
+{
+  CPVRStreamProperties props;
+  const bool bFetched = FetchStreamProperties(channel, props);
+
+  CSingleLock lock(m_critSection);
+  const int iClientId = channel->ClientID();
+  if (!bFetched || props.GetStreamURL().empty())
+  {
+    // either the stream is opened by the client, not by Kodi, or the client can't tell. don't ask
+    // again on every channel switch.
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Client %d returned no stream url or failed, not preloading its channels", iClientId);
+    m_unsupportedClients.insert(iClientId);
+    m_pending.erase(iClientId);
+  }
+  else
+  {
+    PreloadedEntry& entry = m_preloaded[std::make_pair(iClientId, channel->UniqueID())];
+    entry.props = std::move(props);
+    entry.time = std::chrono::steady_clock::now();
+  }
+
+  {
+    // the client is free for the next request already, the token of this one is released later
+    CSingleLock stateLock(m_requestState->section);
+    m_requestState->busyClients.erase(iClientId);
+  }
+
+  if (!m_bStopped)
+    StartNextRequest(iClientId);
+}
+
+void CPVRChannelStreamPreloader::RemoveExpired()
+{
+  const auto now = std::chrono::steady_clock::now();
+  for (auto it = m_preloaded.begin(); it != m_preloaded.end();)
+  {
+    if (now - it->second.time >= m_lifetime)
+      it = m_preloaded.erase(it);
+    else
+      ++it;
+  }
+}
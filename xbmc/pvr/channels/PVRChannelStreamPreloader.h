@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "pvr/PVRStreamProperties.h"
+#include "threads/CriticalSection.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace PVR
+{
+  class CPVRChannel;
+
+  /*!
+   * @brief Fetches the stream properties of channels likely played next (the neighbours of the
+   * playing channel) in the background, so switching to them doesn't wait for the client to
+   * resolve the stream url.
+   *
+   * Only the properties are prefetched. The stream itself is neither opened nor probed ahead of
+   * time, this still happens when switching to the channel. The add-on API has a single live stream
+   * per client, so only channels of clients leaving the stream to Kodi are handled. Clients
+   * returning no stream url or failing to return the properties are skipped after their first
+   * answer. Requests to a client are made one after the other, never concurrently.
+   */
+  class CPVRChannelStreamPreloader
+  {
+  public:
+    /*!
+     * @brief Create a preloader.
+     * @param lifetime The time preloaded properties are used, stream urls might contain tokens that expire.
+     */
+    explicit CPVRChannelStreamPreloader(std::chrono::seconds lifetime = std::chrono::seconds(60));
+    virtual ~CPVRChannelStreamPreloader();
+
+    /*!
+     * @brief Fetch the stream properties of the given channels, replacing pending requests.
+     * @param channels The channels, nullptr entries are ignored.
+     */
+    void Preload(const std::vector<std::shared_ptr<CPVRChannel>>& channels);
+
+    /*!
+     * @brief Take the preloaded stream properties of a channel. They are only handed out once.
+     * @param channel The channel.
+     * @param props The properties.
+     * @return True if there were properties for the channel, false otherwise.
+     */
+    bool TakePreloaded(const std::shared_ptr<CPVRChannel>& channel, CPVRStreamProperties& props);
+
+  protected:
+    /*!
+     * @brief Check whether the client of a channel leaves opening the stream to Kodi.
+     * @param channel The channel.
+     * @return True if the channel can be preloaded, false otherwise.
+     */
+    virtual bool CanPreload(const std::shared_ptr<CPVRChannel>& channel) const;
+
+    /*!
+     * @brief Get the stream properties of a channel from its client.
+     * @param channel The channel.
+     * @param props The properties.
+     * @return True on success, false otherwise.
+     */
+    virtual bool FetchStreamProperties(const std::shared_ptr<CPVRChannel>& channel, CPVRStreamProperties& props);
+
+    /*!
+     * @brief Run a request in the background. The request may be destroyed without being run.
+     * @param job The request.
+     */
+    virtual void Submit(const std::function<void()>& job);
+
+  private:
+    CPVRChannelStreamPreloader(const CPVRChannelStreamPreloader&) = delete;
+    CPVRChannelStreamPreloader& operator=(const CPVRChannelStreamPreloader&) = delete;
+
+    typedef std::pair<int, int> ChannelKey; /*!< client id, unique channel id */
+
+    struct PreloadedEntry
+    {
+      CPVRStreamProperties props;
+      std::chrono::steady_clock::time_point time;
+    };
+
+    struct RequestState;
+    class CRequestToken;
+
+    void StartNextRequest(int iClientId);
+    void Fetch(const std::shared_ptr<CPVRChannel>& channel);
+    void RemoveExpired();
+
+    const std::chrono::seconds m_lifetime;
+    CCriticalSection m_critSection;
+    std::map<ChannelKey, PreloadedEntry> m_preloaded;
+    std::map<int, std::deque<std::shared_ptr<CPVRChannel>>> m_pending; /*!< waiting requests per client */
+    std::set<int> m_unsupportedClients; /*!< clients that returned no stream url or failed */
+    const std::shared_ptr<RequestState> m_requestState; /*!< shared with the submitted requests */
+    unsigned int m_iLastRequestId = 0;
+    bool m_bStopped = false;
+  };
+}
@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-addon-dev-kit/include/kodi/xbmc_pvr_types.h"
+#include "pvr/channels/PVRChannel.h"
+#include "pvr/channels/PVRChannelStreamPreloader.h"
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+  // Stands in for the clients. Requests are queued and run by the test.
+  class TestPreloader : public CPVRChannelStreamPreloader
+  {
+  public:
+    explicit TestPreloader(std::chrono::seconds lifetime = std::chrono::seconds(60))
+    : CPVRChannelStreamPreloader(lifetime) {}
+
+    ~TestPreloader() override { RunJobs(); }
+
+    void RunJobs()
+    {
+      while (!m_jobs.empty())
+      {
+        const std::function<void()> job = m_jobs.front();
+        m_jobs.pop_front();
+        job();
+      }
+    }
+
+    void RunJob()
+    {
+      const std::function<void()> job = m_jobs.front();
+      m_jobs.pop_front();
+      job();
+    }
+
+    std::set<int> m_clientsOpeningStreams; /*!< clients handling the input stream themselves */
+    std::set<int> m_clientsWithoutUrl;
+    std::set<int> m_failingClients;
+    std::map<int, int> m_requests; /*!< requests per client */
+    std::deque<std::function<void()>> m_jobs;
+
+  protected:
+    bool CanPreload(const std::shared_ptr<CPVRChannel>& channel) const override
+    {
+      return m_clientsOpeningStreams.find(channel->ClientID()) == m_clientsOpeningStreams.end();
+    }
+
+    bool FetchStreamProperties(const std::shared_ptr<CPVRChannel>& channel, CPVRStreamProperties& props) override
+    {
+      m_requests[channel->ClientID()]++;
+      if (m_failingClients.find(channel->ClientID()) != m_failingClients.end())
+        return false;
+      if (m_clientsWithoutUrl.find(channel->ClientID()) == m_clientsWithoutUrl.end())
+        props.emplace_back(PVR_STREAM_PROPERTY_STREAMURL, "http://stream/" + channel->ChannelName());
+      return true;
+    }
+
+    void Submit(const std::function<void()>& job) override
+    {
+      m_jobs.emplace_back(job);
+    }
+  };
+
+  std::shared_ptr<CPVRChannel> CreateChannel(int iClientId, int iUniqueId)
+  {
+    PVR_CHANNEL data = {};
+    data.iUniqueId = iUniqueId;
+    const std::string strName = std::to_string(iClientId) + "-" + std::to_string(iUniqueId);
+    strncpy(data.strChannelName, strName.c_str(), sizeof(data.strChannelName) - 1);
+    return std::make_shared<CPVRChannel>(data, iClientId);
+  }
+}
+
+TEST(TestPVRChannelStreamPreloader, TakeOnce)
+{
+  TestPreloader preloader;
+  const std::shared_ptr<CPVRChannel> channel = CreateChannel(1, 1);
+
+  CPVRStreamProperties props;
+  EXPECT_FALSE(preloader.TakePreloaded(channel, props));
+
+  preloader.Preload({channel, nullptr});
+  preloader.RunJobs();
+
+  EXPECT_TRUE(preloader.TakePreloaded(channel, props));
+  EXPECT_EQ("http://stream/1-1", props.GetStreamURL());
+  EXPECT_FALSE(preloader.TakePreloaded(channel, props));
+}
+
+TEST(TestPVRChannelStreamPreloader, SkipsUnsupportedClients)
+{
+  TestPreloader preloader;
+  preloader.m_clientsOpeningStreams.insert(2);
+  preloader.m_clientsWithoutUrl.insert(3);
+  preloader.m_failingClients.insert(4);
+
+  preloader.Preload({CreateChannel(2, 1), CreateChannel(3, 1), CreateChannel(3, 2), CreateChannel(4, 1), CreateChannel(4, 2)});
+  preloader.RunJobs();
+
+  // clients 3 and 4 are not asked again once they returned no url or failed
+  EXPECT_EQ(0, preloader.m_requests[2]);
+  EXPECT_EQ(1, preloader.m_requests[3]);
+  EXPECT_EQ(1, preloader.m_requests[4]);
+
+  preloader.Preload({CreateChannel(3, 3), CreateChannel(4, 3)});
+  preloader.RunJobs();
+  EXPECT_EQ(1, preloader.m_requests[3]);
+  EXPECT_EQ(1, preloader.m_requests[4]);
+
+  CPVRStreamProperties props;
+  EXPECT_FALSE(preloader.TakePreloaded(CreateChannel(3, 1), props));
+}
+
+TEST(TestPVRChannelStreamPreloader, OneRequestPerClient)
+{
+  TestPreloader preloader;
+  preloader.Preload({CreateChannel(1, 1), CreateChannel(1, 2), CreateChannel(2, 1)});
+
+  // one request for each client, the second channel of client 1 waits for the first
+  EXPECT_EQ(2u, preloader.m_jobs.size());
+  preloader.RunJob();
+  EXPECT_EQ(2u, preloader.m_jobs.size());
+  preloader.RunJobs();
+
+  EXPECT_EQ(2, preloader.m_requests[1]);
+  EXPECT_EQ(1, preloader.m_requests[2]);
+
+  // already preloaded channels are not requested again
+  preloader.Preload({CreateChannel(1, 1), CreateChannel(1, 3)});
+  preloader.RunJobs();
+  EXPECT_EQ(3, preloader.m_requests[1]);
+}
+
+TEST(TestPVRChannelStreamPreloader, ReplacesPendingRequests)
+{
+  TestPreloader preloader;
+  preloader.Preload({CreateChannel(1, 1), CreateChannel(1, 2)});
+  preloader.Preload({CreateChannel(1, 3)});
+  preloader.RunJobs();
+
+  CPVRStreamProperties props;
+  EXPECT_TRUE(preloader.TakePreloaded(CreateChannel(1, 1), props));
+  EXPECT_FALSE(preloader.TakePreloaded(CreateChannel(1, 2), props));
+  EXPECT_TRUE(preloader.TakePreloaded(CreateChannel(1, 3), props));
+}
+
+TEST(TestPVRChannelStreamPreloader, DroppedRequests)
+{
+  TestPreloader preloader;
+  preloader.Preload({CreateChannel(1, 1), CreateChannel(1, 2)});
+
+  // the job manager may destroy requests without running them, the client must not stay busy
+  preloader.m_jobs.clear();
+  EXPECT_EQ(0, preloader.m_requests[1]);
+
+  preloader.Preload({CreateChannel(1, 3)});
+  EXPECT_EQ(1u, preloader.m_jobs.size());
+  preloader.m_jobs.clear();
+
+  // destroying the preloader doesn't wait for the dropped requests
+}
+
+TEST(TestPVRChannelStreamPreloader, Expiry)
+{
+  TestPreloader preloader(std::chrono::seconds(0));
+  const std::shared_ptr<CPVRChannel> channel = CreateChannel(1, 1);
+
+  preloader.Preload({channel});
+  preloader.RunJobs();
+
+  CPVRStreamProperties props;
+  EXPECT_FALSE(preloader.TakePreloaded(channel, props));
+}
@@ -21,12 +21,22 @@
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 using namespace PVR;
 
+namespace
+{
+  // shared by all tables, so that a single serial tells which tags of all tables were looked at
+  std::atomic<unsigned int> g_iTagChangeSerial(0);
+}
+
 CPVREpg::CPVREpg(int iEpgID, const std::string& strName, const std::string& strScraperName)
 : m_bChanged(false),
   m_iEpgID(iEpgID),
@@ -73,6 +83,7 @@ void CPVREpg::Clear(void)
 {
   CSingleLock lock(m_critSection);
   m_tags.clear();
+  m_textIndex.Clear();
 }
 
 void CPVREpg::Cleanup(int iPastDays)
@@ -91,6 +102,7 @@ void CPVREpg::Cleanup(const CDateTime &time)
       if (m_nowActiveStart == it->first)
         m_nowActiveStart.SetValid(false);
 
+      m_textIndex.Remove(it->second);
       it = m_tags.erase(it);
     }
     else
@@ -241,8 +253,12 @@ CPVREpgInfoTagPtr CPVREpg::GetTagBetween(const CDateTime &beginTime, const CDate
 
     if (tag)
     {
-      m_tags.insert(std::make_pair(tag->StartAsUTC(), tag));
+      // UpdateEntry adds the tag as new, indexing it and queueing it for the database
       UpdateEntry(tag, CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_EPG_STOREEPGINDATABASE));
+
+      const auto it = m_tags.find(tag->StartAsUTC());
+      if (it != m_tags.end())
+        tag = it->second;
     }
   }
 
@@ -266,6 +282,14 @@ void CPVREpg::AddEntry(const CPVREpgInfoTag &tag)
   newTag->Update(tag);
   newTag->SetChannelData(m_channelData);
   newTag->SetEpgID(m_iEpgID);
+  m_textIndex.Update(newTag);
+  SetTagChanged(newTag);
+}
+
+void CPVREpg::SetTagChanged(const CPVREpgInfoTagPtr& tag)
+{
+  m_iLastChangeSerial = ++g_iTagChangeSerial;
+  tag->SetChangeSerial(m_iLastChangeSerial);
 }
 
 bool CPVREpg::Load(const std::shared_ptr<CPVREpgDatabase>& database)
@@ -356,10 +380,17 @@ bool CPVREpg::UpdateEntry(const CPVREpgInfoTagPtr &tag, bool bUpdateDatabase)
     bNewTag = true;
   }
 
-  infoTag->Update(*tag, bNewTag);
+  const bool bChanged = infoTag->Update(*tag, bNewTag);
   infoTag->SetChannelData(m_channelData);
   infoTag->SetEpgID(m_iEpgID);
 
+  /* unchanged tags are neither indexed nor written again */
+  if (!bNewTag && !bChanged)
+    return true;
+
+  m_textIndex.Update(infoTag);
+  SetTagChanged(infoTag);
+
   if (bUpdateDatabase)
     m_changedTags.insert(std::make_pair(infoTag->UniqueBroadcastID(), infoTag));
 
@@ -399,6 +430,7 @@ bool CPVREpg::UpdateEntry(const CPVREpgInfoTagPtr &tag, EPG_EVENT_STATE newState
         if (bUpdateDatabase)
           m_deletedTags.insert(std::make_pair(it->second->UniqueBroadcastID(), it->second));
 
+        m_textIndex.Remove(it->second);
         m_tags.erase(it);
       }
       else
@@ -481,55 +513,167 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetTags() const
   return tags;
 }
 
-bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetTagsChangedSince(unsigned int iSerial) const
 {
-  if (!database)
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+
+  CSingleLock lock(m_critSection);
+  if (m_iLastChangeSerial <= iSerial)
+    return tags;
+
+  for (const auto& tag : m_tags)
   {
-    CLog::LogF(LOGERROR, "No EPG database");
-    return false;
+    if (tag.second->ChangeSerial() > iSerial)
+      tags.emplace_back(tag.second);
   }
 
-  database->Lock();
+  return tags;
+}
 
+unsigned int CPVREpg::GetTagChangeSerial()
+{
+  return g_iTagChangeSerial;
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetTextSearchCandidates(const CTextSearch& search)
+{
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+
+  CSingleLock lock(m_critSection);
+  if (!m_textIndex.IsBuilt())
   {
-    CSingleLock lock(m_critSection);
-    bool bEpgIdChanged = false;
-    if (m_iEpgID <= 0 || m_bChanged)
+    tags.reserve(m_tags.size());
+    for (const auto& tag : m_tags)
+      tags.emplace_back(tag.second);
+
+    m_textIndex.Build(tags);
+    tags.clear();
+  }
+
+  IndexPendingTags();
+
+  if (!m_textIndex.GetCandidates(search, tags))
+  {
+    for (const auto& tag : m_tags)
+      tags.emplace_back(tag.second);
+  }
+
+  return tags;
+}
+
+void CPVREpg::IndexPendingTags()
+{
+  const std::vector<std::shared_ptr<CPVREpgInfoTag>> pendingTags = m_textIndex.GetPendingTags();
+  if (pendingTags.empty())
+    return;
+
+  const std::shared_ptr<CPVREpgDatabase> database = CServiceBroker::GetPVRManager().EpgContainer().GetEpgDatabase();
+
+  for (size_t iBatchStart = 0; iBatchStart < pendingTags.size(); iBatchStart += CPVREpgInfoTag::PLOT_BATCH_SIZE)
+  {
+    const auto begin = pendingTags.begin() + iBatchStart;
+    const auto end = pendingTags.begin() + std::min(iBatchStart + CPVREpgInfoTag::PLOT_BATCH_SIZE, pendingTags.size());
+
+    std::vector<int> releasedPlotIds;
+    std::vector<unsigned int> changeSerials;
+    for (auto it = begin; it != end; ++it)
     {
-      int iId = database->Persist(*this, m_iEpgID > 0);
-      if (iId > 0 && m_iEpgID != iId)
+      if (!(*it)->GetLoadedPlotAndCast(nullptr, nullptr))
+        releasedPlotIds.emplace_back((*it)->DatabaseID());
+      changeSerials.emplace_back((*it)->ChangeSerial());
+    }
+
+    /* Read the released plots of a batch in one query. Not locked meanwhile, the database
+     * might be locked by a thread waiting for this table. */
+    std::unordered_map<int, std::string> plots;
+    if (!releasedPlotIds.empty() && database)
+    {
+      CSingleExit exit(m_critSection);
+      plots = database->GetPlots(releasedPlotIds);
+    }
+
+    auto changeSerial = changeSerials.begin();
+    for (auto it = begin; it != end; ++it, ++changeSerial)
+    {
+      /* tags changed meanwhile stay pending */
+      if ((*it)->ChangeSerial() != *changeSerial)
+        continue;
+
+      std::string strPlot;
+      if (!(*it)->GetLoadedPlotAndCast(&strPlot, nullptr))
       {
-        m_iEpgID = iId;
-        bEpgIdChanged = true;
+        const auto plot = plots.find((*it)->DatabaseID());
+        if (plot == plots.end())
+          continue;
+
+        strPlot = plot->second;
       }
+
+      m_textIndex.Add(*it, strPlot);
     }
+  }
+}
 
-    for (const auto& tag : m_deletedTags)
-      database->Delete(*tag.second);
+bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
+{
+  if (!database)
+  {
+    CLog::LogF(LOGERROR, "No EPG database");
+    return false;
+  }
 
-    for (const auto& tag : m_changedTags)
-      tag.second->Persist(database, false);
+  database->Lock();
+  QueuePersistQueries(database);
+  bool bRet = database->CommitInsertQueries();
+  database->Unlock();
 
-    if (m_bUpdateLastScanTime)
-      database->PersistLastEpgScanTime(m_iEpgID, m_lastScanTime, true);
+  return bRet;
+}
 
-    if (bEpgIdChanged)
+size_t CPVREpg::QueuePersistQueries(const std::shared_ptr<CPVREpgDatabase>& database)
+{
+  CSingleLock lock(m_critSection);
+  bool bEpgIdChanged = false;
+  if (m_iEpgID <= 0 || m_bChanged)
+  {
+    int iId = database->Persist(*this, m_iEpgID > 0);
+    if (iId > 0 && m_iEpgID != iId)
     {
-      for (const auto& tag : m_tags)
-        tag.second->SetEpgID(m_iEpgID);
+      m_iEpgID = iId;
+      bEpgIdChanged = true;
     }
+  }
 
-    m_deletedTags.clear();
-    m_changedTags.clear();
-    m_bChanged            = false;
-    m_bTagsChanged        = false;
-    m_bUpdateLastScanTime = false;
+  if (bEpgIdChanged)
+  {
+    for (const auto& tag : m_tags)
+      tag.second->SetEpgID(m_iEpgID);
   }
 
-  bool bRet = database->CommitInsertQueries();
+  for (const auto& tag : m_deletedTags)
+    database->Delete(*tag.second, true);
 
-  database->Unlock();
-  return bRet;
+  const bool bReleasePlots = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bEpgLazyLoadPlots;
+  for (const auto& tag : m_changedTags)
+  {
+    /* Tags already stored keep their database id, their plot and cast can be read from there
+     * again. Released now, they are read once the queued writes are committed. */
+    if (tag.second->Persist(database, false) && bReleasePlots)
+      tag.second->ReleasePlotAndCast();
+  }
+
+  if (m_bUpdateLastScanTime)
+    database->PersistLastEpgScanTime(m_iEpgID, m_lastScanTime, true);
+
+  const size_t iQueuedTags = m_deletedTags.size() + m_changedTags.size();
+
+  m_deletedTags.clear();
+  m_changedTags.clear();
+  m_bChanged            = false;
+  m_bTagsChanged        = false;
+  m_bUpdateLastScanTime = false;
+
+  return iQueuedTags;
 }
 
 CDateTime CPVREpg::GetFirstDate(void) const
@@ -577,11 +721,13 @@ bool CPVREpg::FixOverlappingEvents(bool bUpdateDb /* = false */)
       if (m_nowActiveStart == it->first)
         m_nowActiveStart.SetValid(false);
 
+      m_textIndex.Remove(currentTag);
       m_tags.erase(it++);
     }
     else if (previousTag->EndAsUTC() > currentTag->StartAsUTC())
     {
       previousTag->SetEndFromUTC(currentTag->StartAsUTC());
+      SetTagChanged(previousTag);
       if (bUpdateDb)
         m_changedTags.insert(std::make_pair(previousTag->UniqueBroadcastID(), previousTag));
 
@@ -11,6 +11,7 @@
 #include "XBDateTime.h"
 #include "addons/kodi-addon-dev-kit/include/kodi/xbmc_pvr_types.h"
 #include "pvr/PVRTypes.h"
+#include "pvr/epg/EpgTextIndex.h"
 #include "threads/CriticalSection.h"
 #include "utils/Observer.h"
 
@@ -19,6 +20,8 @@
 #include <string>
 #include <vector>
 
+class CTextSearch;
+
 namespace PVR
 {
   class CPVREpgChannelData;
@@ -200,6 +203,26 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTags() const;
 
+    /*!
+     * @brief Get the tags that were added or changed after the given serial.
+     * @param iSerial The serial returned by GetTagChangeSerial() when the caller last looked at the tags.
+     * @return The tags.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTagsChangedSince(unsigned int iSerial) const;
+
+    /*!
+     * @brief Get the serial of the last tag change of all tables.
+     * @return The serial.
+     */
+    static unsigned int GetTagChangeSerial();
+
+    /*!
+     * @brief Get the tags which may match a text search. The text index of this table is built on first use.
+     * @param search The search.
+     * @return The candidates, all tags if the index cannot narrow down the search.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTextSearchCandidates(const CTextSearch& search);
+
     /*!
      * @brief Persist this table in the given database
      * @param database The database.
@@ -207,6 +230,13 @@ namespace PVR
      */
     bool Persist(const std::shared_ptr<CPVREpgDatabase>& database);
 
+    /*!
+     * @brief Queue the queries needed to persist this table in the given database, without committing them.
+     * @param database The database. The caller must hold its lock until the queries are committed.
+     * @return The number of tags that were written or deleted.
+     */
+    size_t QueuePersistQueries(const std::shared_ptr<CPVREpgDatabase>& database);
+
     /*!
      * @brief Get the start time of the first entry in this table.
      * @return The first date in UTC.
@@ -273,6 +303,18 @@ namespace PVR
      */
     void AddEntry(const CPVREpgInfoTag &tag);
 
+    /*!
+     * @brief Give a tag that was added or changed the next change serial.
+     * @param tag The tag.
+     */
+    void SetTagChanged(const CPVREpgInfoTagPtr& tag);
+
+    /*!
+     * @brief Add the new and changed tags to the text index. Released plots are read from the database in batches,
+     * without holding the lock.
+     */
+    void IndexPendingTags();
+
     /*!
      * @brief Load all EPG entries from clients into a temporary table and update this table with the contents of that temporary table.
      * @param start Only get entries after this start time. Use 0 to get all entries before "end".
@@ -297,6 +339,8 @@ namespace PVR
     void Cleanup(int iPastDays);
 
     std::map<CDateTime, CPVREpgInfoTagPtr> m_tags;
+    CPVREpgTextIndex                    m_textIndex;       /*!< the words of m_tags, once searched */
+    unsigned int                        m_iLastChangeSerial = 0; /*!< the serial of the last tag change of this table */
     std::map<int, CPVREpgInfoTagPtr>       m_changedTags;
     std::map<int, CPVREpgInfoTagPtr>       m_deletedTags;
     bool                                m_bChanged = false;        /*!< true if anything changed that needs to be persisted, false otherwise */
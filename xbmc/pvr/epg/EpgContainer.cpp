@@ -21,8 +21,14 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/InternedStringMap.h"
+#include "utils/JobManager.h"
+#include "utils/ParallelJobs.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -307,12 +313,32 @@ bool CPVREpgContainer::PersistAll(void)
     m_critSection.unlock();
 
     const std::shared_ptr<CPVREpgDatabase> database = GetEpgDatabase();
+    const size_t iBatchSize = static_cast<size_t>(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iEpgPersistBatchSize);
+
+    /* commit the queued queries of several tables at once, in one transaction per batch */
+    bReturn = true;
+    size_t iQueuedTags = 0;
+    database->Lock();
 
     for (const auto& epg : epgs)
     {
       if (epg.second && epg.second->NeedsSave())
-        bReturn &= epg.second->Persist(database);
+      {
+        iQueuedTags += epg.second->QueuePersistQueries(database);
+        if (iQueuedTags >= iBatchSize)
+        {
+          bReturn &= database->CommitInsertQueries();
+          iQueuedTags = 0;
+
+          /* let others use the database between the batches */
+          database->Unlock();
+          database->Lock();
+        }
+      }
     }
+
+    bReturn &= database->CommitInsertQueries();
+    database->Unlock();
   }
 
   return bReturn;
@@ -515,6 +541,24 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgContainer::GetAllTags() cons
   return allTags;
 }
 
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgContainer::GetTextSearchCandidates(const CTextSearch& search) const
+{
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+
+  // the tables build their indexes and read plots from the database, not under the container lock
+  m_critSection.lock();
+  const auto epgs = m_epgIdToEpgMap;
+  m_critSection.unlock();
+
+  for (const auto& epgEntry : epgs)
+  {
+    const std::vector<std::shared_ptr<CPVREpgInfoTag>> epgTags = epgEntry.second->GetTextSearchCandidates(search);
+    candidates.insert(candidates.end(), epgTags.begin(), epgTags.end());
+  }
+
+  return candidates;
+}
+
 void CPVREpgContainer::InsertFromDB(const CPVREpgPtr &newEpg)
 {
   // table might already have been created when pvr channels were loaded
@@ -592,6 +636,9 @@ bool CPVREpgContainer::RemoveOldEntries(void)
   if (UseDatabase())
     m_database->DeleteEpgEntries(cleanupTime);
 
+  /* drop the strings only the removed entries referred to */
+  CStringInterner::Purge();
+
   CSingleLock lock(m_critSection);
   CDateTime::GetCurrentDateTime().GetAsUTCDateTime().GetAsTime(m_iLastEpgCleanup);
 
@@ -684,40 +731,83 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
   if (bShowProgress && !bOnlyPending)
     progressHandler = new CPVRGUIProgressHandler(g_localizeStrings.Get(19004)); // Importing guide from clients
 
-  /* load or update all EPG tables */
-  unsigned int iCounter = 0;
-  const std::shared_ptr<CPVREpgDatabase> database = UseDatabase() ? GetEpgDatabase() : nullptr;
-  for (const auto& epgEntry : m_epgIdToEpgMap)
+  /* load or update all EPG tables. the clients are updated in parallel, each of them one or more channels at once */
+  std::map<int, std::vector<CPVREpgPtr>> clientEpgs;
+  size_t iTotalEpgs = 0;
   {
-    if (InterruptUpdate())
+    CSingleLock lock(m_critSection);
+    for (const auto& epgEntry : m_epgIdToEpgMap)
     {
-      bInterrupted = true;
-      break;
+      if (epgEntry.second)
+      {
+        clientEpgs[epgEntry.second->GetChannelData()->ClientId()].emplace_back(epgEntry.second);
+        iTotalEpgs++;
+      }
     }
+  }
 
-    const CPVREpgPtr epg = epgEntry.second;
-    if (!epg)
-      continue;
+  const std::shared_ptr<CPVREpgDatabase> database = UseDatabase() ? GetEpgDatabase() : nullptr;
+  const int iUpdateTime = m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60;
+  const int iPastDays = m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY);
+  const size_t iChannelsPerClient = static_cast<size_t>(std::max(advancedSettings->m_iEpgUpdateChannelsPerClient, 1));
 
-    if (bShowProgress && !bOnlyPending)
-      progressHandler->UpdateProgress(epg->Name(), ++iCounter, m_epgIdToEpgMap.size());
+  std::atomic<unsigned int> iCounter(0);
+  std::atomic<unsigned int> iUpdatedTablesCount(0);
+  std::atomic<bool> bUpdateInterrupted(false);
+  CCriticalSection invalidTablesLock;
 
-    if ((!bOnlyPending || epg->UpdatePending()) &&
-        epg->Update(start,
-                    end,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY),
-                    database,
-                    bOnlyPending))
-    {
-      iUpdatedTables++;
-    }
-    else if (!epg->IsValid())
+  std::vector<std::unique_ptr<std::atomic<size_t>>> nextEpgIndices;
+  CParallelJobs jobs;
+
+  for (const auto& client : clientEpgs)
+  {
+    const std::vector<CPVREpgPtr>& epgs = client.second;
+    nextEpgIndices.emplace_back(new std::atomic<size_t>(0));
+    std::atomic<size_t>& nextEpgIndex = *nextEpgIndices.back();
+
+    const size_t iJobs = std::min(iChannelsPerClient, epgs.size());
+    for (size_t i = 0; i < iJobs; ++i)
     {
-      invalidTables.push_back(epg);
+      jobs.Submit([&]() {
+        for (size_t iEpg = nextEpgIndex++; iEpg < epgs.size(); iEpg = nextEpgIndex++)
+        {
+          if (bUpdateInterrupted || InterruptUpdate())
+          {
+            bUpdateInterrupted = true;
+            break;
+          }
+
+          const CPVREpgPtr& epg = epgs[iEpg];
+
+          if (bShowProgress && !bOnlyPending)
+            progressHandler->UpdateProgress(epg->Name(), ++iCounter, iTotalEpgs);
+
+          if ((!bOnlyPending || epg->UpdatePending()) &&
+              epg->Update(start, end, iUpdateTime, iPastDays, database, bOnlyPending))
+          {
+            iUpdatedTablesCount++;
+          }
+          else if (!epg->IsValid())
+          {
+            CSingleLock lock(invalidTablesLock);
+            invalidTables.push_back(epg);
+          }
+        }
+      });
     }
   }
 
+  // jobs dropped on shutdown leave their tables untouched
+  if (!jobs.Wait([this]() { return InterruptUpdate(); }))
+    bUpdateInterrupted = true;
+
+  bInterrupted = bUpdateInterrupted;
+  iUpdatedTables = iUpdatedTablesCount;
+
+  /* write the changes of all updated tables in a few large transactions */
+  if (iUpdatedTables > 0 && database)
+    PersistAll();
+
   if (bShowProgress && !bOnlyPending)
     progressHandler->DestroyProgress();
 
@@ -24,6 +24,8 @@
 #include <utility>
 #include <vector>
 
+class CTextSearch;
+
 namespace PVR
 {
   class CEpgUpdateRequest;
@@ -147,6 +149,13 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetAllTags() const;
 
+    /*!
+     * @brief Get all EPG tags which may match a text search, looked up in the text indexes of the tables.
+     * @param search The search.
+     * @return The tags, a superset of the matching ones.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTextSearchCandidates(const CTextSearch& search) const;
+
     /*!
      * @brief Check whether data should be persisted to the EPG database.
      * @return True if data should be persisted to the EPG database, false otherwise.
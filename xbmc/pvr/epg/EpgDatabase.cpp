@@ -15,6 +15,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
 #include <cstdlib>
@@ -25,6 +26,12 @@
 using namespace dbiplus;
 using namespace PVR;
 
+namespace
+{
+  // plots and casts of the tags shown last, which are read again and again by the GUI
+  const size_t PLOT_AND_CAST_CACHE_SIZE = 64;
+}
+
 bool CPVREpgDatabase::Open()
 {
   CSingleLock lock(m_critSection);
@@ -150,6 +157,7 @@ bool CPVREpgDatabase::DeleteEpg(void)
   CLog::LogFC(LOGDEBUG, LOGEPG, "Deleting all EPG data from the database");
 
   CSingleLock lock(m_critSection);
+  ClearPlotAndCastCache();
 
   bReturn = DeleteValues("epg") || bReturn;
   bReturn = DeleteValues("epgtags") || bReturn;
@@ -170,6 +178,7 @@ bool CPVREpgDatabase::Delete(const CPVREpg &table)
   Filter filter;
 
   CSingleLock lock(m_critSection);
+  ClearPlotAndCastCache();
   filter.AppendWhere(PrepareSQL("idEpg = %u", table.EpgID()));
   return DeleteValues("epg", filter);
 }
@@ -182,19 +191,23 @@ bool CPVREpgDatabase::DeleteEpgEntries(const CDateTime &maxEndTime)
   Filter filter;
 
   CSingleLock lock(m_critSection);
+  ClearPlotAndCastCache();
   filter.AppendWhere(PrepareSQL("iEndTime < %u", iMaxEndTime));
   return DeleteValues("epgtags", filter);
 }
 
-bool CPVREpgDatabase::Delete(const CPVREpgInfoTag &tag)
+bool CPVREpgDatabase::Delete(const CPVREpgInfoTag &tag, bool bQueueWrite /* = false */)
 {
   /* tag without a database ID was not persisted */
   if (tag.DatabaseID() <= 0)
     return false;
 
-  Filter filter;
-
   CSingleLock lock(m_critSection);
+  UncachePlotAndCast(tag.DatabaseID());
+  if (bQueueWrite)
+    return QueueInsertQuery(PrepareSQL("DELETE FROM epgtags WHERE idBroadcast = %u", tag.DatabaseID()));
+
+  Filter filter;
   filter.AppendWhere(PrepareSQL("idBroadcast = %u", tag.DatabaseID()));
   return DeleteValues("epgtags", filter);
 }
@@ -233,6 +246,8 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::Get(const CPVREpg
 {
   std::vector<std::shared_ptr<CPVREpgInfoTag>> result;
 
+  const bool bLazyLoadPlots = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bEpgLazyLoadPlots;
+
   CSingleLock lock(m_critSection);
   std::string strQuery = PrepareSQL("SELECT * FROM epgtags WHERE idEpg = %u;", epg.EpgID());
   if (ResultQuery(strQuery))
@@ -243,45 +258,39 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::Get(const CPVREpg
       {
         std::shared_ptr<CPVREpgInfoTag> newTag(new CPVREpgInfoTag());
 
-        time_t iStartTime, iEndTime, iFirstAired;
-        iStartTime = (time_t) m_pDS->fv("iStartTime").get_asInt();
-        CDateTime startTime(iStartTime);
-        newTag->m_startTime = startTime;
-
-        iEndTime = (time_t) m_pDS->fv("iEndTime").get_asInt();
-        CDateTime endTime(iEndTime);
-        newTag->m_endTime = endTime;
-
-        iFirstAired = (time_t) m_pDS->fv("iFirstAired").get_asInt();
-        CDateTime firstAired(iFirstAired);
-        newTag->m_firstAired = firstAired;
+        newTag->m_iStartTime         = static_cast<time_t>(m_pDS->fv("iStartTime").get_asInt());
+        newTag->m_iEndTime           = static_cast<time_t>(m_pDS->fv("iEndTime").get_asInt());
+        newTag->m_iFirstAired        = static_cast<time_t>(m_pDS->fv("iFirstAired").get_asInt());
 
         int iBroadcastUID = m_pDS->fv("iBroadcastUid").get_asInt();
         // Compat: null value for broadcast uid changed from numerical -1 to 0 with PVR Addon API v4.0.0
         newTag->m_iUniqueBroadcastID = iBroadcastUID == -1 ? EPG_TAG_INVALID_UID : iBroadcastUID;
 
         newTag->m_iDatabaseID        = m_pDS->fv("idBroadcast").get_asInt();
-        newTag->m_strTitle           = m_pDS->fv("sTitle").get_asString().c_str();
+        newTag->m_title              = CPVREpgInfoTag::Intern(m_pDS->fv("sTitle").get_asString());
         newTag->m_strPlotOutline     = m_pDS->fv("sPlotOutline").get_asString().c_str();
-        newTag->m_strPlot            = m_pDS->fv("sPlot").get_asString().c_str();
-        newTag->m_strOriginalTitle   = m_pDS->fv("sOriginalTitle").get_asString().c_str();
-        newTag->m_cast               = newTag->Tokenize(m_pDS->fv("sCast").get_asString());
-        newTag->m_directors          = newTag->Tokenize(m_pDS->fv("sDirector").get_asString());
-        newTag->m_writers            = newTag->Tokenize(m_pDS->fv("sWriter").get_asString());
+        newTag->m_originalTitle      = CPVREpgInfoTag::Intern(m_pDS->fv("sOriginalTitle").get_asString());
+        newTag->m_directors          = CPVREpgInfoTag::Intern(m_pDS->fv("sDirector").get_asString());
+        newTag->m_writers            = CPVREpgInfoTag::Intern(m_pDS->fv("sWriter").get_asString());
         newTag->m_iYear              = m_pDS->fv("iYear").get_asInt();
         newTag->m_strIMDBNumber      = m_pDS->fv("sIMDBNumber").get_asString().c_str();
         newTag->m_iGenreType         = m_pDS->fv("iGenreType").get_asInt();
         newTag->m_iGenreSubType      = m_pDS->fv("iGenreSubType").get_asInt();
-        newTag->m_genre              = newTag->Tokenize(m_pDS->fv("sGenre").get_asString());
+        newTag->m_genre              = CPVREpgInfoTag::Intern(m_pDS->fv("sGenre").get_asString());
         newTag->m_iParentalRating    = m_pDS->fv("iParentalRating").get_asInt();
         newTag->m_iStarRating        = m_pDS->fv("iStarRating").get_asInt();
         newTag->m_iEpisodeNumber     = m_pDS->fv("iEpisodeId").get_asInt();
         newTag->m_iEpisodePart       = m_pDS->fv("iEpisodePart").get_asInt();
         newTag->m_strEpisodeName     = m_pDS->fv("sEpisodeName").get_asString().c_str();
         newTag->m_iSeriesNumber      = m_pDS->fv("iSeriesId").get_asInt();
-        newTag->m_strIconPath        = m_pDS->fv("sIconPath").get_asString().c_str();
+        newTag->m_iconPath           = CPVREpgInfoTag::Intern(m_pDS->fv("sIconPath").get_asString());
         newTag->m_iFlags             = m_pDS->fv("iFlags").get_asInt();
-        newTag->m_strSeriesLink      = m_pDS->fv("sSeriesLink").get_asString().c_str();
+        newTag->m_seriesLink         = CPVREpgInfoTag::Intern(m_pDS->fv("sSeriesLink").get_asString());
+
+        newTag->SetPlotAndCast(m_pDS->fv("sPlot").get_asString(), newTag->Tokenize(m_pDS->fv("sCast").get_asString()));
+        newTag->m_bPlotAndCastInDatabase = true;
+        if (bLazyLoadPlots)
+          newTag->ReleasePlotAndCast();
 
         result.emplace_back(newTag);
 
@@ -297,6 +306,105 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::Get(const CPVREpg
   return result;
 }
 
+bool CPVREpgDatabase::GetPlotAndCast(int iBroadcastId, std::string& strPlot, std::string& strCast)
+{
+  bool bReturn = false;
+
+  CSingleLock lock(m_critSection);
+  const auto it = m_plotAndCastCacheIds.find(iBroadcastId);
+  if (it != m_plotAndCastCacheIds.end())
+  {
+    m_plotAndCastCache.splice(m_plotAndCastCache.begin(), m_plotAndCastCache, it->second);
+    strPlot = it->second->second.first;
+    strCast = it->second->second.second;
+    return true;
+  }
+
+  std::string strQuery = PrepareSQL("SELECT sPlot, sCast FROM epgtags WHERE idBroadcast = %u;", iBroadcastId);
+  if (ResultQuery(strQuery))
+  {
+    try
+    {
+      if (!m_pDS->eof())
+      {
+        strPlot = m_pDS->fv("sPlot").get_asString();
+        strCast = m_pDS->fv("sCast").get_asString();
+        CachePlotAndCast(iBroadcastId, strPlot, strCast);
+        bReturn = true;
+      }
+      m_pDS->close();
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Could not load plot and cast from the database");
+    }
+  }
+  return bReturn;
+}
+
+std::unordered_map<int, std::string> CPVREpgDatabase::GetPlots(const std::vector<int>& broadcastIds)
+{
+  std::unordered_map<int, std::string> result;
+  if (broadcastIds.empty())
+    return result;
+
+  std::string strIds;
+  for (int iBroadcastId : broadcastIds)
+  {
+    if (!strIds.empty())
+      strIds += ",";
+    strIds += StringUtils::Format("%d", iBroadcastId);
+  }
+
+  CSingleLock lock(m_critSection);
+  std::string strQuery = PrepareSQL("SELECT idBroadcast, sPlot FROM epgtags WHERE idBroadcast IN (%s);", strIds.c_str());
+  if (ResultQuery(strQuery))
+  {
+    try
+    {
+      while (!m_pDS->eof())
+      {
+        result.insert(std::make_pair(m_pDS->fv("idBroadcast").get_asInt(), m_pDS->fv("sPlot").get_asString()));
+        m_pDS->next();
+      }
+      m_pDS->close();
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Could not load plots from the database");
+    }
+  }
+  return result;
+}
+
+void CPVREpgDatabase::CachePlotAndCast(int iBroadcastId, const std::string& strPlot, const std::string& strCast)
+{
+  m_plotAndCastCache.emplace_front(iBroadcastId, std::make_pair(strPlot, strCast));
+  m_plotAndCastCacheIds[iBroadcastId] = m_plotAndCastCache.begin();
+
+  if (m_plotAndCastCache.size() > PLOT_AND_CAST_CACHE_SIZE)
+  {
+    m_plotAndCastCacheIds.erase(m_plotAndCastCache.back().first);
+    m_plotAndCastCache.pop_back();
+  }
+}
+
+void CPVREpgDatabase::UncachePlotAndCast(int iBroadcastId)
+{
+  const auto it = m_plotAndCastCacheIds.find(iBroadcastId);
+  if (it != m_plotAndCastCacheIds.end())
+  {
+    m_plotAndCastCache.erase(it->second);
+    m_plotAndCastCacheIds.erase(it);
+  }
+}
+
+void CPVREpgDatabase::ClearPlotAndCastCache()
+{
+  m_plotAndCastCache.clear();
+  m_plotAndCastCacheIds.clear();
+}
+
 bool CPVREpgDatabase::GetLastEpgScanTime(int iEpgId, CDateTime *lastScan)
 {
   bool bReturn = false;
@@ -375,9 +483,33 @@ int CPVREpgDatabase::Persist(const CPVREpgInfoTag &tag, bool bSingleUpdate /* =
   /* Only store the genre string when needed */
   std::string strGenre = (tag.GenreType() == EPG_GENRE_USE_STRING) ? tag.DeTokenize(tag.Genre()) : "";
 
+  std::string strPlot;
+  std::vector<std::string> cast;
+  const bool bPlotAndCastLoaded = tag.GetLoadedPlotAndCast(&strPlot, &cast);
+
   CSingleLock lock(m_critSection);
 
-  if (iBroadcastId < 0)
+  if (iBroadcastId > 0)
+    UncachePlotAndCast(iBroadcastId);
+
+  if (!bPlotAndCastLoaded && iBroadcastId > 0)
+  {
+    /* plot and cast were released, the row still holds them */
+    strQuery = PrepareSQL("UPDATE epgtags SET idEpg = %u, iStartTime = %u, iEndTime = %u, sTitle = '%s', "
+        "sPlotOutline = '%s', sOriginalTitle = '%s', sDirector = '%s', sWriter = '%s', iYear = %i, sIMDBNumber = '%s', "
+        "sIconPath = '%s', iGenreType = %i, iGenreSubType = %i, sGenre = '%s', iFirstAired = %u, iParentalRating = %i, "
+        "iStarRating = %i, bNotify = %i, iSeriesId = %i, iEpisodeId = %i, iEpisodePart = %i, sEpisodeName = '%s', "
+        "iFlags = %i, sSeriesLink = '%s', iBroadcastUid = %i WHERE idBroadcast = %i;",
+        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
+        tag.Title().c_str(), tag.PlotOutline().c_str(),
+        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Directors()).c_str(),
+        tag.DeTokenize(tag.Writers()).c_str(), tag.Year(), tag.IMDBNumber().c_str(),
+        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
+        static_cast<unsigned int>(iFirstAired), tag.ParentalRating(), tag.StarRating(), false /* unused */,
+        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(), tag.SeriesLink().c_str(),
+        tag.UniqueBroadcastID(), iBroadcastId);
+  }
+  else if (iBroadcastId < 0)
   {
     strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
         "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
@@ -385,8 +517,8 @@ int CPVREpgDatabase::Persist(const CPVREpgInfoTag &tag, bool bSingleUpdate /* =
         "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, iBroadcastUid) "
         "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, '%s', %i);",
         tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(), tag.DeTokenize(tag.Directors()).c_str(),
+        tag.Title().c_str(), tag.PlotOutline().c_str(), strPlot.c_str(),
+        tag.OriginalTitle().c_str(), tag.DeTokenize(cast).c_str(), tag.DeTokenize(tag.Directors()).c_str(),
         tag.DeTokenize(tag.Writers()).c_str(), tag.Year(), tag.IMDBNumber().c_str(),
         tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
         static_cast<unsigned int>(iFirstAired), tag.ParentalRating(), tag.StarRating(), false /* unused */,
@@ -401,8 +533,8 @@ int CPVREpgDatabase::Persist(const CPVREpgInfoTag &tag, bool bSingleUpdate /* =
         "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, iBroadcastUid, idBroadcast) "
         "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, '%s', %i, %i);",
         tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(), tag.DeTokenize(tag.Directors()).c_str(),
+        tag.Title().c_str(), tag.PlotOutline().c_str(), strPlot.c_str(),
+        tag.OriginalTitle().c_str(), tag.DeTokenize(cast).c_str(), tag.DeTokenize(tag.Directors()).c_str(),
         tag.DeTokenize(tag.Writers()).c_str(), tag.Year(), tag.IMDBNumber().c_str(),
         tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
         static_cast<unsigned int>(iFirstAired), tag.ParentalRating(), tag.StarRating(), false /* unused */,
@@ -413,7 +545,7 @@ int CPVREpgDatabase::Persist(const CPVREpgInfoTag &tag, bool bSingleUpdate /* =
   if (bSingleUpdate)
   {
     if (ExecuteQuery(strQuery))
-      iReturn = (int) m_pDS->lastinsertid();
+      iReturn = bPlotAndCastLoaded || iBroadcastId <= 0 ? (int) m_pDS->lastinsertid() : iBroadcastId;
   }
   else
   {
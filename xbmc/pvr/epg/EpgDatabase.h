@@ -11,7 +11,11 @@
 #include "dbwrappers/Database.h"
 #include "threads/CriticalSection.h"
 
+#include <list>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 class CDateTime;
@@ -95,9 +99,10 @@ namespace PVR
     /*!
      * @brief Remove a single EPG entry.
      * @param tag The entry to remove.
-     * @return True if it was removed successfully, false otherwise.
+     * @param bQueueWrite Don't execute the query immediately but queue it if true.
+     * @return True if it was removed (or queued) successfully, false otherwise.
      */
-    bool Delete(const CPVREpgInfoTag &tag);
+    bool Delete(const CPVREpgInfoTag &tag, bool bQueueWrite = false);
 
     /*!
      * @brief Get all EPG tables from the database. Does not get the EPG tables' entries.
@@ -112,6 +117,22 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> Get(const CPVREpg &epg);
 
+    /*!
+     * @brief Get plot and cast of an EPG entry. The entries read last are cached.
+     * @param iBroadcastId The database id of the entry.
+     * @param strPlot The plot.
+     * @param strCast The cast, tokenized.
+     * @return True if the entry was found, false otherwise.
+     */
+    bool GetPlotAndCast(int iBroadcastId, std::string& strPlot, std::string& strCast);
+
+    /*!
+     * @brief Get the plots of several EPG entries in one query.
+     * @param broadcastIds The database ids of the entries.
+     * @return Plot by database id of the entry.
+     */
+    std::unordered_map<int, std::string> GetPlots(const std::vector<int>& broadcastIds);
+
     /*!
      * @brief Get the last stored EPG scan time.
      * @param iEpgId The table to update the time for. Use 0 for a global value.
@@ -138,7 +159,7 @@ namespace PVR
     int Persist(const CPVREpg &epg, bool bQueueWrite = false);
 
     /*!
-     * @brief Persist an infotag.
+     * @brief Persist an infotag. Plot and cast of a tag that released them are kept as stored.
      * @param tag The tag to persist.
      * @param bSingleUpdate If true, this is a single update and the query will be executed immediately.
      * @return The database ID of this entry or 0 if bSingleUpdate is false and the query was queued.
@@ -171,6 +192,14 @@ namespace PVR
 
     int GetMinSchemaVersion() const override { return 4; }
 
+    void CachePlotAndCast(int iBroadcastId, const std::string& strPlot, const std::string& strCast);
+    void UncachePlotAndCast(int iBroadcastId);
+    void ClearPlotAndCastCache();
+
     CCriticalSection m_critSection;
+
+    typedef std::list<std::pair<int, std::pair<std::string, std::string>>> PlotAndCastList;
+    PlotAndCastList m_plotAndCastCache; /*!< plot and cast read last, most recent first */
+    std::unordered_map<int, PlotAndCastList::iterator> m_plotAndCastCacheIds; /*!< entries of m_plotAndCastCache by database id */
   };
 }
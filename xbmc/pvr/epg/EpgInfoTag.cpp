@@ -19,26 +19,77 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/InternedStringMap.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace PVR;
 
+namespace
+{
+  // start, end and first aired time of tags that never got one; they are invalid, not 1970-01-01
+  const time_t TIME_NOT_SET = std::numeric_limits<time_t>::min();
+
+  CDateTime ToDateTime(time_t time)
+  {
+    return time == TIME_NOT_SET ? CDateTime() : CDateTime(time);
+  }
+
+  time_t ToTime(const CDateTime& dateTime)
+  {
+    if (!dateTime.IsValid())
+      return TIME_NOT_SET;
+
+    time_t time;
+    dateTime.GetAsTime(time);
+    return time;
+  }
+
+  const std::string& GetString(const std::shared_ptr<const std::string>& str)
+  {
+    return str ? *str : StringUtils::Empty;
+  }
+
+  std::vector<std::string> GetTokens(const std::shared_ptr<const std::string>& tokens)
+  {
+    return tokens ? CPVREpgInfoTag::Tokenize(*tokens) : std::vector<std::string>();
+  }
+
+  size_t HashPlotAndCast(const std::string& strPlot, const std::vector<std::string>& cast)
+  {
+    size_t hash = std::hash<std::string>()(strPlot);
+    for (const auto& castEntry : cast)
+      hash ^= std::hash<std::string>()(castEntry) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+}
+
 CPVREpgInfoTag::CPVREpgInfoTag()
 : m_iUniqueBroadcastID(EPG_TAG_INVALID_UID),
   m_iFlags(EPG_TAG_FLAG_UNDEFINED),
+  m_iStartTime(TIME_NOT_SET),
+  m_iEndTime(TIME_NOT_SET),
+  m_iFirstAired(TIME_NOT_SET),
   m_channelData(new CPVREpgChannelData)
 {
+  m_iPlotAndCastHash = HashPlotAndCast(m_strPlot, m_cast);
 }
 
 CPVREpgInfoTag::CPVREpgInfoTag(const std::shared_ptr<CPVREpgChannelData>& channelData, int iEpgID)
 : m_iUniqueBroadcastID(EPG_TAG_INVALID_UID),
   m_iFlags(EPG_TAG_FLAG_UNDEFINED),
+  m_iStartTime(TIME_NOT_SET),
+  m_iEndTime(TIME_NOT_SET),
+  m_iFirstAired(TIME_NOT_SET),
   m_iEpgID(iEpgID)
 {
   if (channelData)
@@ -46,7 +97,7 @@ CPVREpgInfoTag::CPVREpgInfoTag(const std::shared_ptr<CPVREpgChannelData>& channe
   else
     m_channelData = std::make_shared<CPVREpgChannelData>();
 
-  UpdatePath();
+  m_iPlotAndCastHash = HashPlotAndCast(m_strPlot, m_cast);
 }
 
 CPVREpgInfoTag::CPVREpgInfoTag(const EPG_TAG& data, int iClientId, const std::shared_ptr<CPVREpgChannelData>& channelData, int iEpgID)
@@ -57,10 +108,10 @@ CPVREpgInfoTag::CPVREpgInfoTag(const EPG_TAG& data, int iClientId, const std::sh
   m_iEpisodePart(data.iEpisodePartNumber),
   m_iUniqueBroadcastID(data.iUniqueBroadcastId),
   m_iYear(data.iYear),
-  m_startTime(data.startTime + CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection),
-  m_endTime(data.endTime + CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection),
-  m_firstAired(data.firstAired + CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection),
   m_iFlags(data.iFlags),
+  m_iStartTime(data.startTime + CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection),
+  m_iEndTime(data.endTime + CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection),
+  m_iFirstAired(data.firstAired + CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection),
   m_iEpgID(iEpgID)
 {
   if (channelData)
@@ -84,29 +135,26 @@ CPVREpgInfoTag::CPVREpgInfoTag(const EPG_TAG& data, int iClientId, const std::sh
 
   // explicit NULL check, because there is no implicit NULL constructor for std::string
   if (data.strTitle)
-    m_strTitle = data.strTitle;
+    m_title = Intern(data.strTitle);
   if (data.strPlotOutline)
     m_strPlotOutline = data.strPlotOutline;
-  if (data.strPlot)
-    m_strPlot = data.strPlot;
   if (data.strOriginalTitle)
-    m_strOriginalTitle = data.strOriginalTitle;
-  if (data.strCast)
-    m_cast = Tokenize(data.strCast);
+    m_originalTitle = Intern(data.strOriginalTitle);
   if (data.strDirector)
-    m_directors = Tokenize(data.strDirector);
+    m_directors = Intern(data.strDirector);
   if (data.strWriter)
-    m_writers = Tokenize(data.strWriter);
+    m_writers = Intern(data.strWriter);
   if (data.strIMDBNumber)
     m_strIMDBNumber = data.strIMDBNumber;
   if (data.strEpisodeName)
     m_strEpisodeName = data.strEpisodeName;
   if (data.strIconPath)
-    m_strIconPath = data.strIconPath;
+    m_iconPath = Intern(data.strIconPath);
   if (data.strSeriesLink)
-    m_strSeriesLink = data.strSeriesLink;
+    m_seriesLink = Intern(data.strSeriesLink);
 
-  UpdatePath();
+  SetPlotAndCast(data.strPlot ? data.strPlot : "",
+                 data.strCast ? Tokenize(data.strCast) : std::vector<std::string>());
 }
 
 void CPVREpgInfoTag::SetChannelData(const std::shared_ptr<CPVREpgChannelData>& data)
@@ -128,17 +176,16 @@ bool CPVREpgInfoTag::operator ==(const CPVREpgInfoTag& right) const
           m_iGenreType         == right.m_iGenreType &&
           m_iGenreSubType      == right.m_iGenreSubType &&
           m_iParentalRating    == right.m_iParentalRating &&
-          m_firstAired         == right.m_firstAired &&
+          m_iFirstAired        == right.m_iFirstAired &&
           m_iStarRating        == right.m_iStarRating &&
           m_iSeriesNumber      == right.m_iSeriesNumber &&
           m_iEpisodeNumber     == right.m_iEpisodeNumber &&
           m_iEpisodePart       == right.m_iEpisodePart &&
           m_iUniqueBroadcastID == right.m_iUniqueBroadcastID &&
-          m_strTitle           == right.m_strTitle &&
+          m_title              == right.m_title &&
           m_strPlotOutline     == right.m_strPlotOutline &&
-          m_strPlot            == right.m_strPlot &&
-          m_strOriginalTitle   == right.m_strOriginalTitle &&
-          m_cast               == right.m_cast &&
+          PlotAndCastEquals(right) &&
+          m_originalTitle      == right.m_originalTitle &&
           m_directors          == right.m_directors &&
           m_writers            == right.m_writers &&
           m_iYear              == right.m_iYear &&
@@ -146,12 +193,11 @@ bool CPVREpgInfoTag::operator ==(const CPVREpgInfoTag& right) const
           m_genre              == right.m_genre &&
           m_strEpisodeName     == right.m_strEpisodeName &&
           m_iEpgID             == right.m_iEpgID &&
-          m_strIconPath        == right.m_strIconPath &&
-          m_strFileNameAndPath == right.m_strFileNameAndPath &&
-          m_startTime          == right.m_startTime &&
-          m_endTime            == right.m_endTime &&
+          m_iconPath           == right.m_iconPath &&
+          m_iStartTime         == right.m_iStartTime &&
+          m_iEndTime           == right.m_iEndTime &&
           m_iFlags             == right.m_iFlags &&
-          m_strSeriesLink      == right.m_strSeriesLink &&
+          m_seriesLink         == right.m_seriesLink &&
           m_channelData        == right.m_channelData);
 }
 
@@ -165,26 +211,34 @@ bool CPVREpgInfoTag::operator !=(const CPVREpgInfoTag& right) const
 
 void CPVREpgInfoTag::Serialize(CVariant &value) const
 {
+  std::string strPlot;
+  std::vector<std::string> cast;
+  GetPlotAndCast(&strPlot, &cast);
+
+  const CDateTime startTime = StartAsUTC();
+  const CDateTime endTime = EndAsUTC();
+  const CDateTime firstAired = FirstAiredAsUTC();
+
   CSingleLock lock(m_critSection);
   value["broadcastid"] = m_iUniqueBroadcastID;
   value["channeluid"] = m_channelData->UniqueClientChannelId();
   value["parentalrating"] = m_iParentalRating;
   value["rating"] = m_iStarRating;
-  value["title"] = m_strTitle;
+  value["title"] = GetString(m_title);
   value["plotoutline"] = m_strPlotOutline;
-  value["plot"] = m_strPlot;
-  value["originaltitle"] = m_strOriginalTitle;
-  value["cast"] = DeTokenize(m_cast);
-  value["director"] = DeTokenize(m_directors);
-  value["writer"] = DeTokenize(m_writers);
+  value["plot"] = strPlot;
+  value["originaltitle"] = GetString(m_originalTitle);
+  value["cast"] = DeTokenize(cast);
+  value["director"] = GetString(m_directors);
+  value["writer"] = GetString(m_writers);
   value["year"] = m_iYear;
   value["imdbnumber"] = m_strIMDBNumber;
-  value["genre"] = m_genre;
-  value["filenameandpath"] = m_strFileNameAndPath;
-  value["starttime"] = m_startTime.IsValid() ? m_startTime.GetAsDBDateTime() : StringUtils::Empty;
-  value["endtime"] = m_endTime.IsValid() ? m_endTime.GetAsDBDateTime() : StringUtils::Empty;
+  value["genre"] = Genre();
+  value["filenameandpath"] = Path();
+  value["starttime"] = startTime.IsValid() ? startTime.GetAsDBDateTime() : StringUtils::Empty;
+  value["endtime"] = endTime.IsValid() ? endTime.GetAsDBDateTime() : StringUtils::Empty;
   value["runtime"] = GetDuration() / 60;
-  value["firstaired"] = m_firstAired.IsValid() ? m_firstAired.GetAsDBDate() : StringUtils::Empty;
+  value["firstaired"] = firstAired.IsValid() ? firstAired.GetAsDBDate() : StringUtils::Empty;
   value["progress"] = Progress();
   value["progresspercentage"] = ProgressPercentage();
   value["episodename"] = m_strEpisodeName;
@@ -197,7 +251,7 @@ void CPVREpgInfoTag::Serialize(CVariant &value) const
   value["isactive"] = IsActive();
   value["wasactive"] = WasActive();
   value["isseries"] = IsSeries();
-  value["serieslink"] = m_strSeriesLink;
+  value["serieslink"] = GetString(m_seriesLink);
 }
 
 int CPVREpgInfoTag::ClientID() const
@@ -244,29 +298,29 @@ CDateTime CPVREpgInfoTag::GetCurrentPlayingTime() const
 bool CPVREpgInfoTag::IsActive(void) const
 {
   CDateTime now = GetCurrentPlayingTime();
-  return (m_startTime <= now && m_endTime > now);
+  return (StartAsUTC() <= now && EndAsUTC() > now);
 }
 
 bool CPVREpgInfoTag::WasActive(void) const
 {
   CDateTime now = GetCurrentPlayingTime();
-  return (m_endTime < now);
+  return (EndAsUTC() < now);
 }
 
 bool CPVREpgInfoTag::IsUpcoming(void) const
 {
   CDateTime now = GetCurrentPlayingTime();
-  return (m_startTime > now);
+  return (StartAsUTC() > now);
 }
 
 float CPVREpgInfoTag::ProgressPercentage(void) const
 {
   float fReturn = 0.0f;
 
-  time_t currentTime, startTime, endTime;
+  time_t currentTime;
   CDateTime::GetCurrentDateTime().GetAsUTCDateTime().GetAsTime(currentTime);
-  m_startTime.GetAsTime(startTime);
-  m_endTime.GetAsTime(endTime);
+  const time_t startTime = m_iStartTime;
+  const time_t endTime = m_iEndTime;
   int iDuration = endTime - startTime > 0 ? endTime - startTime : 3600;
 
   if (currentTime >= startTime && currentTime <= endTime)
@@ -279,10 +333,9 @@ float CPVREpgInfoTag::ProgressPercentage(void) const
 
 int CPVREpgInfoTag::Progress(void) const
 {
-  time_t currentTime, startTime;
+  time_t currentTime;
   CDateTime::GetCurrentDateTime().GetAsUTCDateTime().GetAsTime(currentTime);
-  m_startTime.GetAsTime(startTime);
-  int iDuration = currentTime - startTime;
+  int iDuration = currentTime - m_iStartTime;
 
   if (iDuration <= 0)
     return 0;
@@ -313,44 +366,42 @@ int CPVREpgInfoTag::UniqueChannelID(void) const
 
 CDateTime CPVREpgInfoTag::StartAsUTC(void) const
 {
-  return m_startTime;
+  return ToDateTime(m_iStartTime);
 }
 
 CDateTime CPVREpgInfoTag::StartAsLocalTime(void) const
 {
   CDateTime retVal;
-  retVal.SetFromUTCDateTime(m_startTime);
+  retVal.SetFromUTCDateTime(StartAsUTC());
   return retVal;
 }
 
 CDateTime CPVREpgInfoTag::EndAsUTC(void) const
 {
-  return m_endTime;
+  return ToDateTime(m_iEndTime);
 }
 
 CDateTime CPVREpgInfoTag::EndAsLocalTime(void) const
 {
   CDateTime retVal;
-  retVal.SetFromUTCDateTime(m_endTime);
+  retVal.SetFromUTCDateTime(EndAsUTC());
   return retVal;
 }
 
 void CPVREpgInfoTag::SetEndFromUTC(const CDateTime &end)
 {
-  m_endTime = end;
+  m_iEndTime = ToTime(end);
 }
 
 int CPVREpgInfoTag::GetDuration(void) const
 {
-  time_t start, end;
-  m_startTime.GetAsTime(start);
-  m_endTime.GetAsTime(end);
-  return end - start > 0 ? end - start : 3600;
+  const time_t duration = m_iEndTime - m_iStartTime;
+  return duration > 0 ? duration : 3600;
 }
 
 std::string CPVREpgInfoTag::Title() const
 {
-  return m_strTitle;
+  return GetString(m_title);
 }
 
 std::string CPVREpgInfoTag::PlotOutline() const
@@ -360,34 +411,38 @@ std::string CPVREpgInfoTag::PlotOutline() const
 
 std::string CPVREpgInfoTag::Plot() const
 {
-  return m_strPlot;
+  std::string strPlot;
+  GetPlotAndCast(&strPlot, nullptr);
+  return strPlot;
 }
 
 std::string CPVREpgInfoTag::OriginalTitle() const
 {
-  return m_strOriginalTitle;
+  return GetString(m_originalTitle);
 }
 
 const std::vector<std::string> CPVREpgInfoTag::Cast(void) const
 {
-  return m_cast;
+  std::vector<std::string> cast;
+  GetPlotAndCast(nullptr, &cast);
+  return cast;
 }
 
 const std::vector<std::string> CPVREpgInfoTag::Directors(void) const
 {
-  return m_directors;
+  return GetTokens(m_directors);
 }
 
 const std::vector<std::string> CPVREpgInfoTag::Writers(void) const
 {
-  return m_writers;
+  return GetTokens(m_writers);
 }
 
 const std::string CPVREpgInfoTag::GetCastLabel() const
 {
   // Note: see CVideoInfoTag::GetCast for reference implementation.
   std::string strLabel;
-  for (const auto& castEntry : m_cast)
+  for (const auto& castEntry : Cast())
     strLabel += StringUtils::Format("%s\n", castEntry.c_str());
 
   return StringUtils::TrimRight(strLabel, "\n");
@@ -395,17 +450,17 @@ const std::string CPVREpgInfoTag::GetCastLabel() const
 
 const std::string CPVREpgInfoTag::GetDirectorsLabel() const
 {
-  return StringUtils::Join(m_directors, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  return StringUtils::Join(GetTokens(m_directors), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 const std::string CPVREpgInfoTag::GetWritersLabel() const
 {
-  return StringUtils::Join(m_writers, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  return StringUtils::Join(GetTokens(m_writers), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 const std::string CPVREpgInfoTag::GetGenresLabel() const
 {
-  return StringUtils::Join(m_genre, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  return StringUtils::Join(Genre(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 int CPVREpgInfoTag::Year(void) const
@@ -428,12 +483,12 @@ void CPVREpgInfoTag::SetGenre(int iGenreType, int iGenreSubType, const char* str
     {
       /* Type and sub type are not given. No EPG color coding possible
        * Use the provided genre description as backup. */
-      m_genre = Tokenize(strGenre);
+      m_genre = Intern(strGenre);
     }
     else
     {
-      /* Determine the genre description from the type and subtype IDs */
-      m_genre = StringUtils::Split(CPVREpg::ConvertGenreIdToString(iGenreType, iGenreSubType), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+      /* The genre description is determined from the type and subtype IDs, see Genre() */
+      m_genre.reset();
     }
   }
 }
@@ -450,18 +505,22 @@ int CPVREpgInfoTag::GenreSubType(void) const
 
 const std::vector<std::string> CPVREpgInfoTag::Genre(void) const
 {
-  return m_genre;
+  if (m_genre)
+    return Tokenize(*m_genre);
+
+  /* Determine the genre description from the type and subtype IDs */
+  return StringUtils::Split(CPVREpg::ConvertGenreIdToString(m_iGenreType, m_iGenreSubType), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 CDateTime CPVREpgInfoTag::FirstAiredAsUTC(void) const
 {
-  return m_firstAired;
+  return ToDateTime(m_iFirstAired);
 }
 
 CDateTime CPVREpgInfoTag::FirstAiredAsLocalTime(void) const
 {
   CDateTime retVal;
-  retVal.SetFromUTCDateTime(m_firstAired);
+  retVal.SetFromUTCDateTime(FirstAiredAsUTC());
   return retVal;
 }
 
@@ -482,7 +541,7 @@ int CPVREpgInfoTag::SeriesNumber(void) const
 
 std::string CPVREpgInfoTag::SeriesLink() const
 {
-  return m_strSeriesLink;
+  return GetString(m_seriesLink);
 }
 
 int CPVREpgInfoTag::EpisodeNumber(void) const
@@ -502,32 +561,33 @@ std::string CPVREpgInfoTag::EpisodeName() const
 
 std::string CPVREpgInfoTag::Icon(void) const
 {
-  return m_strIconPath;
+  return GetString(m_iconPath);
 }
 
 std::string CPVREpgInfoTag::Path(void) const
 {
-  return m_strFileNameAndPath;
+  return StringUtils::Format("pvr://guide/%04i/%s.epg", EpgID(), StartAsUTC().GetAsDBDateTime().c_str());
 }
 
 bool CPVREpgInfoTag::Update(const CPVREpgInfoTag &tag, bool bUpdateBroadcastId /* = true */)
 {
   CSingleLock lock(m_critSection);
+  const bool bUpdatePlotAndCast = !PlotAndCastEquals(tag) ||
+                                  (bUpdateBroadcastId && !m_bPlotAndCastLoaded && m_iDatabaseID != tag.m_iDatabaseID);
   bool bChanged = (
-      m_strTitle           != tag.m_strTitle ||
+      m_title              != tag.m_title ||
       m_strPlotOutline     != tag.m_strPlotOutline ||
-      m_strPlot            != tag.m_strPlot ||
-      m_strOriginalTitle   != tag.m_strOriginalTitle ||
-      m_cast               != tag.m_cast ||
+      bUpdatePlotAndCast ||
+      m_originalTitle      != tag.m_originalTitle ||
       m_directors          != tag.m_directors ||
       m_writers            != tag.m_writers ||
       m_iYear              != tag.m_iYear ||
       m_strIMDBNumber      != tag.m_strIMDBNumber ||
-      m_startTime          != tag.m_startTime ||
-      m_endTime            != tag.m_endTime ||
+      m_iStartTime         != tag.m_iStartTime ||
+      m_iEndTime           != tag.m_iEndTime ||
       m_iGenreType         != tag.m_iGenreType ||
       m_iGenreSubType      != tag.m_iGenreSubType ||
-      m_firstAired         != tag.m_firstAired ||
+      m_iFirstAired        != tag.m_iFirstAired ||
       m_iParentalRating    != tag.m_iParentalRating ||
       m_iStarRating        != tag.m_iStarRating ||
       m_iEpisodeNumber     != tag.m_iEpisodeNumber ||
@@ -537,9 +597,9 @@ bool CPVREpgInfoTag::Update(const CPVREpgInfoTag &tag, bool bUpdateBroadcastId /
       m_iUniqueBroadcastID != tag.m_iUniqueBroadcastID ||
       m_iEpgID             != tag.m_iEpgID ||
       m_genre              != tag.m_genre ||
-      m_strIconPath        != tag.m_strIconPath ||
+      m_iconPath           != tag.m_iconPath ||
       m_iFlags             != tag.m_iFlags ||
-      m_strSeriesLink      != tag.m_strSeriesLink ||
+      m_seriesLink         != tag.m_seriesLink ||
       m_channelData        != tag.m_channelData
   );
 
@@ -548,25 +608,46 @@ bool CPVREpgInfoTag::Update(const CPVREpgInfoTag &tag, bool bUpdateBroadcastId /
 
   if (bChanged)
   {
+    const bool bSameDatabaseRow = bUpdateBroadcastId || m_iDatabaseID == tag.m_iDatabaseID;
+
     if (bUpdateBroadcastId)
       m_iDatabaseID      = tag.m_iDatabaseID;
 
-    m_strTitle           = tag.m_strTitle;
+    if (bUpdatePlotAndCast)
+    {
+      if (!tag.m_bPlotAndCastLoaded && bSameDatabaseRow)
+      {
+        /* Plot and cast are still in the database row we refer to now, no need to read them. */
+        m_strPlot.clear();
+        m_cast.clear();
+        m_iPlotAndCastHash = tag.m_iPlotAndCastHash;
+        m_bPlotAndCastLoaded = false;
+        m_bPlotAndCastInDatabase = true;
+      }
+      else
+      {
+        std::string strPlot;
+        std::vector<std::string> cast;
+        tag.GetPlotAndCast(&strPlot, &cast);
+        SetPlotAndCast(strPlot, cast);
+        m_bPlotAndCastInDatabase = tag.m_bPlotAndCastInDatabase && bSameDatabaseRow;
+      }
+    }
+
+    m_title              = tag.m_title;
     m_strPlotOutline     = tag.m_strPlotOutline;
-    m_strPlot            = tag.m_strPlot;
-    m_strOriginalTitle   = tag.m_strOriginalTitle;
-    m_cast               = tag.m_cast;
+    m_originalTitle      = tag.m_originalTitle;
     m_directors          = tag.m_directors;
     m_writers            = tag.m_writers;
     m_iYear              = tag.m_iYear;
     m_strIMDBNumber      = tag.m_strIMDBNumber;
-    m_startTime          = tag.m_startTime;
-    m_endTime            = tag.m_endTime;
+    m_iStartTime         = tag.m_iStartTime;
+    m_iEndTime           = tag.m_iEndTime;
     m_iGenreType         = tag.m_iGenreType;
     m_iGenreSubType      = tag.m_iGenreSubType;
     m_iEpgID             = tag.m_iEpgID;
     m_iFlags             = tag.m_iFlags;
-    m_strSeriesLink      = tag.m_strSeriesLink;
+    m_seriesLink         = tag.m_seriesLink;
 
     if (m_iGenreType == EPG_GENRE_USE_STRING)
     {
@@ -575,10 +656,10 @@ bool CPVREpgInfoTag::Update(const CPVREpgInfoTag &tag, bool bUpdateBroadcastId /
     }
     else
     {
-      /* Determine genre description by type/subtype */
-      m_genre = StringUtils::Split(CPVREpg::ConvertGenreIdToString(tag.m_iGenreType, tag.m_iGenreSubType), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+      /* Genre description is determined by type/subtype */
+      m_genre.reset();
     }
-    m_firstAired         = tag.m_firstAired;
+    m_iFirstAired        = tag.m_iFirstAired;
     m_iParentalRating    = tag.m_iParentalRating;
     m_iStarRating        = tag.m_iStarRating;
     m_iEpisodeNumber     = tag.m_iEpisodeNumber;
@@ -586,13 +667,10 @@ bool CPVREpgInfoTag::Update(const CPVREpgInfoTag &tag, bool bUpdateBroadcastId /
     m_iSeriesNumber      = tag.m_iSeriesNumber;
     m_strEpisodeName     = tag.m_strEpisodeName;
     m_iUniqueBroadcastID = tag.m_iUniqueBroadcastID;
-    m_strIconPath        = tag.m_strIconPath;
+    m_iconPath           = tag.m_iconPath;
     m_channelData        = tag.m_channelData;
   }
 
-  if (bChanged)
-    UpdatePath();
-
   return bChanged;
 }
 
@@ -611,13 +689,140 @@ bool CPVREpgInfoTag::Persist(const std::shared_ptr<CPVREpgDatabase>& database, b
   {
     bReturn = true;
 
+    CSingleLock lock(m_critSection);
     if (iId > 0)
       m_iDatabaseID = iId;
+
+    m_bPlotAndCastInDatabase = true;
   }
 
   return bReturn;
 }
 
+void CPVREpgInfoTag::SetPlotAndCast(const std::string& strPlot, const std::vector<std::string>& cast)
+{
+  CSingleLock lock(m_critSection);
+  m_strPlot = strPlot;
+  m_cast = cast;
+  m_iPlotAndCastHash = HashPlotAndCast(m_strPlot, m_cast);
+  m_bPlotAndCastLoaded = true;
+  m_bPlotAndCastInDatabase = false;
+}
+
+void CPVREpgInfoTag::GetPlotAndCast(std::string* strPlot, std::vector<std::string>* cast) const
+{
+  int iDatabaseId;
+  {
+    CSingleLock lock(m_critSection);
+    if (m_bPlotAndCastLoaded)
+    {
+      if (strPlot)
+        *strPlot = m_strPlot;
+      if (cast)
+        *cast = m_cast;
+      return;
+    }
+    iDatabaseId = m_iDatabaseID;
+  }
+
+  /* Not locked while reading, the database might be locked by a thread waiting for this tag. */
+  std::string strDbPlot;
+  std::string strDbCast;
+  const std::shared_ptr<CPVREpgDatabase> database = CServiceBroker::GetPVRManager().EpgContainer().GetEpgDatabase();
+  const bool bRead = database && database->GetPlotAndCast(iDatabaseId, strDbPlot, strDbCast);
+  if (!bRead)
+    CLog::LogF(LOGERROR, "Could not read plot and cast of EPG tag %d from the database", iDatabaseId);
+
+  /* Not kept, the database caches the plots shown last. */
+  if (strPlot)
+    *strPlot = std::move(strDbPlot);
+  if (cast)
+    *cast = Tokenize(strDbCast);
+}
+
+const size_t CPVREpgInfoTag::PLOT_BATCH_SIZE;
+
+void CPVREpgInfoTag::ForEachPlot(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags,
+                                 const std::function<void(const std::shared_ptr<CPVREpgInfoTag>&, const std::string&)>& handler)
+{
+  const std::shared_ptr<CPVREpgDatabase> database = CServiceBroker::GetPVRManager().EpgContainer().GetEpgDatabase();
+
+  for (size_t iBatchStart = 0; iBatchStart < tags.size(); iBatchStart += PLOT_BATCH_SIZE)
+  {
+    const auto begin = tags.begin() + iBatchStart;
+    const auto end = tags.begin() + std::min(iBatchStart + PLOT_BATCH_SIZE, tags.size());
+
+    std::vector<std::string> loadedPlots;
+    std::vector<int> releasedPlotIds;
+    for (auto it = begin; it != end; ++it)
+    {
+      loadedPlots.emplace_back();
+      if (!(*it)->GetLoadedPlotAndCast(&loadedPlots.back(), nullptr))
+        releasedPlotIds.emplace_back((*it)->DatabaseID());
+    }
+
+    std::unordered_map<int, std::string> plots;
+    if (!releasedPlotIds.empty() && database)
+      plots = database->GetPlots(releasedPlotIds);
+
+    auto loadedPlot = loadedPlots.begin();
+    for (auto it = begin; it != end; ++it, ++loadedPlot)
+    {
+      if ((*it)->GetLoadedPlotAndCast(nullptr, nullptr))
+      {
+        handler(*it, *loadedPlot);
+        continue;
+      }
+
+      const auto plot = plots.find((*it)->DatabaseID());
+      if (plot != plots.end())
+        handler(*it, plot->second);
+      else
+        handler(*it, (*it)->Plot()); // not in the batch, e.g. released meanwhile
+    }
+  }
+}
+
+bool CPVREpgInfoTag::GetLoadedPlotAndCast(std::string* strPlot, std::vector<std::string>* cast) const
+{
+  CSingleLock lock(m_critSection);
+  if (!m_bPlotAndCastLoaded)
+    return false;
+
+  if (strPlot)
+    *strPlot = m_strPlot;
+  if (cast)
+    *cast = m_cast;
+  return true;
+}
+
+bool CPVREpgInfoTag::ReleasePlotAndCast()
+{
+  CSingleLock lock(m_critSection);
+  if (!m_bPlotAndCastLoaded)
+    return true;
+
+  if (!m_bPlotAndCastInDatabase || m_iDatabaseID <= 0)
+    return false;
+
+  std::string().swap(m_strPlot);
+  std::vector<std::string>().swap(m_cast);
+  m_bPlotAndCastLoaded = false;
+  return true;
+}
+
+bool CPVREpgInfoTag::PlotAndCastEquals(const CPVREpgInfoTag& right) const
+{
+  if (m_iPlotAndCastHash != right.m_iPlotAndCastHash)
+    return false;
+
+  /* Released texts are compared by their hash only. */
+  if (m_bPlotAndCastLoaded && right.m_bPlotAndCastLoaded)
+    return m_strPlot == right.m_strPlot && m_cast == right.m_cast;
+
+  return true;
+}
+
 std::vector<PVR_EDL_ENTRY> CPVREpgInfoTag::GetEdl() const
 {
   std::vector<PVR_EDL_ENTRY> edls;
@@ -631,11 +836,6 @@ std::vector<PVR_EDL_ENTRY> CPVREpgInfoTag::GetEdl() const
   return edls;
 }
 
-void CPVREpgInfoTag::UpdatePath(void)
-{
-  m_strFileNameAndPath = StringUtils::Format("pvr://guide/%04i/%s.epg", EpgID(), m_startTime.GetAsDBDateTime().c_str());
-}
-
 int CPVREpgInfoTag::EpgID(void) const
 {
   return m_iEpgID;
@@ -644,7 +844,6 @@ int CPVREpgInfoTag::EpgID(void) const
 void CPVREpgInfoTag::SetEpgID(int iEpgID)
 {
   m_iEpgID = iEpgID;
-  UpdatePath(); // Note: path contains epg id.
 }
 
 bool CPVREpgInfoTag::IsRecordable(void) const
@@ -695,6 +894,14 @@ bool CPVREpgInfoTag::IsParentalLocked() const
   return m_channelData->IsLocked();
 }
 
+std::shared_ptr<const std::string> CPVREpgInfoTag::Intern(const std::string& str)
+{
+  if (str.empty())
+    return {};
+
+  return CStringInterner::Intern(str);
+}
+
 const std::vector<std::string> CPVREpgInfoTag::Tokenize(const std::string &str)
 {
   return StringUtils::Split(str.c_str(), EPG_STRING_TOKEN_SEPARATOR);
@@ -13,6 +13,9 @@
 #include "utils/ISerializable.h"
 #include "utils/ISortable.h"
 
+#include <atomic>
+#include <ctime>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -110,6 +113,18 @@ namespace PVR
      */
     void SetEpgID(int iEpgID);
 
+    /*!
+     * @brief Get the serial the owning table gave this tag when it was last added or changed.
+     * @return The serial, 0 if the tag is not in a table.
+     */
+    unsigned int ChangeSerial(void) const { return m_iChangeSerial; }
+
+    /*!
+     * @brief Set the serial of the last change of this tag.
+     * @param iChangeSerial The serial.
+     */
+    void SetChangeSerial(unsigned int iChangeSerial) { m_iChangeSerial = iChangeSerial; }
+
     /*!
      * @brief Change the unique broadcast ID of this event.
      * @param iUniqueBroadcastId The new unique broadcast ID.
@@ -188,6 +203,20 @@ namespace PVR
      */
     std::string Plot() const;
 
+    /*!
+     * @brief Number of events whose released plots ForEachPlot() reads in one query.
+     */
+    static const size_t PLOT_BATCH_SIZE = 500;
+
+    /*!
+     * @brief Get the plots of many events, e.g. to search them. Released plots are read from the EPG
+     * database with one query per PLOT_BATCH_SIZE events, instead of one query per event.
+     * @param tags The events.
+     * @param handler Called with each event and its plot, in the order of the events.
+     */
+    static void ForEachPlot(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags,
+                            const std::function<void(const std::shared_ptr<CPVREpgInfoTag>&, const std::string&)>& handler);
+
     /*!
      * @brief Get the original title of this event.
      * @return The original title.
@@ -417,17 +446,55 @@ namespace PVR
      */
     void SetGenre(int iGenreType, int iGenreSubType, const char* strGenre);
 
-    /*!
-     * @brief Update the path of this tag.
-     */
-    void UpdatePath(void);
-
     /*!
      * @brief Get current time, taking timeshifting into account.
      * @return The playing time.
      */
     CDateTime GetCurrentPlayingTime(void) const;
 
+    /*!
+     * @brief Set plot and cast of this event.
+     * @param strPlot The plot.
+     * @param cast The cast.
+     */
+    void SetPlotAndCast(const std::string& strPlot, const std::vector<std::string>& cast);
+
+    /*!
+     * @brief Get plot and cast of this event, read them from the EPG database if they were released.
+     * Plot and cast read from the database are not kept by this event.
+     * @param strPlot The plot, not returned if nullptr.
+     * @param cast The cast, not returned if nullptr.
+     */
+    void GetPlotAndCast(std::string* strPlot, std::vector<std::string>* cast) const;
+
+    /*!
+     * @brief Get plot and cast of this event if they were not released, without reading the EPG database.
+     * @param strPlot The plot, not returned if nullptr.
+     * @param cast The cast, not returned if nullptr.
+     * @return True if plot and cast were returned, false if they are only in the database.
+     */
+    bool GetLoadedPlotAndCast(std::string* strPlot, std::vector<std::string>* cast) const;
+
+    /*!
+     * @brief Drop plot and cast from memory if the EPG database holds the same. They are read again when needed.
+     * @return True if plot and cast were released, false otherwise.
+     */
+    bool ReleasePlotAndCast();
+
+    /*!
+     * @brief Check whether plot and cast of this event equal those of the given event, without loading them.
+     * @param right The event to compare with.
+     * @return True if they are equal, false otherwise.
+     */
+    bool PlotAndCastEquals(const CPVREpgInfoTag& right) const;
+
+    /*!
+     * @brief Get the copy of a string shared by all events.
+     * @param str The string.
+     * @return The shared copy, nullptr for an empty string.
+     */
+    static std::shared_ptr<const std::string> Intern(const std::string& str);
+
     int                      m_iDatabaseID = -1;    /*!< database ID */
     int                      m_iGenreType = 0;      /*!< genre type */
     int                      m_iGenreSubType = 0;   /*!< genre subtype */
@@ -437,27 +504,30 @@ namespace PVR
     int                      m_iEpisodeNumber = 0;  /*!< episode number */
     int                      m_iEpisodePart = 0;    /*!< episode part number */
     unsigned int m_iUniqueBroadcastID = 0;   /*!< unique broadcast ID */
-    std::string              m_strTitle;            /*!< title */
-    std::string              m_strPlotOutline;      /*!< plot outline */
-    std::string              m_strPlot;             /*!< plot */
-    std::string              m_strOriginalTitle;    /*!< original title */
-    std::vector<std::string> m_cast;                /*!< cast */
-    std::vector<std::string> m_directors;           /*!< director(s) */
-    std::vector<std::string> m_writers;             /*!< writer(s) */
     int                      m_iYear = 0;           /*!< year */
+    unsigned int m_iFlags = 0; /*!< the flags applicable to this EPG entry */
+    time_t                   m_iStartTime;          /*!< event start time, UTC */
+    time_t                   m_iEndTime;            /*!< event end time, UTC */
+    time_t                   m_iFirstAired;         /*!< first airdate, UTC */
+    std::shared_ptr<const std::string> m_title;     /*!< title, interned */
+    std::shared_ptr<const std::string> m_originalTitle; /*!< original title, interned */
+    std::shared_ptr<const std::string> m_iconPath;  /*!< the path to the icon, interned */
+    std::shared_ptr<const std::string> m_seriesLink; /*!< series link, interned */
+    std::shared_ptr<const std::string> m_directors; /*!< director(s), tokenized and interned */
+    std::shared_ptr<const std::string> m_writers;   /*!< writer(s), tokenized and interned */
+    std::shared_ptr<const std::string> m_genre;     /*!< genre description, tokenized and interned; only used for EPG_GENRE_USE_STRING */
+    std::string              m_strPlotOutline;      /*!< plot outline */
     std::string              m_strIMDBNumber;       /*!< imdb number */
-    std::vector<std::string> m_genre;               /*!< genre */
     std::string              m_strEpisodeName;      /*!< episode name */
-    std::string              m_strIconPath;         /*!< the path to the icon */
-    std::string              m_strFileNameAndPath;  /*!< the filename and path */
-    CDateTime                m_startTime;           /*!< event start time */
-    CDateTime                m_endTime;             /*!< event end time */
-    CDateTime                m_firstAired;          /*!< first airdate */
-    unsigned int m_iFlags = 0; /*!< the flags applicable to this EPG entry */
-    std::string              m_strSeriesLink;       /*!< series link */
+    std::string              m_strPlot;             /*!< plot, empty while released */
+    std::vector<std::string> m_cast;                /*!< cast, empty while released */
+    size_t                   m_iPlotAndCastHash = 0; /*!< hash of plot and cast, valid while they are released */
+    bool                     m_bPlotAndCastLoaded = true; /*!< false while plot and cast are only in the database */
+    bool                     m_bPlotAndCastInDatabase = false; /*!< true if the database row holds the current plot and cast */
 
     mutable CCriticalSection m_critSection;
     std::shared_ptr<CPVREpgChannelData> m_channelData;
     int m_iEpgID = -1;
+    std::atomic<unsigned int> m_iChangeSerial{0}; /*!< serial of the last change of this tag, see CPVREpg::GetTagsChangedSince */
   };
 }
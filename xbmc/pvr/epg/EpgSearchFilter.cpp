@@ -23,6 +23,10 @@
 
 #include <algorithm>
 #include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
 
 using namespace PVR;
 
@@ -35,6 +39,7 @@ CPVREpgSearchFilter::CPVREpgSearchFilter(bool bRadio)
 void CPVREpgSearchFilter::Reset()
 {
   m_strSearchTerm.clear();
+  m_textSearch.reset();
   m_bIsCaseSensitive         = false;
   m_bSearchInDescription     = false;
   m_iGenreType               = EPG_SEARCH_UNSET;
@@ -106,20 +111,29 @@ void CPVREpgSearchFilter::SetSearchPhrase(const std::string &strSearchPhrase)
   m_strSearchTerm = "\"";
   m_strSearchTerm.append(strSearchPhrase);
   m_strSearchTerm.append("\"");
+  m_textSearch.reset();
 }
 
-bool CPVREpgSearchFilter::MatchSearchTerm(const CPVREpgInfoTagPtr &tag) const
+const CTextSearch& CPVREpgSearchFilter::GetTextSearch() const
+{
+  if (!m_textSearch)
+    m_textSearch = std::make_shared<CTextSearch>(m_strSearchTerm, m_bIsCaseSensitive, SEARCH_DEFAULT_OR);
+
+  return *m_textSearch;
+}
+
+bool CPVREpgSearchFilter::MatchSearchTerm(const CPVREpgInfoTagPtr &tag, const std::string* strPlot) const
 {
   bool bReturn(true);
 
   if (!m_strSearchTerm.empty())
   {
-    CTextSearch search(m_strSearchTerm, m_bIsCaseSensitive, SEARCH_DEFAULT_OR);
+    const CTextSearch& search = GetTextSearch();
     bReturn = !CServiceBroker::GetPVRManager().IsParentalLocked(tag);
     if (bReturn)
       bReturn = search.Search(tag->Title()) ||
                 search.Search(tag->PlotOutline()) ||
-                (m_bSearchInDescription && search.Search(tag->Plot()));
+                (m_bSearchInDescription && search.Search(strPlot ? *strPlot : tag->Plot()));
   }
 
   return bReturn;
@@ -133,13 +147,13 @@ bool CPVREpgSearchFilter::MatchBroadcastId(const CPVREpgInfoTagPtr &tag) const
   return true;
 }
 
-bool CPVREpgSearchFilter::FilterEntry(const CPVREpgInfoTagPtr &tag) const
+bool CPVREpgSearchFilter::FilterEntry(const CPVREpgInfoTagPtr &tag, const std::string* strPlot /* = nullptr */) const
 {
   return (MatchGenre(tag) &&
       MatchBroadcastId(tag) &&
       MatchDuration(tag) &&
       MatchStartAndEndTimes(tag) &&
-      MatchSearchTerm(tag) &&
+      MatchSearchTerm(tag, strPlot) &&
       MatchTimers(tag) &&
       MatchRecordings(tag)) &&
       MatchChannelType(tag) &&
@@ -148,23 +162,53 @@ bool CPVREpgSearchFilter::FilterEntry(const CPVREpgInfoTagPtr &tag) const
       MatchFreeToAir(tag);
 }
 
-void CPVREpgSearchFilter::RemoveDuplicates(std::vector<std::shared_ptr<CPVREpgInfoTag>>& results)
+void CPVREpgSearchFilter::FilterEntries(std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const
 {
-  for (auto it = results.begin(); it != results.end();)
+  if (m_bSearchInDescription && !m_strSearchTerm.empty())
   {
-    it = results.erase(std::remove_if(results.begin(),
-                                      results.end(),
-                                      [&it](const std::shared_ptr<CPVREpgInfoTag>& entry)
-                                      {
-                                         return *it != entry &&
-                                                (*it)->Title() == entry->Title() &&
-                                                (*it)->Plot() == entry->Plot() &&
-                                                (*it)->PlotOutline() == entry->PlotOutline();
-                                      }),
-                       results.end());
+    // read the plots released by lazy loading with one query per batch, not one per tag
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> results;
+    CPVREpgInfoTag::ForEachPlot(tags, [this, &results](const std::shared_ptr<CPVREpgInfoTag>& tag, const std::string& strPlot)
+    {
+      if (FilterEntry(tag, &strPlot))
+        results.emplace_back(tag);
+    });
+    tags.swap(results);
+  }
+  else
+  {
+    tags.erase(std::remove_if(tags.begin(),
+                              tags.end(),
+                              [this](const std::shared_ptr<CPVREpgInfoTag>& tag)
+                              {
+                                return !FilterEntry(tag);
+                              }),
+               tags.end());
   }
 }
 
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgSearchFilter::GetCandidateTags() const
+{
+  if (m_strSearchTerm.empty())
+    return CServiceBroker::GetPVRManager().EpgContainer().GetAllTags();
+
+  return CServiceBroker::GetPVRManager().EpgContainer().GetTextSearchCandidates(GetTextSearch());
+}
+
+void CPVREpgSearchFilter::RemoveDuplicates(std::vector<std::shared_ptr<CPVREpgInfoTag>>& results)
+{
+  // keep the first of the tags with the same title, plot and plot outline. the plots are read once
+  // per tag and in batches, not once per pair of tags
+  std::set<std::tuple<std::string, std::string, std::string>> seen;
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> unique;
+  CPVREpgInfoTag::ForEachPlot(results, [&seen, &unique](const std::shared_ptr<CPVREpgInfoTag>& entry, const std::string& strPlot)
+  {
+    if (seen.emplace(entry->Title(), strPlot, entry->PlotOutline()).second)
+      unique.emplace_back(entry);
+  });
+  results.swap(unique);
+}
+
 bool CPVREpgSearchFilter::MatchChannelType(const CPVREpgInfoTagPtr &tag) const
 {
   return tag && (tag->IsRadio() == m_bIsRadio);
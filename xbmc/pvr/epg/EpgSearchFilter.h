@@ -16,6 +16,8 @@
 #include <string>
 #include <vector>
 
+class CTextSearch;
+
 namespace PVR
 {
   #define EPG_SEARCH_UNSET (-1)
@@ -43,9 +45,22 @@ namespace PVR
     /*!
      * @brief Check if a tag will be filtered or not.
      * @param tag The tag to check.
+     * @param strPlot The plot of the tag if the caller already read it, nullptr to get it from the tag.
      * @return True if this tag matches the filter, false if not.
      */
-    bool FilterEntry(const CPVREpgInfoTagPtr &tag) const;
+    bool FilterEntry(const CPVREpgInfoTagPtr &tag, const std::string* strPlot = nullptr) const;
+
+    /*!
+     * @brief Remove the tags not matching the filter. Plots searched for the search term are read in batches.
+     * @param tags The tags to filter.
+     */
+    void FilterEntries(std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const;
+
+    /*!
+     * @brief Get the tags to check with FilterEntry. With a search term, tags not containing its words are skipped using the epg text index.
+     * @return The tags.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetCandidateTags() const;
 
     /*!
      * @brief remove duplicates from a list of epg tags.
@@ -60,11 +75,11 @@ namespace PVR
     bool IsRadio() const { return m_bIsRadio; }
 
     const std::string &GetSearchTerm() const { return m_strSearchTerm; }
-    void SetSearchTerm(const std::string &strSearchTerm) { m_strSearchTerm = strSearchTerm; }
+    void SetSearchTerm(const std::string &strSearchTerm) { m_strSearchTerm = strSearchTerm; m_textSearch.reset(); }
     void SetSearchPhrase(const std::string &strSearchPhrase);
 
     bool IsCaseSensitive() const { return m_bIsCaseSensitive; }
-    void SetCaseSensitive(bool bIsCaseSensitive) { m_bIsCaseSensitive = bIsCaseSensitive; }
+    void SetCaseSensitive(bool bIsCaseSensitive) { m_bIsCaseSensitive = bIsCaseSensitive; m_textSearch.reset(); }
 
     bool ShouldSearchInDescription() const { return m_bSearchInDescription; }
     void SetSearchInDescription(bool bSearchInDescription) {m_bSearchInDescription = bSearchInDescription; }
@@ -115,7 +130,8 @@ namespace PVR
     bool MatchGenre(const CPVREpgInfoTagPtr &tag) const;
     bool MatchDuration(const CPVREpgInfoTagPtr &tag) const;
     bool MatchStartAndEndTimes(const CPVREpgInfoTagPtr &tag) const;
-    bool MatchSearchTerm(const CPVREpgInfoTagPtr &tag) const;
+    bool MatchSearchTerm(const CPVREpgInfoTagPtr &tag, const std::string* strPlot) const;
+    const CTextSearch& GetTextSearch() const;
     bool MatchChannelNumber(const CPVREpgInfoTagPtr &tag) const;
     bool MatchChannelGroup(const CPVREpgInfoTagPtr &tag) const;
     bool MatchBroadcastId(const CPVREpgInfoTagPtr &tag) const;
@@ -125,6 +141,7 @@ namespace PVR
     bool MatchRecordings(const CPVREpgInfoTagPtr &tag) const;
 
     std::string   m_strSearchTerm;            /*!< The term to search for */
+    mutable std::shared_ptr<const CTextSearch> m_textSearch; /*!< m_strSearchTerm parsed, created on first use */
     bool          m_bIsCaseSensitive;         /*!< Do a case sensitive search */
     bool          m_bSearchInDescription;     /*!< Search for strSearchTerm in the description too */
     int           m_iGenreType;               /*!< The genre type for an entry */
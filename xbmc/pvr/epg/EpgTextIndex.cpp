@@ -0,0 +1,304 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgTextIndex.h"
+
+#include "pvr/epg/EpgInfoTag.h"
+#include "utils/StringUtils.h"
+#include "utils/TextSearch.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace PVR;
+
+namespace
+{
+  // a part of a search term without separators is always found within a single word
+  const char* WORD_SEPARATORS = " \t\r\n";
+
+  // removed tags stay in the word lists until the index is compacted
+  const size_t MIN_REMOVED_TAGS_TO_COMPACT = 1024;
+
+  std::vector<std::string> SplitWords(std::string strText)
+  {
+    StringUtils::ToLower(strText);
+
+    std::vector<std::string> words;
+    size_t pos = strText.find_first_not_of(WORD_SEPARATORS);
+    while (pos != std::string::npos)
+    {
+      const size_t end = strText.find_first_of(WORD_SEPARATORS, pos);
+      words.emplace_back(strText.substr(pos, end == std::string::npos ? std::string::npos : end - pos));
+      pos = strText.find_first_not_of(WORD_SEPARATORS, end);
+    }
+    return words;
+  }
+
+  void Intersect(std::vector<unsigned int>& ids, const std::vector<unsigned int>& otherIds)
+  {
+    std::vector<unsigned int> result;
+    std::set_intersection(ids.begin(), ids.end(), otherIds.begin(), otherIds.end(), std::back_inserter(result));
+    ids.swap(result);
+  }
+
+  void Unite(std::vector<unsigned int>& ids, const std::vector<unsigned int>& otherIds)
+  {
+    std::vector<unsigned int> result;
+    std::set_union(ids.begin(), ids.end(), otherIds.begin(), otherIds.end(), std::back_inserter(result));
+    ids.swap(result);
+  }
+} // unnamed namespace
+
+void CPVREpgTextIndex::Build(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags)
+{
+  Clear();
+  m_bBuilt = true;
+
+  m_tags.reserve(tags.size());
+  for (const auto& tag : tags)
+    m_pendingTags.insert(std::make_pair(tag.get(), std::make_pair(m_iNextPending++, tag)));
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgTextIndex::GetPendingTags() const
+{
+  std::vector<std::pair<size_t, std::shared_ptr<CPVREpgInfoTag>>> pendingTags;
+  pendingTags.reserve(m_pendingTags.size());
+  for (const auto& tag : m_pendingTags)
+    pendingTags.emplace_back(tag.second);
+
+  std::sort(pendingTags.begin(), pendingTags.end(),
+            [](const std::pair<size_t, std::shared_ptr<CPVREpgInfoTag>>& left,
+               const std::pair<size_t, std::shared_ptr<CPVREpgInfoTag>>& right) { return left.first < right.first; });
+
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+  tags.reserve(pendingTags.size());
+  for (auto& tag : pendingTags)
+    tags.emplace_back(std::move(tag.second));
+  return tags;
+}
+
+void CPVREpgTextIndex::Update(const std::shared_ptr<CPVREpgInfoTag>& tag)
+{
+  if (!m_bBuilt)
+    return;
+
+  RemoveIndexed(tag);
+  m_pendingTags.insert(std::make_pair(tag.get(), std::make_pair(m_iNextPending++, tag)));
+}
+
+void CPVREpgTextIndex::Add(const std::shared_ptr<CPVREpgInfoTag>& tag, const std::string& strPlot)
+{
+  if (m_pendingTags.erase(tag.get()) == 0)
+    return;
+
+  const unsigned int id = static_cast<unsigned int>(m_tags.size());
+
+  std::vector<std::string> words = SplitWords(tag->Title() + " " + tag->PlotOutline() + " " + strPlot);
+  std::sort(words.begin(), words.end());
+  words.erase(std::unique(words.begin(), words.end()), words.end());
+
+  for (const auto& word : words)
+    m_words[word].emplace_back(id);
+
+  m_tags.emplace_back(tag);
+  m_ids[tag.get()] = id;
+}
+
+void CPVREpgTextIndex::Remove(const std::shared_ptr<CPVREpgInfoTag>& tag)
+{
+  if (!m_bBuilt)
+    return;
+
+  m_pendingTags.erase(tag.get());
+  RemoveIndexed(tag);
+}
+
+void CPVREpgTextIndex::RemoveIndexed(const std::shared_ptr<CPVREpgInfoTag>& tag)
+{
+  const auto it = m_ids.find(tag.get());
+  if (it == m_ids.end())
+    return;
+
+  m_tags[it->second].reset();
+  m_ids.erase(it);
+
+  if (++m_iRemovedTags >= MIN_REMOVED_TAGS_TO_COMPACT && m_iRemovedTags > m_tags.size() / 2)
+    Compact();
+}
+
+void CPVREpgTextIndex::Compact()
+{
+  /* renumber the remaining tags, their words are kept as their plots might be released */
+  std::vector<unsigned int> newIds(m_tags.size(), 0);
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+  tags.reserve(m_ids.size());
+  for (size_t id = 0; id < m_tags.size(); ++id)
+  {
+    if (m_tags[id])
+    {
+      newIds[id] = static_cast<unsigned int>(tags.size());
+      m_ids[m_tags[id].get()] = newIds[id];
+      tags.emplace_back(m_tags[id]);
+    }
+  }
+
+  for (auto it = m_words.begin(); it != m_words.end();)
+  {
+    std::vector<unsigned int> ids;
+    for (unsigned int id : it->second)
+    {
+      if (m_tags[id])
+        ids.emplace_back(newIds[id]);
+    }
+
+    if (ids.empty())
+    {
+      it = m_words.erase(it);
+    }
+    else
+    {
+      it->second.swap(ids);
+      ++it;
+    }
+  }
+
+  m_tags.swap(tags);
+  m_iRemovedTags = 0;
+}
+
+void CPVREpgTextIndex::Clear()
+{
+  m_tags.clear();
+  m_ids.clear();
+  m_words.clear();
+  m_pendingTags.clear();
+  m_iNextPending = 0;
+  m_iRemovedTags = 0;
+}
+
+bool CPVREpgTextIndex::GetCandidates(const CTextSearch& search, std::vector<std::shared_ptr<CPVREpgInfoTag>>& candidates) const
+{
+  if (!m_bBuilt)
+    return false;
+
+  bool bRestricted = false;
+  std::vector<unsigned int> ids;
+
+  // tags have to contain one of the 'or' terms...
+  bool bAnyOrTerm = !search.GetOrTerms().empty();
+  std::vector<unsigned int> orIds;
+  for (const auto& term : search.GetOrTerms())
+  {
+    std::vector<unsigned int> termIds;
+    if (!FindTerm(term, termIds))
+    {
+      bAnyOrTerm = false;
+      break;
+    }
+    Unite(orIds, termIds);
+  }
+
+  if (bAnyOrTerm)
+  {
+    ids.swap(orIds);
+    bRestricted = true;
+  }
+
+  // ...and all 'and' terms
+  for (const auto& term : search.GetAndTerms())
+  {
+    std::vector<unsigned int> termIds;
+    if (!FindTerm(term, termIds))
+      continue;
+
+    if (bRestricted)
+      Intersect(ids, termIds);
+    else
+      ids.swap(termIds);
+
+    bRestricted = true;
+  }
+
+  if (!bRestricted)
+    return false;
+
+  candidates.reserve(candidates.size() + ids.size() + m_pendingTags.size());
+  for (unsigned int id : ids)
+  {
+    if (m_tags[id])
+      candidates.emplace_back(m_tags[id]);
+  }
+
+  const std::vector<std::shared_ptr<CPVREpgInfoTag>> pendingTags = GetPendingTags();
+  candidates.insert(candidates.end(), pendingTags.begin(), pendingTags.end());
+
+  return true;
+}
+
+bool CPVREpgTextIndex::FindTerm(const std::string& strTerm, std::vector<unsigned int>& ids) const
+{
+  std::string strLowerTerm(strTerm);
+  StringUtils::ToLower(strLowerTerm);
+
+  std::vector<WordPart> parts;
+  size_t pos = strLowerTerm.find_first_not_of(WORD_SEPARATORS);
+  while (pos != std::string::npos)
+  {
+    const size_t end = strLowerTerm.find_first_of(WORD_SEPARATORS, pos);
+    parts.push_back({strLowerTerm.substr(pos, end == std::string::npos ? std::string::npos : end - pos),
+                     pos > 0, end != std::string::npos});
+    pos = strLowerTerm.find_first_not_of(WORD_SEPARATORS, end);
+  }
+
+  if (parts.empty())
+    return false;
+
+  // parts found in the sorted words first, those scanning all words only while there are candidates
+  std::stable_partition(parts.begin(), parts.end(), [](const WordPart& part) { return part.bWordStart; });
+
+  FindWordPart(parts.front(), ids);
+  for (auto it = parts.begin() + 1; it != parts.end() && !ids.empty(); ++it)
+  {
+    std::vector<unsigned int> partIds;
+    FindWordPart(*it, partIds);
+    Intersect(ids, partIds);
+  }
+
+  return true;
+}
+
+void CPVREpgTextIndex::FindWordPart(const WordPart& part, std::vector<unsigned int>& ids) const
+{
+  if (part.bWordStart && part.bWordEnd)
+  {
+    const auto it = m_words.find(part.str);
+    if (it != m_words.end())
+      ids = it->second;
+    return;
+  }
+
+  if (part.bWordStart)
+  {
+    // the words starting with the part follow each other in the sorted words
+    for (auto it = m_words.lower_bound(part.str); it != m_words.end() && StringUtils::StartsWith(it->first, part.str); ++it)
+      ids.insert(ids.end(), it->second.begin(), it->second.end());
+  }
+  else
+  {
+    // the part may be within or at the end of a word, all words have to be checked
+    for (const auto& word : m_words)
+    {
+      if (part.bWordEnd ? StringUtils::EndsWith(word.first, part.str) : word.first.find(part.str) != std::string::npos)
+        ids.insert(ids.end(), word.second.begin(), word.second.end());
+    }
+  }
+
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
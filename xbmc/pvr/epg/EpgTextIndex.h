@@ -0,0 +1,116 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class CTextSearch;
+
+namespace PVR
+{
+  class CPVREpgInfoTag;
+
+  /*!
+   * @brief Word index of the title, plot outline and plot of epg tags.
+   *
+   * Finds the tags which may match a text search without looking at every tag. Search terms
+   * match any part of the text. Parts of a term enclosed by separators are looked up in the sorted
+   * words, parts that may start or end within a word of the text in all indexed words containing
+   * them. The candidates are a superset of the matching tags, the caller still has to run the
+   * search on them. Words are indexed lowercase, case sensitive searches get the candidates of
+   * the case insensitive search.
+   *
+   * The index is empty and ignores all changes until it was built. New and changed tags are
+   * pending until the owner indexes them with their plot, which may have to be read from the
+   * database first. Pending tags are always candidates. Not thread safe, the owner has to lock.
+   */
+  class CPVREpgTextIndex
+  {
+  public:
+    CPVREpgTextIndex() = default;
+    CPVREpgTextIndex(const CPVREpgTextIndex& other) = delete;
+    CPVREpgTextIndex& operator=(const CPVREpgTextIndex& other) = delete;
+
+    /*!
+     * @brief Make the given tags pending and keep the index up to date from now on.
+     * @param tags The tags to index.
+     */
+    void Build(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags);
+
+    /*!
+     * @brief Get the tags waiting to be indexed.
+     * @return The tags, in the order they became pending.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetPendingTags() const;
+
+    /*!
+     * @brief Index the title, plot outline and the given plot of a pending tag.
+     * @param tag The tag. Ignored if it is not pending.
+     * @param strPlot The plot of the tag.
+     */
+    void Add(const std::shared_ptr<CPVREpgInfoTag>& tag, const std::string& strPlot);
+
+    /*!
+     * @brief Check whether the index was built.
+     * @return True if built, false otherwise.
+     */
+    bool IsBuilt() const { return m_bBuilt; }
+
+    /*!
+     * @brief Add a tag or make an already indexed tag pending again.
+     * @param tag The tag.
+     */
+    void Update(const std::shared_ptr<CPVREpgInfoTag>& tag);
+
+    /*!
+     * @brief Remove a tag from the index.
+     * @param tag The tag.
+     */
+    void Remove(const std::shared_ptr<CPVREpgInfoTag>& tag);
+
+    /*!
+     * @brief Remove all tags from the index.
+     */
+    void Clear();
+
+    /*!
+     * @brief Get the tags which may match a text search.
+     * @param search The search.
+     * @param candidates The tags, in the order they were indexed, followed by the pending tags.
+     * @return False if the index cannot narrow down the search (e.g. for searches with 'not' terms only), true otherwise.
+     */
+    bool GetCandidates(const CTextSearch& search, std::vector<std::shared_ptr<CPVREpgInfoTag>>& candidates) const;
+
+  private:
+    struct WordPart
+    {
+      std::string str;
+      bool bWordStart; /*!< preceded by a separator in the term, so it starts a word of the text */
+      bool bWordEnd; /*!< followed by a separator in the term, so it ends a word of the text */
+    };
+
+    void RemoveIndexed(const std::shared_ptr<CPVREpgInfoTag>& tag);
+    void Compact();
+    bool FindTerm(const std::string& strTerm, std::vector<unsigned int>& ids) const;
+    void FindWordPart(const WordPart& part, std::vector<unsigned int>& ids) const;
+
+    bool m_bBuilt = false;
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> m_tags; /*!< indexed tags by id, empty for removed tags */
+    std::unordered_map<const CPVREpgInfoTag*, unsigned int> m_ids; /*!< ids of the indexed tags */
+    std::map<std::string, std::vector<unsigned int>> m_words; /*!< ascending ids of the tags containing a word, sorted by word */
+    std::unordered_map<const CPVREpgInfoTag*, std::pair<size_t, std::shared_ptr<CPVREpgInfoTag>>> m_pendingTags; /*!< tags not indexed yet, with the order they became pending */
+    size_t m_iNextPending = 0;
+    size_t m_iRemovedTags = 0;
+  };
+}
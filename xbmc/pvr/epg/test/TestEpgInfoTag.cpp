@@ -0,0 +1,154 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-addon-dev-kit/include/kodi/xbmc_pvr_types.h"
+#include "pvr/epg/EpgChannelData.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "utils/InternedStringMap.h"
+#include "utils/StringUtils.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+  std::shared_ptr<CPVREpgInfoTag> CreateTag(const std::shared_ptr<CPVREpgChannelData>& channelData,
+                                            unsigned int iBroadcastId, time_t start,
+                                            const char* strTitle, const char* strPlot, const char* strCast)
+  {
+    EPG_TAG data = {};
+    data.iUniqueBroadcastId = iBroadcastId;
+    data.iUniqueChannelId = channelData->UniqueClientChannelId();
+    data.startTime = start;
+    data.endTime = start + 1800;
+    data.strTitle = strTitle;
+    data.strPlot = strPlot;
+    data.strCast = strCast;
+    data.iGenreType = EPG_GENRE_USE_STRING;
+    data.strGenreDescription = "Documentary";
+    return std::make_shared<CPVREpgInfoTag>(data, 1, channelData, 1);
+  }
+
+#if defined(TARGET_LINUX)
+  // resident set size of the process in bytes
+  size_t GetResidentSize()
+  {
+    size_t iPages = 0;
+    size_t iResidentPages = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> iPages >> iResidentPages;
+    return iResidentPages * 4096;
+  }
+#endif
+}
+
+TEST(TestEpgInfoTag, InternedStrings)
+{
+  const auto channelData = std::make_shared<CPVREpgChannelData>(1, 1);
+  const std::shared_ptr<CPVREpgInfoTag> tag = CreateTag(channelData, 1, 1500000000, "Interned title", "", "");
+  const size_t iInterned = CStringInterner::GetSize();
+
+  // tags share their title and genre, empty strings are not interned
+  const std::shared_ptr<CPVREpgInfoTag> otherTag = CreateTag(channelData, 2, 1500001800, "Interned title", "", "");
+  EXPECT_EQ(iInterned, CStringInterner::GetSize());
+  EXPECT_EQ("Interned title", otherTag->Title());
+  EXPECT_EQ(std::vector<std::string>({"Documentary"}), otherTag->Genre());
+  EXPECT_TRUE(otherTag->Directors().empty());
+}
+
+TEST(TestEpgInfoTag, Times)
+{
+  const auto channelData = std::make_shared<CPVREpgChannelData>(1, 1);
+  const std::shared_ptr<CPVREpgInfoTag> tag = CreateTag(channelData, 1, 1500000000, "News", "", "");
+
+  time_t start;
+  tag->StartAsUTC().GetAsTime(start);
+  EXPECT_EQ(1500000000, start);
+  EXPECT_EQ(1800, tag->GetDuration());
+  EXPECT_EQ("pvr://guide/0001/2017-07-14 02:40:00.epg", tag->Path());
+
+  // tags without times keep them invalid
+  const CPVREpgInfoTag gapTag(channelData, -1);
+  EXPECT_FALSE(gapTag.StartAsUTC().IsValid());
+  EXPECT_FALSE(gapTag.EndAsUTC().IsValid());
+}
+
+TEST(TestEpgInfoTag, Update)
+{
+  const auto channelData = std::make_shared<CPVREpgChannelData>(1, 1);
+  const std::shared_ptr<CPVREpgInfoTag> tag = CreateTag(channelData, 1, 1500000000, "News", "Plot", "Anchor");
+
+  EXPECT_FALSE(tag->Update(*CreateTag(channelData, 1, 1500000000, "News", "Plot", "Anchor")));
+  EXPECT_TRUE(tag->Update(*CreateTag(channelData, 1, 1500000000, "News", "Other plot", "Anchor")));
+  EXPECT_EQ("Other plot", tag->Plot());
+  EXPECT_TRUE(tag->Update(*CreateTag(channelData, 1, 1500000000, "News", "Other plot", "Anchor,Reporter")));
+  EXPECT_EQ(std::vector<std::string>({"Anchor", "Reporter"}), tag->Cast());
+}
+
+// run with --gtest_also_run_disabled_tests to print the memory taken by a guide of 1M tags
+TEST(TestEpgInfoTag, DISABLED_Benchmark)
+{
+  const int iChannels = 500;
+  const int iTagsPerChannel = 2000;
+
+  std::vector<std::string> titles;
+  for (int i = 0; i < 3000; i++)
+    titles.emplace_back(StringUtils::Format("Programme title %d", i));
+
+  std::vector<std::string> people;
+  for (int i = 0; i < 5000; i++)
+    people.emplace_back(StringUtils::Format("Firstname Lastname %d", i));
+
+  const std::string strPlot(300, 'x');
+
+  // both guides are kept until the end, so the second one doesn't reuse memory freed by the first
+  std::vector<std::vector<std::shared_ptr<CPVREpgInfoTag>>> guides;
+  for (bool bWithPlotAndCast : {true, false})
+  {
+    guides.emplace_back();
+    std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags = guides.back();
+    tags.reserve(iChannels * iTagsPerChannel);
+
+#if defined(TARGET_LINUX)
+    const size_t iResidentBefore = GetResidentSize();
+#endif
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int iChannel = 0; iChannel < iChannels; iChannel++)
+    {
+      const auto channelData = std::make_shared<CPVREpgChannelData>(1, iChannel);
+      for (int i = 0; i < iTagsPerChannel; i++)
+      {
+        const int iTag = iChannel * iTagsPerChannel + i;
+        // every plot and cast is different, like in a real guide
+        const std::string strTagPlot = bWithPlotAndCast ? strPlot + std::to_string(iTag) : "";
+        const std::string strTagCast = bWithPlotAndCast ? people[iTag % 5000] + "," + people[(iTag * 7) % 5000] : "";
+        tags.emplace_back(CreateTag(channelData, iTag + 1, 1500000000 + i * 1800,
+                                    titles[(iTag * 13) % titles.size()].c_str(),
+                                    strTagPlot.c_str(), strTagCast.c_str()));
+      }
+    }
+
+    const auto duration = std::chrono::steady_clock::now() - start;
+    std::cout << tags.size() << " tags " << (bWithPlotAndCast ? "with" : "without (released)") << " plot and cast: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << " ms";
+#if defined(TARGET_LINUX)
+    std::cout << ", " << (GetResidentSize() - iResidentBefore) / tags.size() << " bytes per tag";
+#endif
+    std::cout << ", sizeof(CPVREpgInfoTag) " << sizeof(CPVREpgInfoTag)
+              << ", " << CStringInterner::GetSize() << " interned strings" << std::endl;
+  }
+}
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-addon-dev-kit/include/kodi/xbmc_pvr_types.h"
+#include "pvr/epg/EpgChannelData.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgTextIndex.h"
+#include "utils/TextSearch.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+  std::shared_ptr<CPVREpgInfoTag> CreateTag(unsigned int iBroadcastId, const char* strTitle, const char* strPlot)
+  {
+    EPG_TAG data = {};
+    data.iUniqueBroadcastId = iBroadcastId;
+    data.strTitle = strTitle;
+    data.strPlot = strPlot;
+    return std::make_shared<CPVREpgInfoTag>(data, 1, std::make_shared<CPVREpgChannelData>(1, 0), 1);
+  }
+
+  std::vector<unsigned int> GetCandidateIds(const CPVREpgTextIndex& index, const std::string& strSearch, bool bCaseSensitive = false)
+  {
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+    EXPECT_TRUE(index.GetCandidates(CTextSearch(strSearch, bCaseSensitive, SEARCH_DEFAULT_OR), candidates));
+
+    std::vector<unsigned int> ids;
+    for (const auto& tag : candidates)
+      ids.emplace_back(tag->UniqueBroadcastID());
+    return ids;
+  }
+
+  void IndexPendingTags(CPVREpgTextIndex& index)
+  {
+    for (const auto& tag : index.GetPendingTags())
+      index.Add(tag, tag->Plot());
+  }
+}
+
+class TestEpgTextIndex : public testing::Test
+{
+protected:
+  TestEpgTextIndex()
+  {
+    m_tags.emplace_back(CreateTag(1, "Football Tonight", "Highlights of the Champions League."));
+    m_tags.emplace_back(CreateTag(2, "The Late Show", "Talk show with music and football news."));
+    m_tags.emplace_back(CreateTag(3, "Nature", "Whales of the Pacific."));
+    m_index.Build(m_tags);
+    IndexPendingTags(m_index);
+  }
+
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> m_tags;
+  CPVREpgTextIndex m_index;
+};
+
+TEST_F(TestEpgTextIndex, WordParts)
+{
+  EXPECT_EQ(std::vector<unsigned int>({1, 2}), GetCandidateIds(m_index, "football"));
+  EXPECT_EQ(std::vector<unsigned int>({1, 2}), GetCandidateIds(m_index, "ball"));
+  EXPECT_EQ(std::vector<unsigned int>({3}), GetCandidateIds(m_index, "pacif"));
+  EXPECT_TRUE(GetCandidateIds(m_index, "cricket").empty());
+}
+
+TEST_F(TestEpgTextIndex, CaseInsensitive)
+{
+  EXPECT_EQ(std::vector<unsigned int>({1, 2}), GetCandidateIds(m_index, "FOOTBALL"));
+  // the index narrows down case sensitive searches as if they were not
+  EXPECT_EQ(std::vector<unsigned int>({1, 2}), GetCandidateIds(m_index, "Football", true));
+}
+
+TEST_F(TestEpgTextIndex, Phrases)
+{
+  EXPECT_EQ(std::vector<unsigned int>({1}), GetCandidateIds(m_index, "\"champions league\""));
+  EXPECT_EQ(std::vector<unsigned int>({2}), GetCandidateIds(m_index, "\"late show\""));
+}
+
+TEST_F(TestEpgTextIndex, PhraseWordBoundaries)
+{
+  // parts between separators are whole words, the first part may end and the last one start a word
+  EXPECT_EQ(std::vector<unsigned int>({1}), GetCandidateIds(m_index, "\"pions league\""));
+  EXPECT_EQ(std::vector<unsigned int>({1}), GetCandidateIds(m_index, "\"pions lea\""));
+  EXPECT_EQ(std::vector<unsigned int>({2}), GetCandidateIds(m_index, "\"with music and\""));
+  EXPECT_TRUE(GetCandidateIds(m_index, "\"champ league\"").empty());
+  EXPECT_TRUE(GetCandidateIds(m_index, "\"champions eague\"").empty());
+}
+
+TEST_F(TestEpgTextIndex, Operators)
+{
+  EXPECT_EQ(std::vector<unsigned int>({1, 3}), GetCandidateIds(m_index, "champions | whales"));
+  EXPECT_EQ(std::vector<unsigned int>({2}), GetCandidateIds(m_index, "football + music"));
+
+  // 'not' terms alone cannot be looked up
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+  EXPECT_FALSE(m_index.GetCandidates(CTextSearch("football", false, SEARCH_DEFAULT_NOT), candidates));
+}
+
+TEST_F(TestEpgTextIndex, Update)
+{
+  m_index.Remove(m_tags[0]);
+  EXPECT_EQ(std::vector<unsigned int>({2}), GetCandidateIds(m_index, "football"));
+
+  const std::shared_ptr<CPVREpgInfoTag> tag = CreateTag(4, "Football Classics", "");
+  m_index.Update(tag);
+  EXPECT_EQ(std::vector<unsigned int>({2, 4}), GetCandidateIds(m_index, "football"));
+
+  m_index.Clear();
+  EXPECT_TRUE(GetCandidateIds(m_index, "football").empty());
+}
+
+TEST_F(TestEpgTextIndex, PendingTags)
+{
+  // changed tags are candidates of every search until they are indexed again
+  const std::shared_ptr<CPVREpgInfoTag> tag = CreateTag(4, "Cricket", "");
+  m_index.Update(tag);
+  m_index.Update(m_tags[2]);
+  EXPECT_EQ(4u, GetCandidateIds(m_index, "football").size());
+  EXPECT_EQ(2u, GetCandidateIds(m_index, "tennis").size());
+
+  IndexPendingTags(m_index);
+  EXPECT_TRUE(m_index.GetPendingTags().empty());
+  EXPECT_TRUE(GetCandidateIds(m_index, "tennis").empty());
+  EXPECT_EQ(std::vector<unsigned int>({4}), GetCandidateIds(m_index, "cricket"));
+  EXPECT_EQ(std::vector<unsigned int>({3}), GetCandidateIds(m_index, "whales"));
+
+  // tags that are not pending are not indexed
+  m_index.Add(CreateTag(5, "Cricket", ""), "");
+  EXPECT_EQ(std::vector<unsigned int>({4}), GetCandidateIds(m_index, "cricket"));
+}
+
+TEST(TestEpgTextIndexCompact, KeepsWords)
+{
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+  for (unsigned int i = 1; i < 2048; i++)
+    tags.emplace_back(CreateTag(i, "Filler", ""));
+  tags.emplace_back(CreateTag(2048, "Needle", "Haystack"));
+
+  CPVREpgTextIndex index;
+  index.Build(tags);
+  IndexPendingTags(index);
+
+  // removing more than half of the tags compacts the index, which keeps the words of the others
+  for (unsigned int i = 0; i < 2000; i++)
+    index.Remove(tags[i]);
+
+  EXPECT_EQ(std::vector<unsigned int>({2048}), GetCandidateIds(index, "haystack"));
+  EXPECT_EQ(47u, GetCandidateIds(index, "filler").size());
+}
+
+TEST(TestEpgTextIndexNotBuilt, IgnoresChanges)
+{
+  CPVREpgTextIndex index;
+  index.Update(CreateTag(1, "Football", ""));
+
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+  EXPECT_FALSE(index.GetCandidates(CTextSearch("football"), candidates));
+}
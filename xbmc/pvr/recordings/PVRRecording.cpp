@@ -28,6 +28,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace PVR;
@@ -338,8 +339,47 @@ std::vector<PVR_EDL_ENTRY> CPVRRecording::GetEdl() const
   return edls;
 }
 
-void CPVRRecording::Update(const CPVRRecording &tag)
+bool CPVRRecording::Update(const CPVRRecording &tag)
 {
+  bool bPlayCountFromClient = true;
+  bool bResumePointFromClient = true;
+  if (m_bGotMetaData)
+  {
+    // keep the values read from the database, see UpdateMetadata
+    const CPVRClientPtr client = CServiceBroker::GetPVRManager().GetClient(tag.m_iClientId);
+    bPlayCountFromClient = client && client->GetClientCapabilities().SupportsRecordingsPlayCount();
+    bResumePointFromClient = client && client->GetClientCapabilities().SupportsRecordingsLastPlayedPosition();
+  }
+
+  bool bChanged = m_strRecordingId   != tag.m_strRecordingId ||
+                  m_iClientId        != tag.m_iClientId ||
+                  m_iSeason          != tag.m_iSeason ||
+                  m_iEpisode         != tag.m_iEpisode ||
+                  GetPremiered()     != tag.GetPremiered() ||
+                  m_recordingTime    != tag.m_recordingTime ||
+                  m_iPriority        != tag.m_iPriority ||
+                  m_iLifetime        != tag.m_iLifetime ||
+                  m_strDirectory     != tag.m_strDirectory ||
+                  m_strPlot          != tag.m_strPlot ||
+                  m_strPlotOutline   != tag.m_strPlotOutline ||
+                  m_strChannelName   != tag.m_strChannelName ||
+                  m_strIconPath      != tag.m_strIconPath ||
+                  m_strThumbnailPath != tag.m_strThumbnailPath ||
+                  m_strFanartPath    != tag.m_strFanartPath ||
+                  m_bIsDeleted       != tag.m_bIsDeleted ||
+                  m_iEpgEventId      != tag.m_iEpgEventId ||
+                  m_iChannelUid      != tag.m_iChannelUid ||
+                  m_bRadio           != tag.m_bRadio ||
+                  GetDuration()      != tag.GetDuration() ||
+                  (bPlayCountFromClient && GetLocalPlayCount() != tag.GetLocalPlayCount()) ||
+                  (bResumePointFromClient &&
+                   GetLocalResumePoint().timeInSeconds != tag.GetLocalResumePoint().timeInSeconds);
+
+  // members derived from several values of tag are compared after the update
+  const std::string strOldTitle(std::move(m_strTitle));
+  const std::string strOldShowTitle(std::move(m_strShowTitle));
+  const std::vector<std::string> oldGenre(std::move(m_genre));
+
   m_strRecordingId    = tag.m_strRecordingId;
   m_iClientId         = tag.m_iClientId;
   m_strTitle          = tag.m_strTitle;
@@ -363,8 +403,10 @@ void CPVRRecording::Update(const CPVRRecording &tag)
   m_iChannelUid       = tag.m_iChannelUid;
   m_bRadio            = tag.m_bRadio;
 
-  CVideoInfoTag::SetPlayCount(tag.GetLocalPlayCount());
-  CVideoInfoTag::SetResumePoint(tag.GetLocalResumePoint());
+  if (bPlayCountFromClient)
+    CVideoInfoTag::SetPlayCount(tag.GetLocalPlayCount());
+  if (bResumePointFromClient)
+    CVideoInfoTag::SetResumePoint(tag.GetLocalResumePoint());
   SetDuration(tag.GetDuration());
 
   if (m_iGenreType == EPG_GENRE_USE_STRING)
@@ -396,6 +438,17 @@ void CPVRRecording::Update(const CPVRRecording &tag)
   }
 
   UpdatePath();
+
+  return bChanged || m_strTitle != strOldTitle || m_strShowTitle != strOldShowTitle || m_genre != oldGenre;
+}
+
+std::shared_ptr<CPVRRecording> CPVRRecording::CreateUpdatedCopy(const CPVRRecording &tag) const
+{
+  const std::shared_ptr<CPVRRecording> copy(new CPVRRecording(*this));
+  if (!copy->Update(tag))
+    return {};
+
+  return copy;
 }
 
 void CPVRRecording::UpdatePath(void)
@@ -78,7 +78,7 @@ namespace PVR
     CPVRRecording(const PVR_RECORDING &recording, unsigned int iClientId);
 
   private:
-    CPVRRecording(const CPVRRecording &tag) = delete;
+    CPVRRecording(const CPVRRecording &tag) = default;
     CPVRRecording &operator =(const CPVRRecording &other) = delete;
 
   public:
@@ -178,10 +178,20 @@ namespace PVR
     void UpdateMetadata(CVideoDatabase &db);
 
     /*!
-     * @brief Update this tag with the contents of the given tag.
+     * @brief Update this tag with the contents of the given tag. Once the metadata was read from the database,
+     * play count and resume point are only taken from the given tag if the client handles them itself.
      * @param tag The new tag info.
+     * @return True if anything changed, false otherwise.
      */
-    void Update(const CPVRRecording &tag);
+    bool Update(const CPVRRecording &tag);
+
+    /*!
+     * @brief Create a copy of this tag, updated with the contents of the given tag. This tag is left untouched,
+     * so it can be replaced by the copy while others still read it.
+     * @param tag The new tag info.
+     * @return The updated copy, or nullptr if nothing changed.
+     */
+    std::shared_ptr<CPVRRecording> CreateUpdatedCopy(const CPVRRecording &tag) const;
 
     /*!
      * @brief Retrieve the recording start as UTC time
@@ -8,7 +8,12 @@
 
 #include "PVRRecordings.h"
 
+#include "FileItem.h"
+#include "GUIUserMessages.h"
 #include "ServiceBroker.h"
+#include "guilib/GUIComponent.h"
+#include "guilib/GUIMessage.h"
+#include "guilib/GUIWindowManager.h"
 #include "pvr/PVRManager.h"
 #include "pvr/addons/PVRClients.h"
 #include "pvr/epg/EpgInfoTag.h"
@@ -19,12 +24,19 @@
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
 
 using namespace PVR;
 
+namespace
+{
+  // more changed recordings than this are announced by rebuilding the lists instead of updating single items
+  const size_t MAX_UPDATED_ITEM_NOTIFICATIONS = 50;
+}
+
 CPVRRecordings::CPVRRecordings() = default;
 
 CPVRRecordings::~CPVRRecordings()
@@ -33,12 +45,58 @@ CPVRRecordings::~CPVRRecordings()
     m_database->Close();
 }
 
-void CPVRRecordings::UpdateFromClients(void)
+bool CPVRRecordings::UpdateFromClients(std::vector<std::shared_ptr<CPVRRecording>>& updatedRecordings)
 {
   CSingleLock lock(m_critSection);
-  Unload();
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, false);
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, true);
+  m_bRecordingsAddedOrDeleted = false;
+  m_updatedRecordings.clear();
+  m_receivedRecordings.clear();
+
+  std::vector<int> failedClients;
+  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, false, failedClients);
+  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, true, failedClients);
+
+  /* remove the recordings the clients don't have anymore, keep those of clients that could not be asked */
+  for (auto it = m_recordings.begin(); it != m_recordings.end();)
+  {
+    if (m_receivedRecordings.find(it->second.get()) == m_receivedRecordings.end() &&
+        std::find(failedClients.begin(), failedClients.end(), it->second->m_iClientId) == failedClients.end())
+    {
+      CLog::LogFC(LOGDEBUG, LOGPVR, "Deleted recording %s on client %d",
+                  it->second->m_strRecordingId.c_str(), it->second->m_iClientId);
+      it = m_recordings.erase(it);
+      m_bRecordingsAddedOrDeleted = true;
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  /* recount, the recordings of failed clients are kept */
+  m_bDeletedTVRecordings = false;
+  m_bDeletedRadioRecordings = false;
+  m_iTVRecordings = 0;
+  m_iRadioRecordings = 0;
+  for (const auto& recording : m_recordings)
+  {
+    if (recording.second->IsDeleted())
+    {
+      if (recording.second->IsRadio())
+        m_bDeletedRadioRecordings = true;
+      else
+        m_bDeletedTVRecordings = true;
+    }
+
+    if (recording.second->IsRadio())
+      ++m_iRadioRecordings;
+    else
+      ++m_iTVRecordings;
+  }
+
+  m_receivedRecordings.clear();
+  updatedRecordings.swap(m_updatedRecordings);
+  return m_bRecordingsAddedOrDeleted;
 }
 
 int CPVRRecordings::Load(void)
@@ -67,14 +125,32 @@ void CPVRRecordings::Update(void)
   lock.Leave();
 
   CLog::LogFC(LOGDEBUG, LOGPVR, "Updating recordings");
-  UpdateFromClients();
+  std::vector<std::shared_ptr<CPVRRecording>> updatedRecordings;
+  const bool bAddedOrDeleted = UpdateFromClients(updatedRecordings);
 
   lock.Enter();
   m_bIsUpdating = false;
   lock.Leave();
 
-  CServiceBroker::GetPVRManager().SetChanged();
-  CServiceBroker::GetPVRManager().NotifyObservers(ObservableMessageRecordings);
+  if (!bAddedOrDeleted && updatedRecordings.empty())
+    return;
+
+  if (bAddedOrDeleted || updatedRecordings.size() > MAX_UPDATED_ITEM_NOTIFICATIONS)
+  {
+    // the lists must be rebuilt
+    CServiceBroker::GetPVRManager().SetChanged();
+    CServiceBroker::GetPVRManager().NotifyObservers(ObservableMessageRecordings);
+  }
+  else
+  {
+    // only update the items of the changed recordings
+    for (const auto& recording : updatedRecordings)
+    {
+      CGUIMessage msg(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE_ITEM, 0, std::make_shared<CFileItem>(recording));
+      CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
+    }
+  }
+
   CServiceBroker::GetPVRManager().PublishEvent(PVREvent::RecordingsInvalidated);
 }
 
@@ -167,18 +243,33 @@ void CPVRRecordings::UpdateFromClient(const CPVRRecordingPtr &tag)
 {
   CSingleLock lock(m_critSection);
 
-  if (tag->IsDeleted())
+  CPVRRecordingPtr newTag;
+  const auto it = m_recordings.find(CPVRRecordingUid(tag->m_iClientId, tag->m_strRecordingId));
+  if (it != m_recordings.end())
   {
-    if (tag->IsRadio())
-      m_bDeletedRadioRecordings = true;
-    else
-      m_bDeletedTVRecordings = true;
-  }
+    // others read the recording without locking, so a changed recording is replaced by an updated copy
+    const CPVRRecordingPtr oldTag = it->second;
+    newTag = oldTag->CreateUpdatedCopy(*tag);
+    if (newTag)
+    {
+      it->second = newTag;
 
-  CPVRRecordingPtr newTag = GetById(tag->m_iClientId, tag->m_strRecordingId);
-  if (newTag)
-  {
-    newTag->Update(*tag);
+      // a recording moved to another folder or to the trash changes the lists
+      if (newTag->m_strFileNameAndPath != oldTag->m_strFileNameAndPath)
+        m_bRecordingsAddedOrDeleted = true;
+      else
+      {
+        const auto updatedIt = std::find(m_updatedRecordings.begin(), m_updatedRecordings.end(), oldTag);
+        if (updatedIt != m_updatedRecordings.end())
+          *updatedIt = newTag;
+        else
+          m_updatedRecordings.emplace_back(newTag);
+      }
+    }
+    else
+    {
+      newTag = oldTag;
+    }
   }
   else
   {
@@ -187,11 +278,10 @@ void CPVRRecordings::UpdateFromClient(const CPVRRecordingPtr &tag)
     newTag->UpdateMetadata(GetVideoDatabase());
     newTag->m_iRecordingId = ++m_iLastId;
     m_recordings.insert(std::make_pair(CPVRRecordingUid(newTag->m_iClientId, newTag->m_strRecordingId), newTag));
-    if (newTag->IsRadio())
-      ++m_iRadioRecordings;
-    else
-      ++m_iTVRecordings;
+    m_bRecordingsAddedOrDeleted = true;
   }
+
+  m_receivedRecordings.insert(newTag.get());
 }
 
 CPVRRecordingPtr CPVRRecordings::GetRecordingForEpgTag(const CPVREpgInfoTagPtr &epgTag) const
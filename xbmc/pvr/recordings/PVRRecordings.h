@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 class CVideoDatabase;
@@ -41,10 +42,16 @@ namespace PVR
      */
     void Unload();
 
+    /*!
+     * @brief Add or update a recording received from a client.
+     * @param tag The recording.
+     */
     void UpdateFromClient(const CPVRRecordingPtr &tag);
 
     /*!
-     * @brief refresh the recordings list from the clients.
+     * @brief refresh the recordings list from the clients. Only recordings that were added, changed or
+     * deleted by the clients are touched. Windows get their lists rebuilt if recordings were added or
+     * deleted, otherwise only the items of the changed recordings are updated.
      */
     void Update(void);
 
@@ -96,7 +103,16 @@ namespace PVR
     unsigned int m_iTVRecordings = 0;
     unsigned int m_iRadioRecordings = 0;
 
-    void UpdateFromClients(void);
+    bool m_bRecordingsAddedOrDeleted = false; /*!< true if the running update added, deleted or moved any recording */
+    std::vector<std::shared_ptr<CPVRRecording>> m_updatedRecordings; /*!< recordings changed in place by the running update */
+    std::unordered_set<const CPVRRecording*> m_receivedRecordings; /*!< recordings the clients sent during the running update */
+
+    /*!
+     * @brief Sync the recordings with those of the clients.
+     * @param updatedRecordings Filled with the recordings that were changed in place.
+     * @return True if recordings were added, deleted or moved to another folder, false otherwise.
+     */
+    bool UpdateFromClients(std::vector<std::shared_ptr<CPVRRecording>>& updatedRecordings);
 
     /*!
      * @brief Get/Open the video database.
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRTimerRuleIndex.h"
+
+#include "XBDateTime.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/timers/PVRTimerInfoTag.h"
+#include "pvr/timers/PVRTimerRuleMatcher.h"
+
+using namespace PVR;
+
+namespace
+{
+  // same case folding as CPVRTimerRuleMatcher::GetSearchLiteral and the case insensitive ASCII only regex
+  std::string ToLowerAscii(const std::string& str)
+  {
+    std::string lower(str);
+    for (char& c : lower)
+    {
+      if (c >= 'A' && c <= 'Z')
+        c += 'a' - 'A';
+    }
+    return lower;
+  }
+
+  class CLowerCaseTexts
+  {
+  public:
+    CLowerCaseTexts(const std::shared_ptr<CPVREpgInfoTag>& epgTag, const std::string* strPlot)
+    : m_epgTag(epgTag), m_strPlot(strPlot) {}
+
+    bool Contains(const std::string& literal, bool bFullText)
+    {
+      if (!m_bTitle)
+      {
+        m_title = ToLowerAscii(m_epgTag->Title());
+        m_bTitle = true;
+      }
+
+      if (m_title.find(literal) != std::string::npos)
+        return true;
+
+      if (!bFullText)
+        return false;
+
+      if (!m_bFullText)
+      {
+        m_episodeName = ToLowerAscii(m_epgTag->EpisodeName());
+        m_plotOutline = ToLowerAscii(m_epgTag->PlotOutline());
+        m_plot = ToLowerAscii(m_strPlot ? *m_strPlot : m_epgTag->Plot());
+        m_bFullText = true;
+      }
+
+      return m_episodeName.find(literal) != std::string::npos ||
+             m_plotOutline.find(literal) != std::string::npos ||
+             m_plot.find(literal) != std::string::npos;
+    }
+
+  private:
+    const std::shared_ptr<CPVREpgInfoTag>& m_epgTag;
+    const std::string* m_strPlot;
+    bool m_bTitle = false;
+    bool m_bFullText = false;
+    std::string m_title;
+    std::string m_episodeName;
+    std::string m_plotOutline;
+    std::string m_plot;
+  };
+} // unnamed namespace
+
+void CPVRTimerRuleIndex::Add(const std::shared_ptr<CPVRTimerRuleMatcher>& matcher)
+{
+  const Entry entry = {matcher, matcher->GetSearchLiteral(), matcher->IsFullTextSearch()};
+  const unsigned int iWeekdays = matcher->GetWeekdays();
+
+  if (matcher->MatchesAnyChannel())
+  {
+    AddToWeekdays(m_anyChannelRules, entry, iWeekdays);
+  }
+  else
+  {
+    AddToWeekdays(m_channelRules[matcher->GetClientChannel()], entry, iWeekdays);
+  }
+
+  m_iSize++;
+  if (entry.bFullText)
+    m_iFullTextRules++;
+}
+
+void CPVRTimerRuleIndex::AddToWeekdays(WeekdayEntries& weekdays, const Entry& entry, unsigned int iWeekdays)
+{
+  for (size_t i = 0; i < weekdays.size(); ++i)
+  {
+    if (iWeekdays & (1 << i))
+      weekdays[i].emplace_back(entry);
+  }
+}
+
+void CPVRTimerRuleIndex::GetMatches(const std::shared_ptr<CPVREpgInfoTag>& epgTag,
+                                    std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>& matches,
+                                    const std::string* strPlot /* = nullptr */) const
+{
+  if (!epgTag || m_iSize == 0)
+    return;
+
+  int iWeekday = CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->StartAsUTC()).GetDayOfWeek();
+  iWeekday = (iWeekday == 0) ? 6 : iWeekday - 1; // sunday is last
+
+  CLowerCaseTexts texts(epgTag, strPlot);
+
+  const auto evaluate = [&epgTag, &matches, &texts, strPlot](const std::vector<Entry>& entries)
+  {
+    for (const auto& entry : entries)
+    {
+      if (!entry.literal.empty() && !texts.Contains(entry.literal, entry.bFullText))
+        continue;
+
+      if (entry.matcher->Matches(epgTag, strPlot))
+        matches.emplace_back(entry.matcher);
+    }
+  };
+
+  evaluate(m_anyChannelRules[iWeekday]);
+
+  const auto it = m_channelRules.find(std::make_pair(epgTag->ClientID(), epgTag->UniqueChannelID()));
+  if (it != m_channelRules.end())
+    evaluate(it->second[iWeekday]);
+}
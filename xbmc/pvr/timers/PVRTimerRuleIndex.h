@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace PVR
+{
+  class CPVREpgInfoTag;
+  class CPVRTimerRuleMatcher;
+
+  /*!
+   * @brief Timer rule matchers, indexed by channel, weekday and search text. Only the rules
+   * of the tag's channel and weekday whose plain search text occurs in the tag are evaluated.
+   */
+  class CPVRTimerRuleIndex
+  {
+  public:
+    /*!
+     * @brief Add a rule to the index.
+     * @param matcher The matcher of the rule.
+     */
+    void Add(const std::shared_ptr<CPVRTimerRuleMatcher>& matcher);
+
+    /*!
+     * @brief Check whether the index contains any rule.
+     * @return True if there is no rule, false otherwise.
+     */
+    bool IsEmpty() const { return m_iSize == 0; }
+
+    /*!
+     * @brief Check whether the index contains a rule searching the plot, whose callers should read
+     * the plots of many tags at once with CPVREpgInfoTag::ForEachPlot.
+     * @return True if there is such a rule, false otherwise.
+     */
+    bool HasFullTextRules() const { return m_iFullTextRules > 0; }
+
+    /*!
+     * @brief Get the rules matching an EPG tag.
+     * @param epgTag The tag.
+     * @param matches The matchers of the rules matching the tag are appended to this.
+     * @param strPlot The plot of the tag if the caller already read it, nullptr to get it from the tag.
+     */
+    void GetMatches(const std::shared_ptr<CPVREpgInfoTag>& epgTag,
+                    std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>& matches,
+                    const std::string* strPlot = nullptr) const;
+
+  private:
+    struct Entry
+    {
+      std::shared_ptr<CPVRTimerRuleMatcher> matcher;
+      std::string literal; /*!< lower case search text, empty if the rule must always be evaluated */
+      bool bFullText;
+    };
+
+    typedef std::array<std::vector<Entry>, 7> WeekdayEntries; /*!< the rules of each weekday, monday first */
+
+    void AddToWeekdays(WeekdayEntries& weekdays, const Entry& entry, unsigned int iWeekdays);
+
+    std::map<std::pair<int, int>, WeekdayEntries> m_channelRules; /*!< rules of a single channel, by client id and client channel uid */
+    WeekdayEntries m_anyChannelRules; /*!< rules matching any channel */
+    size_t m_iSize = 0;
+    size_t m_iFullTextRules = 0;
+  };
+}
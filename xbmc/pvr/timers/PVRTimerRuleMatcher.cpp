@@ -13,6 +13,8 @@
 #include "pvr/timers/PVRTimerInfoTag.h"
 #include "utils/RegExp.h"
 
+#include <cstring>
+
 using namespace PVR;
 
 CPVRTimerRuleMatcher::CPVRTimerRuleMatcher(const std::shared_ptr<CPVRTimerInfoTag>& timerRule, const CDateTime& start)
@@ -68,7 +70,7 @@ CDateTime CPVRTimerRuleMatcher::GetNextTimerStart() const
   return nextStart.GetAsUTCDateTime();
 }
 
-bool CPVRTimerRuleMatcher::Matches(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const
+bool CPVRTimerRuleMatcher::Matches(const std::shared_ptr<CPVREpgInfoTag>& epgTag, const std::string* strPlot) const
 {
   return epgTag &&
          CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->EndAsUTC()) > m_start &&
@@ -77,7 +79,57 @@ bool CPVRTimerRuleMatcher::Matches(const std::shared_ptr<CPVREpgInfoTag>& epgTag
          MatchStart(epgTag) &&
          MatchEnd(epgTag) &&
          MatchDayOfWeek(epgTag) &&
-         MatchSearchText(epgTag);
+         MatchSearchText(epgTag, strPlot);
+}
+
+bool CPVRTimerRuleMatcher::MatchesAnyChannel() const
+{
+  if (m_timerRule->GetTimerType()->SupportsAnyChannel() &&
+      m_timerRule->m_iClientChannelUid == PVR_CHANNEL_INVALID_UID)
+    return true;
+
+  return !m_timerRule->GetTimerType()->SupportsChannels();
+}
+
+unsigned int CPVRTimerRuleMatcher::GetWeekdays() const
+{
+  if (m_timerRule->GetTimerType()->SupportsWeekdays())
+    return m_timerRule->m_iWeekdays & PVR_WEEKDAY_ALLDAYS;
+
+  return PVR_WEEKDAY_ALLDAYS;
+}
+
+std::pair<int, int> CPVRTimerRuleMatcher::GetClientChannel() const
+{
+  return std::make_pair(m_timerRule->m_iClientId, m_timerRule->m_iClientChannelUid);
+}
+
+bool CPVRTimerRuleMatcher::IsTextSearch() const
+{
+  return IsFullTextSearch() || m_timerRule->GetTimerType()->SupportsEpgTitleMatch();
+}
+
+bool CPVRTimerRuleMatcher::IsFullTextSearch() const
+{
+  return m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() &&
+         m_timerRule->m_bFullTextEpgSearch;
+}
+
+std::string CPVRTimerRuleMatcher::GetSearchLiteral() const
+{
+  if (!IsTextSearch())
+    return {};
+
+  std::string literal = m_timerRule->m_strEpgSearchString;
+  for (char& c : literal)
+  {
+    if (static_cast<unsigned char>(c) >= 0x80 || std::strchr("\\^$.|?*+()[]{}", c))
+      return {};
+
+    if (c >= 'A' && c <= 'Z')
+      c += 'a' - 'A';
+  }
+  return literal;
 }
 
 bool CPVRTimerRuleMatcher::MatchSeriesLink(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const
@@ -172,7 +224,7 @@ bool CPVRTimerRuleMatcher::MatchDayOfWeek(const std::shared_ptr<CPVREpgInfoTag>&
   return true;
 }
 
-bool CPVRTimerRuleMatcher::MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const
+bool CPVRTimerRuleMatcher::MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>& epgTag, const std::string* strPlot) const
 {
   if (m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() &&
       m_timerRule->m_bFullTextEpgSearch)
@@ -185,7 +237,7 @@ bool CPVRTimerRuleMatcher::MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>
     return m_textSearch->RegFind(epgTag->Title()) >= 0 ||
            m_textSearch->RegFind(epgTag->EpisodeName()) >= 0 ||
            m_textSearch->RegFind(epgTag->PlotOutline()) >= 0 ||
-           m_textSearch->RegFind(epgTag->Plot()) >= 0;
+           m_textSearch->RegFind(strPlot ? *strPlot : epgTag->Plot()) >= 0;
   }
   else if (m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
   {
@@ -11,6 +11,8 @@
 #include "XBDateTime.h"
 
 #include <memory>
+#include <string>
+#include <utility>
 
 class CRegExp;
 
@@ -30,7 +32,36 @@ namespace PVR
 
     std::shared_ptr<CPVRChannel> GetChannel() const;
     CDateTime GetNextTimerStart() const;
-    bool Matches(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
+    bool Matches(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const { return Matches(epgTag, nullptr); }
+
+    /*!
+     * @brief Check whether an EPG tag matches the rule.
+     * @param epgTag The tag.
+     * @param strPlot The plot of the tag if the caller already read it, e.g. with CPVREpgInfoTag::ForEachPlot,
+     * nullptr to get it from the tag.
+     * @return True if the tag matches, false otherwise.
+     */
+    virtual bool Matches(const std::shared_ptr<CPVREpgInfoTag>& epgTag, const std::string* strPlot) const;
+
+    /*!
+     * @brief Properties of the rule, used by CPVRTimerRuleIndex to skip matchers that cannot match a tag.
+     */
+    virtual bool MatchesAnyChannel() const;
+    virtual unsigned int GetWeekdays() const;
+    bool IsTextSearch() const;
+    virtual bool IsFullTextSearch() const;
+
+    /*!
+     * @brief Get the channel of a rule that doesn't match any channel.
+     * @return The client id and the client channel uid.
+     */
+    virtual std::pair<int, int> GetClientChannel() const;
+
+    /*!
+     * @brief Get the lower case search text if it is a plain ASCII string without regex special characters.
+     * @return The text, empty if the search string is empty or needs the regex.
+     */
+    virtual std::string GetSearchLiteral() const;
 
   private:
     bool MatchSeriesLink(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
@@ -38,7 +69,7 @@ namespace PVR
     bool MatchStart(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
     bool MatchEnd(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
     bool MatchDayOfWeek(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
-    bool MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
+    bool MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>& epgTag, const std::string* strPlot) const;
 
     const std::shared_ptr<CPVRTimerInfoTag> m_timerRule;
     CDateTime m_start;
@@ -19,6 +19,7 @@
 #include "pvr/epg/EpgContainer.h"
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/timers/PVRTimerInfoTag.h"
+#include "pvr/timers/PVRTimerRuleIndex.h"
 #include "pvr/timers/PVRTimerRuleMatcher.h"
 #include "settings/Settings.h"
 #include "threads/SingleLock.h"
@@ -27,6 +28,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -118,6 +120,8 @@ void CPVRTimers::Unload()
   // remove all tags
   CSingleLock lock(m_critSection);
   m_tags.clear();
+  m_checkedReminderRules.clear();
+  m_iReminderRulesTagSerial = 0;
 }
 
 bool CPVRTimers::Update(void)
@@ -209,13 +213,29 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
 
   CSingleLock lock(m_critSection);
 
+  /* look up timers by client id and client index, instead of searching both containers for each timer */
+  std::map<std::pair<int, int>, std::shared_ptr<CPVRTimerInfoTag>> existingTimers;
+  for (const auto& tagsEntry : m_tags)
+  {
+    for (const auto& timer : tagsEntry.second)
+      existingTimers.insert(std::make_pair(std::make_pair(timer->m_iClientId, timer->m_iClientIndex), timer));
+  }
+
+  std::map<std::pair<int, int>, std::shared_ptr<CPVRTimerInfoTag>> clientTimers;
+  for (const auto& tagsEntry : timers.GetTags())
+  {
+    for (const auto& timer : tagsEntry.second)
+      clientTimers.insert(std::make_pair(std::make_pair(timer->m_iClientId, timer->m_iClientIndex), timer));
+  }
+
   /* go through the timer list and check for updated or new timers */
   for (MapTags::const_iterator it = timers.GetTags().begin(); it != timers.GetTags().end(); ++it)
   {
     for (VecTimerInfoTag::const_iterator timerIt = it->second.begin(); timerIt != it->second.end(); ++timerIt)
     {
       /* check if this timer is present in this container */
-      CPVRTimerInfoTagPtr existingTimer = GetByClient((*timerIt)->m_iClientId, (*timerIt)->m_iClientIndex);
+      const auto existingIt = existingTimers.find(std::make_pair((*timerIt)->m_iClientId, (*timerIt)->m_iClientIndex));
+      CPVRTimerInfoTagPtr existingTimer = existingIt != existingTimers.end() ? existingIt->second : CPVRTimerInfoTagPtr();
       if (existingTimer)
       {
         /* if it's present, update the current tag */
@@ -243,6 +263,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
         newTimer->UpdateEntry(*timerIt);
         newTimer->m_iTimerId = ++m_iLastId;
         InsertEntry(newTimer);
+        existingTimers.insert(std::make_pair(std::make_pair(newTimer->m_iClientId, newTimer->m_iClientIndex), newTimer));
 
         bChanged = true;
         bAddedOrDeleted = true;
@@ -266,7 +287,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
     for (std::vector<CPVRTimerInfoTagPtr>::iterator it2 = it->second.begin(); it2 != it->second.end();)
     {
       const std::shared_ptr<CPVRTimerInfoTag> timer = *it2;
-      if (!timers.GetByClient(timer->m_iClientId, timer->m_iClientIndex))
+      if (clientTimers.find(std::make_pair(timer->m_iClientId, timer->m_iClientIndex)) == clientTimers.end())
       {
         /* timer was not found */
         bool bIgnoreTimer = !timer->IsOwnedByClient();
@@ -332,19 +353,29 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
   }
 
   /* update child information for all parent timers */
+  std::map<std::pair<int, int>, std::shared_ptr<CPVRTimerInfoTag>> timerRules;
   for (const auto &tagsEntry : m_tags)
   {
     for (const auto &timersEntry : tagsEntry.second)
     {
       if (timersEntry->IsTimerRule())
+      {
         timersEntry->ResetChildState();
+        timerRules.insert(std::make_pair(std::make_pair(timersEntry->m_iClientId, timersEntry->m_iClientIndex), timersEntry));
+      }
     }
+  }
 
+  for (const auto &tagsEntry : m_tags)
+  {
     for (const auto& timersEntry : tagsEntry.second)
     {
-      const std::shared_ptr<CPVRTimerInfoTag> parentTimer = GetTimerRule(timersEntry);
-      if (parentTimer)
-        parentTimer->UpdateChildState(timersEntry, true);
+      if (timersEntry->GetTimerRuleId() == PVR_TIMER_NO_PARENT)
+        continue;
+
+      const auto parentIt = timerRules.find(std::make_pair(timersEntry->m_iClientId, timersEntry->GetTimerRuleId()));
+      if (parentIt != timerRules.end())
+        parentIt->second->UpdateChildState(timersEntry, true);
     }
   }
 
@@ -383,88 +414,50 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
 
 namespace
 {
-  std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTagsForTimerRule(const CPVRTimerRuleMatcher& matcher)
+  void MatchEpgTags(const CPVRTimerRuleMatcher& matcher,
+                    const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags,
+                    std::vector<std::shared_ptr<CPVREpgInfoTag>>& matches)
   {
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> matches;
-
-    const std::shared_ptr<CPVRChannel> channel = matcher.GetChannel();
-    if (channel)
+    if (matcher.IsFullTextSearch())
     {
-      // match single channel
-      const std::shared_ptr<CPVREpg> epg = channel->GetEPG();
-      if (epg)
+      // read the plots released by lazy loading with one query per batch, not one per tag
+      CPVREpgInfoTag::ForEachPlot(tags, [&matcher, &matches](const std::shared_ptr<CPVREpgInfoTag>& tag, const std::string& strPlot)
       {
-        std::vector<std::shared_ptr<CPVREpgInfoTag>> tags = epg->GetTags();
-        for (const auto& tag : tags)
-        {
-          if (matcher.Matches(tag))
-            matches.emplace_back(tag);
-        }
-      }
+        if (matcher.Matches(tag, &strPlot))
+          matches.emplace_back(tag);
+      });
     }
     else
     {
-      // match any channel
-      const std::vector<std::shared_ptr<CPVREpg>> epgs = CServiceBroker::GetPVRManager().EpgContainer().GetAllEpgs();
-      for (const auto& epg : epgs)
+      for (const auto& tag : tags)
       {
-        std::vector<std::shared_ptr<CPVREpgInfoTag>> tags = epg->GetTags();
-        for (const auto& tag : tags)
-        {
-          if (matcher.Matches(tag))
-            matches.emplace_back(tag);
-        }
+        if (matcher.Matches(tag))
+          matches.emplace_back(tag);
       }
     }
-
-    return matches;
   }
 
-  void AddTimerRuleToEpgMap(const std::shared_ptr<CPVRTimerInfoTag>& timer,
-                            const CDateTime& now,
-                            std::map<std::shared_ptr<CPVREpg>, std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>>& epgMap,
-                            bool& bFetchedAllEpgs)
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTagsForTimerRule(const CPVRTimerRuleMatcher& matcher)
   {
-    const std::shared_ptr<CPVRChannel> channel = timer->Channel();
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> matches;
+
+    const std::shared_ptr<CPVRChannel> channel = matcher.GetChannel();
     if (channel)
     {
+      // match single channel
       const std::shared_ptr<CPVREpg> epg = channel->GetEPG();
       if (epg)
-      {
-        const std::shared_ptr<CPVRTimerRuleMatcher> matcher = std::make_shared<CPVRTimerRuleMatcher>(timer, now);
-        auto it = epgMap.find(epg);
-        if (it == epgMap.end())
-          epgMap.insert({epg, {matcher}});
-        else
-          it->second.emplace_back(matcher);
-      }
+        MatchEpgTags(matcher, epg->GetTags(), matches);
     }
     else
     {
-      // rule matches "any channel" => we need to check all channels
-      if (!bFetchedAllEpgs)
-      {
-        const std::vector<std::shared_ptr<CPVREpg>> epgs = CServiceBroker::GetPVRManager().EpgContainer().GetAllEpgs();
-        for (const auto& epg : epgs)
-        {
-          const std::shared_ptr<CPVRTimerRuleMatcher> matcher = std::make_shared<CPVRTimerRuleMatcher>(timer, now);
-          auto it = epgMap.find(epg);
-          if (it == epgMap.end())
-            epgMap.insert({epg, {matcher}});
-          else
-            it->second.emplace_back(matcher);
-        }
-        bFetchedAllEpgs = true;
-      }
-      else
-      {
-        for (auto& epgMapEntry : epgMap)
-        {
-          const std::shared_ptr<CPVRTimerRuleMatcher> matcher = std::make_shared<CPVRTimerRuleMatcher>(timer, now);
-          epgMapEntry.second.emplace_back(matcher);
-        }
-      }
+      // match any channel
+      const std::vector<std::shared_ptr<CPVREpg>> epgs = CServiceBroker::GetPVRManager().EpgContainer().GetAllEpgs();
+      for (const auto& epg : epgs)
+        MatchEpgTags(matcher, epg->GetTags(), matches);
     }
+
+    return matches;
   }
 } // unnamed namespace
 
@@ -472,10 +465,9 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
 {
   std::vector<std::shared_ptr<CPVRTimerInfoTag>> timersToReinsert;
   std::vector<std::pair<std::shared_ptr<CPVRTimerInfoTag>, std::shared_ptr<CPVRTimerInfoTag>>> childTimersToInsert;
+  std::vector<std::shared_ptr<CPVRTimerInfoTag>> reminderRules;
   bool bChanged = false;
   const CDateTime now = CDateTime::GetUTCDateTime();
-  bool bFetchedAllEpgs = false;
-  std::map<std::shared_ptr<CPVREpg>, std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>> epgMap;
 
   CSingleLock lock(m_critSection);
 
@@ -554,7 +546,7 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
           if (timer->IsEpgBased())
           {
             if (m_bReminderRulesUpdatePending)
-              AddTimerRuleToEpgMap(timer, now, epgMap, bFetchedAllEpgs);
+              reminderRules.emplace_back(timer);
           }
           else
           {
@@ -610,28 +602,8 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
   }
 
   // create new children of local epg-based reminder timer rules
-  for (const auto& epgMapEntry : epgMap)
-  {
-    const auto epgTags = epgMapEntry.first->GetTags();
-    for (const auto& epgTag : epgTags)
-    {
-      if (GetTimerForEpgTag(epgTag))
-        continue;
-
-      for (const auto& matcher : epgMapEntry.second)
-      {
-        if (!matcher->Matches(epgTag))
-          continue;
-
-        const std::shared_ptr<CPVRTimerInfoTag> childTimer = CPVRTimerInfoTag::CreateReminderFromEpg(epgTag, matcher->GetTimerRule());
-        if (childTimer)
-        {
-          bChanged = true;
-          childTimersToInsert.emplace_back(std::make_pair(matcher->GetTimerRule(), childTimer)); // remember and insert/save later
-        }
-      }
-    }
-  }
+  if (m_bReminderRulesUpdatePending)
+    bChanged |= CreateReminderRuleChildren(reminderRules, now, childTimersToInsert);
 
   // reinsert timers with changed timer start
   for (const auto& timer : timersToReinsert)
@@ -658,6 +630,82 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
   return bChanged;
 }
 
+bool CPVRTimers::CreateReminderRuleChildren(
+  const std::vector<std::shared_ptr<CPVRTimerInfoTag>>& reminderRules,
+  const CDateTime& now,
+  std::vector<std::pair<std::shared_ptr<CPVRTimerInfoTag>, std::shared_ptr<CPVRTimerInfoTag>>>& childTimersToInsert)
+{
+  bool bChanged = false;
+
+  // rules already checked by the last run only need to be matched against the tags changed since then
+  CPVRTimerRuleIndex newRules;
+  CPVRTimerRuleIndex checkedRules;
+  std::set<std::shared_ptr<CPVRTimerInfoTag>> rules;
+  for (const auto& rule : reminderRules)
+  {
+    const std::shared_ptr<CPVRTimerRuleMatcher> matcher = std::make_shared<CPVRTimerRuleMatcher>(rule, now);
+    if (m_checkedReminderRules.find(rule) == m_checkedReminderRules.end())
+      newRules.Add(matcher);
+    else
+      checkedRules.Add(matcher);
+
+    rules.insert(rule);
+  }
+
+  const unsigned int iTagChangeSerial = CPVREpg::GetTagChangeSerial();
+  std::vector<std::shared_ptr<CPVRTimerRuleMatcher>> matches;
+
+  const auto createChildren = [this, &newRules, &checkedRules, &matches, &bChanged, &childTimersToInsert](
+    const std::shared_ptr<CPVREpgInfoTag>& epgTag, const std::string* strPlot)
+  {
+    matches.clear();
+    newRules.GetMatches(epgTag, matches, strPlot);
+    if (epgTag->ChangeSerial() > m_iReminderRulesTagSerial)
+      checkedRules.GetMatches(epgTag, matches, strPlot);
+
+    if (matches.empty() || GetTimerForEpgTag(epgTag))
+      return;
+
+    for (const auto& matcher : matches)
+    {
+      const std::shared_ptr<CPVRTimerInfoTag> childTimer = CPVRTimerInfoTag::CreateReminderFromEpg(epgTag, matcher->GetTimerRule());
+      if (childTimer)
+      {
+        bChanged = true;
+        childTimersToInsert.emplace_back(std::make_pair(matcher->GetTimerRule(), childTimer)); // remember and insert/save later
+      }
+    }
+  };
+
+  // full-text rules search the plots, read those released by lazy loading with one query per batch, not one per tag
+  const bool bReadPlots = newRules.HasFullTextRules() || checkedRules.HasFullTextRules();
+
+  const std::vector<std::shared_ptr<CPVREpg>> epgs = CServiceBroker::GetPVRManager().EpgContainer().GetAllEpgs();
+  for (const auto& epg : epgs)
+  {
+    const std::vector<std::shared_ptr<CPVREpgInfoTag>> epgTags = newRules.IsEmpty()
+                                                                 ? epg->GetTagsChangedSince(m_iReminderRulesTagSerial)
+                                                                 : epg->GetTags();
+    if (bReadPlots)
+    {
+      CPVREpgInfoTag::ForEachPlot(epgTags, [&createChildren](const std::shared_ptr<CPVREpgInfoTag>& epgTag, const std::string& strPlot)
+      {
+        createChildren(epgTag, &strPlot);
+      });
+    }
+    else
+    {
+      for (const auto& epgTag : epgTags)
+        createChildren(epgTag, nullptr);
+    }
+  }
+
+  m_checkedReminderRules.swap(rules);
+  m_iReminderRulesTagSerial = iTagChangeSerial;
+
+  return bChanged;
+}
+
 std::shared_ptr<CPVRTimerInfoTag> CPVRTimers::GetNextReminderToAnnnounce()
 {
   std::shared_ptr<CPVRTimerInfoTag> ret;
@@ -902,6 +950,10 @@ std::shared_ptr<CPVRTimerInfoTag> CPVRTimers::UpdateEntry(const std::shared_ptr<
     {
       InsertEntry(tag);
     }
+
+    // rules are updated in place, an edited reminder rule must be matched against all EPG tags again
+    if (bChanged && m_checkedReminderRules.erase(tag) > 0)
+      m_bReminderRulesUpdatePending = true;
   }
   else
   {
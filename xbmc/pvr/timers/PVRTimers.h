@@ -17,6 +17,8 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <set>
+#include <utility>
 #include <vector>
 
 namespace PVR
@@ -266,6 +268,19 @@ namespace PVR
     bool UpdateEntries(int iMaxNotificationDelay);
     std::shared_ptr<CPVRTimerInfoTag> UpdateEntry(const std::shared_ptr<CPVRTimerInfoTag>& timer);
 
+    /*!
+     * @brief Create the children of local epg-based reminder rules for the EPG tags matching the rules.
+     * Rules that were checked before are only matched against the EPG tags changed since the last check.
+     * @param reminderRules The active epg-based reminder rules.
+     * @param now The current time.
+     * @param childTimersToInsert The new children and their rules are appended to this.
+     * @return True if any child was created, false otherwise.
+     */
+    bool CreateReminderRuleChildren(
+      const std::vector<std::shared_ptr<CPVRTimerInfoTag>>& reminderRules,
+      const CDateTime& now,
+      std::vector<std::pair<std::shared_ptr<CPVRTimerInfoTag>, std::shared_ptr<CPVRTimerInfoTag>>>& childTimersToInsert);
+
     bool AddLocalTimer(const std::shared_ptr<CPVRTimerInfoTag>& tag, bool bNotify);
     bool DeleteLocalTimer(const std::shared_ptr<CPVRTimerInfoTag>& tag, bool bNotify);
     bool RenameLocalTimer(const std::shared_ptr<CPVRTimerInfoTag>& tag, const std::string& strNewName);
@@ -292,5 +307,7 @@ namespace PVR
     CPVRSettings m_settings;
     std::queue<std::shared_ptr<CPVRTimerInfoTag>> m_remindersToAnnounce;
     bool m_bReminderRulesUpdatePending = false;
+    std::set<std::shared_ptr<CPVRTimerInfoTag>> m_checkedReminderRules; /*!< the reminder rules checked against all EPG tags, since they were last changed */
+    unsigned int m_iReminderRulesTagSerial = 0; /*!< the EPG tag change serial of the last reminder rules check */
   };
 }
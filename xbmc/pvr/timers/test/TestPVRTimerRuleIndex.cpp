@@ -0,0 +1,161 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XBDateTime.h"
+#include "addons/kodi-addon-dev-kit/include/kodi/xbmc_pvr_types.h"
+#include "pvr/epg/EpgChannelData.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/timers/PVRTimerRuleIndex.h"
+#include "pvr/timers/PVRTimerRuleMatcher.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+  const time_t MONDAY_NOON = 1546862400; // 2019-01-07 12:00 UTC
+
+  // Stands in for a timer rule. Matches every tag it is evaluated for and counts the evaluations.
+  class TestRule : public CPVRTimerRuleMatcher
+  {
+  public:
+    TestRule(const std::string& strSearch, bool bFullText,
+             unsigned int iWeekdays = PVR_WEEKDAY_ALLDAYS, int iClientChannelUid = PVR_CHANNEL_INVALID_UID)
+    : CPVRTimerRuleMatcher(nullptr, CDateTime(MONDAY_NOON - 7 * 24 * 3600)),
+      m_strSearch(strSearch),
+      m_bFullText(bFullText),
+      m_iWeekdays(iWeekdays),
+      m_iClientChannelUid(iClientChannelUid)
+    {
+    }
+
+    bool Matches(const std::shared_ptr<CPVREpgInfoTag>& epgTag, const std::string* strPlot) const override
+    {
+      m_iEvaluated++;
+      return true;
+    }
+
+    bool MatchesAnyChannel() const override { return m_iClientChannelUid == PVR_CHANNEL_INVALID_UID; }
+    unsigned int GetWeekdays() const override { return m_iWeekdays; }
+    bool IsFullTextSearch() const override { return m_bFullText; }
+    std::pair<int, int> GetClientChannel() const override { return std::make_pair(1, m_iClientChannelUid); }
+    std::string GetSearchLiteral() const override { return m_strSearch; }
+
+    mutable int m_iEvaluated = 0;
+
+  private:
+    std::string m_strSearch;
+    bool m_bFullText;
+    unsigned int m_iWeekdays;
+    int m_iClientChannelUid;
+  };
+
+  std::shared_ptr<CPVREpgInfoTag> CreateTag(int iClientChannelUid, const char* strTitle, const char* strPlot)
+  {
+    const auto channelData = std::make_shared<CPVREpgChannelData>(1, iClientChannelUid);
+    EPG_TAG data = {};
+    data.iUniqueBroadcastId = 1;
+    data.iUniqueChannelId = iClientChannelUid;
+    data.startTime = MONDAY_NOON;
+    data.endTime = MONDAY_NOON + 1800;
+    data.strTitle = strTitle;
+    data.strPlot = strPlot;
+    return std::make_shared<CPVREpgInfoTag>(data, 1, channelData, 1);
+  }
+
+  std::vector<std::shared_ptr<CPVRTimerRuleMatcher>> GetMatches(const CPVRTimerRuleIndex& index,
+                                                                const std::shared_ptr<CPVREpgInfoTag>& epgTag)
+  {
+    std::vector<std::shared_ptr<CPVRTimerRuleMatcher>> matches;
+    index.GetMatches(epgTag, matches);
+    return matches;
+  }
+}
+
+TEST(TestPVRTimerRuleIndex, Empty)
+{
+  CPVRTimerRuleIndex index;
+  EXPECT_TRUE(index.IsEmpty());
+  EXPECT_TRUE(GetMatches(index, CreateTag(1, "News", "")).empty());
+
+  index.Add(std::make_shared<TestRule>("", false));
+  EXPECT_FALSE(index.IsEmpty());
+}
+
+TEST(TestPVRTimerRuleIndex, ChannelAndWeekday)
+{
+  const auto anyChannel = std::make_shared<TestRule>("", false);
+  const auto otherChannel = std::make_shared<TestRule>("", false, PVR_WEEKDAY_ALLDAYS, 2);
+  const auto sameChannel = std::make_shared<TestRule>("", false, PVR_WEEKDAY_ALLDAYS, 1);
+  const auto tuesday = std::make_shared<TestRule>("", false, PVR_WEEKDAY_TUESDAY);
+
+  CPVRTimerRuleIndex index;
+  index.Add(anyChannel);
+  index.Add(otherChannel);
+  index.Add(sameChannel);
+  index.Add(tuesday);
+
+  const auto matches = GetMatches(index, CreateTag(1, "News", ""));
+  ASSERT_EQ(2u, matches.size());
+  EXPECT_EQ(anyChannel, matches[0]);
+  EXPECT_EQ(sameChannel, matches[1]);
+
+  // rules of other channels and weekdays aren't evaluated at all
+  EXPECT_EQ(0, otherChannel->m_iEvaluated);
+  EXPECT_EQ(0, tuesday->m_iEvaluated);
+}
+
+TEST(TestPVRTimerRuleIndex, SearchText)
+{
+  const auto title = std::make_shared<TestRule>("news", false);
+  const auto titleOnly = std::make_shared<TestRule>("weather", false);
+  const auto fullText = std::make_shared<TestRule>("weather", true);
+  const auto regex = std::make_shared<TestRule>("", false);
+
+  CPVRTimerRuleIndex index;
+  index.Add(title);
+  index.Add(titleOnly);
+  index.Add(fullText);
+  index.Add(regex);
+
+  const auto matches = GetMatches(index, CreateTag(1, "Evening NEWS", "Followed by the weather."));
+  ASSERT_EQ(3u, matches.size());
+  EXPECT_EQ(title, matches[0]);
+  EXPECT_EQ(fullText, matches[1]);
+  EXPECT_EQ(regex, matches[2]);
+
+  // rules whose text doesn't occur in the tag aren't evaluated, those without a plain text always are
+  EXPECT_EQ(0, titleOnly->m_iEvaluated);
+  EXPECT_EQ(1, regex->m_iEvaluated);
+}
+
+TEST(TestPVRTimerRuleIndex, GivenPlot)
+{
+  const auto fullText = std::make_shared<TestRule>("weather", true);
+
+  CPVRTimerRuleIndex index;
+  index.Add(fullText);
+  EXPECT_TRUE(index.HasFullTextRules());
+
+  // a plot read by the caller, e.g. in a batch, is searched instead of the tag's
+  const auto epgTag = CreateTag(1, "Evening News", "");
+  std::vector<std::shared_ptr<CPVRTimerRuleMatcher>> matches;
+  index.GetMatches(epgTag, matches);
+  EXPECT_TRUE(matches.empty());
+
+  const std::string strPlot = "Followed by the weather.";
+  index.GetMatches(epgTag, matches, &strPlot);
+  ASSERT_EQ(1u, matches.size());
+  EXPECT_EQ(fullText, matches[0]);
+}
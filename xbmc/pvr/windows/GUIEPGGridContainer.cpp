@@ -146,7 +146,7 @@ CGUIEPGGridContainer::CGUIEPGGridContainer(const CGUIEPGGridContainer &other)
   m_channelScrollOffset(other.m_channelScrollOffset),
   m_gridModel(new CGUIEPGGridContainerModel(*other.m_gridModel)),
   m_updatedGridModel(other.m_updatedGridModel ? new CGUIEPGGridContainerModel(*other.m_updatedGridModel) : nullptr),
-  m_item(GetItem(m_channelCursor)) // pointer to grid model internal data.
+  m_item(GetItem(m_channelCursor)) // grid model internal data.
 {
 }
 
@@ -701,11 +701,11 @@ void CGUIEPGGridContainer::UpdateItems()
     }
     else // "gap" tag selected
     {
-      const GridItem *currItem(GetItem(m_channelCursor));
+      const std::shared_ptr<GridItem> currItem(GetItem(m_channelCursor));
       if (currItem)
         channelUid = currItem->item->GetEPGInfoTag()->UniqueChannelID();
 
-      const GridItem *prevItem(GetPrevItem(m_channelCursor));
+      const std::shared_ptr<GridItem> prevItem(GetPrevItem(m_channelCursor));
       if (prevItem)
       {
         const CPVREpgInfoTagPtr tag(prevItem->item->GetEPGInfoTag());
@@ -1403,7 +1403,7 @@ int CGUIEPGGridContainer::GetRealBlock(const CGUIListItemPtr &item, int channel)
   return block;
 }
 
-GridItem *CGUIEPGGridContainer::GetNextItem(int channel)
+std::shared_ptr<GridItem> CGUIEPGGridContainer::GetNextItem(int channel)
 {
   const int channelIndex = channel + m_channelOffset;
   const int blockIndex = m_blockCursor + m_blockOffset;
@@ -1420,7 +1420,7 @@ GridItem *CGUIEPGGridContainer::GetNextItem(int channel)
   return m_gridModel->GetGridItemPtr(channelIndex, i + m_blockOffset);
 }
 
-GridItem *CGUIEPGGridContainer::GetPrevItem(int channel)
+std::shared_ptr<GridItem> CGUIEPGGridContainer::GetPrevItem(int channel)
 {
   int channelIndex = channel + m_channelOffset;
   int blockIndex = m_blockCursor + m_blockOffset;
@@ -1435,7 +1435,7 @@ GridItem *CGUIEPGGridContainer::GetPrevItem(int channel)
   return m_gridModel->GetGridItemPtr(channelIndex, i + m_blockOffset);
 }
 
-GridItem *CGUIEPGGridContainer::GetItem(int channel)
+std::shared_ptr<GridItem> CGUIEPGGridContainer::GetItem(int channel)
 {
   int channelIndex = channel + m_channelOffset;
   int blockIndex = m_blockCursor + m_blockOffset;
@@ -1713,6 +1713,8 @@ void CGUIEPGGridContainer::GoToMostRight()
 
 void CGUIEPGGridContainer::SetTimelineItems(const std::unique_ptr<CFileItemList> &items, const CDateTime &gridStart, const CDateTime &gridEnd)
 {
+  std::unique_ptr<CGUIEPGGridContainerModel> oldUpdatedGridModel;
+  std::unique_ptr<CGUIEPGGridContainerModel> newUpdatedGridModel(new CGUIEPGGridContainerModel);
   int iRulerUnit;
   int iBlocksPerPage;
   float fBlockSize;
@@ -1723,10 +1725,11 @@ void CGUIEPGGridContainer::SetTimelineItems(const std::unique_ptr<CFileItemList>
     iRulerUnit = m_rulerUnit;
     iBlocksPerPage = m_blocksPerPage;
     fBlockSize = m_blockSize;
+
+    // only channels with changed programmes need new rows.
+    newUpdatedGridModel->ReuseGridRows(m_updatedGridModel ? *m_updatedGridModel : *m_gridModel);
   }
 
-  std::unique_ptr<CGUIEPGGridContainerModel> oldUpdatedGridModel;
-  std::unique_ptr<CGUIEPGGridContainerModel> newUpdatedGridModel(new CGUIEPGGridContainerModel);
   // can be very expensive. never call with lock acquired.
   newUpdatedGridModel->Initialize(items, gridStart, gridEnd, iRulerUnit, iBlocksPerPage, fBlockSize);
 
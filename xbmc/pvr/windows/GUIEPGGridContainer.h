@@ -118,9 +118,9 @@ namespace PVR
     void ValidateOffset();
     void UpdateLayout();
 
-    GridItem *GetItem(int channel);
-    GridItem *GetNextItem(int channel);
-    GridItem *GetPrevItem(int channel);
+    std::shared_ptr<GridItem> GetItem(int channel);
+    std::shared_ptr<GridItem> GetNextItem(int channel);
+    std::shared_ptr<GridItem> GetPrevItem(int channel);
 
     int GetBlock(const CGUIListItemPtr &item, int channel);
     int GetRealBlock(const CGUIListItemPtr &item, int channel);
@@ -238,6 +238,6 @@ namespace PVR
     std::unique_ptr<CGUIEPGGridContainerModel> m_gridModel;
     std::unique_ptr<CGUIEPGGridContainerModel> m_updatedGridModel;
 
-    GridItem *m_item;
+    std::shared_ptr<GridItem> m_item;
   };
 }
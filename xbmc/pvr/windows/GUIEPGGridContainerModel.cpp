@@ -19,14 +19,36 @@
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <cmath>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 using namespace PVR;
 
 static const unsigned int GRID_START_PADDING = 30; // minutes
 
+CGUIEPGGridContainerModel::CGUIEPGGridContainerModel(const CGUIEPGGridContainerModel &other)
+  : m_gridStart(other.m_gridStart),
+    m_gridEnd(other.m_gridEnd),
+    m_programmeItems(other.m_programmeItems),
+    m_channelItems(other.m_channelItems),
+    m_rulerItems(other.m_rulerItems),
+    m_epgItemsPtr(other.m_epgItemsPtr),
+    m_gridRows(other.m_gridRows),
+    m_gridCells(other.m_gridCells.size()), // cells hold the widths of this model, create them again
+    m_blocks(other.m_blocks),
+    m_blockSize(other.m_blockSize)
+{
+}
+
+void CGUIEPGGridContainerModel::ReuseGridRows(const CGUIEPGGridContainerModel &previous)
+{
+  m_gridRows = previous.m_gridRows;
+}
+
 void CGUIEPGGridContainerModel::SetInvalid()
 {
   for (const auto &programme : m_programmeItems)
@@ -148,7 +170,6 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>
 
   ////////////////////////////////////////////////////////////////////////
   // Create epg grid
-  const CDateTimeSpan blockDuration(0, 0, MINSPERBLOCK, 0);
   const CDateTimeSpan gridDuration(m_gridEnd - m_gridStart);
   m_blocks = (gridDuration.GetDays() * 24 * 60 + gridDuration.GetHours() * 60 + gridDuration.GetMinutes()) / MINSPERBLOCK;
   if (m_blocks >= MAXBLOCKS)
@@ -156,113 +177,205 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>
   else if (m_blocks < iBlocksPerPage)
     m_blocks = iBlocksPerPage;
 
-  m_gridIndex.reserve(m_channelItems.size());
-  const std::vector<GridItem> blocks(m_blocks);
+  m_blockSize = fBlockSize;
 
+  std::map<std::pair<int, int>, std::shared_ptr<const GridRow>> previousRows;
+  for (const auto &row : m_gridRows)
+    previousRows.insert(std::make_pair(std::make_pair(row->iClientUid, row->iChannelUid), row));
+
+  m_gridRows.clear();
+  m_gridRows.reserve(m_channelItems.size());
+  m_gridCells.clear();
+  m_gridCells.resize(m_channelItems.size());
+
+  int iReusedRows = 0;
   for (size_t channel = 0; channel < m_channelItems.size(); ++channel)
   {
-    m_gridIndex.emplace_back(blocks);
-
-    CDateTime gridCursor(m_gridStart); //reset cursor for new channel
-    unsigned long progIdx = m_epgItemsPtr[channel].start;
-    unsigned long lastIdx = m_epgItemsPtr[channel].stop;
-    int iEpgId            = m_programmeItems[progIdx]->GetEPGInfoTag()->EpgID();
-    int itemSize          = 1; // size of the programme in blocks
-    int savedBlock        = 0;
-    CFileItemPtr item;
-    CPVREpgInfoTagPtr tag;
-
-    for (int block = 0; block < m_blocks; ++block)
+    std::shared_ptr<const GridRow> row = CreateGridRow(channel);
+
+    const auto it = previousRows.find(std::make_pair(row->iClientUid, row->iChannelUid));
+    if (it != previousRows.end() && CanReuseGridRow(*it->second, *row))
     {
-      while (progIdx <= lastIdx)
-      {
-        item = m_programmeItems[progIdx];
-        tag = item->GetEPGInfoTag();
+      // keep the items of unchanged channels, along with their layouts
+      row = it->second;
+      std::copy(row->programmes.begin(), row->programmes.end(), m_programmeItems.begin() + m_epgItemsPtr[channel].start);
+      iReusedRows++;
+    }
 
-        // Note: Start block of an event is start-time-based calculated block + 1,
-        //       unless start times matches exactly the begin of a block.
+    m_gridRows.emplace_back(row);
+  }
 
-        if (tag->EpgID() != iEpgId || gridCursor < tag->StartAsUTC() || m_gridEnd <= tag->StartAsUTC())
-          break;
+  if (!previousRows.empty())
+    CLog::LogF(LOGDEBUG, "Reused %d of %d channels", iReusedRows, static_cast<int>(m_gridRows.size()));
+}
 
-        if (gridCursor < tag->EndAsUTC())
-        {
-          m_gridIndex[channel][block].item = item;
-          m_gridIndex[channel][block].progIndex = progIdx;
-          break;
-        }
+std::shared_ptr<const CGUIEPGGridContainerModel::GridRow> CGUIEPGGridContainerModel::CreateGridRow(int iChannel) const
+{
+  const std::shared_ptr<CPVRChannel> channel = m_channelItems[iChannel]->GetPVRChannelInfoTag();
 
-        progIdx++;
-      }
+  const std::shared_ptr<GridRow> row = std::make_shared<GridRow>();
+  row->iChannelUid = channel->UniqueID();
+  row->iClientUid = channel->ClientID();
+  row->gridStart = m_gridStart;
+  row->blocks = m_blocks;
+  row->programmes.assign(m_programmeItems.begin() + m_epgItemsPtr[iChannel].start,
+                         m_programmeItems.begin() + m_epgItemsPtr[iChannel].stop + 1);
+
+  const int iEpgId = row->programmes.front()->GetEPGInfoTag()->EpgID();
+  int nextBlock = 0;
+  for (size_t i = 0; i < row->programmes.size() && nextBlock < m_blocks; ++i)
+  {
+    const std::shared_ptr<CPVREpgInfoTag> tag = row->programmes[i]->GetEPGInfoTag();
 
-      gridCursor += blockDuration;
+    if (tag->EpgID() != iEpgId || m_gridEnd <= tag->StartAsUTC())
+      break;
 
-      if (block == 0)
-        continue;
+    if (!tag->StartAsUTC().IsValid() || !tag->EndAsUTC().IsValid())
+      continue;
 
-      const CFileItemPtr prevItem(m_gridIndex[channel][block - 1].item);
-      const CFileItemPtr currItem(m_gridIndex[channel][block].item);
+    // Note: Start block of an event is start-time-based calculated block + 1,
+    //       unless start times matches exactly the begin of a block.
+    //       Overlapping events start after the end of the previous event.
+    const int startBlock = std::max(nextBlock, GetFirstBlockAtOrAfter(tag->StartAsUTC()));
+    const int endBlock = std::min(m_blocks, GetFirstBlockAtOrAfter(tag->EndAsUTC())) - 1;
+    if (startBlock > endBlock)
+      continue;
 
-      if (block == m_blocks - 1 || prevItem != currItem)
-      {
-        // special handling for last block.
-        int blockDelta = -1;
-        int sizeDelta = 0;
-        if (block == m_blocks - 1 && prevItem == currItem)
-        {
-          itemSize++;
-          blockDelta = 0;
-          sizeDelta = 1;
-        }
-
-        if (prevItem)
-        {
-          m_gridIndex[channel][savedBlock].item->SetProperty("GenreType", prevItem->GetEPGInfoTag()->GenreType());
-        }
-        else
-        {
-          const std::shared_ptr<CFileItem> gapItem = CreateGapItem(channel);
-          for (int i = block + blockDelta; i >= block - itemSize + sizeDelta; --i)
-          {
-            m_gridIndex[channel][i].item = gapItem;
-          }
-        }
-
-        float fItemWidth = itemSize * fBlockSize;
-        m_gridIndex[channel][savedBlock].originWidth = fItemWidth;
-        m_gridIndex[channel][savedBlock].width = fItemWidth;
-
-        itemSize = 1;
-        savedBlock = block;
-
-        // special handling for last block.
-        if (block == m_blocks - 1 && prevItem != currItem)
-        {
-          if (currItem)
-          {
-            m_gridIndex[channel][savedBlock].item->SetProperty("GenreType", currItem->GetEPGInfoTag()->GenreType());
-          }
-          else
-          {
-            m_gridIndex[channel][block].item = CreateGapItem(channel);
-          }
-
-          m_gridIndex[channel][savedBlock].originWidth = fBlockSize; // size always 1 block here
-          m_gridIndex[channel][savedBlock].width = fBlockSize;
-        }
-      }
-      else
-      {
-        itemSize++;
-      }
+    if (startBlock > nextBlock)
+      row->ranges.emplace_back(GridRange{nextBlock, startBlock - 1, -1, CreateGapItem(iChannel)});
+
+    row->ranges.emplace_back(GridRange{startBlock, endBlock, static_cast<int>(i), row->programmes[i]});
+    nextBlock = endBlock + 1;
+  }
+
+  if (nextBlock < m_blocks)
+    row->ranges.emplace_back(GridRange{nextBlock, m_blocks - 1, -1, CreateGapItem(iChannel)});
+
+  return row;
+}
+
+bool CGUIEPGGridContainerModel::CanReuseGridRow(const GridRow &oldRow, const GridRow &newRow) const
+{
+  if (oldRow.gridStart != newRow.gridStart ||
+      oldRow.blocks != newRow.blocks ||
+      oldRow.programmes.size() != newRow.programmes.size() ||
+      oldRow.ranges.size() != newRow.ranges.size())
+    return false;
+
+  // epg tags are updated in place, compare what the items took from them
+  for (size_t i = 0; i < oldRow.programmes.size(); ++i)
+  {
+    const std::shared_ptr<CFileItem> &oldItem = oldRow.programmes[i];
+    const std::shared_ptr<CFileItem> &newItem = newRow.programmes[i];
+    if (oldItem->GetEPGInfoTag() != newItem->GetEPGInfoTag() ||
+        oldItem->GetLabel() != newItem->GetLabel() ||
+        oldItem->GetIconImage() != newItem->GetIconImage())
+      return false;
+  }
+
+  for (size_t i = 0; i < oldRow.ranges.size(); ++i)
+  {
+    if (oldRow.ranges[i].startBlock != newRow.ranges[i].startBlock ||
+        oldRow.ranges[i].endBlock != newRow.ranges[i].endBlock ||
+        oldRow.ranges[i].progOffset != newRow.ranges[i].progOffset)
+      return false;
+  }
+
+  return true;
+}
+
+int CGUIEPGGridContainerModel::GetFirstBlockAtOrAfter(const CDateTime &datetime) const
+{
+  if (datetime <= m_gridStart)
+    return 0;
+
+  const int blockSeconds = MINSPERBLOCK * 60;
+  return ((datetime - m_gridStart).GetSecondsTotal() + blockSeconds - 1) / blockSeconds;
+}
+
+int CGUIEPGGridContainerModel::GetRangeIndex(int iChannel, int iBlock) const
+{
+  const std::vector<GridRange> &ranges = m_gridRows[iChannel]->ranges;
+  const auto it = std::upper_bound(ranges.begin(), ranges.end(), iBlock,
+                                   [](int block, const GridRange &range) { return block < range.startBlock; });
+  return static_cast<int>(it - ranges.begin()) - 1;
+}
+
+std::shared_ptr<GridItem> CGUIEPGGridContainerModel::GetGridItemPtr(int iChannel, int iBlock)
+{
+  const int iRange = GetRangeIndex(iChannel, iBlock);
+  if (iRange < 0)
+    return {};
+
+  std::shared_ptr<GridItem> &cell = m_gridCells[iChannel][iRange];
+  if (!cell)
+  {
+    const GridRange &range = m_gridRows[iChannel]->ranges[iRange];
+    cell = std::make_shared<GridItem>();
+    cell->item = range.item;
+    cell->originWidth = (range.endBlock - range.startBlock + 1) * m_blockSize;
+    cell->width = cell->originWidth;
+    if (range.progOffset >= 0)
+    {
+      cell->progIndex = m_epgItemsPtr[iChannel].start + range.progOffset;
+      cell->item->SetProperty("GenreType", cell->item->GetEPGInfoTag()->GenreType());
     }
   }
+  return cell;
 }
 
-void CGUIEPGGridContainerModel::FindChannelAndBlockIndex(int channelUid, unsigned int broadcastUid, int eventOffset, int &newChannelIndex, int &newBlockIndex) const
+std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetGridItem(int iChannel, int iBlock) const
+{
+  const int iRange = GetRangeIndex(iChannel, iBlock);
+  if (iRange < 0)
+    return {};
+
+  return m_gridRows[iChannel]->ranges[iRange].item;
+}
+
+float CGUIEPGGridContainerModel::GetGridItemWidth(int iChannel, int iBlock) const
+{
+  const int iRange = GetRangeIndex(iChannel, iBlock);
+  if (iRange < 0)
+    return 0.0f;
+
+  const auto it = m_gridCells[iChannel].find(iRange);
+  if (it != m_gridCells[iChannel].end())
+    return it->second->width;
+
+  const GridRange &range = m_gridRows[iChannel]->ranges[iRange];
+  return (range.endBlock - range.startBlock + 1) * m_blockSize;
+}
+
+float CGUIEPGGridContainerModel::GetGridItemOriginWidth(int iChannel, int iBlock) const
+{
+  const int iRange = GetRangeIndex(iChannel, iBlock);
+  if (iRange < 0)
+    return 0.0f;
+
+  const GridRange &range = m_gridRows[iChannel]->ranges[iRange];
+  return (range.endBlock - range.startBlock + 1) * m_blockSize;
+}
+
+int CGUIEPGGridContainerModel::GetGridItemIndex(int iChannel, int iBlock) const
+{
+  const int iRange = GetRangeIndex(iChannel, iBlock);
+  if (iRange < 0)
+    return -1;
+
+  const GridRange &range = m_gridRows[iChannel]->ranges[iRange];
+  return range.progOffset < 0 ? -1 : m_epgItemsPtr[iChannel].start + range.progOffset;
+}
+
+void CGUIEPGGridContainerModel::SetGridItemWidth(int iChannel, int iBlock, float fWidth)
 {
-  const CDateTimeSpan blockDuration(0, 0, MINSPERBLOCK, 0);
+  const std::shared_ptr<GridItem> cell = GetGridItemPtr(iChannel, iBlock);
+  if (cell)
+    cell->width = fWidth;
+}
 
+void CGUIEPGGridContainerModel::FindChannelAndBlockIndex(int channelUid, unsigned int broadcastUid, int eventOffset, int &newChannelIndex, int &newBlockIndex) const
+{
   newChannelIndex = INVALID_INDEX;
   newBlockIndex = INVALID_INDEX;
 
@@ -278,35 +391,16 @@ void CGUIEPGGridContainerModel::FindChannelAndBlockIndex(int channelUid, unsigne
     iCurrentChannel++;
   }
 
-  if (newChannelIndex != INVALID_INDEX)
+  if (newChannelIndex != INVALID_INDEX && broadcastUid > 0)
   {
     // find the block
-    CDateTime gridCursor(m_gridStart); //reset cursor for new channel
-    unsigned long progIdx = m_epgItemsPtr[newChannelIndex].start;
-    unsigned long lastIdx = m_epgItemsPtr[newChannelIndex].stop;
-    int iEpgId = m_programmeItems[progIdx]->GetEPGInfoTag()->EpgID();
-    CPVREpgInfoTagPtr tag;
-    for (int block = 0; block < m_blocks; ++block)
+    for (const auto &range : m_gridRows[newChannelIndex]->ranges)
     {
-      while (progIdx <= lastIdx)
+      if (range.progOffset >= 0 && range.item->GetEPGInfoTag()->UniqueBroadcastID() == broadcastUid)
       {
-        tag = m_programmeItems[progIdx]->GetEPGInfoTag();
-
-        if (tag->EpgID() != iEpgId || gridCursor < tag->StartAsUTC() || m_gridEnd <= tag->StartAsUTC())
-          break; // next block
-
-        if (gridCursor < tag->EndAsUTC())
-        {
-          if (broadcastUid > 0 && tag->UniqueBroadcastID() == broadcastUid)
-          {
-            newBlockIndex = block + eventOffset;
-            return; // done.
-          }
-          break; // next block
-        }
-        progIdx++;
+        newBlockIndex = range.startBlock + eventOffset;
+        return; // done.
       }
-      gridCursor += blockDuration;
     }
   }
 }
@@ -327,55 +421,54 @@ void CGUIEPGGridContainerModel::FreeChannelMemory(int keepStart, int keepEnd)
   {
     // remove before keepStart and after keepEnd
     for (int i = 0; i < keepStart && i < ChannelItemsSize(); ++i)
+    {
       m_channelItems[i]->FreeMemory();
+      FreeGridCells(i);
+    }
     for (int i = keepEnd + 1; i < ChannelItemsSize(); ++i)
+    {
       m_channelItems[i]->FreeMemory();
+      FreeGridCells(i);
+    }
   }
   else
   {
     // wrapping
     for (int i = keepEnd + 1; i < keepStart && i < ChannelItemsSize(); ++i)
+    {
       m_channelItems[i]->FreeMemory();
+      FreeGridCells(i);
+    }
   }
 }
 
+void CGUIEPGGridContainerModel::FreeGridCells(int channel)
+{
+  if (channel >= static_cast<int>(m_gridCells.size()))
+    return;
+
+  for (const auto &cell : m_gridCells[channel])
+    cell.second->item->FreeMemory();
+  m_gridCells[channel].clear();
+}
+
 void CGUIEPGGridContainerModel::FreeProgrammeMemory(int channel, int keepStart, int keepEnd)
 {
-  if (keepStart < keepEnd)
+  if (keepStart < keepEnd && channel < static_cast<int>(m_gridCells.size()))
   {
-    // remove before keepStart and after keepEnd
-    if (keepStart > 0 && keepStart < m_blocks)
+    // only items of cells in view have layouts, drop the cells of items no longer (even partially) visible
+    const std::vector<GridRange> &ranges = m_gridRows[channel]->ranges;
+    auto &cells = m_gridCells[channel];
+    for (auto it = cells.begin(); it != cells.end();)
     {
-      // if item exist and block is not part of visible item
-      std::shared_ptr<CGUIListItem> last = m_gridIndex[channel][keepStart].item;
-      for (int i = keepStart - 1; i > 0; --i)
+      const GridRange &range = ranges[it->first];
+      if (range.endBlock < keepStart || range.startBlock > keepEnd)
       {
-        if (m_gridIndex[channel][i].item && m_gridIndex[channel][i].item != last)
-        {
-          m_gridIndex[channel][i].item->FreeMemory();
-          // FreeMemory() is smart enough to not cause any problems when called multiple times on same item
-          // but we can make use of condition needed to not call FreeMemory() on item that is partially visible
-          // to avoid calling FreeMemory() multiple times on item that occupy few blocks in a row
-          last = m_gridIndex[channel][i].item;
-        }
-      }
-    }
-
-    if (keepEnd > 0 && keepEnd < m_blocks)
-    {
-      std::shared_ptr<CGUIListItem> last = m_gridIndex[channel][keepEnd].item;
-      for (int i = keepEnd + 1; i < m_blocks; ++i)
-      {
-        // if item exist and block is not part of visible item
-        if (m_gridIndex[channel][i].item && m_gridIndex[channel][i].item != last)
-        {
-          m_gridIndex[channel][i].item->FreeMemory();
-          // FreeMemory() is smart enough to not cause any problems when called multiple times on same item
-          // but we can make use of condition needed to not call FreeMemory() on item that is partially visible
-          // to avoid calling FreeMemory() multiple times on item that occupy few blocks in a row
-          last = m_gridIndex[channel][i].item;
-        }
+        it->second->item->FreeMemory();
+        it = cells.erase(it);
       }
+      else
+        ++it;
     }
   }
 }
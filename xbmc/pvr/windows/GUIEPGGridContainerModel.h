@@ -12,6 +12,7 @@
 #include "pvr/PVRTypes.h"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 class CFileItem;
@@ -34,8 +35,16 @@ namespace PVR
     static const int MAXBLOCKS = 33 * 24 * 60 / MINSPERBLOCK; //! 33 days of 5 minute blocks (31 days for upcoming data + 1 day for past data + 1 day for fillers)
 
     CGUIEPGGridContainerModel() = default;
+    CGUIEPGGridContainerModel(const CGUIEPGGridContainerModel &other);
     virtual ~CGUIEPGGridContainerModel() = default;
 
+    /*!
+     \brief Take over the rows of a previous model. Initialize keeps the rows of all channels whose
+     programmes did not change, including their file items, instead of building them again.
+     \param previous the model to take the rows from
+     */
+    void ReuseGridRows(const CGUIEPGGridContainerModel &previous);
+
     void Initialize(const std::unique_ptr<CFileItemList> &items, const CDateTime &gridStart, const CDateTime &gridEnd, int iRulerUnit, int iBlocksPerPage, float fBlockSize);
     void SetInvalid();
 
@@ -58,13 +67,19 @@ namespace PVR
     int RulerItemsSize() const { return static_cast<int>(m_rulerItems.size()); }
 
     int GetBlockCount() const { return m_blocks; }
-    bool HasGridItems() const { return !m_gridIndex.empty(); }
-    GridItem *GetGridItemPtr(int iChannel, int iBlock) { return &m_gridIndex[iChannel][iBlock]; }
-    std::shared_ptr<CFileItem> GetGridItem(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].item; }
-    float GetGridItemWidth(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].width; }
-    float GetGridItemOriginWidth(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].originWidth; }
-    int GetGridItemIndex(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].progIndex; }
-    void SetGridItemWidth(int iChannel, int iBlock, float fWidth) { m_gridIndex[iChannel][iBlock].width = fWidth; }
+    bool HasGridItems() const { return !m_gridRows.empty(); }
+
+    /*!
+     \brief Get the grid cell of the programme or gap covering the given block, create it if needed.
+     All blocks of a programme share the same cell. Cells are dropped again by FreeChannelMemory and
+     FreeProgrammeMemory once they are out of view.
+     */
+    std::shared_ptr<GridItem> GetGridItemPtr(int iChannel, int iBlock);
+    std::shared_ptr<CFileItem> GetGridItem(int iChannel, int iBlock) const;
+    float GetGridItemWidth(int iChannel, int iBlock) const;
+    float GetGridItemOriginWidth(int iChannel, int iBlock) const;
+    int GetGridItemIndex(int iChannel, int iBlock) const;
+    void SetGridItemWidth(int iChannel, int iBlock, float fWidth);
 
     bool IsZeroGridDuration() const { return (m_gridEnd - m_gridStart) == CDateTimeSpan(0, 0, 0, 0); }
     const CDateTime &GetGridStart() const { return m_gridStart; }
@@ -89,6 +104,37 @@ namespace PVR
       long stop;
     };
 
+    /*!
+     \brief The blocks covered by a programme or by a gap between programmes
+     */
+    struct GridRange
+    {
+      int startBlock;
+      int endBlock;
+      int progOffset; ///< index relative to the first programme of the channel, -1 for gaps
+      std::shared_ptr<CFileItem> item;
+    };
+
+    /*!
+     \brief The programme boundaries of a channel, covering all blocks of the grid.
+     Rows are never changed once built and can be shared with the following model.
+     */
+    struct GridRow
+    {
+      int iChannelUid;
+      int iClientUid;
+      CDateTime gridStart;
+      int blocks;
+      std::vector<std::shared_ptr<CFileItem>> programmes;
+      std::vector<GridRange> ranges;
+    };
+
+    std::shared_ptr<const GridRow> CreateGridRow(int iChannel) const;
+    bool CanReuseGridRow(const GridRow &oldRow, const GridRow &newRow) const;
+    int GetRangeIndex(int iChannel, int iBlock) const;
+    int GetFirstBlockAtOrAfter(const CDateTime &datetime) const;
+    void FreeGridCells(int channel);
+
     CDateTime m_gridStart;
     CDateTime m_gridEnd;
 
@@ -96,8 +142,10 @@ namespace PVR
     std::vector<std::shared_ptr<CFileItem>> m_channelItems;
     std::vector<std::shared_ptr<CFileItem>> m_rulerItems;
     std::vector<ItemsPtr> m_epgItemsPtr;
-    std::vector<std::vector<GridItem> > m_gridIndex;
+    std::vector<std::shared_ptr<const GridRow>> m_gridRows;
+    std::vector<std::unordered_map<int, std::shared_ptr<GridItem>>> m_gridCells; ///< cells in view, by range index
 
     int m_blocks = 0;
+    float m_blockSize = 0.0f;
   };
 }
@@ -21,7 +21,6 @@
 #include "pvr/PVRItem.h"
 #include "pvr/PVRManager.h"
 #include "pvr/dialogs/GUIDialogPVRGuideSearch.h"
-#include "pvr/epg/EpgContainer.h"
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/epg/EpgSearchFilter.h"
 #include "pvr/recordings/PVRRecording.h"
@@ -29,7 +28,6 @@
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 
-#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -61,17 +59,8 @@ namespace
 
   void AsyncSearchAction::Run()
   {
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> results = CServiceBroker::GetPVRManager().EpgContainer().GetAllTags();
-    for (auto it = results.begin(); it != results.end();)
-    {
-      it = results.erase(std::remove_if(results.begin(),
-                                        results.end(),
-                                        [this](const std::shared_ptr<CPVREpgInfoTag>& entry)
-                                        {
-                                          return !m_filter->FilterEntry(entry);
-                                        }),
-                         results.end());
-    }
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> results = m_filter->GetCandidateTags();
+    m_filter->FilterEntries(results);
 
     if (m_filter->ShouldRemoveDuplicates())
       m_filter->RemoveDuplicates(results);
@@ -169,6 +169,8 @@ void CAdvancedSettings::Initialize()
   m_DXVACheckCompatibilityPresent = false;
   m_DXVAForceProcessorRenderer = true;
   m_videoFpsDetect = 1;
+  m_videoDemuxReadAheadPackets = 64;
+  m_videoFilterThreads = -1;
   m_maxTempo = 1.55f;
   m_videoPreferStereoStream = false;
 
@@ -342,6 +344,13 @@ void CAdvancedSettings::Initialize()
   m_bEpgDisplayUpdatePopup = true; /* Display a progress popup while updating EPG data from clients */
   m_bEpgDisplayIncrementalUpdatePopup = false; /* Display a progress popup while doing incremental EPG updates, but
                                                   only if 'displayupdatepopup' is also enabled. */
+  m_iEpgUpdateChannelsPerClient = 1; /* Fetch the EPG data of up to X channels of the same client at once. Clients are
+                                        always updated in parallel, increase this only for add-ons that can handle
+                                        concurrent requests. */
+  m_iEpgPersistBatchSize = 1000; /* Write the changed EPG tags of several tables in one transaction, commit after
+                                    about X tags. */
+  m_bEpgLazyLoadPlots = true; /* Keep plot and cast of EPG tags stored in the database only there and read them when
+                                 needed, instead of holding them in memory for the whole guide. */
 
   m_bEdlMergeShortCommBreaks = false;      // Off by default
   m_iEdlMaxCommBreakLength = 8 * 30 + 10;  // Just over 8 * 30 second commercial break.
@@ -398,6 +407,10 @@ void CAdvancedSettings::Initialize()
   m_iPVRNumericChannelSwitchTimeout = 2000;
   m_iPVRTimeshiftThreshold = 10;
   m_bPVRTimeshiftSimpleOSD = true;
+  m_bPVRPreloadChannelStreams = false;
+  m_bPVRBackgroundChannelSync = true;
+  m_iPVRTimeshiftBufferSize = 0;
+  m_pvrTimeshiftBufferClientSizes.clear();
 
   m_cacheMemSize = 1024 * 1024 * 20;
   m_cacheBufferMode = CACHE_BUFFER_MODE_INTERNET; // Default (buffer all internet streams/filesystems)
@@ -416,6 +429,11 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiSkinWindowCache = true;
+  m_guiFontPrewarmCharacters = 512;
+  m_guiVirtualListThreshold = 10000;
+  m_guiProfileConditions = false;
+  m_guiWindowPrepareBudget = 100;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -727,6 +745,10 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "allowdiscretedecoder", m_allowUseSeparateDeviceForDecoding);
     //0 = disable fps detect, 1 = only detect on timestamps with uniform spacing, 2 detect on all timestamps
     XMLUtils::GetInt(pElement, "fpsdetect", m_videoFpsDetect, 0, 2);
+    //number of packets the demuxer reads ahead on its own thread, 0 = read on the player thread
+    XMLUtils::GetInt(pElement, "demuxreadahead", m_videoDemuxReadAheadPackets, 0, 1024);
+    //software deinterlacing/scaling: -1 = own thread with auto slice threads, 0 = on decode thread, n = own thread with n slice threads
+    XMLUtils::GetInt(pElement, "filterthreads", m_videoFilterThreads, -1, 64);
     XMLUtils::GetFloat(pElement, "maxtempo", m_maxTempo, 1.5, 2.1);
     XMLUtils::GetBoolean(pElement, "preferstereostream", m_videoPreferStereoStream);
 
@@ -937,6 +959,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "updateemptytagsinterval", m_iEpgUpdateEmptyTagsInterval);
     XMLUtils::GetBoolean(pElement, "displayupdatepopup", m_bEpgDisplayUpdatePopup);
     XMLUtils::GetBoolean(pElement, "displayincrementalupdatepopup", m_bEpgDisplayIncrementalUpdatePopup);
+    XMLUtils::GetInt(pElement, "updatechannelsperclient", m_iEpgUpdateChannelsPerClient, 1, 32);
+    XMLUtils::GetInt(pElement, "persistbatchsize", m_iEpgPersistBatchSize, 1, 100000);
+    XMLUtils::GetBoolean(pElement, "lazyloadplots", m_bEpgLazyLoadPlots);
   }
 
   // EDL commercial break handling
@@ -1131,6 +1156,25 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pPVR, "numericchannelswitchtimeout", m_iPVRNumericChannelSwitchTimeout, 50, 60000);
     XMLUtils::GetInt(pPVR, "timeshiftthreshold", m_iPVRTimeshiftThreshold, 0, 60);
     XMLUtils::GetBoolean(pPVR, "timeshiftsimpleosd", m_bPVRTimeshiftSimpleOSD);
+    XMLUtils::GetBoolean(pPVR, "preloadchannelstreams", m_bPVRPreloadChannelStreams);
+    XMLUtils::GetBoolean(pPVR, "backgroundchannelsync", m_bPVRBackgroundChannelSync);
+
+    TiXmlElement* pTimeshiftBuffer = pPVR->FirstChildElement("timeshiftbuffer");
+    if (pTimeshiftBuffer)
+    {
+      XMLUtils::GetInt(pTimeshiftBuffer, "size", m_iPVRTimeshiftBufferSize, 0, 102400);
+
+      const TiXmlElement* pClient = pTimeshiftBuffer->FirstChildElement("client");
+      while (pClient)
+      {
+        const std::string strClientId = XMLUtils::GetAttribute(pClient, "id");
+        int iSize = 0;
+        if (!strClientId.empty() && pClient->QueryIntAttribute("size", &iSize) == TIXML_SUCCESS && iSize >= 0)
+          m_pvrTimeshiftBufferClientSizes[strClientId] = iSize;
+
+        pClient = pClient->NextSiblingElement("client");
+      }
+    }
   }
 
   TiXmlElement* pDatabase = pRootElement->FirstChildElement("videodatabase");
@@ -1231,6 +1275,11 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetBoolean(pElement, "skinwindowcache", m_guiSkinWindowCache);
+    XMLUtils::GetInt(pElement, "fontprewarmcharacters", m_guiFontPrewarmCharacters, 0, 8192);
+    XMLUtils::GetInt(pElement, "virtuallistthreshold", m_guiVirtualListThreshold, 0, INT_MAX);
+    XMLUtils::GetBoolean(pElement, "profileconditions", m_guiProfileConditions);
+    XMLUtils::GetInt(pElement, "windowpreparebudget", m_guiWindowPrepareBudget, -1, 10000);
   }
 
   std::string seekSteps;
@@ -12,6 +12,7 @@
 #include "settings/lib/ISettingCallback.h"
 #include "settings/lib/ISettingsHandler.h"
 
+#include <map>
 #include <set>
 #include <string>
 #include <utility>
@@ -179,6 +180,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_DXVACheckCompatibilityPresent;
     bool m_DXVAForceProcessorRenderer;
     int  m_videoFpsDetect;
+    int  m_videoDemuxReadAheadPackets;
+    int  m_videoFilterThreads;
     bool m_mediacodecForceSoftwareRendering;
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
@@ -284,6 +287,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iEpgUpdateEmptyTagsInterval; // seconds
     bool m_bEpgDisplayUpdatePopup;
     bool m_bEpgDisplayIncrementalUpdatePopup;
+    int m_iEpgUpdateChannelsPerClient;
+    int m_iEpgPersistBatchSize;       // tags
+    bool m_bEpgLazyLoadPlots;
 
     // EDL Commercial Break
     bool m_bEdlMergeShortCommBreaks;
@@ -333,6 +339,10 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iPVRNumericChannelSwitchTimeout; /*!< @brief time in msecs after that a channel switch occurs after entering a channel number, if confirmchannelswitch is disabled */
     int m_iPVRTimeshiftThreshold; /*!< @brief time diff between current playing time and timeshift buffer end, in seconds, before a playing stream is displayed as timeshifting. */
     bool m_bPVRTimeshiftSimpleOSD; /*!< @brief use simple timeshift OSD (with progress only for the playing event instead of progress for the whole ts buffer). */
+    bool m_bPVRPreloadChannelStreams; /*!< @brief fetch the stream urls of the channels next to the playing one in the background, for faster channel switching. */
+    bool m_bPVRBackgroundChannelSync; /*!< @brief start with the channels and groups stored in the database and sync them with the clients in the background. */
+    int m_iPVRTimeshiftBufferSize; /*!< @brief size in MB of the local time-shift buffer for live streams of clients that can't pause them. 0 (default) disables it. */
+    std::map<std::string, int> m_pvrTimeshiftBufferClientSizes; /*!< @brief local time-shift buffer size in MB per client add-on id, overrides m_iPVRTimeshiftBufferSize. */
     DatabaseSettings m_databaseMusic; // advanced music database setup
     DatabaseSettings m_databaseVideo; // advanced video database setup
     DatabaseSettings m_databaseTV;    // advanced tv database setup
@@ -342,6 +352,11 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    bool m_guiSkinWindowCache;
+    int m_guiFontPrewarmCharacters; ///< number of the most used characters of the GUI language rendered in the background at skin load
+    int m_guiVirtualListThreshold; ///< number of songs from which library lists are paged in from the database, 0 to always load all
+    bool m_guiProfileConditions; ///< measure the time spent on skin conditions, logged per window on skin unload
+    int m_guiWindowPrepareBudget; ///< ms to wait for a window loaded by a worker before the busy dialog is shown, -1 to load windows on the GUI thread
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
@@ -0,0 +1,221 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "FileItemListPager.h"
+#include "utils/StringUtils.h"
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// numbered songs "Song 0" ... that can be sorted ascending or descending
+class CTestSource : public IFileItemListSource
+{
+public:
+  explicit CTestSource(int count, int *requests) : m_count(count), m_requests(requests) { }
+
+  std::unique_ptr<IFileItemListSource> Clone() const override
+  {
+    std::unique_ptr<CTestSource> source(new CTestSource(m_count, m_requests));
+    source->m_descending = m_descending;
+    return std::move(source);
+  }
+
+  int GetCount() override { return m_count; }
+
+  bool GetItems(int start, int count, CFileItemList &items) override
+  {
+    (*m_requests)++;
+    for (int i = start; i < start + count; i++)
+    {
+      const int number = m_descending ? m_count - 1 - i : i;
+      CFileItemPtr item(new CFileItem(StringUtils::Format("Song %i", number)));
+      item->SetPath(StringUtils::Format("musicdb://songs/%i.mp3", number));
+      items.Add(item);
+    }
+    return true;
+  }
+
+  bool CanSort(const SortDescription &sortDescription) const override
+  {
+    return sortDescription.sortBy == SortByTitle;
+  }
+
+  bool Sort(const SortDescription &sortDescription) override
+  {
+    if (!CanSort(sortDescription))
+      return false;
+    m_descending = sortDescription.sortOrder == SortOrderDescending;
+    return true;
+  }
+
+  bool GetLetterOffsets(std::vector<std::pair<int, std::string>> &offsets) override
+  {
+    offsets.push_back(std::make_pair(0, "S"));
+    return true;
+  }
+
+private:
+  int m_count;
+  int *m_requests;
+  bool m_descending = false;
+};
+}
+
+TEST(TestFileItemListPager, PagesInItems)
+{
+  int requests = 0;
+  CFileItemListPager pager(std::unique_ptr<IFileItemListSource>(new CTestSource(1000, &requests)));
+
+  EXPECT_EQ(1000, pager.GetCount());
+  EXPECT_EQ(0, requests);
+
+  EXPECT_EQ("Song 150", pager.Get(150)->GetLabel());
+  EXPECT_EQ("Song 199", pager.Get(199)->GetLabel());
+  EXPECT_EQ(1, requests);
+
+  EXPECT_EQ("Song 999", pager.Get(999)->GetLabel());
+  EXPECT_EQ(2, requests);
+  EXPECT_EQ(nullptr, pager.Get(1000));
+  EXPECT_EQ(nullptr, pager.Get(-1));
+}
+
+TEST(TestFileItemListPager, DropsLeastRecentlyUsedPages)
+{
+  int requests = 0;
+  const int pages = CFileItemListPager::MAX_PAGES + 1;
+  CFileItemListPager pager(std::unique_ptr<IFileItemListSource>(new CTestSource(pages * CFileItemListPager::PAGE_SIZE, &requests)));
+
+  for (int page = 0; page < pages; page++)
+    pager.Get(page * CFileItemListPager::PAGE_SIZE);
+  EXPECT_EQ(pages, requests);
+
+  std::vector<std::pair<int, CFileItemPtr>> loaded;
+  pager.GetLoadedItems(loaded);
+  EXPECT_EQ(static_cast<size_t>(CFileItemListPager::MAX_PAGES * CFileItemListPager::PAGE_SIZE), loaded.size());
+
+  // the first page was dropped, the last one is still there
+  pager.Get(pages * CFileItemListPager::PAGE_SIZE - 1);
+  EXPECT_EQ(pages, requests);
+  pager.Get(0);
+  EXPECT_EQ(pages + 1, requests);
+}
+
+TEST(TestFileItemListPager, Sort)
+{
+  int requests = 0;
+  CFileItemListPager pager(std::unique_ptr<IFileItemListSource>(new CTestSource(250, &requests)));
+
+  EXPECT_EQ("Song 0", pager.Get(0)->GetLabel());
+  EXPECT_FALSE(pager.Sort(SortDescription()));
+  EXPECT_EQ("Song 0", pager.Get(0)->GetLabel());
+
+  SortDescription sorting;
+  sorting.sortBy = SortByTitle;
+  sorting.sortOrder = SortOrderDescending;
+  EXPECT_TRUE(pager.Sort(sorting));
+  EXPECT_EQ("Song 249", pager.Get(0)->GetLabel());
+  EXPECT_EQ("Song 0", pager.Get(249)->GetLabel());
+}
+
+TEST(TestFileItemListPager, PrepareFunction)
+{
+  int requests = 0;
+  CFileItemListPager pager(std::unique_ptr<IFileItemListSource>(new CTestSource(10, &requests)));
+  pager.SetPrepareFunction([](CFileItemList &page)
+  {
+    for (int i = 0; i < page.Size(); i++)
+      page[i]->SetLabel2("prepared");
+  });
+
+  EXPECT_EQ("prepared", pager.Get(5)->GetLabel2());
+}
+
+TEST(TestFileItemListPager, LoadsPagesOnJobs)
+{
+  int requests = 0;
+  auto pager = std::make_shared<CFileItemListPager>(std::unique_ptr<IFileItemListSource>(new CTestSource(250, &requests)));
+  pager->SetPrepareFunction([](CFileItemList &page)
+  {
+    for (int i = 0; i < page.Size(); i++)
+      page[i]->SetLabel2("prepared");
+  });
+
+  EXPECT_EQ(nullptr, pager->GetIfLoaded(250));
+
+  // the first call only requests the page
+  CFileItemPtr item = pager->GetIfLoaded(150);
+  for (int i = 0; i < 500 && !item; i++)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    item = pager->GetIfLoaded(150);
+  }
+  ASSERT_NE(nullptr, item);
+  EXPECT_EQ("Song 150", item->GetLabel());
+  EXPECT_EQ("prepared", item->GetLabel2());
+  EXPECT_EQ(1, requests);
+
+  // loaded pages are returned right away
+  ASSERT_NE(nullptr, pager->GetIfLoaded(199));
+  EXPECT_EQ("Song 199", pager->GetIfLoaded(199)->GetLabel());
+  EXPECT_EQ(1, requests);
+}
+
+TEST(TestFileItemListPager, VirtualFileItemList)
+{
+  int requests = 0;
+  CFileItemList items("musicdb://songs/");
+  CFileItemPtr parent(new CFileItem(".."));
+  parent->m_bIsFolder = true;
+  items.Add(parent);
+  items.SetPager(std::make_shared<CFileItemListPager>(std::unique_ptr<IFileItemListSource>(new CTestSource(500, &requests))));
+
+  EXPECT_TRUE(items.IsVirtual());
+  EXPECT_EQ(501, items.Size());
+  EXPECT_EQ(1, items.GetAddedCount());
+  EXPECT_EQ(500, items.GetFileCount());
+  EXPECT_TRUE(items.Get(0)->IsParentFolder());
+  EXPECT_EQ("Song 0", items.Get(1)->GetLabel());
+  EXPECT_EQ("Song 499", items.Get(500)->GetLabel());
+
+  // copies get their own pager, sorting one doesn't change the other
+  CFileItemList copy;
+  copy.Copy(items);
+  EXPECT_EQ(501, copy.Size());
+  ASSERT_NE(nullptr, copy.GetPager());
+  EXPECT_NE(items.GetPager(), copy.GetPager());
+
+  SortDescription sorting;
+  sorting.sortBy = SortByTitle;
+  sorting.sortOrder = SortOrderDescending;
+  EXPECT_TRUE(copy.GetPager()->Sort(sorting));
+  EXPECT_EQ("Song 499", copy.Get(1)->GetLabel());
+  EXPECT_EQ("Song 0", items.Get(1)->GetLabel());
+
+  items.ClearItems();
+  EXPECT_FALSE(items.IsVirtual());
+  EXPECT_EQ(0, items.Size());
+}
+
+TEST(TestFileItemListPager, SortInMemory)
+{
+  int requests = 0;
+  CFileItemList items("musicdb://songs/");
+  items.SetPager(std::make_shared<CFileItemListPager>(std::unique_ptr<IFileItemListSource>(new CTestSource(10, &requests))));
+
+  // the source can't sort by label, all items are loaded and sorted in memory
+  items.Sort(SortByLabel, SortOrderDescending);
+  EXPECT_FALSE(items.IsVirtual());
+  EXPECT_EQ(10, items.Size());
+  EXPECT_EQ("Song 9", items.Get(0)->GetLabel());
+  EXPECT_EQ("Song 0", items.Get(9)->GetLabel());
+}
@@ -15,9 +15,11 @@
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingDefinitions.h"
 #include "utils/StringUtils.h"
+#include "utils/UnicodeTranscoder.h"
 #include "utils/Utf8Utils.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include <fribidi.h>
 #include <iconv.h>
@@ -88,7 +90,17 @@ public:
   CConverterType(const CConverterType& other);
   ~CConverterType();
 
-  iconv_t GetConverter(CSingleLock& converterLock);
+  /*!
+   \brief Open a new iconv handle for the current charsets, the caller owns it
+   \param generation [out] the generation of the charsets the handle was opened for
+   \param targetSingleCharMaxLen [out] size multiplier for the target buffer
+   */
+  iconv_t OpenConverter(unsigned int& generation, unsigned int& targetSingleCharMaxLen);
+
+  /*!
+   \brief Changes whenever the charsets are reset, handles of older generations must not be used any more
+   */
+  unsigned int GetGeneration(void) const { return m_generation; }
 
   void Reset(void);
   void ReinitTo(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen = 1);
@@ -103,8 +115,8 @@ private:
   std::string         m_sourceCharset;
   enum SpecialCharset m_targetSpecialCharset;
   std::string         m_targetCharset;
-  iconv_t             m_iconv;
   unsigned int        m_targetSingleCharMaxLen;
+  std::atomic<unsigned int> m_generation;
 };
 
 CConverterType::CConverterType(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen /*= 1*/) : CCriticalSection(),
@@ -112,8 +124,8 @@ CConverterType::CConverterType(const std::string& sourceCharset, const std::stri
   m_sourceCharset(sourceCharset),
   m_targetSpecialCharset(NotSpecialCharset),
   m_targetCharset(targetCharset),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -122,8 +134,8 @@ CConverterType::CConverterType(enum SpecialCharset sourceSpecialCharset, const s
   m_sourceCharset(),
   m_targetSpecialCharset(NotSpecialCharset),
   m_targetCharset(targetCharset),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -132,8 +144,8 @@ CConverterType::CConverterType(const std::string& sourceCharset, enum SpecialCha
   m_sourceCharset(sourceCharset),
   m_targetSpecialCharset(targetSpecialCharset),
   m_targetCharset(),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -142,8 +154,8 @@ CConverterType::CConverterType(enum SpecialCharset sourceSpecialCharset, enum Sp
   m_sourceCharset(),
   m_targetSpecialCharset(targetSpecialCharset),
   m_targetCharset(),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -152,56 +164,41 @@ CConverterType::CConverterType(const CConverterType& other) : CCriticalSection()
   m_sourceCharset(other.m_sourceCharset),
   m_targetSpecialCharset(other.m_targetSpecialCharset),
   m_targetCharset(other.m_targetCharset),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(other.m_targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(other.m_targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
-CConverterType::~CConverterType()
-{
-  CSingleLock lock(*this);
-  if (m_iconv != NO_ICONV)
-    iconv_close(m_iconv);
-  lock.Leave(); // ensure unlocking before final destruction
-}
+CConverterType::~CConverterType() = default;
 
-iconv_t CConverterType::GetConverter(CSingleLock& converterLock)
+iconv_t CConverterType::OpenConverter(unsigned int& generation, unsigned int& targetSingleCharMaxLen)
 {
-  // ensure that this unique instance is locked externally
-  if (&converterLock.get_underlying() != this)
-    return NO_ICONV;
-
-  if (m_iconv == NO_ICONV)
-  {
-    if (m_sourceSpecialCharset)
-      m_sourceCharset = ResolveSpecialCharset(m_sourceSpecialCharset);
-    if (m_targetSpecialCharset)
-      m_targetCharset = ResolveSpecialCharset(m_targetSpecialCharset);
+  CSingleLock lock(*this);
+  if (m_sourceSpecialCharset)
+    m_sourceCharset = ResolveSpecialCharset(m_sourceSpecialCharset);
+  if (m_targetSpecialCharset)
+    m_targetCharset = ResolveSpecialCharset(m_targetSpecialCharset);
 
-    m_iconv = iconv_open(m_targetCharset.c_str(), m_sourceCharset.c_str());
+  generation = m_generation;
+  targetSingleCharMaxLen = m_targetSingleCharMaxLen;
 
-    if (m_iconv == NO_ICONV)
-      CLog::Log(LOGERROR, "%s: iconv_open() for \"%s\" -> \"%s\" failed, errno = %d (%s)",
-                __FUNCTION__, m_sourceCharset.c_str(), m_targetCharset.c_str(), errno, strerror(errno));
-  }
+  iconv_t converter = iconv_open(m_targetCharset.c_str(), m_sourceCharset.c_str());
+  if (converter == NO_ICONV)
+    CLog::Log(LOGERROR, "%s: iconv_open() for \"%s\" -> \"%s\" failed, errno = %d (%s)",
+              __FUNCTION__, m_sourceCharset.c_str(), m_targetCharset.c_str(), errno, strerror(errno));
 
-  return m_iconv;
+  return converter;
 }
 
 void CConverterType::Reset(void)
 {
   CSingleLock lock(*this);
-  if (m_iconv != NO_ICONV)
-  {
-    iconv_close(m_iconv);
-    m_iconv = NO_ICONV;
-  }
+  m_generation++;
 
   if (m_sourceSpecialCharset)
     m_sourceCharset.clear();
   if (m_targetSpecialCharset)
     m_targetCharset.clear();
-
 }
 
 void CConverterType::ReinitTo(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen /*= 1*/)
@@ -209,11 +206,7 @@ void CConverterType::ReinitTo(const std::string& sourceCharset, const std::strin
   CSingleLock lock(*this);
   if (sourceCharset != m_sourceCharset || targetCharset != m_targetCharset)
   {
-    if (m_iconv != NO_ICONV)
-    {
-      iconv_close(m_iconv);
-      m_iconv = NO_ICONV;
-    }
+    m_generation++;
 
     m_sourceSpecialCharset = NotSpecialCharset;
     m_sourceCharset = sourceCharset;
@@ -270,6 +263,20 @@ public:
 
   template<class INPUT,class OUTPUT>
   static bool stdConvert(StdConversionType convertType, const INPUT& strSource, OUTPUT& strDest, bool failOnInvalidChar = false);
+
+  /* Conversions between Unicode encodings without iconv, return false if the
+     conversion isn't supported or the input has to be handled by iconv */
+  template<class INPUT,class OUTPUT>
+  static bool fastConvert(StdConversionType convertType, const INPUT& strSource, OUTPUT& strDest) { return false; }
+  static bool fastConvert(StdConversionType convertType, const std::string& strSource, std::u32string& strDest);
+  static bool fastConvert(StdConversionType convertType, const std::string& strSource, std::wstring& strDest);
+  static bool fastConvert(StdConversionType convertType, const std::u32string& strSource, std::string& strDest);
+  static bool fastConvert(StdConversionType convertType, const std::u32string& strSource, std::wstring& strDest);
+  static bool fastConvert(StdConversionType convertType, const std::wstring& strSource, std::string& strDest);
+  static bool fastConvert(StdConversionType convertType, const std::wstring& strSource, std::u32string& strDest);
+  static bool fastConvert(StdConversionType convertType, const std::u16string& strSource, std::string& strDest);
+  static bool fastConvert(StdConversionType convertType, const std::u16string& strSource, std::wstring& strDest);
+  static bool isPlainUtf8Source(const std::string& strSource);
   template<class INPUT,class OUTPUT>
   static bool customConvert(const std::string& sourceCharset, const std::string& targetCharset, const INPUT& strSource, OUTPUT& strDest, bool failOnInvalidChar = false);
 
@@ -306,6 +313,49 @@ CConverterType CCharsetConverter::CInnerConverter::m_stdConversion[NumberOfStdCo
 
 CCriticalSection CCharsetConverter::CInnerConverter::m_critSectionFriBiDi;
 
+/* iconv handles must not be used concurrently, so every thread opens its own
+   handles for the standard conversions instead of sharing locked ones */
+class CThreadConverters
+{
+public:
+  struct Converter
+  {
+    iconv_t handle = NO_ICONV;
+    unsigned int generation = 0;
+    unsigned int targetSingleCharMaxLen = 1;
+  };
+
+  ~CThreadConverters()
+  {
+    for (Converter& converter : m_converters)
+    {
+      if (converter.handle != NO_ICONV)
+        iconv_close(converter.handle);
+    }
+  }
+
+  Converter& Get(StdConversionType convertType, CConverterType& convType)
+  {
+    Converter& converter = m_converters[convertType];
+    if (converter.handle == NO_ICONV || converter.generation != convType.GetGeneration())
+    {
+      if (converter.handle != NO_ICONV)
+        iconv_close(converter.handle);
+      converter.handle = convType.OpenConverter(converter.generation, converter.targetSingleCharMaxLen);
+    }
+    return converter;
+  }
+
+  static CThreadConverters& GetInstance()
+  {
+    static thread_local CThreadConverters threadConverters;
+    return threadConverters;
+  }
+
+private:
+  Converter m_converters[NumberOfStdConversionTypes];
+};
+
 template<class INPUT,class OUTPUT>
 bool CCharsetConverter::CInnerConverter::stdConvert(StdConversionType convertType, const INPUT& strSource, OUTPUT& strDest, bool failOnInvalidChar /*= false*/)
 {
@@ -316,10 +366,68 @@ bool CCharsetConverter::CInnerConverter::stdConvert(StdConversionType convertTyp
   if (convertType < 0 || convertType >= NumberOfStdConversionTypes)
     return false;
 
-  CConverterType& convType = m_stdConversion[convertType];
-  CSingleLock converterLock(convType);
+  if (fastConvert(convertType, strSource, strDest))
+    return true;
+
+  CThreadConverters::Converter& converter = CThreadConverters::GetInstance().Get(convertType, m_stdConversion[convertType]);
+
+  return convert(converter.handle, converter.targetSingleCharMaxLen, strSource, strDest, failOnInvalidChar);
+}
+
+bool CCharsetConverter::CInnerConverter::isPlainUtf8Source(const std::string& strSource)
+{
+#if defined(TARGET_DARWIN)
+  // UTF-8-MAC composes decomposed characters, only plain ASCII converts the same way
+  return CUtf8Utils::checkStrForUtf8(strSource) == CUtf8Utils::plainAscii;
+#else
+  return true;
+#endif
+}
+
+bool CCharsetConverter::CInnerConverter::fastConvert(StdConversionType convertType, const std::string& strSource, std::u32string& strDest)
+{
+  return convertType == Utf8ToUtf32 && isPlainUtf8Source(strSource) &&
+         CUnicodeTranscoder::Utf8ToUtf32(strSource, strDest);
+}
 
-  return convert(convType.GetConverter(converterLock), convType.GetTargetSingleCharMaxLen(), strSource, strDest, failOnInvalidChar);
+bool CCharsetConverter::CInnerConverter::fastConvert(StdConversionType convertType, const std::string& strSource, std::wstring& strDest)
+{
+  return convertType == Utf8toW && isPlainUtf8Source(strSource) &&
+         CUnicodeTranscoder::Utf8ToW(strSource, strDest);
+}
+
+bool CCharsetConverter::CInnerConverter::fastConvert(StdConversionType convertType, const std::u32string& strSource, std::string& strDest)
+{
+  return convertType == Utf32ToUtf8 && CUnicodeTranscoder::Utf32ToUtf8(strSource, strDest);
+}
+
+bool CCharsetConverter::CInnerConverter::fastConvert(StdConversionType convertType, const std::u32string& strSource, std::wstring& strDest)
+{
+  return convertType == Utf32ToW && CUnicodeTranscoder::Utf32ToW(strSource, strDest);
+}
+
+bool CCharsetConverter::CInnerConverter::fastConvert(StdConversionType convertType, const std::wstring& strSource, std::string& strDest)
+{
+  return convertType == WtoUtf8 && CUnicodeTranscoder::WToUtf8(strSource, strDest);
+}
+
+bool CCharsetConverter::CInnerConverter::fastConvert(StdConversionType convertType, const std::wstring& strSource, std::u32string& strDest)
+{
+  return convertType == WToUtf32 && CUnicodeTranscoder::WToUtf32(strSource, strDest);
+}
+
+bool CCharsetConverter::CInnerConverter::fastConvert(StdConversionType convertType, const std::u16string& strSource, std::string& strDest)
+{
+  if (convertType == Utf16LEtoUtf8)
+    return CUnicodeTranscoder::Utf16ToUtf8(strSource, strDest, false);
+  if (convertType == Utf16BEtoUtf8)
+    return CUnicodeTranscoder::Utf16ToUtf8(strSource, strDest, true);
+  return false;
+}
+
+bool CCharsetConverter::CInnerConverter::fastConvert(StdConversionType convertType, const std::u16string& strSource, std::wstring& strDest)
+{
+  return convertType == Utf16LEtoW && CUnicodeTranscoder::Utf16ToW(strSource, strDest, false);
 }
 
 template<class INPUT,class OUTPUT>
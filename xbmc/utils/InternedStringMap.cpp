@@ -0,0 +1,87 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "InternedStringMap.h"
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+#include <iterator>
+#include <unordered_set>
+
+namespace
+{
+struct Hash
+{
+  size_t operator()(const std::shared_ptr<const std::string> &str) const
+  {
+    return std::hash<std::string>()(*str);
+  }
+};
+
+struct Equal
+{
+  bool operator()(const std::shared_ptr<const std::string> &left, const std::shared_ptr<const std::string> &right) const
+  {
+    return *left == *right;
+  }
+};
+
+struct StringTable
+{
+  CCriticalSection section;
+  std::unordered_set<std::shared_ptr<const std::string>, Hash, Equal> strings;
+  size_t purgeSize = 1024; // size of the table that triggers the next purge
+
+  void PurgeUnreferenced()
+  {
+    for (auto it = strings.begin(); it != strings.end();)
+      it = it->use_count() == 1 ? strings.erase(it) : std::next(it);
+  }
+};
+
+StringTable& GetStringTable()
+{
+  static StringTable table;
+  return table;
+}
+}
+
+std::shared_ptr<const std::string> CStringInterner::Intern(const std::string &str)
+{
+  // look up with a non-owning pointer to the given string, so hits don't allocate
+  const std::shared_ptr<const std::string> key(std::shared_ptr<const std::string>(), &str);
+
+  StringTable& table = GetStringTable();
+  CSingleLock lock(table.section);
+  const auto it = table.strings.find(key);
+  if (it != table.strings.end())
+    return *it;
+
+  if (table.strings.size() >= table.purgeSize)
+  {
+    table.PurgeUnreferenced();
+    table.purgeSize = std::max(table.purgeSize, table.strings.size() * 2);
+  }
+
+  return *table.strings.insert(std::make_shared<const std::string>(str)).first;
+}
+
+void CStringInterner::Purge()
+{
+  StringTable& table = GetStringTable();
+  CSingleLock lock(table.section);
+  table.PurgeUnreferenced();
+}
+
+size_t CStringInterner::GetSize()
+{
+  StringTable& table = GetStringTable();
+  CSingleLock lock(table.section);
+  return table.strings.size();
+}
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Process wide table of strings shared by many objects.
+
+ Each distinct string is stored once, holders of the returned pointer share
+ it. Strings nobody holds any more are dropped whenever the table has doubled
+ in size, or on Purge(), so keys made up by add-ons don't pile up. Thread safe.
+ */
+class CStringInterner
+{
+public:
+  static std::shared_ptr<const std::string> Intern(const std::string &str);
+
+  /*!
+   \brief Drop all strings nobody holds any more
+   */
+  static void Purge();
+
+  /*!
+   \brief Number of strings in the table
+   */
+  static size_t GetSize();
+};
+
+/*!
+ \brief Small map with interned keys, stored in a sorted vector.
+
+ Takes a pointer and the value per entry instead of a tree node and a key
+ string, which matters for objects that exist in huge numbers with a handful
+ of entries each (e.g. list items with their properties and art). Lookups are
+ binary searches, insertions shift the following entries.
+ */
+template<typename T, typename Less = std::less<std::string>>
+class CInternedStringMap
+{
+public:
+  struct Entry
+  {
+    std::shared_ptr<const std::string> key;
+    T value;
+  };
+
+  typedef typename std::vector<Entry>::const_iterator const_iterator;
+
+  const T* Find(const std::string &key) const
+  {
+    const_iterator it = LowerBound(key);
+    if (it == m_entries.end() || Less()(key, *it->key))
+      return nullptr;
+    return &it->value;
+  }
+
+  /*!
+   \brief Add or change an entry
+   \return true if the entry was added or its value changed
+   */
+  bool Set(const std::string &key, const T &value)
+  {
+    auto it = m_entries.begin() + (LowerBound(key) - m_entries.cbegin());
+    if (it != m_entries.end() && !Less()(key, *it->key))
+    {
+      if (it->value == value)
+        return false;
+      it->value = value;
+      return true;
+    }
+    m_entries.insert(it, Entry{CStringInterner::Intern(key), value});
+    return true;
+  }
+
+  bool Erase(const std::string &key)
+  {
+    auto it = m_entries.begin() + (LowerBound(key) - m_entries.cbegin());
+    if (it == m_entries.end() || Less()(key, *it->key))
+      return false;
+    m_entries.erase(it);
+    return true;
+  }
+
+  void Clear()
+  {
+    // release the memory, cleared items usually stay empty
+    std::vector<Entry>().swap(m_entries);
+  }
+
+  bool Empty() const { return m_entries.empty(); }
+  size_t Size() const { return m_entries.size(); }
+  const_iterator begin() const { return m_entries.cbegin(); }
+  const_iterator end() const { return m_entries.cend(); }
+
+private:
+  const_iterator LowerBound(const std::string &key) const
+  {
+    return std::lower_bound(m_entries.cbegin(), m_entries.cend(), key,
+                            [](const Entry &entry, const std::string &k) { return Less()(*entry.key, k); });
+  }
+
+  std::vector<Entry> m_entries;
+};
@@ -243,20 +243,26 @@ public:
 
   /*!
    \brief Add a function f to this job manager for asynchronously execution.
+   \return the id of the job, 0 if the job manager is shutting down and f won't be run
    */
   template<typename F>
-  void Submit(F&& f, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
+  unsigned int Submit(F&& f, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
   {
-    AddJob(new CLambdaJob<F>(std::forward<F>(f)), nullptr, priority);
+    return Submit(std::forward<F>(f), nullptr, priority);
   }
 
   /*!
    \brief Add a function f to this job manager for asynchronously execution.
+   \return the id of the job, 0 if the job manager is shutting down and f won't be run
    */
   template<typename F>
-  void Submit(F&& f, IJobCallback *callback, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
+  unsigned int Submit(F&& f, IJobCallback *callback, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
   {
-    AddJob(new CLambdaJob<F>(std::forward<F>(f)), callback, priority);
+    CJob *job = new CLambdaJob<F>(std::forward<F>(f));
+    const unsigned int jobID = AddJob(job, callback, priority);
+    if (jobID == 0)
+      delete job;
+    return jobID;
   }
 
   /*!
@@ -302,6 +308,12 @@ public:
    */
   void UnPauseJobs();
 
+  /*!
+   \brief Checks whether jobs with priority PRIORITY_LOW_PAUSABLE are currently paused
+   \sa PauseJobs(), UnPauseJobs()
+   */
+  bool IsPaused() const;
+
   /*!
    \brief Checks to see if any jobs with specific priority are currently processing.
    \param priority to search for
@@ -21,10 +21,13 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "video/VideoInfoTag.h"
 
 #include <cassert>
 #include <cstdlib>
+#include <map>
 
 using namespace MUSIC_INFO;
 
@@ -96,37 +99,67 @@ using namespace MUSIC_INFO;
  *  %p - Last Played
  *  %r - User Rating
  *  *t - Date Taken (suitable for Pictures)
+ *
+ * Masks are parsed once per process into the lists of static and dynamic content,
+ * formatting an item only walks these lists. Items remember the id of the masks
+ * their labels were formatted with, formatting them again with the same masks is
+ * skipped unless the item was changed since.
  */
 
 #define MASK_CHARS "NSATBGYFLDIJRCKMEPHZOQUVXWacdiprstuv"
 
 CLabelFormatter::CLabelFormatter(const std::string &mask, const std::string &mask2)
 {
-  // assemble our label masks
-  AssembleMask(0, mask);
-  AssembleMask(1, mask2);
-  // save a bool for faster lookups
-  m_hideFileExtensions = !CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_FILELISTS_SHOWEXTENSIONS);
+  const bool hideFileExtensions = !CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_FILELISTS_SHOWEXTENSIONS);
+  m_masks = GetCompiledMasks(mask, mask2, hideFileExtensions);
+}
+
+std::shared_ptr<const CLabelFormatter::CCompiledMasks> CLabelFormatter::GetCompiledMasks(const std::string &mask, const std::string &mask2, bool hideFileExtensions)
+{
+  // views use a handful of masks only, so they are kept for the lifetime of the process
+  static CCriticalSection section;
+  static std::map<std::string, std::shared_ptr<const CCompiledMasks>> cache;
+
+  std::string key = std::to_string(mask.size()) + ':' + mask + mask2 + (hideFileExtensions ? '1' : '0');
+
+  CSingleLock lock(section);
+  auto it = cache.find(key);
+  if (it != cache.end())
+    return it->second;
+
+  auto masks = std::make_shared<CCompiledMasks>();
+  AssembleMask(*masks, 0, mask);
+  AssembleMask(*masks, 1, mask2);
+  masks->m_format = static_cast<unsigned int>(cache.size()) + 1;
+  masks->m_hideFileExtensions = hideFileExtensions;
+  cache.insert(std::make_pair(std::move(key), masks));
+  return masks;
 }
 
 std::string CLabelFormatter::GetContent(unsigned int label, const CFileItem *item) const
 {
   assert(label < 2);
-  assert(m_staticContent[label].size() == m_dynamicContent[label].size() + 1);
+  const std::vector<std::string> &staticContent = m_masks->m_staticContent[label];
+  const std::vector<CMaskString> &dynamicContent = m_masks->m_dynamicContent[label];
+  assert(staticContent.size() == dynamicContent.size() + 1);
 
-  if (!item) return "";
+  if (!item || dynamicContent.empty()) return "";
+
+  const CMusicInfoTag *music = item->GetMusicInfoTag();
+  const CVideoInfoTag *movie = item->GetVideoInfoTag();
+  const CPictureInfoTag *pic = item->GetPictureInfoTag();
 
   std::string strLabel, dynamicLeft, dynamicRight;
-  for (unsigned int i = 0; i < m_dynamicContent[label].size(); i++)
+  for (unsigned int i = 0; i < dynamicContent.size(); i++)
   {
-    dynamicRight = GetMaskContent(m_dynamicContent[label][i], item);
+    dynamicRight = GetMaskContent(dynamicContent[i], item, music, movie, pic);
     if ((i == 0 || !dynamicLeft.empty()) && !dynamicRight.empty())
-      strLabel += m_staticContent[label][i];
+      strLabel += staticContent[i];
     strLabel += dynamicRight;
-    dynamicLeft = dynamicRight;
+    dynamicLeft.swap(dynamicRight);
   }
   if (!dynamicLeft.empty())
-    strLabel += m_staticContent[label][m_dynamicContent[label].size()];
+    strLabel += staticContent[dynamicContent.size()];
 
   return strLabel;
 }
@@ -136,7 +169,7 @@ void CLabelFormatter::FormatLabel(CFileItem *item) const
   std::string maskedLabel = GetContent(0, item);
   if (!maskedLabel.empty())
     item->SetLabel(maskedLabel);
-  else if (!item->m_bIsFolder && m_hideFileExtensions)
+  else if (!item->m_bIsFolder && m_masks->m_hideFileExtensions)
     item->RemoveExtension();
 }
 
@@ -145,12 +178,20 @@ void CLabelFormatter::FormatLabel2(CFileItem *item) const
   item->SetLabel2(GetContent(1, item));
 }
 
-std::string CLabelFormatter::GetMaskContent(const CMaskString &mask, const CFileItem *item) const
+void CLabelFormatter::FormatLabels(CFileItem *item) const
+{
+  // e.g. only the sort order or the view changed
+  if (item->GetLabelFormat() == m_masks->m_format)
+    return;
+
+  FormatLabel(item);
+  FormatLabel2(item);
+  item->SetLabelFormat(m_masks->m_format);
+}
+
+std::string CLabelFormatter::GetMaskContent(const CMaskString &mask, const CFileItem *item, const CMusicInfoTag *music,
+                                            const CVideoInfoTag *movie, const CPictureInfoTag *pic) const
 {
-  if (!item) return "";
-  const CMusicInfoTag *music = item->GetMusicInfoTag();
-  const CVideoInfoTag *movie = item->GetVideoInfoTag();
-  const CPictureInfoTag *pic = item->GetPictureInfoTag();
   std::string value;
   switch (mask.m_content)
   {
@@ -358,7 +399,7 @@ std::string CLabelFormatter::GetMaskContent(const CMaskString &mask, const CFile
   return "";
 }
 
-void CLabelFormatter::SplitMask(unsigned int label, const std::string &mask)
+void CLabelFormatter::SplitMask(CCompiledMasks &masks, unsigned int label, const std::string &mask)
 {
   assert(label < 2);
   CRegExp reg;
@@ -367,19 +408,19 @@ void CLabelFormatter::SplitMask(unsigned int label, const std::string &mask)
   int findStart = -1;
   while ((findStart = reg.RegFind(work.c_str())) >= 0)
   { // we've found a match
-    m_staticContent[label].push_back(work.substr(0, findStart));
-    m_dynamicContent[label].push_back(CMaskString("",
+    masks.m_staticContent[label].push_back(work.substr(0, findStart));
+    masks.m_dynamicContent[label].push_back(CMaskString("",
           reg.GetMatch(1)[0], ""));
     work = work.substr(findStart + reg.GetFindLen());
   }
-  m_staticContent[label].push_back(work);
+  masks.m_staticContent[label].push_back(work);
 }
 
-void CLabelFormatter::AssembleMask(unsigned int label, const std::string& mask)
+void CLabelFormatter::AssembleMask(CCompiledMasks &masks, unsigned int label, const std::string& mask)
 {
   assert(label < 2);
-  m_staticContent[label].clear();
-  m_dynamicContent[label].clear();
+  masks.m_staticContent[label].clear();
+  masks.m_dynamicContent[label].clear();
 
   // we want to match [<prefix>%A<postfix]
   // but allow %%, %[, %] to be in the prefix and postfix.  Anything before the first [
@@ -391,31 +432,34 @@ void CLabelFormatter::AssembleMask(unsigned int label, const std::string& mask)
   while ((findStart = reg.RegFind(work.c_str())) >= 0)
   { // we've found a match for a pre/postfixed string
     // send anything
-    SplitMask(label, work.substr(0, findStart) + reg.GetMatch(1));
-    m_dynamicContent[label].push_back(CMaskString(
+    SplitMask(masks, label, work.substr(0, findStart) + reg.GetMatch(1));
+    masks.m_dynamicContent[label].push_back(CMaskString(
             reg.GetMatch(2),
             reg.GetMatch(4)[0],
             reg.GetMatch(5)));
     work = work.substr(findStart + reg.GetFindLen());
   }
-  SplitMask(label, work);
-  assert(m_staticContent[label].size() == m_dynamicContent[label].size() + 1);
+  SplitMask(masks, label, work);
+  assert(masks.m_staticContent[label].size() == masks.m_dynamicContent[label].size() + 1);
 }
 
 bool CLabelFormatter::FillMusicTag(const std::string &fileName, CMusicInfoTag *tag) const
 {
+  const std::vector<std::string> &staticContent = m_masks->m_staticContent[0];
+  const std::vector<CMaskString> &dynamicContent = m_masks->m_dynamicContent[0];
+
   // run through and find static content to split the string up
-  size_t pos1 = fileName.find(m_staticContent[0][0], 0);
+  size_t pos1 = fileName.find(staticContent[0], 0);
   if (pos1 == std::string::npos)
     return false;
-  for (unsigned int i = 1; i < m_staticContent[0].size(); i++)
+  for (unsigned int i = 1; i < staticContent.size(); i++)
   {
-    size_t pos2 = m_staticContent[0][i].size() ? fileName.find(m_staticContent[0][i], pos1) : fileName.size();
+    size_t pos2 = staticContent[i].size() ? fileName.find(staticContent[i], pos1) : fileName.size();
     if (pos2 == std::string::npos)
       return false;
     // found static content - thus we have the dynamic content surrounded
-    FillMusicMaskContent(m_dynamicContent[0][i - 1].m_content, fileName.substr(pos1, pos2 - pos1), tag);
-    pos1 = pos2 + m_staticContent[0][i].size();
+    FillMusicMaskContent(dynamicContent[i - 1].m_content, fileName.substr(pos1, pos2 - pos1), tag);
+    pos1 = pos2 + staticContent[i].size();
   }
   return true;
 }
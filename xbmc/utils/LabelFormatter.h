@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,9 @@ namespace MUSIC_INFO
   class CMusicInfoTag;
 }
 
+class CPictureInfoTag;
+class CVideoInfoTag;
+
 class CFileItem;  // forward
 
 struct LABEL_MASKS
@@ -39,11 +43,12 @@ public:
 
   void FormatLabel(CFileItem *item) const;
   void FormatLabel2(CFileItem *item) const;
-  void FormatLabels(CFileItem *item) const // convenient shorthand
-  {
-    FormatLabel(item);
-    FormatLabel2(item);
-  }
+
+  /*! \brief Format both labels of an item, skipped if the item still has the labels of these masks.
+   Safe to call for different items from several threads at once.
+   \sa CGUIListItem::GetLabelFormat
+   */
+  void FormatLabels(CFileItem *item) const;
 
   bool FillMusicTag(const std::string &fileName, MUSIC_INFO::CMusicInfoTag *tag) const;
 
@@ -61,16 +66,28 @@ private:
     char m_content;
   };
 
+  /*! \brief Both masks split into static text and the metadata to put in between.
+   Parsing a mask is done once per process, all formatters with the same masks share it.
+   */
+  struct CCompiledMasks
+  {
+    std::vector<std::string> m_staticContent[2];
+    std::vector<CMaskString> m_dynamicContent[2];
+    unsigned int m_format; ///< unique id of the masks, stored in the items formatted with them
+    bool m_hideFileExtensions;
+  };
+
+  static std::shared_ptr<const CCompiledMasks> GetCompiledMasks(const std::string &mask, const std::string &mask2, bool hideFileExtensions);
+
   // functions for assembling the mask vectors
-  void AssembleMask(unsigned int label, const std::string &mask);
-  void SplitMask(unsigned int label, const std::string &mask);
+  static void AssembleMask(CCompiledMasks &masks, unsigned int label, const std::string &mask);
+  static void SplitMask(CCompiledMasks &masks, unsigned int label, const std::string &mask);
 
   // functions for retrieving content based on our mask vectors
   std::string GetContent(unsigned int label, const CFileItem *item) const;
-  std::string GetMaskContent(const CMaskString &mask, const CFileItem *item) const;
+  std::string GetMaskContent(const CMaskString &mask, const CFileItem *item, const MUSIC_INFO::CMusicInfoTag *music,
+                             const CVideoInfoTag *movie, const CPictureInfoTag *pic) const;
   void FillMusicMaskContent(const char mask, const std::string &value, MUSIC_INFO::CMusicInfoTag *tag) const;
 
-  std::vector<std::string>   m_staticContent[2];
-  std::vector<CMaskString>  m_dynamicContent[2];
-  bool                 m_hideFileExtensions;
+  std::shared_ptr<const CCompiledMasks> m_masks;
 };
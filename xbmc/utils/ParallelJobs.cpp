@@ -0,0 +1,127 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ParallelJobs.h"
+
+#include "JobManager.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+
+#include <vector>
+
+namespace
+{
+// interval of checking whether waiting shall be aborted
+const unsigned int ABORT_CHECK_INTERVAL_MS = 100;
+}
+
+// shared with the jobs, which may outlive the waiting CParallelJobs by a few instructions
+struct CParallelJobs::State
+{
+  CCriticalSection section;
+  CEvent done{true};
+  size_t iPending = 0; ///< jobs not destroyed yet, whether they ran or not
+  size_t iSubmitted = 0;
+  size_t iRan = 0;
+  bool bAborted = false;
+  std::vector<unsigned int> jobIDs;
+};
+
+namespace
+{
+// owned by the lambda of a job, destroyed with the job once it ran or was dropped
+class CJobToken
+{
+public:
+  explicit CJobToken(std::function<void()> onDone) : m_onDone(std::move(onDone)) {}
+  ~CJobToken() { m_onDone(); }
+
+private:
+  std::function<void()> m_onDone;
+};
+}
+
+CParallelJobs::CParallelJobs(CJob::PRIORITY priority /* = CJob::PRIORITY_DEDICATED */)
+  : m_priority(priority),
+    m_state(std::make_shared<State>())
+{
+  m_state->done.Set();
+}
+
+CParallelJobs::~CParallelJobs()
+{
+  Wait();
+}
+
+void CParallelJobs::Submit(const std::function<void()>& f)
+{
+  const std::shared_ptr<State> state = m_state;
+  {
+    CSingleLock lock(state->section);
+    if (state->iPending++ == 0)
+      state->done.Reset();
+    state->iSubmitted++;
+  }
+
+  const std::shared_ptr<CJobToken> token = std::make_shared<CJobToken>([state]() {
+    CSingleLock lock(state->section);
+    if (--state->iPending == 0)
+      state->done.Set();
+  });
+
+  const unsigned int jobID = CJobManager::GetInstance().Submit([f, state, token]() {
+    {
+      CSingleLock lock(state->section);
+      if (state->bAborted)
+        return;
+    }
+
+    f();
+
+    CSingleLock lock(state->section);
+    state->iRan++;
+  }, m_priority);
+
+  // a rejected job was destroyed already
+  if (jobID != 0)
+  {
+    CSingleLock lock(state->section);
+    state->jobIDs.emplace_back(jobID);
+  }
+}
+
+bool CParallelJobs::Wait(const std::function<bool()>& abort /* = nullptr */)
+{
+  if (abort)
+  {
+    while (!m_state->done.WaitMSec(ABORT_CHECK_INTERVAL_MS))
+    {
+      if (!abort())
+        continue;
+
+      std::vector<unsigned int> jobIDs;
+      {
+        CSingleLock lock(m_state->section);
+        m_state->bAborted = true;
+        jobIDs.swap(m_state->jobIDs);
+      }
+
+      // destroys the jobs that didn't start yet, the running ones are waited for below
+      for (unsigned int jobID : jobIDs)
+        CJobManager::GetInstance().CancelJob(jobID);
+      break;
+    }
+  }
+
+  m_state->done.Wait();
+
+  CSingleLock lock(m_state->section);
+  m_state->jobIDs.clear();
+  return !m_state->bAborted && m_state->iRan == m_state->iSubmitted;
+}
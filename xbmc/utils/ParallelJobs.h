@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "Job.h"
+
+#include <functional>
+#include <memory>
+
+/*!
+ \brief Runs functions in parallel on the job manager and waits for all of them.
+
+ The functions may reference the caller's stack, Wait() only returns once none of
+ them runs any more. Functions the job manager rejects or drops (e.g. CancelJobs()
+ on shutdown) count as done without having run, so waiting never hangs on them.
+
+ \code
+ CParallelJobs jobs;
+ for (const auto& item : items)
+   jobs.Submit([&item]() { item->Update(); });
+ if (!jobs.Wait([this]() { return m_bStop; }))
+   ... // not all items were updated
+ \endcode
+ */
+class CParallelJobs
+{
+public:
+  explicit CParallelJobs(CJob::PRIORITY priority = CJob::PRIORITY_DEDICATED);
+
+  /*!
+   \brief Waits for the submitted functions
+   */
+  ~CParallelJobs();
+
+  /*!
+   \brief Run a function on a job manager worker
+   \param f the function
+   */
+  void Submit(const std::function<void()>& f);
+
+  /*!
+   \brief Wait for all submitted functions
+   \param abort checked while waiting, once it returns true the functions that didn't start
+   yet are cancelled and only those already running are waited for
+   \return true if all functions ran, false if any was rejected, dropped or cancelled
+   */
+  bool Wait(const std::function<bool()>& abort = nullptr);
+
+private:
+  CParallelJobs(const CParallelJobs&) = delete;
+  CParallelJobs& operator=(const CParallelJobs&) = delete;
+
+  struct State;
+
+  const CJob::PRIORITY m_priority;
+  std::shared_ptr<State> m_state;
+};
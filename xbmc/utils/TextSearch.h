@@ -26,6 +26,12 @@ public:
   bool Search(const std::string &strHaystack) const;
   bool IsValid(void) const;
 
+  /*!
+   \brief The terms of which all respectively at least one have to be found, lowercase unless the search is case sensitive
+   */
+  const std::vector<std::string>& GetAndTerms() const { return m_AND; }
+  const std::vector<std::string>& GetOrTerms() const { return m_OR; }
+
 private:
   static void GetAndCutNextTerm(std::string &strSearchTerm, std::string &strNextTerm);
   void ExtractSearchTerms(const std::string &strSearchTerm, TextSearchDefault defaultSearchMode);
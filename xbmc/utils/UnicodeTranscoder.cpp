@@ -0,0 +1,308 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "UnicodeTranscoder.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+#ifdef WORDS_BIGENDIAN
+const bool HOST_BIG_ENDIAN = true;
+#else
+const bool HOST_BIG_ENDIAN = false;
+#endif
+
+/*!
+ \brief Number of leading ASCII bytes, checks 16 (SSE2) or 8 bytes at once
+ */
+size_t AsciiLength(const uint8_t* str, size_t size)
+{
+  size_t pos = 0;
+#if defined(__SSE2__)
+  for (; pos + 16 <= size; pos += 16)
+  {
+    if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos))) != 0)
+      break;
+  }
+#else
+  for (; pos + 8 <= size; pos += 8)
+  {
+    uint64_t block;
+    memcpy(&block, str + pos, sizeof(block));
+    if (block & 0x8080808080808080ULL)
+      break;
+  }
+#endif
+  while (pos < size && str[pos] < 0x80)
+    pos++;
+  return pos;
+}
+
+inline bool IsSurrogate(uint32_t codePoint)
+{
+  return codePoint >= 0xD800 && codePoint <= 0xDFFF;
+}
+
+/*!
+ \brief Append a code point as UTF-16 or UTF-32 code units
+ */
+template<typename CHAR>
+inline void AppendCodePoint(CHAR*& out, uint32_t codePoint)
+{
+  if (sizeof(CHAR) == 2 && codePoint >= 0x10000)
+  {
+    codePoint -= 0x10000;
+    *out++ = static_cast<CHAR>(0xD800 + (codePoint >> 10));
+    *out++ = static_cast<CHAR>(0xDC00 + (codePoint & 0x3FF));
+  }
+  else
+    *out++ = static_cast<CHAR>(codePoint);
+}
+
+inline uint32_t GetUnit(char16_t unit, bool swap)
+{
+  return swap ? static_cast<uint16_t>((unit << 8) | (unit >> 8)) : unit;
+}
+
+inline uint32_t GetUnit(char32_t unit, bool)
+{
+  return unit;
+}
+
+inline uint32_t GetUnit(wchar_t unit, bool swap)
+{
+  return sizeof(wchar_t) == 2 ? GetUnit(static_cast<char16_t>(unit), swap) : static_cast<uint32_t>(unit);
+}
+
+/*!
+ \brief Read the next code point of a UTF-16 or UTF-32 string
+ \return false for unpaired surrogates and code points out of range
+ */
+template<typename CHAR>
+inline bool NextCodePoint(const CHAR* str, size_t size, size_t& pos, bool swap, uint32_t& codePoint)
+{
+  codePoint = GetUnit(str[pos++], swap);
+  if (!IsSurrogate(codePoint))
+    return codePoint <= 0x10FFFF;
+
+  if (sizeof(CHAR) != 2 || codePoint > 0xDBFF || pos == size)
+    return false;
+
+  const uint32_t low = GetUnit(str[pos], swap);
+  if (low < 0xDC00 || low > 0xDFFF)
+    return false;
+
+  pos++;
+  codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+  return true;
+}
+
+template<typename CHAR>
+bool DecodeUtf8(const std::string& src, std::basic_string<CHAR>& dst)
+{
+  static_assert(sizeof(CHAR) == 2 || sizeof(CHAR) == 4, "UTF-16 or UTF-32 code units expected");
+
+  const uint8_t* str = reinterpret_cast<const uint8_t*>(src.data());
+  const size_t size = src.size();
+  if (size == 0)
+  {
+    dst.clear();
+    return true;
+  }
+
+  // a UTF-8 sequence never has less bytes than code units are needed for it
+  dst.resize(size);
+  CHAR* out = &dst[0];
+
+  size_t pos = 0;
+  while (pos < size)
+  {
+    const size_t asciiEnd = pos + AsciiLength(str + pos, size - pos);
+    for (; pos < asciiEnd; pos++)
+      *out++ = static_cast<CHAR>(str[pos]);
+    if (pos == size)
+      break;
+
+    // multi byte sequence, reject overlong forms, surrogates and values above U+10FFFF
+    const uint8_t lead = str[pos];
+    size_t length;
+    uint32_t codePoint;
+    uint8_t lower = 0x80;
+    uint8_t upper = 0xBF;
+    if (lead < 0xC2)
+      return false;
+    else if (lead < 0xE0)
+    {
+      length = 2;
+      codePoint = lead & 0x1F;
+    }
+    else if (lead < 0xF0)
+    {
+      length = 3;
+      codePoint = lead & 0x0F;
+      if (lead == 0xE0)
+        lower = 0xA0;
+      else if (lead == 0xED)
+        upper = 0x9F;
+    }
+    else if (lead < 0xF5)
+    {
+      length = 4;
+      codePoint = lead & 0x07;
+      if (lead == 0xF0)
+        lower = 0x90;
+      else if (lead == 0xF4)
+        upper = 0x8F;
+    }
+    else
+      return false;
+
+    if (size - pos < length || str[pos + 1] < lower || str[pos + 1] > upper)
+      return false;
+
+    codePoint = (codePoint << 6) | (str[pos + 1] & 0x3F);
+    for (size_t i = 2; i < length; i++)
+    {
+      if ((str[pos + i] & 0xC0) != 0x80)
+        return false;
+      codePoint = (codePoint << 6) | (str[pos + i] & 0x3F);
+    }
+    pos += length;
+
+    AppendCodePoint(out, codePoint);
+  }
+
+  dst.resize(out - dst.data());
+  return true;
+}
+
+template<typename CHAR>
+bool EncodeUtf8(const std::basic_string<CHAR>& src, std::string& dst, bool swap)
+{
+  const CHAR* str = src.data();
+  const size_t size = src.size();
+  if (size == 0)
+  {
+    dst.clear();
+    return true;
+  }
+
+  // at most 4 bytes per UTF-32 unit, 3 bytes per UTF-16 unit (surrogate pairs take 4 bytes for 2 units)
+  dst.resize(size * (sizeof(CHAR) == 2 ? 3 : 4));
+  char* out = &dst[0];
+
+  size_t pos = 0;
+  while (pos < size)
+  {
+    uint32_t codePoint = GetUnit(str[pos], swap);
+    if (codePoint < 0x80)
+    {
+      *out++ = static_cast<char>(codePoint);
+      pos++;
+      continue;
+    }
+
+    if (!NextCodePoint(str, size, pos, swap, codePoint))
+      return false;
+
+    if (codePoint < 0x800)
+    {
+      *out++ = static_cast<char>(0xC0 | (codePoint >> 6));
+    }
+    else if (codePoint < 0x10000)
+    {
+      *out++ = static_cast<char>(0xE0 | (codePoint >> 12));
+      *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    }
+    else
+    {
+      *out++ = static_cast<char>(0xF0 | (codePoint >> 18));
+      *out++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    }
+    *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+
+  dst.resize(out - dst.data());
+  return true;
+}
+
+template<typename IN, typename OUT>
+bool ConvertUnits(const std::basic_string<IN>& src, std::basic_string<OUT>& dst, bool swap)
+{
+  const IN* str = src.data();
+  const size_t size = src.size();
+  if (size == 0)
+  {
+    dst.clear();
+    return true;
+  }
+
+  // a UTF-32 unit takes up to 2 UTF-16 units, a UTF-16 unit never more than one UTF-32 unit
+  dst.resize(sizeof(OUT) < sizeof(IN) ? size * 2 : size);
+  OUT* out = &dst[0];
+
+  size_t pos = 0;
+  while (pos < size)
+  {
+    uint32_t codePoint;
+    if (!NextCodePoint(str, size, pos, swap, codePoint))
+      return false;
+    AppendCodePoint(out, codePoint);
+  }
+
+  dst.resize(out - dst.data());
+  return true;
+}
+}
+
+bool CUnicodeTranscoder::Utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst)
+{
+  return DecodeUtf8(utf8StringSrc, utf32StringDst);
+}
+
+bool CUnicodeTranscoder::Utf8ToW(const std::string& utf8StringSrc, std::wstring& wStringDst)
+{
+  return DecodeUtf8(utf8StringSrc, wStringDst);
+}
+
+bool CUnicodeTranscoder::Utf32ToUtf8(const std::u32string& utf32StringSrc, std::string& utf8StringDst)
+{
+  return EncodeUtf8(utf32StringSrc, utf8StringDst, false);
+}
+
+bool CUnicodeTranscoder::WToUtf8(const std::wstring& wStringSrc, std::string& utf8StringDst)
+{
+  return EncodeUtf8(wStringSrc, utf8StringDst, false);
+}
+
+bool CUnicodeTranscoder::Utf32ToW(const std::u32string& utf32StringSrc, std::wstring& wStringDst)
+{
+  return ConvertUnits(utf32StringSrc, wStringDst, false);
+}
+
+bool CUnicodeTranscoder::WToUtf32(const std::wstring& wStringSrc, std::u32string& utf32StringDst)
+{
+  return ConvertUnits(wStringSrc, utf32StringDst, false);
+}
+
+bool CUnicodeTranscoder::Utf16ToUtf8(const std::u16string& utf16StringSrc, std::string& utf8StringDst, bool bigEndian)
+{
+  return EncodeUtf8(utf16StringSrc, utf8StringDst, bigEndian != HOST_BIG_ENDIAN);
+}
+
+bool CUnicodeTranscoder::Utf16ToW(const std::u16string& utf16StringSrc, std::wstring& wStringDst, bool bigEndian)
+{
+  return ConvertUnits(utf16StringSrc, wStringDst, bigEndian != HOST_BIG_ENDIAN);
+}
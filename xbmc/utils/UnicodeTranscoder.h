@@ -0,0 +1,40 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+
+/*!
+ \brief Conversions between the Unicode encodings without iconv.
+
+ All functions are thread safe and don't lock. The input is validated, they
+ return false for malformed input (invalid or overlong UTF-8 sequences,
+ unpaired surrogates, code points above U+10FFFF) and leave the handling of
+ such strings to CCharsetConverter's iconv based conversions.
+
+ wchar_t strings are UTF-32 or UTF-16 depending on the size of wchar_t.
+ */
+class CUnicodeTranscoder
+{
+public:
+  static bool Utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst);
+  static bool Utf8ToW(const std::string& utf8StringSrc, std::wstring& wStringDst);
+
+  static bool Utf32ToUtf8(const std::u32string& utf32StringSrc, std::string& utf8StringDst);
+  static bool WToUtf8(const std::wstring& wStringSrc, std::string& utf8StringDst);
+
+  static bool Utf32ToW(const std::u32string& utf32StringSrc, std::wstring& wStringDst);
+  static bool WToUtf32(const std::wstring& wStringSrc, std::u32string& utf32StringDst);
+
+  /*!
+   \param bigEndian byte order of the code units in utf16StringSrc
+   */
+  static bool Utf16ToUtf8(const std::u16string& utf16StringSrc, std::string& utf8StringDst, bool bigEndian);
+  static bool Utf16ToW(const std::u16string& utf16StringSrc, std::wstring& wStringDst, bool bigEndian);
+};
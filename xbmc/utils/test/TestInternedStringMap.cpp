@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIListItem.h"
+#include "utils/InternedStringMap.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct NoCaseLess
+{
+  bool operator()(const std::string &s1, const std::string &s2) const
+  {
+    return StringUtils::CompareNoCase(s1, s2) < 0;
+  }
+};
+}
+
+TEST(TestInternedStringMap, Intern)
+{
+  const std::shared_ptr<const std::string> thumb = CStringInterner::Intern("thumb");
+  EXPECT_EQ(thumb, CStringInterner::Intern(std::string("thu") + "mb"));
+  EXPECT_NE(thumb, CStringInterner::Intern("Thumb"));
+  EXPECT_EQ("thumb", *thumb);
+}
+
+TEST(TestInternedStringMap, PurgesUnusedStrings)
+{
+  CStringInterner::Purge();
+  const size_t size = CStringInterner::GetSize();
+
+  {
+    // keys made up per item, e.g. by add-ons
+    CInternedStringMap<std::string> map;
+    for (int i = 0; i < 100; i++)
+      map.Set(StringUtils::Format("contextmenulabel(%i)", i), "label");
+    EXPECT_EQ(size + 100, CStringInterner::GetSize());
+  }
+
+  const std::shared_ptr<const std::string> held = CStringInterner::Intern("contextmenulabel(1000)");
+  CStringInterner::Purge();
+  EXPECT_EQ(size + 1, CStringInterner::GetSize());
+  EXPECT_EQ(held, CStringInterner::Intern("contextmenulabel(1000)"));
+}
+
+TEST(TestInternedStringMap, SetFindErase)
+{
+  CInternedStringMap<std::string> map;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(nullptr, map.Find("thumb"));
+
+  EXPECT_TRUE(map.Set("thumb", "a.jpg"));
+  EXPECT_TRUE(map.Set("fanart", "b.jpg"));
+  EXPECT_TRUE(map.Set("banner", "c.jpg"));
+  EXPECT_FALSE(map.Set("fanart", "b.jpg"));
+  EXPECT_TRUE(map.Set("fanart", "d.jpg"));
+  ASSERT_EQ(3U, map.Size());
+  ASSERT_NE(nullptr, map.Find("fanart"));
+  EXPECT_EQ("d.jpg", *map.Find("fanart"));
+  EXPECT_EQ(nullptr, map.Find("Fanart"));
+
+  // iterates in key order like std::map
+  std::vector<std::string> keys;
+  for (const auto& entry : map)
+    keys.push_back(*entry.key);
+  EXPECT_EQ((std::vector<std::string>{"banner", "fanart", "thumb"}), keys);
+
+  EXPECT_TRUE(map.Erase("banner"));
+  EXPECT_FALSE(map.Erase("banner"));
+  EXPECT_EQ(2U, map.Size());
+
+  map.Clear();
+  EXPECT_TRUE(map.Empty());
+}
+
+TEST(TestInternedStringMap, IgnoreCase)
+{
+  CInternedStringMap<CVariant, NoCaseLess> map;
+  EXPECT_TRUE(map.Set("TotalEpisodes", 10));
+  EXPECT_FALSE(map.Set("totalepisodes", 10));
+  EXPECT_TRUE(map.Set("TOTALEPISODES", 12));
+  ASSERT_EQ(1U, map.Size());
+  EXPECT_EQ("TotalEpisodes", *map.begin()->key);
+  EXPECT_EQ(12, map.Find("totalEpisodes")->asInteger());
+}
+
+TEST(TestInternedStringMap, ListItemProperties)
+{
+  CGUIListItem item;
+  EXPECT_FALSE(item.HasProperties());
+  item.SetProperty("WatchedEpisodes", 3);
+  item.IncrementProperty("watchedepisodes", 2);
+  EXPECT_EQ(5, item.GetProperty("WATCHEDEPISODES").asInteger());
+  EXPECT_TRUE(item.GetProperty("unknown").isNull());
+
+  item.SetArt("thumb", "a.jpg");
+  item.SetArtFallback("poster", "thumb");
+  EXPECT_EQ("a.jpg", item.GetArt("poster"));
+  EXPECT_TRUE(item.HasArt());
+  EXPECT_EQ(1U, item.GetArtCount());
+  EXPECT_EQ(1U, item.GetArt().size());
+
+  CGUIListItem copy(item);
+  EXPECT_EQ(5, copy.GetProperty("watchedepisodes").asInteger());
+  EXPECT_EQ("a.jpg", copy.GetArt("poster"));
+
+  item.ClearProperty("watchedEpisodes");
+  EXPECT_FALSE(item.HasProperties());
+  EXPECT_TRUE(copy.HasProperties());
+}
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+namespace
+{
+size_t HeapInUse()
+{
+  return mallinfo2().uordblks;
+}
+
+// properties and art of a typical tv show item
+void FillItem(CGUIListItem &item, int index)
+{
+  item.SetProperty("TotalSeasons", 5);
+  item.SetProperty("TotalEpisodes", 60 + index % 10);
+  item.SetProperty("WatchedEpisodes", index % 60);
+  item.SetProperty("UnWatchedEpisodes", 60 - index % 60);
+  item.SetProperty("NumEpisodes", 60);
+  item.SetProperty("IsPlayable", "true");
+  item.SetArt("thumb", "image://thumb.jpg/");
+  item.SetArt("fanart", "image://fanart.jpg/");
+  item.SetArt("poster", "image://poster.jpg/");
+  item.SetArt("banner", "image://banner.jpg/");
+  item.SetArtFallback("thumb", "poster");
+}
+
+// the storage used before, a tree node with its own key string per entry
+struct MapStorage
+{
+  std::map<std::string, CVariant, NoCaseLess> properties;
+  std::map<std::string, std::string> art;
+  std::map<std::string, std::string> artFallbacks;
+};
+}
+
+// run with --gtest_also_run_disabled_tests to see the memory used per list item. an -O2 build
+// with glibc 2.36 reported 1344 bytes per item for the std::map storage and 719 bytes for CGUIListItem.
+TEST(TestInternedStringMap, DISABLED_MemoryPerItem)
+{
+  const int count = 100000;
+
+  {
+    std::vector<MapStorage> items(count);
+    const size_t before = HeapInUse();
+    for (int i = 0; i < count; i++)
+    {
+      CGUIListItem item;
+      FillItem(item, i);
+      for (const auto& entry : {"TotalSeasons", "TotalEpisodes", "WatchedEpisodes", "UnWatchedEpisodes", "NumEpisodes", "IsPlayable"})
+        items[i].properties.insert(std::make_pair(entry, item.GetProperty(entry)));
+      items[i].art = item.GetArt();
+      items[i].artFallbacks.insert(std::make_pair("thumb", "poster"));
+    }
+    const size_t mapBytes = HeapInUse() - before;
+    std::cout << "std::map storage: " << mapBytes / count << " bytes per item" << std::endl;
+  }
+
+  std::vector<CGUIListItem> items(count);
+  const size_t before = HeapInUse();
+  for (int i = 0; i < count; i++)
+    FillItem(items[i], i);
+  const size_t internedBytes = HeapInUse() - before;
+  std::cout << "interned storage: " << internedBytes / count << " bytes per item ("
+            << CStringInterner::GetSize() << " interned keys)" << std::endl;
+}
+#endif
@@ -9,6 +9,7 @@
 #include "FileItem.h"
 #include "ServiceBroker.h"
 #include "filesystem/File.h"
+#include "music/tags/MusicInfoTag.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "test/TestUtils.h"
@@ -79,3 +80,42 @@ TEST_F(TestLabelFormatter, FormatLabel2)
 
   EXPECT_TRUE(XBMC_DELETETEMPFILE(tmpfile));
 }
+
+TEST_F(TestLabelFormatter, FormatLabelsCached)
+{
+  CLabelFormatter formatter("%T", "%A");
+  CFileItem item;
+  item.GetMusicInfoTag()->SetTitle("Title");
+  item.GetMusicInfoTag()->SetArtist("Artist");
+
+  formatter.FormatLabels(&item);
+  EXPECT_EQ("Title", item.GetLabel());
+  EXPECT_EQ("Artist", item.GetLabel2());
+  EXPECT_NE(0U, item.GetLabelFormat());
+
+  // formatters with the same masks share the compiled masks
+  const unsigned int format = item.GetLabelFormat();
+  CLabelFormatter same("%T", "%A");
+  same.FormatLabels(&item);
+  EXPECT_EQ(format, item.GetLabelFormat());
+
+  // a label set by someone else is formatted again
+  item.SetLabel2("changed");
+  EXPECT_EQ(0U, item.GetLabelFormat());
+  same.FormatLabels(&item);
+  EXPECT_EQ("Artist", item.GetLabel2());
+
+  // so is an item whose tag may have changed
+  item.GetMusicInfoTag()->SetTitle("Other");
+  formatter.FormatLabels(&item);
+  EXPECT_EQ("Other", item.GetLabel());
+
+  CLabelFormatter other("%A", "%T");
+  other.FormatLabels(&item);
+  EXPECT_EQ("Artist", item.GetLabel());
+  EXPECT_EQ("Other", item.GetLabel2());
+
+  // copies are formatted again
+  CFileItem copy(item);
+  EXPECT_EQ(0U, copy.GetLabelFormat());
+}
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/JobManager.h"
+#include "utils/ParallelJobs.h"
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+class TestParallelJobs : public testing::Test
+{
+protected:
+  ~TestParallelJobs() override
+  {
+    CJobManager::GetInstance().UnPauseJobs();
+    CJobManager::GetInstance().CancelJobs();
+    CJobManager::GetInstance().Restart();
+  }
+};
+
+TEST_F(TestParallelJobs, RunsAll)
+{
+  std::atomic<int> count{0};
+
+  CParallelJobs jobs;
+  for (int i = 0; i < 20; i++)
+    jobs.Submit([&count]() { count++; });
+
+  EXPECT_TRUE(jobs.Wait());
+  EXPECT_EQ(20, count);
+}
+
+TEST_F(TestParallelJobs, Rejected)
+{
+  std::atomic<int> count{0};
+
+  // the job manager rejects jobs until it is restarted
+  CJobManager::GetInstance().CancelJobs();
+
+  CParallelJobs jobs;
+  jobs.Submit([&count]() { count++; });
+
+  EXPECT_FALSE(jobs.Wait());
+  EXPECT_EQ(0, count);
+}
+
+TEST_F(TestParallelJobs, Aborted)
+{
+  std::atomic<int> count{0};
+
+  // paused jobs stay queued until they are cancelled
+  CJobManager::GetInstance().PauseJobs();
+
+  CParallelJobs jobs(CJob::PRIORITY_LOW_PAUSABLE);
+  for (int i = 0; i < 3; i++)
+    jobs.Submit([&count]() { count++; });
+
+  EXPECT_FALSE(jobs.Wait([]() { return true; }));
+  EXPECT_EQ(0, count);
+}
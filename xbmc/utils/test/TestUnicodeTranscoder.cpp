@@ -0,0 +1,150 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/CharsetConverter.h"
+#include "utils/UnicodeTranscoder.h"
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+// "Kodi: Unicode" with accents, the euro sign and G clef: two, three and four byte sequences
+static const char utf8Mixed[] = "Kodi: \xc3\x9cn\xc3\xaf\x63\xc3\xb6\x64\xc3\xa9 \xe2\x82\xac \xf0\x9d\x84\x9e";
+static const char32_t utf32Mixed[] = U"Kodi: \u00dcn\u00efc\u00f6d\u00e9 \u20ac \U0001d11e";
+static const char16_t utf16Mixed[] = u"Kodi: \u00dcn\u00efc\u00f6d\u00e9 \u20ac \U0001d11e";
+
+TEST(TestUnicodeTranscoder, Utf8ToUtf32)
+{
+  std::u32string result;
+  EXPECT_TRUE(CUnicodeTranscoder::Utf8ToUtf32(utf8Mixed, result));
+  EXPECT_EQ(std::u32string(utf32Mixed), result);
+
+  EXPECT_TRUE(CUnicodeTranscoder::Utf8ToUtf32("", result));
+  EXPECT_TRUE(result.empty());
+
+  // longer than the blocks checked at once for ASCII
+  std::string ascii(100, 'a');
+  ascii += "\xc3\xa9";
+  EXPECT_TRUE(CUnicodeTranscoder::Utf8ToUtf32(ascii, result));
+  ASSERT_EQ(101U, result.size());
+  EXPECT_EQ(U'a', result[99]);
+  EXPECT_EQ(U'\u00e9', result[100]);
+}
+
+TEST(TestUnicodeTranscoder, Utf8ToUtf32EmbeddedNull)
+{
+  std::u32string result;
+  EXPECT_TRUE(CUnicodeTranscoder::Utf8ToUtf32(std::string("a\0b", 3), result));
+  EXPECT_EQ(std::u32string(U"a\0b", 3), result);
+}
+
+TEST(TestUnicodeTranscoder, Utf8Invalid)
+{
+  std::u32string result;
+  // stray continuation byte
+  EXPECT_FALSE(CUnicodeTranscoder::Utf8ToUtf32("a\x80", result));
+  // overlong '/'
+  EXPECT_FALSE(CUnicodeTranscoder::Utf8ToUtf32("\xc0\xaf", result));
+  EXPECT_FALSE(CUnicodeTranscoder::Utf8ToUtf32("\xe0\x80\xaf", result));
+  // encoded surrogate
+  EXPECT_FALSE(CUnicodeTranscoder::Utf8ToUtf32("\xed\xa0\x80", result));
+  // above U+10FFFF
+  EXPECT_FALSE(CUnicodeTranscoder::Utf8ToUtf32("\xf4\x90\x80\x80", result));
+  // truncated sequence
+  EXPECT_FALSE(CUnicodeTranscoder::Utf8ToUtf32("abc\xe2\x82", result));
+  // Latin-1
+  EXPECT_FALSE(CUnicodeTranscoder::Utf8ToUtf32("caf\xe9", result));
+}
+
+TEST(TestUnicodeTranscoder, Utf32ToUtf8)
+{
+  std::string result;
+  EXPECT_TRUE(CUnicodeTranscoder::Utf32ToUtf8(utf32Mixed, result));
+  EXPECT_EQ(std::string(utf8Mixed), result);
+
+  EXPECT_FALSE(CUnicodeTranscoder::Utf32ToUtf8(std::u32string(1, 0xD800), result));
+  EXPECT_FALSE(CUnicodeTranscoder::Utf32ToUtf8(std::u32string(1, 0x110000), result));
+}
+
+TEST(TestUnicodeTranscoder, Utf16ToUtf8)
+{
+  std::string result;
+#ifdef WORDS_BIGENDIAN
+  const bool bigEndian = true;
+#else
+  const bool bigEndian = false;
+#endif
+  EXPECT_TRUE(CUnicodeTranscoder::Utf16ToUtf8(utf16Mixed, result, bigEndian));
+  EXPECT_EQ(std::string(utf8Mixed), result);
+
+  // same string with swapped bytes
+  std::u16string swapped(utf16Mixed);
+  for (char16_t& unit : swapped)
+    unit = static_cast<char16_t>((unit << 8) | (unit >> 8));
+  EXPECT_TRUE(CUnicodeTranscoder::Utf16ToUtf8(swapped, result, !bigEndian));
+  EXPECT_EQ(std::string(utf8Mixed), result);
+
+  // unpaired surrogates
+  EXPECT_FALSE(CUnicodeTranscoder::Utf16ToUtf8(std::u16string(1, 0xD834), result, bigEndian));
+  EXPECT_FALSE(CUnicodeTranscoder::Utf16ToUtf8(std::u16string(1, 0xDD1E), result, bigEndian));
+}
+
+TEST(TestUnicodeTranscoder, WideRoundTrip)
+{
+  std::wstring wide;
+  EXPECT_TRUE(CUnicodeTranscoder::Utf8ToW(utf8Mixed, wide));
+
+  std::u32string utf32;
+  EXPECT_TRUE(CUnicodeTranscoder::WToUtf32(wide, utf32));
+  EXPECT_EQ(std::u32string(utf32Mixed), utf32);
+
+  std::wstring wide2;
+  EXPECT_TRUE(CUnicodeTranscoder::Utf32ToW(utf32, wide2));
+  EXPECT_EQ(wide, wide2);
+
+  std::string utf8;
+  EXPECT_TRUE(CUnicodeTranscoder::WToUtf8(wide, utf8));
+  EXPECT_EQ(std::string(utf8Mixed), utf8);
+}
+
+TEST(TestUnicodeTranscoder, MatchesIconv)
+{
+  // the conversions of CCharsetConverter must not change for valid input
+  std::wstring fast;
+  std::wstring iconv;
+  EXPECT_TRUE(g_charsetConverter.utf8ToW(utf8Mixed, fast, false));
+  EXPECT_TRUE(g_charsetConverter.toW(utf8Mixed, iconv, "UTF-8"));
+  EXPECT_EQ(iconv, fast);
+
+  // invalid input is still handled by iconv, which skips the bad byte
+  EXPECT_TRUE(g_charsetConverter.utf8ToW("a\x80" "b", fast, false, false, false));
+  EXPECT_EQ(std::wstring(L"ab"), fast);
+}
+
+// run with --gtest_also_run_disabled_tests to compare against iconv
+TEST(TestUnicodeTranscoder, DISABLED_Benchmark)
+{
+  const std::string label = "Season 3 - Episode 12: The long and winding road (2018) - \xc3\x9cn\xc3\xaf\x63\xc3\xb6\x64\xc3\xa9";
+  const int iterations = 200000;
+  std::wstring result;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    CUnicodeTranscoder::Utf8ToW(label, result);
+  auto fast = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    g_charsetConverter.toW(label, result, "UTF-8");
+  auto iconv = std::chrono::steady_clock::now() - start;
+
+  std::cout << "Utf8ToW x" << iterations << ": transcoder "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(fast).count() << " ms, iconv "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(iconv).count() << " ms" << std::endl;
+}
@@ -193,6 +193,9 @@ void CVideoDatabase::CreateTables()
 
   CLog::Log(LOGINFO, "create uniqueid table");
   m_pDS->exec("CREATE TABLE uniqueid (uniqueid_id INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, value TEXT, type TEXT)");
+
+  CLog::Log(LOGINFO, "create backfill table");
+  m_pDS->exec("CREATE TABLE backfill (idFile integer)");
 }
 
 void CVideoDatabase::CreateLinkIndex(const char *table)
@@ -3754,6 +3757,74 @@ CVideoInfoTag CVideoDatabase::GetDetailsByTypeAndId(VIDEODB_CONTENT_TYPE type, i
   return details;
 }
 
+bool CVideoDatabase::GetItemsForBackfill(int idFileAfter, unsigned int limit, CFileItemList& items)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    // items without stream details, episodes without a thumb and items without any art
+    std::string sql = PrepareSQL("SELECT media.idFile, media.idMedia, media.mediaType FROM ("
+                                 "SELECT idFile, idMovie AS idMedia, '%s' AS mediaType FROM movie "
+                                 "UNION ALL SELECT idFile, idEpisode, '%s' FROM episode "
+                                 "UNION ALL SELECT idFile, idMVideo, '%s' FROM musicvideo) AS media "
+                                 "WHERE media.idFile > %i AND "
+                                 "(NOT EXISTS (SELECT 1 FROM streamdetails WHERE streamdetails.idFile = media.idFile) OR "
+                                 "(media.mediaType = '%s' AND NOT EXISTS (SELECT 1 FROM art WHERE art.media_id = media.idMedia AND art.media_type = media.mediaType AND art.type = 'thumb')) OR "
+                                 "NOT EXISTS (SELECT 1 FROM art WHERE art.media_id = media.idMedia AND art.media_type = media.mediaType)) "
+                                 "ORDER BY media.idFile LIMIT %u",
+                                 MediaTypeMovie, MediaTypeEpisode, MediaTypeMusicVideo,
+                                 idFileAfter, MediaTypeEpisode, limit);
+    if (!m_pDS->query(sql))
+      return false;
+
+    while (!m_pDS->eof())
+    {
+      CFileItemPtr item(new CFileItem());
+      CVideoInfoTag* tag = item->GetVideoInfoTag();
+      tag->m_iFileId = m_pDS->fv(0).get_asInt();
+      tag->m_iDbId = m_pDS->fv(1).get_asInt();
+      tag->m_type = m_pDS->fv(2).get_asString();
+      items.Add(item);
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s(%i) failed", __FUNCTION__, idFileAfter);
+  }
+  return false;
+}
+
+int CVideoDatabase::GetBackfillCheckpoint()
+{
+  std::string value = GetSingleValue("backfill", "idFile");
+  return value.empty() ? 0 : atoi(value.c_str());
+}
+
+void CVideoDatabase::SetBackfillCheckpoint(int idFile)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return;
+    if (NULL == m_pDS.get()) return;
+
+    BeginTransaction();
+    m_pDS->exec("DELETE FROM backfill");
+    if (idFile > 0)
+      m_pDS->exec(PrepareSQL("INSERT INTO backfill (idFile) VALUES (%i)", idFile));
+    CommitTransaction();
+  }
+  catch (...)
+  {
+    RollbackTransaction();
+    CLog::Log(LOGERROR, "%s(%i) failed", __FUNCTION__, idFile);
+  }
+}
+
 bool CVideoDatabase::GetStreamDetails(CFileItem& item)
 {
   // Note that this function (possibly) creates VideoInfoTags for items that don't have one yet!
@@ -5577,11 +5648,14 @@ void CVideoDatabase::UpdateTables(int iVersion)
     }
     m_pDS->close();
   }
+
+  if (iVersion < 117)
+    m_pDS->exec("CREATE TABLE backfill (idFile integer)");
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 116;
+  return 117;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -624,6 +624,21 @@ public:
   bool GetStreamDetails(CVideoInfoTag& tag) const;
   CVideoInfoTag GetDetailsByTypeAndId(VIDEODB_CONTENT_TYPE type, int id);
 
+  /*! \brief Get library items that are missing stream details or thumbs.
+   Only the file id, database id and media type of the returned items are filled in.
+   \param idFileAfter only return items with a larger file id, used to resume a previous run
+   \param limit maximum number of items to return
+   \param items [out] items ordered by file id
+   \return true if the query succeeded, false otherwise
+   */
+  bool GetItemsForBackfill(int idFileAfter, unsigned int limit, CFileItemList& items);
+
+  /*! \brief Get the file id the last backfill run has processed items up to.
+   \return the file id, 0 if no run is pending
+   */
+  int GetBackfillCheckpoint();
+  void SetBackfillCheckpoint(int idFile);
+
   // scraper settings
   void SetScraperForPath(const std::string& filePath, const ADDON::ScraperPtr& info, const VIDEO::SScanSettings& settings);
   ADDON::ScraperPtr GetScraperForPath(const std::string& strPath);
@@ -14,6 +14,7 @@
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
 #include "threads/SingleLock.h"
+#include "video/jobs/VideoLibraryBackfillJob.h"
 #include "video/jobs/VideoLibraryCleaningJob.h"
 #include "video/jobs/VideoLibraryJob.h"
 #include "video/jobs/VideoLibraryMarkWatchedJob.h"
@@ -25,7 +26,8 @@
 
 CVideoLibraryQueue::CVideoLibraryQueue()
   : CJobQueue(false, 1, CJob::PRIORITY_LOW),
-    m_jobs()
+    m_jobs(),
+    m_backfillQueue(false, 1, CJob::PRIORITY_LOW_PAUSABLE)
 { }
 
 CVideoLibraryQueue::~CVideoLibraryQueue()
@@ -150,6 +152,11 @@ void CVideoLibraryQueue::ResetResumePoint(const CFileItemPtr item)
   AddJob(new CVideoLibraryResetResumePointJob(item));
 }
 
+void CVideoLibraryQueue::BackfillLibrary(bool resumeOnly /* = false */)
+{
+  m_backfillQueue.AddJob(new CVideoLibraryBackfillJob(resumeOnly));
+}
+
 void CVideoLibraryQueue::AddJob(CVideoLibraryJob *job)
 {
   if (job == NULL)
@@ -201,6 +208,7 @@ void CVideoLibraryQueue::CancelAllJobs()
 {
   CSingleLock lock(m_critical);
   CJobQueue::CancelJobs();
+  m_backfillQueue.CancelJobs();
 
   // remove all scanning jobs
   m_jobs.clear();
@@ -224,6 +232,10 @@ void CVideoLibraryQueue::OnJobComplete(unsigned int jobID, bool success, CJob *j
   {
     if (QueueEmpty())
       Refresh();
+
+    // fill in what the scan didn't, instead of when items become visible
+    if (strcmp(job->GetType(), "VideoLibraryScanningJob") == 0)
+      BackfillLibrary();
   }
 
   {
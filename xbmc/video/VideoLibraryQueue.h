@@ -107,6 +107,14 @@ public:
    */
   void ResetResumePoint(const CFileItemPtr item);
 
+  /*!
+   \brief Queue a job filling in missing stream details, durations and
+   thumbs of all library items in the background.
+
+   \param[in] resumeOnly Only continue a previously interrupted run
+   */
+  void BackfillLibrary(bool resumeOnly = false);
+
   /*!
    \brief Adds the given job to the queue.
 
@@ -152,4 +160,7 @@ private:
 
   bool m_modal = false;
   bool m_cleaning = false;
+
+  // backfill runs independently of the other jobs and is paused during playback
+  CJobQueue m_backfillQueue;
 };
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoLibraryBackfillJob.h"
+
+#include "FileItem.h"
+#include "GUIUserMessages.h"
+#include "ServiceBroker.h"
+#include "TextureCache.h"
+#include "Util.h"
+#include "guilib/GUIComponent.h"
+#include "guilib/GUIWindowManager.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/Event.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoInfoTag.h"
+#include "video/VideoThumbLoader.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+namespace
+{
+// number of items fetched from the database per batch and extraction worker
+const unsigned int BATCH_ITEMS_PER_WORKER = 4;
+
+/*!
+ \brief Runs the extraction jobs of a batch and signals every finished job.
+ */
+class CBackfillQueue : public CJobQueue
+{
+public:
+  explicit CBackfillQueue(unsigned int workers)
+    : CJobQueue(false, workers, CJob::PRIORITY_LOW)
+  { }
+
+  void OnJobComplete(unsigned int jobID, bool success, CJob *job) override
+  {
+    if (success)
+      m_updated++;
+
+    CJobQueue::OnJobComplete(jobID, success, job);
+    m_jobEvent.Set();
+  }
+
+  CEvent m_jobEvent;
+  std::atomic<unsigned int> m_updated{0};
+};
+
+CFileItemPtr LoadItem(CVideoDatabase &db, int dbId, const std::string &mediaType)
+{
+  VIDEODB_CONTENT_TYPE type;
+  if (mediaType == MediaTypeMovie)
+    type = VIDEODB_CONTENT_MOVIES;
+  else if (mediaType == MediaTypeEpisode)
+    type = VIDEODB_CONTENT_EPISODES;
+  else if (mediaType == MediaTypeMusicVideo)
+    type = VIDEODB_CONTENT_MUSICVIDEOS;
+  else
+    return CFileItemPtr();
+
+  CVideoInfoTag tag = db.GetDetailsByTypeAndId(type, dbId);
+  if (tag.m_iDbId <= 0 || tag.m_strFileNameAndPath.empty())
+    return CFileItemPtr();
+
+  CFileItemPtr item(new CFileItem(tag));
+
+  std::map<std::string, std::string> artwork;
+  if (db.GetArtForItem(dbId, mediaType, artwork))
+    item->SetArt(artwork);
+
+  return item;
+}
+}
+
+CVideoLibraryBackfillJob::CVideoLibraryBackfillJob(bool resumeOnly /* = false */)
+  : m_resumeOnly(resumeOnly)
+{ }
+
+bool CVideoLibraryBackfillJob::operator==(const CJob* job) const
+{
+  // there's no point in having more than one backfill job
+  return strcmp(job->GetType(), GetType()) == 0;
+}
+
+bool CVideoLibraryBackfillJob::Cancel()
+{
+  m_cancelled = true;
+  m_cancelEvent.Set();
+  return true;
+}
+
+bool CVideoLibraryBackfillJob::IsCancelled()
+{
+  return m_cancelled || ShouldCancel(0, 0);
+}
+
+bool CVideoLibraryBackfillJob::Work(CVideoDatabase &db)
+{
+  const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+
+  // same conditions as for on-demand extraction in CVideoThumbLoader
+  if (!settings->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTFLAGS))
+    return true;
+  const bool extractThumb = settings->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTTHUMB);
+
+  int checkpoint = db.GetBackfillCheckpoint();
+  if (m_resumeOnly && checkpoint <= 0)
+    return true;
+
+  const unsigned int workers = std::max(2, g_cpuInfo.getCPUCount() / 2);
+  CBackfillQueue queue(workers);
+
+  CLog::Log(LOGDEBUG, "%s - filling in library items after file %i with %u workers", __FUNCTION__, checkpoint, workers);
+
+  while (!IsCancelled())
+  {
+    // don't start a batch while pausable jobs are held back, e.g. during playback
+    if (CJobManager::GetInstance().IsPaused())
+    {
+      m_cancelEvent.WaitMSec(500);
+      continue;
+    }
+
+    CFileItemList items;
+    if (!db.GetItemsForBackfill(checkpoint, workers * BATCH_ITEMS_PER_WORKER, items))
+      return false;
+
+    if (items.IsEmpty())
+    {
+      CLog::Log(LOGDEBUG, "%s - all library items are up to date", __FUNCTION__);
+      db.SetBackfillCheckpoint(0);
+      break;
+    }
+
+    for (const auto& batchItem : items)
+    {
+      const CVideoInfoTag* batchTag = batchItem->GetVideoInfoTag();
+      CFileItemPtr item = LoadItem(db, batchTag->m_iDbId, batchTag->m_type);
+      if (!item)
+        continue;
+
+      const CVideoInfoTag* tag = item->GetVideoInfoTag();
+      bool needsThumb = extractThumb && !item->HasArt("thumb") &&
+                        (tag->m_type == MediaTypeEpisode || !item->HasArt());
+      if (needsThumb)
+      {
+        // an auto-generated thumb may already exist, e.g. from browsing by file
+        std::string thumbURL = CVideoThumbLoader::GetEmbeddedThumbURL(*item);
+        if (CTextureCache::GetInstance().HasCachedImage(thumbURL))
+          db.SetArtForItem(tag->m_iDbId, tag->m_type, "thumb", thumbURL);
+        else
+        {
+          queue.AddJob(new CThumbExtractor(*item, item->GetPath(), true, thumbURL));
+          continue;
+        }
+      }
+
+      if (!tag->HasStreamDetails())
+        queue.AddJob(new CThumbExtractor(*item, item->GetPath(), false));
+    }
+
+    while (queue.IsProcessing())
+    {
+      if (IsCancelled())
+      {
+        queue.CancelJobs();
+        return false;
+      }
+      queue.m_jobEvent.WaitMSec(100);
+    }
+
+    // the batch is done, an interrupted run continues after it
+    checkpoint = items.Get(items.Size() - 1)->GetVideoInfoTag()->m_iFileId;
+    db.SetBackfillCheckpoint(checkpoint);
+  }
+
+  if (queue.m_updated > 0)
+  {
+    CUtil::DeleteVideoDatabaseDirectoryCache();
+    CGUIMessage msg(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE);
+    CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
+  }
+
+  return !IsCancelled();
+}
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Event.h"
+#include "video/jobs/VideoLibraryJob.h"
+
+#include <atomic>
+
+/*!
+ \brief Video library job implementation for filling in stream details,
+ durations and thumbs of library items in the background.
+
+ Items are processed in batches by several extraction jobs in parallel. The
+ progress is stored in the video database after every batch, so an
+ interrupted run continues where it left off. While pausable jobs are paused
+ (e.g. during video playback) no new batch is started.
+ */
+class CVideoLibraryBackfillJob : public CVideoLibraryJob
+{
+public:
+  /*!
+   \brief Creates a new backfill job.
+
+   \param[in] resumeOnly Only continue an interrupted run, don't start a new one
+   */
+  explicit CVideoLibraryBackfillJob(bool resumeOnly = false);
+  ~CVideoLibraryBackfillJob() override = default;
+
+  // specialization of CVideoLibraryJob
+  bool CanBeCancelled() const override { return true; }
+  bool Cancel() override;
+
+  // specialization of CJob
+  const char *GetType() const override { return "VideoLibraryBackfillJob"; }
+  bool operator==(const CJob* job) const override;
+
+protected:
+  // implementation of CVideoLibraryJob
+  bool Work(CVideoDatabase &db) override;
+
+private:
+  bool IsCancelled();
+
+  bool m_resumeOnly;
+  std::atomic<bool> m_cancelled{false};
+  CEvent m_cancelEvent;
+};
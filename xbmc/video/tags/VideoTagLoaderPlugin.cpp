@@ -22,9 +22,9 @@ CVideoTagLoaderPlugin::CVideoTagLoaderPlugin(const CFileItem& item, bool forceRe
   // Preserve CFileItem video info and art to avoid info loss between creating VideoInfoTagLoaderFactory and calling Load()
   if (m_item.HasVideoInfoTag())
     m_tag.reset(new CVideoInfoTag(*m_item.GetVideoInfoTag()));
-  auto& art = item.GetArt();
+  CGUIListItem::ArtMap art = item.GetArt();
   if (!art.empty())
-    m_art.reset(new CGUIListItem::ArtMap(art));
+    m_art.reset(new CGUIListItem::ArtMap(std::move(art)));
 }
 
 bool CVideoTagLoaderPlugin::HasInfo() const
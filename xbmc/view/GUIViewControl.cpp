@@ -9,6 +9,7 @@
 #include "GUIViewControl.h"
 
 #include "FileItem.h"
+#include "FileItemListPager.h"
 #include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "guilib/GUIComponent.h"
@@ -20,6 +21,7 @@
 #include "utils/URIUtils.h"
 
 #include <utility>
+#include <vector>
 
 CGUIViewControl::CGUIViewControl(void)
 {
@@ -206,7 +208,7 @@ void CGUIViewControl::SetSelectedItem(const std::string &itemPath)
   URIUtils::RemoveSlashAtEnd(comparePath);
 
   int item = -1;
-  for (int i = 0; i < m_fileItems->Size(); ++i)
+  for (int i = 0; i < m_fileItems->GetAddedCount(); ++i)
   {
     std::string strPath =(*m_fileItems)[i]->GetPath();
     URIUtils::RemoveSlashAtEnd(strPath);
@@ -216,6 +218,23 @@ void CGUIViewControl::SetSelectedItem(const std::string &itemPath)
       break;
     }
   }
+
+  // only look at the loaded items of virtual lists instead of loading all of them
+  if (item < 0 && m_fileItems->IsVirtual())
+  {
+    std::vector<std::pair<int, CFileItemPtr>> loadedItems;
+    m_fileItems->GetPager()->GetLoadedItems(loadedItems);
+    for (const auto& loadedItem : loadedItems)
+    {
+      std::string strPath = loadedItem.second->GetPath();
+      URIUtils::RemoveSlashAtEnd(strPath);
+      if (strPath == comparePath)
+      {
+        item = m_fileItems->GetAddedCount() + loadedItem.first;
+        break;
+      }
+    }
+  }
   SetSelectedItem(item);
 }
 
@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "messaging/ApplicationMessenger.h"
 #include "ContextMenuManager.h"
+#include "FileItemListPager.h"
 #include "FileItemListModification.h"
 #include "GUIPassword.h"
 #include "GUIUserMessages.h"
@@ -50,16 +51,21 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "storage/MediaManager.h"
+#include "threads/Event.h"
 #include "threads/IRunnable.h"
 #include "threads/SystemClock.h"
 #include "utils/FileUtils.h"
+#include "utils/JobManager.h"
 #include "utils/LabelFormatter.h"
 #include "utils/log.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
+#include "utils/SystemInfo.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "view/GUIViewState.h"
+#include <algorithm>
+#include <atomic>
 #include <inttypes.h>
 
 #define CONTROL_BTNVIEWASICONS       2
@@ -106,6 +112,77 @@ protected:
   CFileItemList &m_items;
   bool m_useDir;
 };
+
+class CGetVirtualItems : public IRunnable
+{
+public:
+  CGetVirtualItems(const CFileItemList &list, CFileItemList &items, bool addedItems = true)
+  : m_pager(list.GetPager()->Clone()), m_items(items)
+  {
+    for (int i = 0; addedItems && i < list.GetAddedCount(); i++)
+      m_items.Add(list.Get(i));
+  }
+
+  void Run() override
+  {
+    // a pager of its own, the list keeps paging in its items meanwhile
+    CFileItemList pagerItems;
+    m_result = m_pager->GetAllItems(pagerItems);
+    if (m_result)
+      m_items.Append(pagerItems);
+  }
+
+  bool m_result = false;
+
+protected:
+  std::shared_ptr<CFileItemListPager> m_pager;
+  CFileItemList &m_items;
+};
+
+// smaller lists are formatted faster than jobs are handed out
+const int PARALLEL_FORMAT_MIN_ITEMS = 2000;
+const int FORMAT_CHUNK_SIZE = 250;
+
+/*!
+ \brief Items of a list split into chunks, formatted by whichever thread claims a chunk first
+ */
+struct CFormatChunks
+{
+  std::vector<CFileItem*> items;
+  const CLabelFormatter* fileFormatter;
+  const CLabelFormatter* folderFormatter;
+  int chunks;
+  std::atomic<int> nextChunk{0};
+  std::atomic<int> doneChunks{0};
+  CEvent done;
+};
+
+void FormatItemLabel(CFileItem* item, const CLabelFormatter& fileFormatter, const CLabelFormatter& folderFormatter)
+{
+  if (item->IsLabelPreformatted())
+    return;
+
+  if (item->m_bIsFolder)
+    folderFormatter.FormatLabels(item);
+  else
+    fileFormatter.FormatLabels(item);
+}
+
+void FormatChunks(CFormatChunks& state)
+{
+  // items and formatters are only touched while a chunk is claimed,
+  // the formatting thread waits for all of them to be done
+  int chunk;
+  while ((chunk = state.nextChunk++) < state.chunks)
+  {
+    const size_t end = std::min(state.items.size(), static_cast<size_t>(chunk + 1) * FORMAT_CHUNK_SIZE);
+    for (size_t i = static_cast<size_t>(chunk) * FORMAT_CHUNK_SIZE; i < end; ++i)
+      FormatItemLabel(state.items[i], *state.fileFormatter, *state.folderFormatter);
+
+    if (++state.doneChunks == state.chunks)
+      state.done.Set();
+  }
+}
 }
 
 CGUIMediaWindow::CGUIMediaWindow(int id, const char *xmlFile)
@@ -344,8 +421,11 @@ bool CGUIMediaWindow::OnMessage(CGUIMessage& message)
       }
       else if ( message.GetParam1() == GUI_MSG_REFRESH_THUMBS )
       {
-        for (int i = 0; i < m_vecItems->Size(); i++)
-          m_vecItems->Get(i)->FreeMemory(true);
+        // pages of virtual lists that aren't loaded get the new images when they are
+        std::vector<std::pair<int, CFileItemPtr>> items;
+        m_vecItems->GetLoadedItems(items);
+        for (const auto& item : items)
+          item.second->FreeMemory(true);
         break;  // the window will take care of any info images
       }
       else if (message.GetParam1() == GUI_MSG_REMOVED_MEDIA)
@@ -666,17 +746,31 @@ void CGUIMediaWindow::FormatItemLabels(CFileItemList &items, const LABEL_MASKS &
 {
   CLabelFormatter fileFormatter(labelMasks.m_strLabelFile, labelMasks.m_strLabel2File);
   CLabelFormatter folderFormatter(labelMasks.m_strLabelFolder, labelMasks.m_strLabel2Folder);
-  for (int i=0; i<items.Size(); ++i)
+  // only the items in front of a virtual list, its pages are formatted when they are loaded
+  const int count = items.GetAddedCount();
+  const int helpers = std::min(CSysInfo::GetCPUCount() - 1, count / FORMAT_CHUNK_SIZE);
+  if (count < PARALLEL_FORMAT_MIN_ITEMS || helpers <= 0)
   {
-    CFileItemPtr pItem=items[i];
+    for (int i=0; i<count; ++i)
+      FormatItemLabel(items[i].get(), fileFormatter, folderFormatter);
+  }
+  else
+  {
+    // the jobs share the state, a job started after all chunks were claimed just returns
+    auto state = std::make_shared<CFormatChunks>();
+    state->items.reserve(count);
+    for (int i = 0; i < count; ++i)
+      state->items.push_back(items[i].get());
+    state->fileFormatter = &fileFormatter;
+    state->folderFormatter = &folderFormatter;
+    state->chunks = (count + FORMAT_CHUNK_SIZE - 1) / FORMAT_CHUNK_SIZE;
 
-    if (pItem->IsLabelPreformatted())
-      continue;
+    for (int i = 0; i < helpers; ++i)
+      CJobManager::GetInstance().Submit([state]() { FormatChunks(*state); }, CJob::PRIORITY_HIGH);
 
-    if (pItem->m_bIsFolder)
-      folderFormatter.FormatLabels(pItem.get());
-    else
-      fileFormatter.FormatLabels(pItem.get());
+    // format on this thread as well, the jobs may be queued behind others
+    FormatChunks(*state);
+    state->done.Wait();
   }
 
   if (items.GetSortMethod() == SortByLabel)
@@ -694,11 +788,35 @@ void CGUIMediaWindow::FormatAndSort(CFileItemList &items)
 
   if (viewState.get())
   {
+    // sort methods the source of a virtual list can't do need all items in memory. they are
+    // loaded off the GUI thread, the list keeps its order if they can't be loaded.
+    bool sort = true;
+    if (items.IsVirtual() && !items.GetPager()->CanSort(viewState->GetSortMethod()))
+    {
+      CFileItemList pagerItems;
+      CGetVirtualItems getItems(items, pagerItems, false);
+      if (CGUIDialogBusy::Wait(&getItems, 100, false) && getItems.m_result)
+        items.SetPagerItems(pagerItems);
+      else
+        sort = false;
+    }
+
     LABEL_MASKS labelMasks;
     viewState->GetSortMethodLabelMasks(labelMasks);
     FormatItemLabels(items, labelMasks);
 
-    items.Sort(viewState->GetSortMethod().sortBy, viewState->GetSortOrder(), viewState->GetSortMethod().sortAttributes);
+    if (items.IsVirtual())
+    {
+      items.GetPager()->SetPrepareFunction([this, labelMasks](CFileItemList &page)
+      {
+        FormatItemLabels(page, labelMasks);
+        OnPrepareVirtualItems(page);
+        page.FillInDefaultIcons();
+      });
+    }
+
+    if (sort)
+      items.Sort(viewState->GetSortMethod().sortBy, viewState->GetSortOrder(), viewState->GetSortMethod().sortAttributes);
   }
 }
 
@@ -722,9 +840,20 @@ bool CGUIMediaWindow::GetDirectory(const std::string &strDirectory, CFileItemLis
   if (pathToUrl.IsProtocol("plugin") && !pathToUrl.GetHostName().empty())
     CServiceBroker::GetAddonMgr().UpdateLastUsed(pathToUrl.GetHostName());
 
+  // very large directories are paged in from their source, nothing to cache
+  std::unique_ptr<IFileItemListSource> virtualSource;
+  if (!strDirectory.empty())
+    virtualSource = GetVirtualSource(strDirectory);
+
   // see if we can load a previously cached folder
   CFileItemList cachedItems(strDirectory);
-  if (!strDirectory.empty() && cachedItems.Load(GetID()))
+  if (virtualSource)
+  {
+    items.Clear();
+    items.SetPath(strDirectory);
+    items.SetPager(std::make_shared<CFileItemListPager>(std::move(virtualSource)));
+  }
+  else if (!strDirectory.empty() && cachedItems.Load(GetID()))
   {
     items.Assign(cachedItems);
   }
@@ -781,7 +910,8 @@ bool CGUIMediaWindow::GetDirectory(const std::string &strDirectory, CFileItemLis
   if (iWindow == WINDOW_PICTURES)
     regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_pictureExcludeFromListingRegExps;
 
-  if (regexps.size())
+  // the sources of virtual lists are database queries, they can't be matched against the regexps
+  if (regexps.size() && !items.IsVirtual())
   {
     for (int i=0; i < items.Size();)
     {
@@ -1294,7 +1424,23 @@ void CGUIMediaWindow::RestoreSelectedItemFromHistory()
 {
   std::string strSelectedItem = m_history.GetSelectedItem(m_vecItems->GetPath());
 
-  if (!strSelectedItem.empty())
+  if (!strSelectedItem.empty() && m_vecItems->IsVirtual())
+  {
+    // don't load all pages of a virtual list, the selected item is usually still loaded
+    std::vector<std::pair<int, CFileItemPtr>> loadedItems;
+    m_vecItems->GetLoadedItems(loadedItems);
+    for (const auto& item : loadedItems)
+    {
+      std::string strHistory;
+      GetDirectoryHistoryString(item.second.get(), strHistory);
+      if (strHistory == strSelectedItem)
+      {
+        m_viewControl.SetSelectedItem(item.first);
+        return;
+      }
+    }
+  }
+  else if (!strSelectedItem.empty())
   {
     for (int i = 0; i < m_vecItems->Size(); ++i)
     {
@@ -1493,6 +1639,17 @@ bool CGUIMediaWindow::OnPlayAndQueueMedia(const CFileItemPtr &item, std::string
   int iPlaylist = m_guiState->GetPlaylist();
   if (iPlaylist != PLAYLIST_NONE)
   {
+    // virtual lists only have some of their items loaded, get all of them off the GUI thread
+    CFileItemList virtualItems;
+    const CFileItemList* items = m_vecItems;
+    if (m_vecItems->IsVirtual())
+    {
+      CGetVirtualItems getItems(*m_vecItems, virtualItems);
+      if (!CGUIDialogBusy::Wait(&getItems, 100, false) || !getItems.m_result)
+        return false;
+      items = &virtualItems;
+    }
+
     CServiceBroker::GetPlaylistPlayer().ClearPlaylist(iPlaylist);
     CServiceBroker::GetPlaylistPlayer().Reset();
     int mediaToPlay = 0;
@@ -1500,9 +1657,9 @@ bool CGUIMediaWindow::OnPlayAndQueueMedia(const CFileItemPtr &item, std::string
     // first try to find mainDVD file (VIDEO_TS.IFO).
     // If we find this we should not allow to queue VOB files
     std::string mainDVD;
-    for (int i = 0; i < m_vecItems->Size(); i++)
+    for (int i = 0; i < items->Size(); i++)
     {
-      std::string path = URIUtils::GetFileName(m_vecItems->Get(i)->GetPath());
+      std::string path = URIUtils::GetFileName(items->Get(i)->GetPath());
       if (StringUtils::EqualsNoCase(path, "VIDEO_TS.IFO"))
       {
         mainDVD = path;
@@ -1511,9 +1668,9 @@ bool CGUIMediaWindow::OnPlayAndQueueMedia(const CFileItemPtr &item, std::string
     }
 
     // now queue...
-    for ( int i = 0; i < m_vecItems->Size(); i++ )
+    for ( int i = 0; i < items->Size(); i++ )
     {
-      CFileItemPtr nItem = m_vecItems->Get(i);
+      CFileItemPtr nItem = items->Get(i);
 
       if (nItem->m_bIsFolder)
         continue;
@@ -1917,7 +2074,8 @@ void CGUIMediaWindow::OnFilterItems(const std::string &filter)
   CFileItemList items;
   items.Copy(*m_vecItems, false); // use the original path - it'll likely be relied on for other things later.
   items.Append(*m_unfilteredItems);
-  bool filtered = GetFilteredItems(filter, items);
+  // virtual lists aren't filtered, that would need all of their items
+  bool filtered = !items.IsVirtual() && GetFilteredItems(filter, items);
 
   m_vecItems->ClearItems();
   // we need to clear the sort state and re-sort the items
@@ -1957,7 +2115,8 @@ void CGUIMediaWindow::OnFilterItems(const std::string &filter)
 
   // apply the "filter" option to any folder item so that
   // the filter can be passed down to the sub-directory
-  for (int index = 0; index < m_vecItems->Size(); index++)
+  // (the items of virtual lists are no folders)
+  for (int index = 0; index < m_vecItems->GetAddedCount(); index++)
   {
     CFileItemPtr pItem = m_vecItems->Get(index);
     // if the item is a folder we need to copy the path of
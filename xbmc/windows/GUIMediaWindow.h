@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "IFileItemListSource.h"
 #include "dialogs/GUIDialogContextMenu.h"
 #include "filesystem/DirectoryHistory.h"
 #include "filesystem/VirtualDirectory.h"
@@ -16,6 +17,7 @@
 #include "view/GUIViewControl.h"
 
 #include <atomic>
+#include <memory>
 
 class CFileItemList;
 class CGUIViewState;
@@ -85,6 +87,12 @@ protected:
   void RestoreControlStates() override;
 
   virtual bool GetDirectory(const std::string &strDirectory, CFileItemList &items);
+  /*! \brief Get a source for very large directories, whose items are then paged in instead of loaded at once
+   \param strDirectory The path to the directory to get the items from
+   \return the source of a virtual list, nullptr to get the items of the directory as usual
+   \sa CFileItemList::IsVirtual
+   */
+  virtual std::unique_ptr<IFileItemListSource> GetVirtualSource(const std::string &strDirectory) { return nullptr; }
   /*! \brief Retrieves the items from the given path and updates the list
    \param strDirectory The path to the directory to get the items from
    \param updateFilterPath Whether to update the filter path in m_strFilterPath or not
@@ -103,6 +111,10 @@ protected:
 
   virtual void FormatAndSort(CFileItemList &items);
   virtual void OnPrepareFileItems(CFileItemList &items);
+  /*! \brief Called for each page of a virtual list after it was loaded and its labels were formatted
+   \sa OnPrepareFileItems
+   */
+  virtual void OnPrepareVirtualItems(CFileItemList &items) { }
   virtual void OnCacheFileItems(CFileItemList &items);
   virtual void GetGroupedItems(CFileItemList &items) { }
 